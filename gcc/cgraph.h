@@ -25,6 +25,17 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 #include "bitmap.h"
 #include "tree.h"
 
+/* Side effects of a function, from the most to the least restrictive.
+   A const function only computes its result from its arguments, a pure
+   function may also read global memory.  */
+
+enum ipa_pure_const_state
+{
+  IPA_CONST,
+  IPA_PURE,
+  IPA_NEITHER
+};
+
 /* Information about the function collected locally.
    Available after function is analyzed.  */
 
@@ -47,6 +58,10 @@ struct cgraph_local_info GTY(())
   bool calls_read_all;
   bool calls_write_all;
 
+  /* Side effects of the body of the function, not counting the calls
+     to other functions of the compilation unit.  */
+  enum ipa_pure_const_state pure_const_state;
+
   /* Set once it has been finalized so we consider it to be output.  */
   bool finalized;
 
@@ -78,6 +93,9 @@ struct cgraph_global_info GTY(())
 
   /* Set iff the function has been inlined at least once.  */
   bool inlined;
+
+  /* Side effects of the function including all its callees.  */
+  enum ipa_pure_const_state pure_const_state;
 };
 
 /* Information about the function that is propagated by the RTL backend.
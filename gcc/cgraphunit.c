@@ -175,7 +175,16 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
    performed over the call graph to determine the worst case set of
    side effects of each call.  In a later part of the compiler, these
    local and global sets are examined to make the call clobbering less
-   traumatic both with respect to aliasing and to code generation.  */
+   traumatic both with respect to aliasing and to code generation.
+
+   Public variables are considered as well.  Code outside of the
+   compilation unit may know their address, so every store or load
+   through a pointer is assumed to write or read all of them.
+
+   The same walk classifies each function body as const, pure or
+   neither, and the classification is propagated along with the
+   variable sets.  Functions of the unit that turn out to be const or
+   pure are then marked as such, so their calls clobber nothing.  */
 
 #include "config.h"
 #include "system.h"
@@ -201,17 +210,21 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 #include "intl.h"
 #include "function.h"
 #include "tree-gimple.h"
+#include "coverage.h"
 
 #define INSNS_PER_CALL 10
 
 static void cgraph_expand_all_functions (void);
+static void cgraph_order_by_profile (struct cgraph_node **, int);
 static void cgraph_mark_functions_to_output (void);
 static void cgraph_expand_function (struct cgraph_node *);
 static tree record_call_1 (tree *, int *, void *);
 static void cgraph_mark_local_and_external_functions (void);
+static void cgraph_propagate_constants (void);
 static bool cgraph_default_inline_p (struct cgraph_node *n);
 static void cgraph_analyze_function (struct cgraph_node *node);
 static void cgraph_decide_inlining_incrementally (struct cgraph_node *);
+static bool cgraph_characterize_node_p (struct cgraph_node *);
 
 /* Statistics we collect about inlining algorithm.  */
 static int ncalls_inlined;
@@ -229,10 +242,10 @@ static FILE *cgraph_dump_file;
 
 /* These splay trees contain all of the static variables that are
    being considered by the compilation level alias analysis.  For
-   module_at_a_time compilation, this is the set of static but not
-   public variables.  Any variables that either have their address
-   taken or participate in otherwise unsavory operations are deleted
-   from this list.  */
+   module_at_a_time compilation, this is the set of non-volatile
+   variables with static storage.  Any variables that either have their
+   address taken or participate in otherwise unsavory operations are
+   deleted from this list.  */
 static GTY((param1_is(tree), param2_is(tree)))
      splay_tree static_vars_to_consider_by_tree;
 
@@ -246,6 +259,11 @@ static GTY((param1_is(int), param2_is(tree)))
    uid.  */
 static bitmap module_statics_escape;
 
+/* The subset of the variables considered that are public, indexed by
+   DECL_UID.  This is ored into the local info of a function that reads
+   or writes through a pointer.  */
+static bitmap module_statics_public;
+
 /* FIXME -- PROFILE-RESTRUCTURE: change comment from DECL_UID to var-ann. */    
 /* A bit is set for every module static we are considering and is
    indexed by DECL_UID.  This is ored into the local info when asm
@@ -383,10 +401,11 @@ new_static_vars_info(struct cgraph_node* node,
   local_static_vars_info_t l
     = ggc_calloc (1, sizeof (struct local_static_vars_info_d));
 
-  /* Add the info to the tree's annotation.  */
-  var_ann_t var_ann = get_var_ann(node->decl);
+  /* Add the info to the tree's annotation.  Inline clones share the
+     decl of the function that is output.  */
   node->static_vars_info = info;
-  var_ann->static_vars_info = info;
+  if (!node->global.inlined_to)
+    get_var_ann (node->decl)->static_vars_info = info;
 
   info->local = l;
   l->statics_read_by_decl_uid = BITMAP_GGC_ALLOC ();
@@ -1219,7 +1238,7 @@ searchc (struct searchc_env* env, struct cgraph_node *v)
 /* Topsort the call graph by caller relation.  Put the result in ORDER.
 
    The REDUCE flag is true if you want the cycles reduced to single
-   nodes.  Only consider nodes that have the output bit set. */
+   nodes.  Only consider the nodes cgraph_characterize_node_p accepts.  */
 
 static int
 cgraph_reduced_inorder (struct cgraph_node **order, bool reduce)
@@ -1236,7 +1255,7 @@ cgraph_reduced_inorder (struct cgraph_node **order, bool reduce)
   env.reduce = reduce;
   
   for (node = cgraph_nodes; node; node = node->next)
-    if (node->output) 
+    if (cgraph_characterize_node_p (node))
       {
 	struct dfs_info *info = xcalloc (1, sizeof (struct dfs_info));
 	info->new = true;
@@ -2016,17 +2035,35 @@ cgraph_inline_p (struct cgraph_edge *e, const char **reason)
   return !e->inline_failed;
 }
 
-/* FIXME this needs to be enhanced.  If we are compiling a single
-   module this returns true if the variable is a module level static,
-   but if we are doing whole program compilation, this could return
-   true if TREE_PUBLIC is true. */
 /* Return true if the variable T is the right kind of static variable to
-   perform compilation unit scope escape analysis.  */
+   perform compilation unit scope escape analysis.  Public variables
+   qualify too; the accesses through pointers that may reach them are
+   accounted for by module_statics_public.  */
 
 static inline
 bool has_proper_scope_for_analysis (tree t)
 {
-  return (TREE_STATIC(t)) && !(TREE_PUBLIC(t)) && !(TREE_THIS_VOLATILE(t));
+  return (TREE_STATIC(t)) && !(TREE_THIS_VOLATILE(t));
+}
+
+/* Return true if the set of nodes analyzed by cgraph_characterize_statics
+   includes NODE.  Inline clones stand for the bodies inlined into the
+   functions output.  */
+
+static inline bool
+cgraph_characterize_node_p (struct cgraph_node *node)
+{
+  return node->output || node->global.inlined_to;
+}
+
+/* Lower the pure/const state of the body of FN to STATE.  */
+
+static inline void
+update_pure_const_state (struct cgraph_node *fn,
+			 enum ipa_pure_const_state state)
+{
+  if (fn->local.pure_const_state < state)
+    fn->local.pure_const_state = state;
 }
 
 /* Check to see if T is a read or address of operation on a static var
@@ -2038,8 +2075,8 @@ check_rhs_var (struct cgraph_node *fn, tree t)
 {
   if (TREE_CODE (t) == ADDR_EXPR)
     {
-      tree x = TREE_OPERAND (t, 0);
-      if ((TREE_CODE (x) == VAR_DECL) && has_proper_scope_for_analysis (x))
+      tree x = get_base_address (TREE_OPERAND (t, 0));
+      if (x && (TREE_CODE (x) == VAR_DECL) && has_proper_scope_for_analysis (x))
 	{
 	  if (cgraph_dump_file)
 	    fprintf (cgraph_dump_file, "\nadding address:%s",
@@ -2062,6 +2099,10 @@ check_rhs_var (struct cgraph_node *fn, tree t)
       bitmap_set_bit (fn->static_vars_info->local->statics_read_by_decl_uid, 
 		      DECL_UID (t));
     }
+  else if (TREE_CODE (t) == INDIRECT_REF)
+    bitmap_a_or_b (fn->static_vars_info->local->statics_read_by_decl_uid,
+		   fn->static_vars_info->local->statics_read_by_decl_uid,
+		   module_statics_public);
 }
 
 /* Check to see if T is an assignment to a static var we are
@@ -2073,7 +2114,15 @@ static void
 check_lhs_var (struct cgraph_node *fn, tree t)
 {
   t = get_base_address (t);
+  if (!t
+      || TREE_CODE (t) == INDIRECT_REF
+      || (DECL_P (t) && is_global_var (t)))
+    update_pure_const_state (fn, IPA_NEITHER);
   if (!t) return;
+  if (TREE_CODE (t) == INDIRECT_REF)
+    bitmap_a_or_b (fn->static_vars_info->local->statics_written_by_decl_uid,
+		   fn->static_vars_info->local->statics_written_by_decl_uid,
+		   module_statics_public);
   if ((TREE_CODE (t) == VAR_DECL) && has_proper_scope_for_analysis (t))
     {
       if (cgraph_dump_file)
@@ -2104,6 +2153,8 @@ get_asm_expr_operands (struct cgraph_node * fn, tree stmt)
   tree link;
   const char *constraint;
   bool allows_mem, allows_reg, is_inout;
+
+  update_pure_const_state (fn, IPA_NEITHER);
   
   for (i=0, link = ASM_OUTPUTS (stmt); link; ++i, link = TREE_CHAIN (link))
     {
@@ -2179,7 +2230,10 @@ process_call_for_static_vars(struct cgraph_node * caller, tree call_expr)
   if (flags & ECF_CONST) 
     return;
   else if (flags & ECF_PURE) 
-    caller->local.calls_write_all = true;
+    {
+      caller->local.calls_read_all = true;
+      update_pure_const_state (caller, IPA_PURE);
+    }
   else 
     {
       tree callee_t = get_callee_fndecl (call_expr);
@@ -2188,15 +2242,24 @@ process_call_for_static_vars(struct cgraph_node * caller, tree call_expr)
 	  /* Indirect call. */
 	  caller->local.calls_read_all = true;
 	  caller->local.calls_write_all = true;
+	  update_pure_const_state (caller, IPA_NEITHER);
 	}
       else 
 	{
- 	  struct cgraph_node* callee = cgraph_node(callee_t);
-
-	  if (callee->local.external) 
+	  struct cgraph_edge *e = cgraph_edge (caller, call_expr);
+
+	  /* Calls to functions whose body is not analyzed here, or may be
+	     replaced at link time, are calls outside of the compilation
+	     unit.  Calls that are inlined always run the body seen.  */
+	  if (!e
+	      || !cgraph_characterize_node_p (e->callee)
+	      || (!e->callee->global.inlined_to
+		  && (DECL_WEAK (callee_t)
+		      || !targetm.binds_local_p (callee_t))))
 	    {
 	      caller->local.calls_read_all = true;
 	      caller->local.calls_write_all = true;
+	      update_pure_const_state (caller, IPA_NEITHER);
 	    }
 	}
     }
@@ -2211,19 +2274,56 @@ process_call_for_static_vars(struct cgraph_node * caller, tree call_expr)
    rather than being a walk_tree callback.  The data is the function
    that is being scanned.  */
 /* TP is the part of the tree currently under the
-   microscope. WALK_SUBTREES is part of the walk_tree api but is
-   unused here.  DATA is cgraph_node of the function being walked.  */
+   microscope. WALK_SUBTREES is part of the walk_tree api.  DATA is
+   cgraph_node of the function being walked.  */
 
 static tree
 scan_for_static_refs (tree *tp, 
-		      int *walk_subtrees ATTRIBUTE_UNUSED, 
+		      int *walk_subtrees, 
 		      void *data)
 {
   struct cgraph_node *fn = data;
   tree t = *tp;
+
+  if (TREE_THIS_VOLATILE (t)
+      && (DECL_P (t) || TREE_CODE_CLASS (TREE_CODE (t)) == tcc_reference))
+    update_pure_const_state (fn, IPA_NEITHER);
   
   switch (TREE_CODE (t))  
     {
+    case VAR_DECL:
+      /* Stores were seen by check_lhs_var; this is a load or a store, and
+	 either way the function is not const.  */
+      if (is_global_var (t) && !TREE_READONLY (t))
+	update_pure_const_state (fn, IPA_PURE);
+      break;
+
+    case INDIRECT_REF:
+      update_pure_const_state (fn, IPA_PURE);
+      break;
+
+    case ADDR_EXPR:
+      /* Taking an address reads nothing.  */
+      *walk_subtrees = 0;
+      break;
+
+    case GOTO_EXPR:
+      /* A jump back to a label already walked may form a loop, and a
+	 function that may not return must not lose its calls because they
+	 look pure.  Labels are entered into VISITED_NODES when their
+	 LABEL_EXPR is walked; do not walk the destination here so a label
+	 only used by forward jumps never gets there first.  */
+      if (TREE_CODE (GOTO_DESTINATION (t)) != LABEL_DECL
+	  || htab_find (visited_nodes, GOTO_DESTINATION (t)))
+	update_pure_const_state (fn, IPA_NEITHER);
+      *walk_subtrees = 0;
+      break;
+
+    case LOOP_EXPR:
+    case VA_ARG_EXPR:
+      update_pure_const_state (fn, IPA_NEITHER);
+      break;
+
     case MODIFY_EXPR:
       {
 	/* First look on the lhs and see what variable is stored to */
@@ -2236,9 +2336,9 @@ scan_for_static_refs (tree *tp,
 	  check_rhs_var (fn, TREE_OPERAND (rhs, 1));
 	  break;
 	case tcc_unary:
-	case tcc_reference:
 	  check_rhs_var (fn, TREE_OPERAND (rhs, 0));
 	  break;
+	case tcc_reference:
 	case tcc_declaration:
 	  check_rhs_var (fn, rhs);
 	  break;
@@ -2295,6 +2395,12 @@ cgraph_characterize_statics_local (struct cgraph_node *fn)
   l->statics_read_by_decl_uid = BITMAP_GGC_ALLOC ();
   l->statics_written_by_decl_uid = BITMAP_GGC_ALLOC ();
   
+  /* The walk lowers this as it finds side effects.  Nested functions
+     may access the frame of their origin.  */
+  fn->local.pure_const_state = IPA_CONST;
+  if (fn->origin || fn->nested)
+    fn->local.pure_const_state = IPA_NEITHER;
+
   if (cgraph_dump_file)
     fprintf (cgraph_dump_file, "\n local analysis of %s", cgraph_node_name (fn));
   
@@ -2345,8 +2451,8 @@ cgraph_propagate_bits (struct cgraph_node *x)
       struct cgraph_node *y = e->callee;
 
       /* We are only going to look at edges that point to nodes that
-	 have their output bit set.  */
-      if (y->output)
+	 have been analyzed.  */
+      if (cgraph_characterize_node_p (y))
 	{
 	  static_vars_info_t y_info; 
 	  global_static_vars_info_t y_global;
@@ -2380,6 +2486,79 @@ cgraph_propagate_bits (struct cgraph_node *x)
     }
 }
 
+/* Compute the pure/const state of the region of the call graph
+   represented by NODE, whose members are linked by next_cycle, from the
+   state of their bodies and of the functions they call.  The callees
+   outside of the region have been visited already.  All the members of
+   a region get the same state.  A call within the region is a recursion,
+   which may not terminate any more than a loop, so it makes the region
+   neither const nor pure.  */
+
+static void
+cgraph_propagate_pure_const (struct cgraph_node *node)
+{
+  enum ipa_pure_const_state state = IPA_CONST;
+  struct cgraph_node *w;
+  struct cgraph_edge *e;
+
+  for (w = node; w; w = w->next_cycle)
+    w->aux = node;
+
+  for (w = node; w && state != IPA_NEITHER; w = w->next_cycle)
+    {
+      if (w->local.pure_const_state > state)
+	state = w->local.pure_const_state;
+      /* The calls to functions that are not analyzed were accounted for
+	 by process_call_for_static_vars.  */
+      for (e = w->callees; e; e = e->next_callee)
+	if (e->callee->aux == node)
+	  state = IPA_NEITHER;
+	else if (cgraph_characterize_node_p (e->callee)
+		 && e->callee->global.pure_const_state > state)
+	  state = e->callee->global.pure_const_state;
+    }
+
+  for (w = node; w; w = w->next_cycle)
+    {
+      w->global.pure_const_state = state;
+      w->aux = NULL;
+    }
+}
+
+/* Mark the function of NODE const or pure if it was found to be so.
+   Only do so when the body analyzed is the one that will run, and when
+   calls to the function can not throw; the calls may be deleted when
+   their result is unused.  */
+
+static void
+cgraph_mark_pure_const (struct cgraph_node *node)
+{
+  tree decl = node->decl;
+
+  if (!flag_ipa_pure_const
+      || node->global.inlined_to
+      || node->global.pure_const_state == IPA_NEITHER
+      || DECL_EXTERNAL (decl)
+      || DECL_WEAK (decl)
+      || TREE_THIS_VOLATILE (decl)
+      || TREE_READONLY (decl)
+      || !targetm.binds_local_p (decl)
+      || (flag_exceptions && !TREE_NOTHROW (decl)))
+    return;
+
+  if (node->global.pure_const_state == IPA_CONST)
+    TREE_READONLY (decl) = 1;
+  else if (!DECL_IS_PURE (decl))
+    DECL_IS_PURE (decl) = 1;
+  else
+    return;
+
+  if (cgraph_dump_file)
+    fprintf (cgraph_dump_file, "\nFunction found to be %s: %s",
+	     TREE_READONLY (decl) ? "const" : "pure",
+	     cgraph_node_name (node));
+}
+
 /* FIXME -- PROFILE-RESTRUCTURE: Change all *_decl_uid to *_ann_uid
    except where noted below.  */
 
@@ -2409,11 +2588,13 @@ cgraph_characterize_statics (void)
   if (module_statics_escape) 
     {
       bitmap_clear (module_statics_escape);
+      bitmap_clear (module_statics_public);
       bitmap_clear (all_module_statics);
     } 
   else
     {
       module_statics_escape = BITMAP_XMALLOC ();
+      module_statics_public = BITMAP_XMALLOC ();
       all_module_statics = BITMAP_GGC_ALLOC ();
     }
 
@@ -2438,6 +2619,12 @@ cgraph_characterize_statics (void)
 	  /* FIXME -- PROFILE-RESTRUCTURE: Change the call from
 	     DECL_UID to get the uid from the var_ann field. */    
 	  bitmap_set_bit (all_module_statics, DECL_UID (global));
+	  if (TREE_PUBLIC (global))
+	    bitmap_set_bit (module_statics_public, DECL_UID (global));
+	  /* The address may have been taken outside of any function,
+	     such as in the initializer of another variable.  */
+	  if (TREE_ADDRESSABLE (global))
+	    bitmap_set_bit (module_statics_escape, DECL_UID (global));
 	}
     }
 
@@ -2466,6 +2653,8 @@ cgraph_characterize_statics (void)
       }
     bitmap_operation (all_module_statics, all_module_statics,
 		      module_statics_escape, BITMAP_AND_COMPL);
+    bitmap_operation (module_statics_public, module_statics_public,
+		      module_statics_escape, BITMAP_AND_COMPL);
 
     for (i = order_pos - 1; i >= 0; i--)
       {
@@ -2600,6 +2789,10 @@ cgraph_characterize_statics (void)
 	  cgraph_propagate_bits (w);
 	  w = w->next_cycle;
 	}
+
+      cgraph_propagate_pure_const (node);
+      for (w = node; w; w = w->next_cycle)
+	cgraph_mark_pure_const (w);
     }
 
   if (cgraph_dump_file)
@@ -2690,6 +2883,130 @@ cgraph_characterize_statics (void)
   free (order);
 }
 
+/* Profile counts of the nodes, indexed by uid, used while ordering the
+   functions for output.  A count of -1 means the node has no profile.  */
+static gcov_type *cgraph_node_counts;
+
+/* Nonzero for the uids of the hot nodes that have not been placed yet.  */
+static char *cgraph_hot_unplaced;
+
+/* Compare two nodes by decreasing profile count, for qsort.  */
+
+static int
+cgraph_node_count_cmp (const void *p1, const void *p2)
+{
+  const struct cgraph_node *n1 = *(const struct cgraph_node *const *) p1;
+  const struct cgraph_node *n2 = *(const struct cgraph_node *const *) p2;
+  gcov_type c1 = cgraph_node_counts[n1->uid];
+  gcov_type c2 = cgraph_node_counts[n2->uid];
+
+  if (c1 != c2)
+    return c1 > c2 ? -1 : 1;
+  return n1->uid - n2->uid;
+}
+
+/* Store into SEQ, starting at *POS, the hot unplaced functions called by
+   NODE, recursively, followed by NODE itself if it is one of them.  Calls
+   inlined into NODE are looked through, as the functions they call are
+   called by NODE's body.  */
+
+static void
+cgraph_place_hot_node (struct cgraph_node *node, struct cgraph_node **seq,
+		       int *pos)
+{
+  struct cgraph_edge *e;
+  bool place = cgraph_hot_unplaced[node->uid];
+
+  /* Mark NODE placed before recursing, so that cycles terminate.  */
+  cgraph_hot_unplaced[node->uid] = 0;
+
+  for (e = node->callees; e; e = e->next_callee)
+    if (!e->inline_failed || cgraph_hot_unplaced[e->callee->uid])
+      cgraph_place_hot_node (e->callee, seq, pos);
+
+  if (place)
+    seq[(*pos)++] = node;
+}
+
+/* With profile feedback, rearrange the ORDER_POS nodes of ORDER, which
+   are expanded from the last to the first, so that the functions the
+   profile shows to be hot are output first, each next to the hot
+   functions it calls, and the remaining ones after them in their original
+   order.  Callees are still output before their callers where the hot
+   subgraph allows it.  Together with the hot and unlikely executed text
+   sections chosen by choose_function_section, this packs the code run by
+   the training workload into as few pages as possible.  */
+
+static void
+cgraph_order_by_profile (struct cgraph_node **order, int order_pos)
+{
+  struct cgraph_node **hot, **seq;
+  const struct gcov_ctr_summary *summary = NULL;
+  gcov_type threshold;
+  int i, n_hot = 0, pos = 0;
+
+  cgraph_node_counts = xcalloc (cgraph_max_uid, sizeof (gcov_type));
+  for (i = 0; i < order_pos; i++)
+    {
+      const struct gcov_ctr_summary *s;
+      struct cgraph_node *node = order[i];
+
+      cgraph_node_counts[node->uid]
+	= coverage_function_max_count (node->decl, &s);
+      if (!summary && cgraph_node_counts[node->uid] >= 0)
+	summary = s;
+    }
+  if (!summary)
+    {
+      free (cgraph_node_counts);
+      return;
+    }
+
+  /* Use the same notion of hotness as maybe_hot_bb_p.  */
+  threshold = summary->sum_max / PARAM_VALUE (HOT_BB_COUNT_FRACTION);
+  cgraph_hot_unplaced = xcalloc (cgraph_max_uid, 1);
+  hot = xmalloc (order_pos * sizeof (struct cgraph_node *));
+  for (i = 0; i < order_pos; i++)
+    if (cgraph_node_counts[order[i]->uid] > threshold)
+      {
+	cgraph_hot_unplaced[order[i]->uid] = 1;
+	hot[n_hot++] = order[i];
+      }
+
+  if (n_hot)
+    {
+      /* SEQ receives the nodes in expansion order: the hot ones, hottest
+	 first together with their hot callees, then all others.  */
+      seq = xmalloc (order_pos * sizeof (struct cgraph_node *));
+      qsort (hot, n_hot, sizeof (struct cgraph_node *), cgraph_node_count_cmp);
+      for (i = 0; i < n_hot; i++)
+	if (cgraph_hot_unplaced[hot[i]->uid])
+	  cgraph_place_hot_node (hot[i], seq, &pos);
+      gcc_assert (pos == n_hot);
+
+      for (i = order_pos - 1; i >= 0; i--)
+	if (cgraph_node_counts[order[i]->uid] <= threshold)
+	  seq[pos++] = order[i];
+      gcc_assert (pos == order_pos);
+
+      for (i = 0; i < order_pos; i++)
+	order[order_pos - 1 - i] = seq[i];
+      free (seq);
+
+      if (cgraph_dump_file)
+	{
+	  fprintf (cgraph_dump_file, "\nHot functions in output order:");
+	  for (i = order_pos - 1; i >= order_pos - n_hot; i--)
+	    fprintf (cgraph_dump_file, " %s", cgraph_node_name (order[i]));
+	  fprintf (cgraph_dump_file, "\n");
+	}
+    }
+
+  free (hot);
+  free (cgraph_hot_unplaced);
+  free (cgraph_node_counts);
+}
+
 /* Expand all functions that must be output.
 
    Attempt to topologically sort the nodes so function is output when
@@ -2718,6 +3035,9 @@ cgraph_expand_all_functions (void)
     if (order[i]->output)
       order[new_order_pos++] = order[i];
 
+  if (flag_reorder_functions && flag_branch_probabilities)
+    cgraph_order_by_profile (order, new_order_pos);
+
   for (i = new_order_pos - 1; i >= 0; i--)
     {
       node = order[i];
@@ -2772,6 +3092,593 @@ cgraph_mark_local_and_external_functions (void)
 }
 }
 
+/* Interprocedural constant propagation.
+
+   The formal parameters of each function are given a value in the lattice
+   below, computed from the arguments of all its calls.  Arguments that are
+   themselves unmodified parameters of a local caller take the value of
+   that parameter, so constants flow through chains of calls; the values
+   are iterated to a fixed point.
+
+   A local function, i.e. one whose calls are all known, gets its body
+   prefixed by an assignment of the constant to each parameter all calls
+   agree on, leaving the rest to the intraprocedural optimizers.  When the
+   calls disagree, the most common combination of constant arguments may
+   still be worth a specialized clone of the function; the calls passing
+   that combination are redirected to the clone.  Cloning is limited by
+   the ipcp-clone-min-calls, ipcp-max-clone-insns and ipcp-unit-growth
+   parameters.  */
+
+/* Lattice of values of a formal parameter.  */
+enum ipcp_lattice_type
+{
+  IPCP_TOP,		/* No call seen yet.  */
+  IPCP_CONST,		/* All calls pass the same constant.  */
+  IPCP_BOTTOM		/* Unknown, or calls disagree.  */
+};
+
+struct ipcp_lattice
+{
+  enum ipcp_lattice_type type;
+  tree value;
+};
+
+/* What IPA-CP knows about a function.  */
+struct ipcp_info
+{
+  /* Number of formal parameters, and the PARM_DECLs themselves.  */
+  int n_params;
+  tree *params;
+  /* The values of the parameters.  */
+  struct ipcp_lattice *lattices;
+  /* Set for the parameters the body may modify.  */
+  bool *modified;
+};
+
+/* IPA-CP information of the candidate functions, indexed by uid; NULL for
+   the other nodes.  */
+static struct ipcp_info **ipcp_infos;
+static int ipcp_n_infos;
+
+/* Number of clones made so far, used to name them.  */
+static int ipcp_clone_number;
+
+/* Return true if IPA-CP may handle NODE.  Nested functions and functions
+   with nested functions share their frames, and variadic functions do not
+   have all their arguments in parameters.  */
+
+static bool
+ipcp_candidate_p (struct cgraph_node *node)
+{
+  tree decl = node->decl;
+
+  return (node->analyzed
+	  && DECL_SAVED_TREE (decl)
+	  && DECL_ARGUMENTS (decl)
+	  && !DECL_EXTERNAL (decl)
+	  && !node->origin
+	  && !node->nested
+	  && DECL_STRUCT_FUNCTION (decl)
+	  && !DECL_STRUCT_FUNCTION (decl)->stdarg);
+}
+
+/* Note in INFO that the parameter REF, a reference to a whole parameter or
+   to a part of it, may be modified.  */
+
+static void
+ipcp_note_modified (struct ipcp_info *info, tree ref)
+{
+  int i;
+
+  while (handled_component_p (ref))
+    ref = TREE_OPERAND (ref, 0);
+  if (TREE_CODE (ref) != PARM_DECL)
+    return;
+  for (i = 0; i < info->n_params; i++)
+    if (ref == info->params[i])
+      info->modified[i] = true;
+}
+
+/* Called via walk_tree.  Note in the ipcp_info DATA the parameters stored
+   to by *TP, in whole or in part, and those whose address it takes.  */
+
+static tree
+ipcp_note_modified_r (tree *tp, int *walk_subtrees ATTRIBUTE_UNUSED,
+		      void *data)
+{
+  struct ipcp_info *info = data;
+  tree t = *tp;
+
+  switch (TREE_CODE (t))
+    {
+    case MODIFY_EXPR:
+    case INIT_EXPR:
+    case PREDECREMENT_EXPR:
+    case PREINCREMENT_EXPR:
+    case POSTDECREMENT_EXPR:
+    case POSTINCREMENT_EXPR:
+    case ADDR_EXPR:
+      ipcp_note_modified (info, TREE_OPERAND (t, 0));
+      break;
+
+    case ASM_EXPR:
+      {
+	tree link;
+
+	for (link = ASM_OUTPUTS (t); link; link = TREE_CHAIN (link))
+	  ipcp_note_modified (info, TREE_VALUE (link));
+      }
+      break;
+
+    default:
+      break;
+    }
+
+  return NULL_TREE;
+}
+
+/* Create the ipcp_info of NODE.  The parameters of functions that are not
+   local may receive any value, so they start at the bottom of the
+   lattice.  */
+
+static struct ipcp_info *
+ipcp_init_info (struct cgraph_node *node)
+{
+  struct ipcp_info *info = xcalloc (1, sizeof (struct ipcp_info));
+  tree parm;
+  int i;
+
+  for (parm = DECL_ARGUMENTS (node->decl); parm; parm = TREE_CHAIN (parm))
+    info->n_params++;
+  info->params = xmalloc (info->n_params * sizeof (tree));
+  info->lattices = xcalloc (info->n_params, sizeof (struct ipcp_lattice));
+  info->modified = xcalloc (info->n_params, sizeof (bool));
+
+  for (i = 0, parm = DECL_ARGUMENTS (node->decl); parm;
+       i++, parm = TREE_CHAIN (parm))
+    {
+      info->params[i] = parm;
+      info->modified[i] = TREE_ADDRESSABLE (parm);
+      info->lattices[i].type = node->local.local ? IPCP_TOP : IPCP_BOTTOM;
+    }
+
+  walk_tree_without_duplicates (&DECL_SAVED_TREE (node->decl),
+				ipcp_note_modified_r, info);
+  return info;
+}
+
+/* Return true if VALUE may be propagated into another function: a numeric
+   constant, or the address of an object or function that has static
+   storage.  The address of an automatic variable of the caller is
+   invariant in the caller only.  */
+
+static bool
+ipcp_propagatable_p (tree value)
+{
+  tree base;
+
+  switch (TREE_CODE (value))
+    {
+    case INTEGER_CST:
+    case REAL_CST:
+      return true;
+
+    case ADDR_EXPR:
+      if (!is_gimple_min_invariant (value))
+	return false;
+      base = TREE_OPERAND (value, 0);
+      while (handled_component_p (base))
+	base = TREE_OPERAND (base, 0);
+      return ((TREE_CODE (base) == VAR_DECL
+	       || TREE_CODE (base) == FUNCTION_DECL)
+	      && (TREE_STATIC (base) || DECL_EXTERNAL (base)));
+
+    default:
+      return false;
+    }
+}
+
+/* Return ARG, an argument of a call made by CALLER, as a constant of the
+   type of PARM, or NULL_TREE if it is not known to be constant.  Set
+   *TOP if the value of ARG is still at the top of the lattice.  */
+
+static tree
+ipcp_arg_value (struct cgraph_node *caller, tree arg, tree parm, bool *top)
+{
+  tree type = TREE_TYPE (parm);
+  tree value = NULL_TREE;
+
+  *top = false;
+  STRIP_NOPS (arg);
+  if (ipcp_propagatable_p (arg))
+    value = arg;
+  else if (TREE_CODE (arg) == PARM_DECL
+	   && DECL_CONTEXT (arg) == caller->decl
+	   && caller->uid < ipcp_n_infos
+	   && ipcp_infos[caller->uid])
+    {
+      struct ipcp_info *info = ipcp_infos[caller->uid];
+      int i;
+
+      for (i = 0; i < info->n_params; i++)
+	if (info->params[i] == arg && !info->modified[i])
+	  {
+	    if (info->lattices[i].type == IPCP_TOP)
+	      *top = true;
+	    else if (info->lattices[i].type == IPCP_CONST)
+	      value = info->lattices[i].value;
+	    break;
+	  }
+    }
+
+  if (!value)
+    return NULL_TREE;
+
+  /* Unprototyped calls and K&R definitions may pass values that need a
+     conversion; only convert between scalars of the same size.  */
+  if (TYPE_MAIN_VARIANT (TREE_TYPE (value)) == TYPE_MAIN_VARIANT (type))
+    return value;
+  if ((INTEGRAL_TYPE_P (type) || POINTER_TYPE_P (type))
+      && (INTEGRAL_TYPE_P (TREE_TYPE (value))
+	  || POINTER_TYPE_P (TREE_TYPE (value)))
+      && TYPE_PRECISION (type) == TYPE_PRECISION (TREE_TYPE (value)))
+    {
+      value = fold_convert (type, value);
+      if (is_gimple_min_invariant (value))
+	return value;
+    }
+  return NULL_TREE;
+}
+
+/* Compute the values of the parameters of the local function NODE from
+   its calls.  Return true if any of them changed.  */
+
+static bool
+ipcp_compute_lattices (struct cgraph_node *node)
+{
+  struct ipcp_info *info = ipcp_infos[node->uid];
+  struct cgraph_edge *e;
+  bool changed = false;
+  int i;
+
+  for (i = 0; i < info->n_params; i++)
+    {
+      struct ipcp_lattice lat;
+
+      lat.type = IPCP_TOP;
+      lat.value = NULL_TREE;
+      for (e = node->callers; e && lat.type != IPCP_BOTTOM;
+	   e = e->next_caller)
+	{
+	  tree args = TREE_OPERAND (e->call_expr, 1);
+	  tree value;
+	  bool top;
+	  int j;
+
+	  for (j = 0; j < i && args; j++)
+	    args = TREE_CHAIN (args);
+	  if (!args)
+	    {
+	      lat.type = IPCP_BOTTOM;
+	      break;
+	    }
+
+	  value = ipcp_arg_value (e->caller, TREE_VALUE (args),
+				  info->params[i], &top);
+	  if (top)
+	    continue;
+	  if (!value)
+	    lat.type = IPCP_BOTTOM;
+	  else if (lat.type == IPCP_TOP)
+	    {
+	      lat.type = IPCP_CONST;
+	      lat.value = value;
+	    }
+	  else if (!operand_equal_p (lat.value, value, 0))
+	    lat.type = IPCP_BOTTOM;
+	}
+
+      if (lat.type != info->lattices[i].type
+	  || (lat.type == IPCP_CONST
+	      && !operand_equal_p (lat.value, info->lattices[i].value, 0)))
+	{
+	  info->lattices[i] = lat;
+	  changed = true;
+	}
+    }
+
+  return changed;
+}
+
+/* Insert at the start of the body of FNDECL the assignment of VALUE to its
+   parameter PARM.  */
+
+static void
+ipcp_insert_parm_assignment (tree fndecl, tree parm, tree value)
+{
+  tree *body = &DECL_SAVED_TREE (fndecl);
+  tree list = NULL_TREE;
+
+  if (TREE_CODE (*body) == BIND_EXPR)
+    body = &BIND_EXPR_BODY (*body);
+
+  append_to_statement_list_force (build2 (MODIFY_EXPR, TREE_TYPE (parm),
+					  parm, value),
+				  &list);
+  append_to_statement_list_force (*body, &list);
+  *body = list;
+}
+
+/* Substitute the constants found for the parameters of the local function
+   NODE.  */
+
+static void
+ipcp_substitute_constants (struct cgraph_node *node)
+{
+  struct ipcp_info *info = ipcp_infos[node->uid];
+  int i;
+
+  for (i = 0; i < info->n_params; i++)
+    if (info->lattices[i].type == IPCP_CONST
+	&& TREE_USED (info->params[i]))
+      {
+	if (cgraph_dump_file)
+	  {
+	    fprintf (cgraph_dump_file, "  %s: parameter %i is ",
+		     cgraph_node_name (node), i);
+	    print_generic_expr (cgraph_dump_file, info->lattices[i].value, 0);
+	    fprintf (cgraph_dump_file, "\n");
+	  }
+	ipcp_insert_parm_assignment (node->decl, info->params[i],
+				     info->lattices[i].value);
+      }
+}
+
+/* Store into VALUES the constants the call E passes to the parameters of
+   its callee that are not already known to be constant, NULL_TREE for
+   the others.  */
+
+static void
+ipcp_edge_values (struct cgraph_edge *e, tree *values)
+{
+  struct ipcp_info *info = ipcp_infos[e->callee->uid];
+  tree args = TREE_OPERAND (e->call_expr, 1);
+  bool top;
+  int i;
+
+  for (i = 0; i < info->n_params; i++)
+    {
+      values[i] = NULL_TREE;
+      if (!args)
+	continue;
+      if (info->lattices[i].type != IPCP_CONST
+	  && TREE_USED (info->params[i]))
+	values[i] = ipcp_arg_value (e->caller, TREE_VALUE (args),
+				    info->params[i], &top);
+      args = TREE_CHAIN (args);
+    }
+}
+
+/* Return true if the constants in VALUES2 include all those of VALUES1,
+   each of N parameters.  */
+
+static bool
+ipcp_values_match_p (tree *values1, tree *values2, int n)
+{
+  int i;
+
+  for (i = 0; i < n; i++)
+    if (values1[i]
+	&& (!values2[i] || !operand_equal_p (values1[i], values2[i], 0)))
+      return false;
+  return true;
+}
+
+/* Make a clone of NODE specialized for the constant arguments VALUES, and
+   return its node.  */
+
+static struct cgraph_node *
+ipcp_make_clone (struct cgraph_node *node, tree *values)
+{
+  struct ipcp_info *info = ipcp_infos[node->uid];
+  struct function *saved_cfun = cfun;
+  tree decl = node->decl;
+  tree clone, parm;
+  struct cgraph_node *new_node;
+  char *name;
+  int i;
+
+  clone = copy_node (decl);
+  lang_hooks.dup_lang_specific_decl (clone);
+  ASM_FORMAT_PRIVATE_NAME (name,
+			   IDENTIFIER_POINTER (DECL_ASSEMBLER_NAME (decl)),
+			   ipcp_clone_number++);
+  SET_DECL_ASSEMBLER_NAME (clone, get_identifier (name));
+  SET_DECL_RTL (clone, NULL_RTX);
+  TREE_PUBLIC (clone) = 0;
+  TREE_ADDRESSABLE (clone) = 0;
+  TREE_ASM_WRITTEN (clone) = 0;
+  DECL_EXTERNAL (clone) = 0;
+  DECL_WEAK (clone) = 0;
+  DECL_COMDAT (clone) = 0;
+  DECL_ONE_ONLY (clone) = 0;
+  DECL_VIRTUAL_P (clone) = 0;
+  DECL_STATIC_CONSTRUCTOR (clone) = 0;
+  DECL_STATIC_DESTRUCTOR (clone) = 0;
+  DECL_ARTIFICIAL (clone) = 1;
+  /* Debug information describes the original function only.  */
+  DECL_IGNORED_P (clone) = 1;
+  if (DECL_ONE_ONLY (decl))
+    DECL_SECTION_NAME (clone) = NULL_TREE;
+
+  new_node = cgraph_node (clone);
+  copy_function_body (clone, decl);
+
+  allocate_struct_function (clone);
+  cfun->function_end_locus = DECL_STRUCT_FUNCTION (decl)->function_end_locus;
+  cfun = saved_cfun;
+
+  new_node->local = node->local;
+  new_node->local.local = true;
+  new_node->local.external = false;
+  new_node->global.insns = node->local.self_insns;
+  new_node->analyzed = true;
+  new_node->reachable = true;
+
+  for (i = 0, parm = DECL_ARGUMENTS (clone); i < info->n_params;
+       i++, parm = TREE_CHAIN (parm))
+    if (values[i])
+      ipcp_insert_parm_assignment (clone, parm, values[i]);
+
+  return new_node;
+}
+
+/* Consider specializing NODE for the most common combination of constant
+   arguments among its calls, if doing so stays within the INSNS the unit
+   may still grow by.  Return the number of insns added.  */
+
+static int
+ipcp_maybe_clone (struct cgraph_node *node, int insns)
+{
+  struct ipcp_info *info = ipcp_infos[node->uid];
+  struct cgraph_edge *e, **edges;
+  struct cgraph_node *clone;
+  tree **values, *best = NULL;
+  int n_edges = 0, best_count = 0, i, j;
+
+  if (!node->local.inlinable
+      || node->local.self_insns > PARAM_VALUE (PARAM_IPCP_MAX_CLONE_INSNS)
+      || node->local.self_insns > insns)
+    return 0;
+
+  for (e = node->callers; e; e = e->next_caller)
+    n_edges++;
+  if (n_edges < PARAM_VALUE (PARAM_IPCP_CLONE_MIN_CALLS))
+    return 0;
+
+  edges = xmalloc (n_edges * sizeof (struct cgraph_edge *));
+  values = xmalloc (n_edges * sizeof (tree *));
+  for (i = 0, e = node->callers; e; i++, e = e->next_caller)
+    {
+      edges[i] = e;
+      values[i] = xmalloc (info->n_params * sizeof (tree));
+      ipcp_edge_values (e, values[i]);
+    }
+
+  /* Pick the combination, among those passed by some call, that the most
+     calls pass.  */
+  for (i = 0; i < n_edges; i++)
+    {
+      int count = 0;
+
+      for (j = 0; j < info->n_params && !values[i][j]; j++)
+	;
+      if (j == info->n_params)
+	continue;
+      for (j = 0; j < n_edges; j++)
+	if (ipcp_values_match_p (values[i], values[j], info->n_params))
+	  count++;
+      if (count > best_count)
+	{
+	  best_count = count;
+	  best = values[i];
+	}
+    }
+
+  /* Calls all passing the same values make a local function's parameters
+     constant already.  */
+  if (best_count < PARAM_VALUE (PARAM_IPCP_CLONE_MIN_CALLS)
+      || (node->local.local && best_count == n_edges))
+    best = NULL;
+
+  if (best)
+    {
+      clone = ipcp_make_clone (node, best);
+      if (cgraph_dump_file)
+	fprintf (cgraph_dump_file, "  Cloned %s as %s for %i calls\n",
+		 cgraph_node_name (node),
+		 IDENTIFIER_POINTER (DECL_ASSEMBLER_NAME (clone->decl)),
+		 best_count);
+
+      for (i = 0; i < n_edges; i++)
+	if (values[i] != best
+	    && !ipcp_values_match_p (best, values[i], info->n_params))
+	  edges[i] = NULL;
+      for (i = 0; i < n_edges; i++)
+	if ((e = edges[i]))
+	  {
+	    TREE_OPERAND (e->call_expr, 0) = build_fold_addr_expr (clone->decl);
+	    cgraph_redirect_edge_callee (e, clone);
+	  }
+    }
+
+  for (i = 0; i < n_edges; i++)
+    free (values[i]);
+  free (values);
+  free (edges);
+  return best ? node->local.self_insns : 0;
+}
+
+/* Perform interprocedural constant propagation over the callgraph.  */
+
+static void
+cgraph_propagate_constants (void)
+{
+  struct cgraph_node *node, **candidates;
+  int n_candidates = 0, unit_insns = 0, max_growth, i;
+  bool changed;
+
+  if (cgraph_dump_file)
+    fprintf (cgraph_dump_file, "\nInterprocedural constant propagation:\n");
+
+  ipcp_n_infos = cgraph_max_uid;
+  ipcp_infos = xcalloc (ipcp_n_infos, sizeof (struct ipcp_info *));
+  candidates = xmalloc (cgraph_n_nodes * sizeof (struct cgraph_node *));
+  for (node = cgraph_nodes; node; node = node->next)
+    {
+      if (node->analyzed)
+	unit_insns += node->local.self_insns;
+      if (ipcp_candidate_p (node))
+	{
+	  ipcp_infos[node->uid] = ipcp_init_info (node);
+	  candidates[n_candidates++] = node;
+	}
+    }
+
+  /* The lattices only ever move down, so this terminates.  */
+  do
+    {
+      changed = false;
+      for (i = 0; i < n_candidates; i++)
+	if (candidates[i]->local.local
+	    && ipcp_compute_lattices (candidates[i]))
+	  changed = true;
+    }
+  while (changed);
+
+  /* Parameters no call reaches stay at the top; nothing to do for them.  */
+  for (i = 0; i < n_candidates; i++)
+    if (candidates[i]->local.local)
+      ipcp_substitute_constants (candidates[i]);
+
+  max_growth = unit_insns * PARAM_VALUE (PARAM_IPCP_UNIT_GROWTH) / 100;
+  for (i = 0; i < n_candidates; i++)
+    max_growth -= ipcp_maybe_clone (candidates[i], max_growth);
+
+  for (i = 0; i < n_candidates; i++)
+    {
+      struct ipcp_info *info = ipcp_infos[candidates[i]->uid];
+
+      free (info->params);
+      free (info->lattices);
+      free (info->modified);
+      free (info);
+    }
+  free (candidates);
+  free (ipcp_infos);
+  ipcp_infos = NULL;
+}
+
 /* Return true when function body of DECL still needs to be kept around
    for later re-use.  */
 bool
@@ -2811,6 +3718,8 @@ cgraph_optimize (void)
       dump_cgraph (cgraph_dump_file);
     }
 
+  if (flag_ipa_cp)
+    cgraph_propagate_constants ();
   if (flag_inline_trees)
     cgraph_decide_inlining ();
   cgraph_global_info_ready = true;
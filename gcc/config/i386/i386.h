@@ -1793,6 +1793,12 @@ typedef struct ix86_args {
 
 #define PROFILE_COUNT_REGISTER "edx"
 
+/* Template of an instruction adding operand 1, a register, to operand 0,
+   a 64-bit arc counter in memory, atomically.  The 32-bit targets have no
+   single such instruction and call __gcov_atomic_add instead.  */
+#define GCOV_ATOMIC_ADD_ASM \
+  (TARGET_64BIT ? "lock{;| }add{q}\t{%1, %0|%0, %1}" : NULL)
+
 /* EXIT_IGNORE_STACK should be nonzero if, when returning from a function,
    the stack pointer does not matter.  The value is tested only in
    functions that have frame pointers.
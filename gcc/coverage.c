@@ -359,6 +359,39 @@ get_coverage_counts (unsigned counter, unsigned expected,
   return entry->counts;
 }
 
+/* Return the largest arc count recorded for FNDECL in the profile
+   feedback file, and store the summary of the arc counters in *SUMMARY;
+   return -1 if there are no counts for FNDECL.  Unlike
+   get_coverage_counts, FNDECL need not be the current function, so the
+   callgraph can rank functions before any of them is compiled.  Mismatches
+   are diagnosed later, when FNDECL itself reads its counts.  */
+
+gcov_type
+coverage_function_max_count (tree fndecl,
+			     const struct gcov_ctr_summary **summary)
+{
+  counts_entry_t *entry, elt;
+  struct function *fn = DECL_STRUCT_FUNCTION (fndecl);
+  gcov_type max = 0;
+  unsigned ix;
+
+  if (!counts_hash || !fn)
+    return -1;
+
+  elt.ident = fn->funcdef_no + 1;
+  elt.ctr = GCOV_COUNTER_ARCS;
+  entry = htab_find (counts_hash, &elt);
+  if (!entry)
+    return -1;
+
+  for (ix = 0; ix < entry->summary.num; ix++)
+    if (entry->counts[ix] > max)
+      max = entry->counts[ix];
+
+  *summary = &entry->summary;
+  return max;
+}
+
 /* Allocate NUM counters of type COUNTER. Returns nonzero if the
    allocation succeeded.  */
 
@@ -439,6 +472,42 @@ tree_coverage_counter_ref (unsigned counter, unsigned no)
 			     size_int (TYPE_ALIGN_UNIT (GCOV_TYPE_NODE))));
 }
 
+/* Generate a statement adding one to COUNTER NO atomically, or NULL if
+   the target has no GCOV_ATOMIC_ADD_ASM instruction for the current
+   options, in which case -fprofile-update=locked falls back to
+   __gcov_atomic_add.  */
+
+tree
+tree_coverage_counter_atomic_inc (unsigned counter, unsigned no)
+{
+#ifdef GCOV_ATOMIC_ADD_ASM
+  const char *insn = GCOV_ATOMIC_ADD_ASM;
+  tree ref, outputs, inputs, clobbers, stmt;
+
+  if (!insn)
+    return NULL_TREE;
+
+  /* The counter is read as well as written: it is also an input, which
+     the instruction does not need to name.  */
+  ref = tree_coverage_counter_ref (counter, no);
+  outputs = build_tree_list (build_tree_list (NULL_TREE,
+					      build_string (2, "=m")),
+			     ref);
+  inputs = tree_cons (build_tree_list (NULL_TREE, build_string (1, "r")),
+		      build_int_cst (GCOV_TYPE_NODE, 1),
+		      build_tree_list (build_tree_list (NULL_TREE,
+							build_string (1, "m")),
+				       unshare_expr (ref)));
+  clobbers = build_tree_list (NULL_TREE, build_string (2, "cc"));
+  stmt = build4 (ASM_EXPR, void_type_node, build_string (strlen (insn), insn),
+		 outputs, inputs, clobbers);
+  ASM_VOLATILE_P (stmt) = 1;
+  return stmt;
+#else
+  return NULL_TREE;
+#endif
+}
+
 /* Generate a checksum for a string.  CHKSUM is the current
    checksum.  */
 
@@ -41,10 +41,16 @@ extern int coverage_counter_alloc (unsigned /*counter*/, unsigned/*num*/);
 extern rtx rtl_coverage_counter_ref (unsigned /*counter*/, unsigned/*num*/);
 /* Use a counter from the most recent allocation.  */
 extern tree tree_coverage_counter_ref (unsigned /*counter*/, unsigned/*num*/);
+extern tree tree_coverage_counter_atomic_inc (unsigned /*counter*/,
+					      unsigned /*num*/);
 
 /* Get all the counters for the current function.  */
 extern gcov_type *get_coverage_counts (unsigned /*counter*/,
 				       unsigned /*expected*/,
 				       const struct gcov_ctr_summary **);
 
+/* Get the largest arc count of a function, before compiling it.  */
+extern gcov_type coverage_function_max_count (tree,
+					      const struct gcov_ctr_summary **);
+
 #endif
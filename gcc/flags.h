@@ -82,6 +82,18 @@ struct visibility_flags
 /* Global visibility options.  */
 extern struct visibility_flags visibility_options;
 
+/* How the arc counters inserted by -fprofile-arcs are updated.  */
+enum profile_update
+{
+  PROFILE_UPDATE_SINGLE,	/* Plain increments; fastest, but racy.  */
+  PROFILE_UPDATE_ATOMIC,	/* Atomic instruction of the target.  */
+  PROFILE_UPDATE_LOCKED		/* Atomic instruction, or else a libgcov
+				   routine serialized by a lock.  */
+};
+
+/* The counter update method selected by -fprofile-update=.  */
+extern enum profile_update flag_profile_update;
+
 /* Nonzero means do optimizations.  -opt.  */
 
 extern int optimize;
@@ -74,9 +74,11 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
    collating can be used to compare version strings.  Be aware that
    the 'e' designation will (naturally) be unstable and might be
    incompatible with itself.  For gcc 3.4 experimental, it would be
-   '304e' (0x33303465).  When the major version reaches 10, the
-   letters A-Z will be used.  Assuming minor increments releases every
-   6 months, we have to make a major increment every 50 years.
+   '304e' (0x33303465).  A change of the file format within a release
+   bumps the status character, see GCOV_FORMAT_REVISION in gcov-iov.c.
+   When the major version reaches 10, the letters A-Z will be used.
+   Assuming minor increments releases every 6 months, we have to make
+   a major increment every 50 years.
    Assuming major increments releases every 5 years, we're ok for the
    next 155 years -- good enough for me.
 
@@ -317,23 +319,27 @@ typedef HOST_WIDEST_INT gcov_type;
 #define GCOV_COUNTER_V_SINGLE	3  /* The most common value of expression.  */
 #define GCOV_COUNTER_V_DELTA	4  /* The most common difference between
 				      consecutive values of expression.  */
-#define GCOV_LAST_VALUE_COUNTER 4  /* The last of counters used for value
+#define GCOV_COUNTER_V_INDIR	5  /* The most common indirect call
+				      target.  */
+#define GCOV_LAST_VALUE_COUNTER 5  /* The last of counters used for value
 				      profiling.  */
-#define GCOV_COUNTERS		5
+#define GCOV_COUNTERS		6
 
 /* Number of counters used for value profiling.  */
 #define GCOV_N_VALUE_COUNTERS \
   (GCOV_LAST_VALUE_COUNTER - GCOV_FIRST_VALUE_COUNTER + 1)
   
   /* A list of human readable names of the counters */
-#define GCOV_COUNTER_NAMES	{"arcs", "interval", "pow2", "single", "delta"}
+#define GCOV_COUNTER_NAMES	{"arcs", "interval", "pow2", "single", "delta", \
+				 "indirect_call"}
   
   /* Names of merge functions for counters.  */
 #define GCOV_MERGE_FUNCTIONS	{"__gcov_merge_add",	\
 				 "__gcov_merge_add",	\
 				 "__gcov_merge_add",	\
 				 "__gcov_merge_single",	\
-				 "__gcov_merge_delta"}
+				 "__gcov_merge_delta",	\
+				 "__gcov_merge_single"}
   
 /* Convert a counter index to a tag.  */
 #define GCOV_TAG_FOR_COUNTER(COUNT)				\
@@ -437,6 +443,15 @@ extern void __gcov_init (struct gcov_info *);
 /* Called before fork, to avoid double counting.  */
 extern void __gcov_flush (void);
 
+/* Write out the profile gathered so far, without resetting it.  */
+extern void __gcov_dump (void);
+
+/* Zero the profile gathered so far.  */
+extern void __gcov_reset (void);
+
+/* Atomically add to an arc counter, for -fprofile-update=atomic.  */
+extern void __gcov_atomic_add (gcov_type *, gcov_type);
+
 /* The merge function that just sums the counters.  */
 extern void __gcov_merge_add (gcov_type *, unsigned);
 
@@ -447,6 +462,16 @@ extern void __gcov_merge_single (gcov_type *, unsigned);
    consecutive values.  */
 extern void __gcov_merge_delta (gcov_type *, unsigned);
 
+/* The value profilers called from code instrumented on trees.  */
+extern void __gcov_pow2_profiler (gcov_type *, gcov_type);
+extern void __gcov_one_value_profiler (gcov_type *, gcov_type);
+extern void __gcov_indirect_call_profiler (gcov_type *, gcov_type,
+					   void *, void *);
+
+/* The target of the last instrumented indirect call, and its histogram.  */
+extern void *__gcov_indirect_call_callee;
+extern gcov_type *__gcov_indirect_call_counters;
+
 #ifndef inhibit_libc
 /* The wrappers around some library functions..  */
 extern pid_t __gcov_fork (void);
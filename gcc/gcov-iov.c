@@ -26,6 +26,11 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 #include "tm.h"
 #include "version.c" /* We want the actual string.  */
 
+/* Revision of the file format within a release, added to the status
+   character of the version: 1 since the indirect call counters were
+   added, which changed GCOV_COUNTERS.  */
+#define GCOV_FORMAT_REVISION 1
+
 int main (int, char **);
 
 int
@@ -53,7 +58,7 @@ main (int argc ATTRIBUTE_UNUSED, char **argv ATTRIBUTE_UNUSED)
   v[0] = (major < 10 ? '0' : 'A' - 10) + major;
   v[1] = (minor / 10) + '0';
   v[2] = (minor % 10) + '0';
-  v[3] = s ? s : '*';
+  v[3] = (s ? s : '*') + GCOV_FORMAT_REVISION;
 
   for (ix = 0; ix != 4; ix++)
     version = (version << 8) | v[ix];
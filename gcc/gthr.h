@@ -79,6 +79,18 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
      int __gthread_recursive_mutex_trylock (__gthread_recursive_mutex_t *mutex);
      int __gthread_recursive_mutex_unlock (__gthread_recursive_mutex_t *mutex);
 
+   The following are optional; a threads interface that provides them
+   must also
+       #define __GTHREAD_HAS_COND 1
+   and define the type __gthread_cond_t and the macro
+     __GTHREAD_COND_INIT
+		to initialize __gthread_cond_t statically.
+
+     int __gthread_cond_broadcast (__gthread_cond_t *cond);
+     int __gthread_cond_wait_recursive (__gthread_cond_t *cond,
+					__gthread_recursive_mutex_t *mutex);
+		MUTEX must be held exactly once by the caller.
+
    All functions returning int should return zero on success or the error
    number.  If the operation is not supported, -1 is returned.
 
@@ -56,6 +56,8 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 #ifdef L_gcov
 void __gcov_init (struct gcov_info *p __attribute__ ((unused))) {}
 void __gcov_flush (void) {}
+void __gcov_dump (void) {}
+void __gcov_reset (void) {}
 #endif
 
 #ifdef L_gcov_merge_add
@@ -73,6 +75,32 @@ void __gcov_merge_delta (gcov_type *counters  __attribute__ ((unused)),
 			 unsigned n_counters __attribute__ ((unused))) {}
 #endif
 
+#ifdef L_gcov_pow2_profiler
+void __gcov_pow2_profiler (gcov_type *counters  __attribute__ ((unused)),
+			   gcov_type value __attribute__ ((unused))) {}
+#endif
+
+#ifdef L_gcov_one_value_profiler
+void __gcov_one_value_profiler (gcov_type *counters  __attribute__ ((unused)),
+				gcov_type value __attribute__ ((unused))) {}
+#endif
+
+#ifdef L_gcov_atomic_add
+void __gcov_atomic_add (gcov_type *counter  __attribute__ ((unused)),
+			gcov_type value  __attribute__ ((unused))) {}
+#endif
+
+#ifdef L_gcov_indirect_call_profiler
+void *__gcov_indirect_call_callee;
+gcov_type *__gcov_indirect_call_counters;
+
+void __gcov_indirect_call_profiler (gcov_type *counters __attribute__ ((unused)),
+				    gcov_type value __attribute__ ((unused)),
+				    void *cur_func __attribute__ ((unused)),
+				    void *callee_func __attribute__ ((unused)))
+{}
+#endif
+
 #else
 
 #include <string.h>
@@ -84,10 +112,37 @@ void __gcov_merge_delta (gcov_type *counters  __attribute__ ((unused)),
 
 #ifdef L_gcov
 #include "gcov-io.c"
+#include <signal.h>
+#include "gthr.h"
 
 /* Chain of per-object gcov structures.  */
 static struct gcov_info *gcov_list;
 
+/* Serializes registering, dumping and resetting the counters, which a
+   multi-threaded program may request from several threads at once.  */
+#ifdef __GTHREAD_MUTEX_INIT
+static __gthread_mutex_t gcov_mutex = __GTHREAD_MUTEX_INIT;
+#else
+static __gthread_mutex_t gcov_mutex;
+#endif
+
+#ifdef __GTHREAD_MUTEX_INIT_FUNCTION
+static void
+init_gcov_mutex (void)
+{
+  __GTHREAD_MUTEX_INIT_FUNCTION (&gcov_mutex);
+}
+
+static void
+init_gcov_mutex_once (void)
+{
+  static __gthread_once_t once = __GTHREAD_ONCE_INIT;
+  __gthread_once (&once, init_gcov_mutex);
+}
+#else
+#define init_gcov_mutex_once()
+#endif
+
 /* A program checksum allows us to distinguish program data for an
    object file included in multiple programs.  */
 static gcov_unsigned_t gcov_crc32;
@@ -115,10 +170,10 @@ gcov_version (struct gcov_info *ptr, gcov_unsigned_t version)
    program's checksum to make sure we only accumulate whole program
    statistics to the correct summary. An object file might be embedded
    in two separate programs, and we must keep the two program
-   summaries separate.  */
+   summaries separate.  The caller must hold gcov_mutex.  */
 
 static void
-gcov_exit (void)
+gcov_dump_counters (void)
 {
   struct gcov_info *gi_ptr;
   struct gcov_summary this_program;
@@ -425,6 +480,131 @@ gcov_exit (void)
     }
 }
 
+/* Zero the counters of all registered object files.  The caller must
+   hold gcov_mutex.  */
+
+static void
+gcov_reset_counters (void)
+{
+  const struct gcov_info *gi_ptr;
+
+  for (gi_ptr = gcov_list; gi_ptr; gi_ptr = gi_ptr->next)
+    {
+      unsigned t_ix;
+      const struct gcov_ctr_info *ci_ptr;
+      
+      for (t_ix = 0, ci_ptr = gi_ptr->counts; t_ix != GCOV_COUNTERS; t_ix++)
+	if ((1 << t_ix) & gi_ptr->ctr_mask)
+	  {
+	    memset (ci_ptr->values, 0, sizeof (gcov_type) * ci_ptr->num);
+	    ci_ptr++;
+	  }
+    }
+}
+
+static void
+gcov_exit (void)
+{
+  __gcov_dump ();
+}
+
+/* Set by the signal named by the GCOV_DUMP_SIGNAL environment variable,
+   to write out and reset the profile at the next call to __gcov_flush,
+   __gcov_dump or __gcov_reset.  */
+static volatile sig_atomic_t gcov_dump_requested;
+
+#if defined (GCC_GTHR_POSIX_H) && GCOV_LOCKED
+#define GCOV_DUMP_THREAD 1
+#include <unistd.h>
+
+/* Pipe on which the signal handler wakes up gcov_dump_thread, and the
+   process that owns the thread; a child created by fork has no such
+   thread and falls back to gcov_dump_requested.  */
+static int gcov_dump_pipe[2] = { -1, -1 };
+static pid_t gcov_dump_pid;
+
+/* Write out and reset the profile each time the signal handler asks for
+   it.  Runs in a thread of its own, where taking locks and allocating
+   memory is safe.  */
+
+static void *
+gcov_dump_thread (void *arg __attribute__ ((unused)))
+{
+  char c;
+
+  for (;;)
+    {
+      ssize_t n = read (gcov_dump_pipe[0], &c, 1);
+
+      if (n == 1)
+	__gcov_flush ();
+      else if (n == 0 || errno != EINTR)
+	return NULL;
+    }
+}
+
+/* Start gcov_dump_thread, if the program is multi-threaded.  Returns
+   nonzero on success.  */
+
+static int
+gcov_start_dump_thread (void)
+{
+  pthread_t thread;
+
+  if (!__gthread_active_p () || pipe (gcov_dump_pipe))
+    return 0;
+  fcntl (gcov_dump_pipe[1], F_SETFL, O_NONBLOCK);
+  if (pthread_create (&thread, NULL, gcov_dump_thread, NULL))
+    {
+      close (gcov_dump_pipe[0]);
+      close (gcov_dump_pipe[1]);
+      gcov_dump_pipe[1] = -1;
+      return 0;
+    }
+  gcov_dump_pid = getpid ();
+  return 1;
+}
+#endif
+
+/* Handler for the signal named by GCOV_DUMP_SIGNAL.  Writing the files
+   takes locks and allocates memory, which is not safe in a signal
+   handler, so the request is recorded here and, where there is one,
+   gcov_dump_thread is woken up to carry it out.  */
+
+static void
+gcov_signal_handler (int sig)
+{
+  gcov_dump_requested = 1;
+#ifdef GCOV_DUMP_THREAD
+  if (gcov_dump_pipe[1] >= 0 && getpid () == gcov_dump_pid)
+    {
+      int saved_errno = errno;
+      char c = 0;
+
+      write (gcov_dump_pipe[1], &c, 1);
+      errno = saved_errno;
+    }
+#endif
+  signal (sig, gcov_signal_handler);
+}
+
+/* Install gcov_signal_handler if GCOV_DUMP_SIGNAL requests it.  */
+
+static void
+gcov_init_signal (void)
+{
+  const char *env = getenv ("GCOV_DUMP_SIGNAL");
+  int sig = env ? atoi (env) : 0;
+
+  if (sig > 0)
+    {
+#ifdef GCOV_DUMP_THREAD
+      gcov_start_dump_thread ();
+#endif
+      signal (sig, gcov_signal_handler);
+    }
+}
+
 /* Add a new object file onto the bb chain.  Invoked automatically
    when running an object file's global ctors.  */
 
@@ -454,13 +634,21 @@ __gcov_init (struct gcov_info *info)
 	}
       while (*ptr++);
       
+      init_gcov_mutex_once ();
+      __gthread_mutex_lock (&gcov_mutex);
+
       gcov_crc32 = crc32;
       
       if (!gcov_list)
-	atexit (gcov_exit);
+	{
+	  atexit (gcov_exit);
+	  gcov_init_signal ();
+	}
       
       info->next = gcov_list;
       gcov_list = info;
+
+      __gthread_mutex_unlock (&gcov_mutex);
     }
   info->version = 0;
 }
@@ -472,21 +660,53 @@ __gcov_init (struct gcov_info *info)
 void
 __gcov_flush (void)
 {
-  const struct gcov_info *gi_ptr;
+  init_gcov_mutex_once ();
+  __gthread_mutex_lock (&gcov_mutex);
 
-  gcov_exit ();
-  for (gi_ptr = gcov_list; gi_ptr; gi_ptr = gi_ptr->next)
+  gcov_dump_requested = 0;
+  gcov_dump_counters ();
+  gcov_reset_counters ();
+
+  __gthread_mutex_unlock (&gcov_mutex);
+}
+
+/* Write out the profile information gathered so far, without resetting
+   it.  May be called at any time, e.g. by a long-running service that
+   wants to snapshot its profile under load.  */
+
+void
+__gcov_dump (void)
+{
+  init_gcov_mutex_once ();
+  __gthread_mutex_lock (&gcov_mutex);
+
+  gcov_dump_counters ();
+  if (gcov_dump_requested)
     {
-      unsigned t_ix;
-      const struct gcov_ctr_info *ci_ptr;
-      
-      for (t_ix = 0, ci_ptr = gi_ptr->counts; t_ix != GCOV_COUNTERS; t_ix++)
-	if ((1 << t_ix) & gi_ptr->ctr_mask)
-	  {
-	    memset (ci_ptr->values, 0, sizeof (gcov_type) * ci_ptr->num);
-	    ci_ptr++;
-	  }
+      gcov_dump_requested = 0;
+      gcov_reset_counters ();
+    }
+
+  __gthread_mutex_unlock (&gcov_mutex);
+}
+
+/* Zero the profile information gathered so far, e.g. to discard the
+   start-up phase of a program before profiling its steady state.  */
+
+void
+__gcov_reset (void)
+{
+  init_gcov_mutex_once ();
+  __gthread_mutex_lock (&gcov_mutex);
+
+  if (gcov_dump_requested)
+    {
+      gcov_dump_requested = 0;
+      gcov_dump_counters ();
     }
+  gcov_reset_counters ();
+
+  __gthread_mutex_unlock (&gcov_mutex);
 }
 
 #endif /* L_gcov */
@@ -581,6 +801,151 @@ __gcov_merge_delta (gcov_type *counters, unsigned n_counters)
 }
 #endif /* L_gcov_merge_delta */
 
+#ifdef L_gcov_pow2_profiler
+/* The power of two histogram profiler, called from code instrumented on
+   trees.  If VALUE is a power of two, COUNTERS[1 + log2 (VALUE)] is
+   increased, otherwise COUNTERS[0] is.  The layout matches the counters
+   produced by rtl_gen_pow2_profiler.  */
+void
+__gcov_pow2_profiler (gcov_type *counters, gcov_type value)
+{
+  if (value <= 0 || (value & (value - 1)))
+    counters[0]++;
+  else
+    {
+      unsigned log2 = 0;
+
+      while (value >>= 1)
+	log2++;
+      counters[log2 + 1]++;
+    }
+}
+#endif /* L_gcov_pow2_profiler */
+
+#if defined (L_gcov_one_value_profiler) \
+    || defined (L_gcov_indirect_call_profiler)
+/* Tries to determine the most common value among its inputs.  COUNTERS
+   form the same 3-tuple as read by __gcov_merge_single: the candidate on
+   the most common value is kept in COUNTERS[0], COUNTERS[1] is increased
+   when VALUE matches it and decreased otherwise, the candidate being
+   replaced once it drops to zero.  COUNTERS[2] counts all evaluations.  */
+static inline void
+__gcov_one_value_profiler_body (gcov_type *counters, gcov_type value)
+{
+  if (value == counters[0])
+    counters[1]++;
+  else if (counters[1] == 0)
+    {
+      counters[1] = 1;
+      counters[0] = value;
+    }
+  else
+    counters[1]--;
+  counters[2]++;
+}
+#endif
+
+#ifdef L_gcov_one_value_profiler
+/* The single value profiler, called from code instrumented on trees.  */
+void
+__gcov_one_value_profiler (gcov_type *counters, gcov_type value)
+{
+  __gcov_one_value_profiler_body (counters, value);
+}
+#endif /* L_gcov_one_value_profiler */
+
+#ifdef L_gcov_indirect_call_profiler
+/* The target of the last instrumented indirect call, and its histogram.
+   The call sites of all the units store there, so that a function reached
+   from another unit records the call as well.  */
+void *__gcov_indirect_call_callee;
+gcov_type *__gcov_indirect_call_counters;
+
+/* Called on entry of every function that may be the target of an indirect
+   call.  CALLEE_FUNC is the target of the last instrumented indirect call
+   and COUNTERS its histogram; if the call reached CUR_FUNC, record VALUE,
+   the profile identifier of CUR_FUNC.  */
+void
+__gcov_indirect_call_profiler (gcov_type *counters, gcov_type value,
+			       void *cur_func, void *callee_func)
+{
+  if (cur_func == callee_func && counters)
+    __gcov_one_value_profiler_body (counters, value);
+}
+#endif /* L_gcov_indirect_call_profiler */
+
+#ifdef L_gcov_atomic_add
+#include "gthr.h"
+
+/* Add VALUE to the arc counter *COUNTER atomically.  Called from code
+   compiled with -fprofile-update=atomic.  Targets without a cheap
+   atomic add of a gcov_type fall back to a global lock.  */
+
+#if BITS_PER_UNIT == 8 && LONG_LONG_TYPE_SIZE > 32 \
+    && (defined (__x86_64__) || defined (__powerpc64__) || defined (__ppc64__))
+#define GCOV_INLINE_ATOMIC_ADD 1
+#else
+#define GCOV_INLINE_ATOMIC_ADD 0
+#endif
+
+#if !GCOV_INLINE_ATOMIC_ADD
+#ifdef __GTHREAD_MUTEX_INIT
+static __gthread_mutex_t gcov_counter_mutex = __GTHREAD_MUTEX_INIT;
+#else
+static __gthread_mutex_t gcov_counter_mutex;
+#endif
+
+#ifdef __GTHREAD_MUTEX_INIT_FUNCTION
+static void
+init_gcov_counter_mutex (void)
+{
+  __GTHREAD_MUTEX_INIT_FUNCTION (&gcov_counter_mutex);
+}
+
+static void
+init_gcov_counter_mutex_once (void)
+{
+  static __gthread_once_t once = __GTHREAD_ONCE_INIT;
+  __gthread_once (&once, init_gcov_counter_mutex);
+}
+#else
+#define init_gcov_counter_mutex_once()
+#endif
+#endif /* !GCOV_INLINE_ATOMIC_ADD */
+
+void
+__gcov_atomic_add (gcov_type *counter, gcov_type value)
+{
+#if defined (__x86_64__) && GCOV_INLINE_ATOMIC_ADD
+  __asm__ __volatile__ ("lock; addq %1,%0"
+			: "+m" (*counter)
+			: "r" (value)
+			: "cc");
+#elif GCOV_INLINE_ATOMIC_ADD
+  gcov_type tmp;
+
+  __asm__ __volatile__ ("1:\tldarx %0,0,%2\n\t"
+			"add %0,%0,%3\n\t"
+			"stdcx. %0,0,%2\n\t"
+			"bne- 1b"
+			: "=&r" (tmp), "+m" (*counter)
+			: "r" (counter), "r" (value)
+			: "cc");
+#else
+  if (!__gthread_active_p ())
+    {
+      *counter += value;
+      return;
+    }
+
+  init_gcov_counter_mutex_once ();
+  __gthread_mutex_lock (&gcov_counter_mutex);
+  *counter += value;
+  __gthread_mutex_unlock (&gcov_counter_mutex);
+#endif
+}
+#endif /* L_gcov_atomic_add */
+
 #ifdef L_gcov_fork
 /* A wrapper for the fork function.  Flushes the accumulated profiling data, so
    that they are not counted twice.  */
@@ -79,6 +79,9 @@ bool use_gnu_debug_info_extensions;
 /* The default visibility for all symbols (unless overridden) */
 enum symbol_visibility default_visibility = VISIBILITY_DEFAULT;
 
+/* The method used to update the -fprofile-arcs counters.  */
+enum profile_update flag_profile_update = PROFILE_UPDATE_SINGLE;
+
 /* Global visibility options.  */
 struct visibility_flags visibility_options;
 
@@ -576,6 +579,7 @@ decode_options (unsigned int argc, const char **argv)
   if (optimize >= 3)
     {
       flag_inline_functions = 1;
+      flag_ipa_cp = 1;
       flag_unswitch_loops = 1;
       flag_gcse_after_reload = 1;
     }
@@ -931,6 +935,17 @@ common_handle_option (size_t scode, const char *arg, int value)
 #endif
       break;
 
+    case OPT_fprofile_update_:
+      if (!strcmp (arg, "single"))
+	flag_profile_update = PROFILE_UPDATE_SINGLE;
+      else if (!strcmp (arg, "atomic"))
+	flag_profile_update = PROFILE_UPDATE_ATOMIC;
+      else if (!strcmp (arg, "locked"))
+	flag_profile_update = PROFILE_UPDATE_LOCKED;
+      else
+	error ("unknown profile update method \"%s\"", arg);
+      break;
+
     case OPT_fprofile_values:
       flag_profile_values_set = true;
       break;
@@ -965,6 +980,10 @@ common_handle_option (size_t scode, const char *arg, int value)
       flag_random_seed = NULL;
       break;
 
+    case OPT_forder_file_:
+      order_file_name = arg;
+      break;
+
     case OPT_frandom_seed_:
       flag_random_seed = arg;
       break;
@@ -386,6 +386,13 @@ extern int sdb_begin_function_line;
 extern FILE *asm_out_file;
 #endif
 
+/* File to which the names of the functions output are appended, for
+   -forder-file.  */
+
+#ifdef BUFSIZ
+extern FILE *order_file;
+#endif
+
 /* The first global object in the file.  */
 extern const char *first_global_object_name;
 
@@ -196,6 +196,10 @@ instrument_values (histogram_values values)
 	  t = GCOV_COUNTER_V_DELTA;
 	  break;
 
+	case HIST_TYPE_INDIR_CALL:
+	  t = GCOV_COUNTER_V_INDIR;
+	  break;
+
 	default:
 	  abort ();
 	}
@@ -220,6 +224,10 @@ instrument_values (histogram_values values)
 	  (profile_hooks->gen_const_delta_profiler) (hist, t, 0);
 	  break;
 
+	case HIST_TYPE_INDIR_CALL:
+	  (profile_hooks->gen_ic_profiler) (hist, t, 0);
+	  break;
+
 	default:
 	  abort ();
 	}
@@ -685,11 +693,21 @@ compute_value_histograms (histogram_values values)
       hist = VEC_index (histogram_value, values, i);
       t = (int) hist->type;
 
-      /* FIXME: make this work for trees.  */
-      if (!ir_type ())
+      aact_count = act_count[t];
+      if (!aact_count)
+	continue;
+      act_count[t] += hist->n_counters;
+
+      /* There are no notes on trees; the histogram keeps its counters
+	 until tree_value_profile_transformations consumes them.  */
+      if (ir_type ())
+	{
+	  hist->counters = xmalloc (sizeof (gcov_type) * hist->n_counters);
+	  memcpy (hist->counters, aact_count,
+		  sizeof (gcov_type) * hist->n_counters);
+	}
+      else
 	{
-	  aact_count = act_count[t];
-	  act_count[t] += hist->n_counters;
 	  for (j = hist->n_counters; j > 0; j--)
 	    hist_list = alloc_EXPR_LIST (0, GEN_INT (aact_count[j - 1]), 
 					hist_list);
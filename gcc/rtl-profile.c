@@ -64,6 +64,9 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 #include "tree.h"
 #include "ggc.h"
 
+/* The libgcov routine used for -fprofile-update=locked.  */
+static GTY(()) rtx gcov_atomic_add_libfunc;
+
 /* Output instructions as RTL to increment the edge execution count.  */
 
 static void
@@ -73,15 +76,36 @@ rtl_gen_edge_profiler (int edgeno, edge e)
   rtx tmp;
   enum machine_mode mode = GET_MODE (ref);
   rtx sequence;
+  tree insn = NULL_TREE;
 
   start_sequence ();
-  ref = validize_mem (ref);
 
-  tmp = expand_simple_binop (mode, PLUS, ref, const1_rtx,
-			     ref, 0, OPTAB_WIDEN);
+  if (flag_profile_update != PROFILE_UPDATE_SINGLE)
+    insn = tree_coverage_counter_atomic_inc (GCOV_COUNTER_ARCS, edgeno);
+
+  if (insn)
+    /* The target has an atomic add instruction.  */
+    expand_asm_expr (insn);
+  else if (flag_profile_update == PROFILE_UPDATE_LOCKED)
+    {
+      /* Let libgcov do the update, so that racing threads do not lose
+	 counts.  */
+      if (!gcov_atomic_add_libfunc)
+	gcov_atomic_add_libfunc = init_one_libfunc ("__gcov_atomic_add");
+      emit_library_call (gcov_atomic_add_libfunc, LCT_NORMAL, VOIDmode, 2,
+			 force_reg (Pmode, XEXP (ref, 0)), Pmode,
+			 const1_rtx, mode);
+    }
+  else
+    {
+      ref = validize_mem (ref);
+
+      tmp = expand_simple_binop (mode, PLUS, ref, const1_rtx,
+				 ref, 0, OPTAB_WIDEN);
 
-  if (tmp != ref)
-    emit_move_insn (copy_rtx (ref), tmp);
+      if (tmp != ref)
+	emit_move_insn (copy_rtx (ref), tmp);
+    }
 
   sequence = get_insns ();
   end_sequence ();
@@ -418,5 +442,8 @@ struct profile_hooks rtl_profile_hooks =
   rtl_gen_pow2_profiler,
   rtl_gen_one_value_profiler,
   rtl_gen_const_delta_profiler,
+  NULL,				/* Indirect calls are profiled on trees only.  */
   rtl_profile_dump_file
 };
+
+#include "gt-rtl-profile.h"
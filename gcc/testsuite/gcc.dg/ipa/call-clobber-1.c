@@ -0,0 +1,56 @@
+/* The loads of G after the calls must see the stores of the callees,
+   whether they are in another unit, recursive, or through a pointer.  */
+
+/* { dg-do run } */
+/* { dg-options "-O2" } */
+/* { dg-additional-sources "call-clobber-1a.c" } */
+
+extern void abort (void);
+
+int g;
+static int s;
+int *p = &s;
+
+extern void set_g (int);
+
+static void __attribute__ ((noinline))
+wrap (int x)
+{
+  set_g (x);
+}
+
+static void __attribute__ ((noinline))
+count_down (int n)
+{
+  if (n > 0)
+    {
+      s = n;
+      count_down (n - 1);
+    }
+}
+
+static void __attribute__ ((noinline))
+set_s (int x)
+{
+  *p = x;
+}
+
+int
+main (void)
+{
+  g = 1;
+  wrap (2);
+  if (g != 2)
+    abort ();
+
+  s = 3;
+  count_down (2);
+  if (s != 1)
+    abort ();
+
+  s = 4;
+  set_s (5);
+  if (s != 5)
+    abort ();
+  return 0;
+}
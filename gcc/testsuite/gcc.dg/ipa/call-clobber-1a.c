@@ -0,0 +1,7 @@
+extern int g;
+
+void
+set_g (int x)
+{
+  g = x;
+}
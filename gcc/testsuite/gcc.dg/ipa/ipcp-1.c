@@ -0,0 +1,28 @@
+/* The constant all calls pass to the local function f is propagated into
+   its body.  */
+
+/* { dg-do run } */
+/* { dg-options "-O2 -fipa-cp -fdump-ipa-cgraph" } */
+
+extern void abort (void);
+
+static int __attribute__ ((noinline))
+f (int x, int y)
+{
+  return x * y;
+}
+
+int
+main (void)
+{
+  int i, sum = 0;
+
+  for (i = 0; i < 10; i++)
+    sum += f (7, i);
+  if (sum != 7 * 45 || f (7, 2) != 14)
+    abort ();
+  return 0;
+}
+
+/* { dg-final { scan-ipa-dump "f: parameter 0 is 7" "cgraph" } } */
+/* { dg-final { scan-ipa-dump-not "f: parameter 1 is" "cgraph" } } */
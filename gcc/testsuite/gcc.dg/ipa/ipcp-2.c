@@ -0,0 +1,42 @@
+/* The address of an automatic variable of the caller is not a constant
+   in the callee, although it is invariant in the caller.  */
+
+/* { dg-do run } */
+/* { dg-options "-O2 -fipa-cp -fdump-ipa-cgraph" } */
+
+extern void abort (void);
+
+static int global = 5;
+
+static int __attribute__ ((noinline))
+get (int *p)
+{
+  return *p;
+}
+
+static int __attribute__ ((noinline))
+get_static (int *p)
+{
+  return *p;
+}
+
+static int __attribute__ ((noinline))
+caller (int n)
+{
+  int local = n;
+
+  return get (&local);
+}
+
+int
+main (void)
+{
+  if (caller (3) != 3 || caller (4) != 4)
+    abort ();
+  if (get_static (&global) != 5)
+    abort ();
+  return 0;
+}
+
+/* { dg-final { scan-ipa-dump-not "get: parameter 0 is" "cgraph" } } */
+/* { dg-final { scan-ipa-dump "get_static: parameter 0 is &global" "cgraph" } } */
@@ -0,0 +1,40 @@
+/* Parameters stored to in part, or whose address is taken, do not keep
+   the value they were passed.  */
+
+/* { dg-do run } */
+/* { dg-options "-O2 -fipa-cp -fdump-ipa-cgraph" } */
+
+extern void abort (void);
+
+static double __attribute__ ((noinline))
+set_real (_Complex double z)
+{
+  __real__ z = 1.0;
+  return __real__ z + __imag__ z;
+}
+
+static void __attribute__ ((noinline))
+store (int *p, int v)
+{
+  *p = v;
+}
+
+static int __attribute__ ((noinline))
+through_address (int x)
+{
+  store (&x, 3);
+  return x;
+}
+
+int
+main (void)
+{
+  if (set_real (2.0) != 1.0)
+    abort ();
+  if (through_address (1) != 3)
+    abort ();
+  return 0;
+}
+
+/* { dg-final { scan-ipa-dump-not "set_real: parameter 0 is" "cgraph" } } */
+/* { dg-final { scan-ipa-dump-not "through_address: parameter 0 is" "cgraph" } } */
@@ -0,0 +1,67 @@
+/* Functions are found const or pure through the functions they call,
+   but not when they recurse, as the recursion may not terminate.  */
+
+/* { dg-do run } */
+/* { dg-options "-O2 -fdump-ipa-cgraph" } */
+
+extern void abort (void);
+
+int g = 3;
+
+static int __attribute__ ((noinline))
+twice (int x)
+{
+  return 2 * x;
+}
+
+static int __attribute__ ((noinline))
+four_times (int x)
+{
+  return twice (twice (x));
+}
+
+static int __attribute__ ((noinline))
+scaled_g (void)
+{
+  return four_times (g);
+}
+
+static int __attribute__ ((noinline))
+forever (int x)
+{
+  return forever (x);
+}
+
+static int __attribute__ ((noinline))
+even (int x);
+
+static int __attribute__ ((noinline))
+odd (int x)
+{
+  return x == 0 ? 0 : even (x - 1);
+}
+
+static int __attribute__ ((noinline))
+even (int x)
+{
+  return x == 0 ? 1 : odd (x - 1);
+}
+
+int
+main (int argc, char **argv)
+{
+  if (four_times (argc) != 4 * argc || scaled_g () != 12)
+    abort ();
+  if (even (4) != 1 || odd (4) != 0)
+    abort ();
+  if (argc > 1000)
+    return forever (argc);
+  return 0;
+}
+
+/* { dg-final { scan-ipa-dump "found to be const: twice" "cgraph" } } */
+/* { dg-final { scan-ipa-dump "found to be const: four_times" "cgraph" } } */
+/* { dg-final { scan-ipa-dump "found to be pure: scaled_g" "cgraph" } } */
+/* { dg-final { scan-ipa-dump-not "found to be \[a-z\]*: forever" "cgraph" } } */
+/* { dg-final { scan-ipa-dump-not "found to be \[a-z\]*: even" "cgraph" } } */
+/* { dg-final { scan-ipa-dump-not "found to be \[a-z\]*: odd" "cgraph" } } */
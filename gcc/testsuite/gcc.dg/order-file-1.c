@@ -0,0 +1,10 @@
+/* A -forder-file that cannot be created is diagnosed.  */
+
+/* { dg-do compile } */
+/* { dg-options "-forder-file=order-file-1.dir/order-file-1.order" } */
+/* { dg-error "open order-file-1.dir/order-file-1.order" "" { target *-*-* } 0 } */
+
+void
+f (void)
+{
+}
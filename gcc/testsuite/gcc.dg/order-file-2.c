@@ -0,0 +1,10 @@
+/* -forder-file needs a file name.  */
+
+/* { dg-do compile } */
+/* { dg-options "-forder-file=" } */
+/* { dg-error "missing argument" "" { target *-*-* } 0 } */
+
+void
+f (void)
+{
+}
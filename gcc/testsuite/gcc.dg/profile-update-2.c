@@ -0,0 +1,20 @@
+/* With -fprofile-update=atomic, the tree edge profiler increments the
+   arc counters with a locked add instruction, not a libgcov call.  */
+
+/* { dg-do compile { target x86_64-*-* } } */
+/* { dg-options "-O2 -m64 -fprofile-arcs -ftree-based-profiling -fprofile-update=atomic" } */
+
+int a;
+
+void
+inc (int n)
+{
+  int i;
+
+  for (i = 0; i < n; i++)
+    if (i & 1)
+      a++;
+}
+
+/* { dg-final { scan-assembler "lock" } } */
+/* { dg-final { scan-assembler-not "__gcov_atomic_add" } } */
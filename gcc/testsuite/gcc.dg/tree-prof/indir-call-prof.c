@@ -0,0 +1,43 @@
+/* { dg-options "-fdump-tree-tree_profile" } */
+
+/* The indirect call in do_op almost always reaches add_one: it is
+   promoted to a direct call.  */
+
+extern void abort (void);
+
+static inline int
+add_one (int x)
+{
+  return x + 1;
+}
+
+static int
+sub_one (int x)
+{
+  return x - 1;
+}
+
+int (*volatile op) (int);
+
+int __attribute__ ((noinline))
+do_op (int x)
+{
+  return op (x);
+}
+
+int
+main (void)
+{
+  int i, sum = 0;
+
+  for (i = 0; i < 1000; i++)
+    {
+      op = i == 500 ? sub_one : add_one;
+      sum += do_op (i);
+    }
+  if (sum != 1000 * 999 / 2 + 1000 - 2)
+    abort ();
+  return 0;
+}
+
+/* { dg-final-use { scan-tree-dump "Indirect call -> direct call to add_one" "tree_profile" } } */
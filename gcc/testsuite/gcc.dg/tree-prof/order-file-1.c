@@ -0,0 +1,35 @@
+/* { dg-options "-freorder-functions -save-temps -forder-file=order-file-1.order" } */
+
+/* With profile feedback, the hot function is output first, although it
+   is defined after the cold one.  */
+
+extern void abort (void);
+
+int count;
+
+void __attribute__ ((noinline))
+cold_function (void)
+{
+  count -= 2;
+}
+
+void __attribute__ ((noinline))
+hot_function (void)
+{
+  count++;
+}
+
+int
+main (void)
+{
+  int i;
+
+  cold_function ();
+  for (i = 0; i < 100000; i++)
+    hot_function ();
+  if (count != 100000 - 2)
+    abort ();
+  return 0;
+}
+
+/* { dg-final-use { scan-assembler "hot_function:.*cold_function:" } } */
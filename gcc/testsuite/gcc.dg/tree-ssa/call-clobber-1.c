@@ -0,0 +1,38 @@
+/* { dg-do compile } */
+/* { dg-options "-O2 -fdump-tree-optimized" } */
+
+/* The callees neither write G nor are they outside of the unit, so
+   the loads of G after the calls should be replaced by X.  */
+
+static int g;
+int h;
+
+static int __attribute__ ((noinline))
+square (int x)
+{
+  return x * x;
+}
+
+static void __attribute__ ((noinline))
+set_h (int x)
+{
+  h = x;
+}
+
+int
+foo (int x)
+{
+  g = x;
+  h = square (x);
+  return g;
+}
+
+int
+bar (int x)
+{
+  g = x;
+  set_h (x);
+  return g;
+}
+
+/* { dg-final { scan-tree-dump-not "= g;" "optimized" } } */
@@ -0,0 +1,24 @@
+/* { dg-do compile } */
+/* { dg-options "-O2 -fdump-tree-optimized" } */
+
+/* G is public and the callee calls a function of another unit, which
+   may write it, so the load of G after the call must stay.  */
+
+int g;
+extern void set_g (int);
+
+static void __attribute__ ((noinline))
+wrap (int x)
+{
+  set_g (x);
+}
+
+int
+foo (int x)
+{
+  g = x;
+  wrap (x + 1);
+  return g;
+}
+
+/* { dg-final { scan-tree-dump "= g;" "optimized" } } */
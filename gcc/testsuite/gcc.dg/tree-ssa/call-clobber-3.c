@@ -0,0 +1,27 @@
+/* { dg-do compile } */
+/* { dg-options "-O2 -fdump-tree-optimized" } */
+
+/* The recursive callee writes G, so the load of G after the call must
+   stay.  */
+
+static int g;
+
+static void __attribute__ ((noinline))
+count_down (int n)
+{
+  if (n > 0)
+    {
+      g = n;
+      count_down (n - 1);
+    }
+}
+
+int
+foo (int x)
+{
+  g = x;
+  count_down (x);
+  return g;
+}
+
+/* { dg-final { scan-tree-dump "= g;" "optimized" } } */
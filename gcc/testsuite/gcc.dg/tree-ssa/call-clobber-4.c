@@ -0,0 +1,24 @@
+/* { dg-do compile } */
+/* { dg-options "-O2 -fdump-tree-optimized" } */
+
+/* The address of G escapes into P, and the callee writes G through P,
+   so the load of G after the call must stay.  */
+
+static int g;
+int *p = &g;
+
+static void __attribute__ ((noinline))
+set (int x)
+{
+  *p = x;
+}
+
+int
+foo (int x)
+{
+  g = x;
+  set (x + 1);
+  return g;
+}
+
+/* { dg-final { scan-tree-dump "= g;" "optimized" } } */
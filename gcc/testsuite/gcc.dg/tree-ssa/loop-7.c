@@ -0,0 +1,40 @@
+/* { dg-do compile } */
+/* { dg-options "-O2 -fdump-tree-lim-details" } */
+
+/* The fields stored in the loops live in the same memory, but do not
+   overlap, so each of them is kept in a register through the loop.  */
+
+struct pair
+{
+  int x;
+  int y;
+} s;
+
+void
+sum_global (int n)
+{
+  int i;
+
+  for (i = 0; i < n; i++)
+    {
+      s.x += i;
+      s.y += 2 * i;
+    }
+}
+
+void
+sum_pointer (struct pair *p, int n)
+{
+  int i;
+
+  for (i = 0; i < n; i++)
+    {
+      p->x += i;
+      p->y += 2 * i;
+    }
+}
+
+/* { dg-final { scan-tree-dump-times "Executing store motion of s.x" 1 "lim" } } */
+/* { dg-final { scan-tree-dump-times "Executing store motion of s.y" 1 "lim" } } */
+/* { dg-final { scan-tree-dump-times "Executing store motion of p_\[0-9\]*->x" 1 "lim" } } */
+/* { dg-final { scan-tree-dump-times "Executing store motion of p_\[0-9\]*->y" 1 "lim" } } */
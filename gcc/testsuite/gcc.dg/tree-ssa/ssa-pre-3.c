@@ -0,0 +1,15 @@
+/* { dg-do compile } */ 
+/* { dg-options "-O2 -fdump-tree-pre-stats" } */
+int load_test1 (int *p, int c)
+{
+	int t = 0;
+
+	if (c)
+		t = *p;
+	return t + *p;
+}
+/* The load of *p after the if is partially redundant.  We should
+   insert a load on the path that skips the first one, and eliminate
+   the second load.  */
+/* { dg-final { scan-tree-dump-times "Inserted loads:1" 1 "pre"} } */
+/* { dg-final { scan-tree-dump-times "Eliminated:1" 1 "pre"} } */
@@ -0,0 +1,35 @@
+/* { dg-do run } */
+/* { dg-options "-O2" } */
+
+/* A store into a bit-field truncates the value stored, so the loads of
+   the field after the store must not be replaced by the stored value.
+   Like gcc.c-torture/execute/921016-1.c, for PRE.  */
+
+extern void abort (void);
+
+struct s
+{
+  signed int m : 11;
+  unsigned int u : 3;
+};
+
+static int __attribute__ ((noinline))
+store_and_load (struct s *p, int j, int k)
+{
+  p->m = j;
+  p->u = k;
+  return p->m + p->u;
+}
+
+int
+main (void)
+{
+  struct s l;
+  int j = 1081;
+
+  if ((l.m = j) == j)
+    abort ();
+  if (store_and_load (&l, j, 9) != -967 + 1)
+    abort ();
+  return 0;
+}
@@ -0,0 +1,81 @@
+/* Test value profile transformations: division by a mostly constant
+   divisor, modulo by a power of two, block copies of a mostly constant
+   size and indirect calls that mostly reach the same function.  */
+
+extern void abort (void);
+extern void exit (int);
+extern void *memcpy (void *, const void *, __SIZE_TYPE__);
+extern void *memset (void *, int, __SIZE_TYPE__);
+
+int divisor = 8;
+unsigned int pow2_divisor = 16;
+__SIZE_TYPE__ copy_size = 12;
+
+int
+div_test (int a, int b)
+{
+  return a / b;
+}
+
+unsigned int
+mod_test (unsigned int a, unsigned int b)
+{
+  return a % b;
+}
+
+char src[64] = "0123456789abcdefghijklmnopqrstuvwxyz";
+char dst[64];
+
+void
+copy_test (__SIZE_TYPE__ n)
+{
+  memset (dst, 0, sizeof (dst));
+  memcpy (dst, src, n);
+}
+
+static int
+add_one (int x)
+{
+  return x + 1;
+}
+
+static int
+sub_one (int x)
+{
+  return x - 1;
+}
+
+int (*volatile fnptr) (int) = add_one;
+
+int
+call_test (int x)
+{
+  return fnptr (x);
+}
+
+int
+main (void)
+{
+  int i;
+
+  for (i = 0; i < 1000; i++)
+    {
+      int d = (i % 100) ? divisor : 3;
+      unsigned int m = (i % 100) ? pow2_divisor : 7;
+      __SIZE_TYPE__ n = (i % 100) ? copy_size : 5;
+
+      if (div_test (i, d) != i / d)
+	abort ();
+      if (mod_test (i, m) != i % m)
+	abort ();
+
+      copy_test (n);
+      if (dst[n - 1] != src[n - 1] || dst[n] != 0)
+	abort ();
+
+      fnptr = (i % 100) ? add_one : sub_one;
+      if (call_test (i) != ((i % 100) ? i + 1 : i - 1))
+	abort ();
+    }
+  exit (0);
+}
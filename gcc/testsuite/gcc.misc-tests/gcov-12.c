@@ -0,0 +1,31 @@
+/* Test that __gcov_reset discards the counts gathered so far, with
+   atomically updated counters.  */
+
+/* { dg-options "-fprofile-arcs -ftest-coverage -fprofile-update=locked" } */
+/* { dg-do run { target native } } */
+
+extern void __gcov_reset (void);
+
+int a;
+
+void inc ()
+{
+  a++;				/* count(5) */
+}
+
+int main ()
+{
+  int i;
+
+  for (i = 0; i < 10; i++)
+    inc ();
+
+  __gcov_reset ();
+
+  for (i = 0; i < 5; i++)
+    inc ();
+
+  return 0;
+}
+
+/* { dg-final { run-gcov gcov-12.c } } */
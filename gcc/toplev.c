@@ -315,6 +315,11 @@ int flag_gen_aux_info = 0;
 
 const char *aux_info_file_name;
 
+/* Name of the file the names of the functions output are appended to,
+   for use as a linker order file.  */
+
+const char *order_file_name;
+
 /* Nonzero if we are compiling code for a shared library, zero for
    executable.  */
 
@@ -451,6 +456,7 @@ int warn_return_type;
 
 FILE *asm_out_file;
 FILE *aux_info_file;
+FILE *order_file;
 FILE *dump_file = NULL;
 char *dump_file_name;
 
@@ -1871,6 +1877,21 @@ process_options (void)
       flag_prefetch_loop_arrays = 0;
     }
 
+  /* Atomic updates of the arc counters need an instruction of the target.
+     Only -fprofile-update=locked falls back to a libgcov routine that
+     takes a lock for every update.  */
+  if (flag_profile_update == PROFILE_UPDATE_ATOMIC)
+    {
+#ifdef GCOV_ATOMIC_ADD_ASM
+      if (!GCOV_ATOMIC_ADD_ASM)
+#endif
+	{
+	  warning ("-fprofile-update=atomic is not supported on this target,"
+		   " using -fprofile-update=single");
+	  flag_profile_update = PROFILE_UPDATE_SINGLE;
+	}
+    }
+
   /* Warn about options that are not supported on this machine.  */
 #ifndef INSN_SCHEDULING
   if (flag_schedule_insns || flag_schedule_insns_after_reload)
@@ -1881,9 +1902,6 @@ process_options (void)
     warning ("this target machine does not have delayed branches");
 #endif
 
-  if (flag_tree_based_profiling && flag_profile_values)
-    sorry ("value-based profiling not yet implemented in trees.");
-
   user_label_prefix = USER_LABEL_PREFIX;
   if (flag_leading_underscore != -1)
     {
@@ -2007,6 +2025,15 @@ process_options (void)
 	fatal_error ("can%'t open %s: %m", aux_info_file_name);
     }
 
+  /* Each compilation writes its own order file; appending would pile
+     up the entries of repeated builds.  */
+  if (order_file_name)
+    {
+      order_file = fopen (order_file_name, "w");
+      if (order_file == 0)
+	fatal_error ("can%'t open %s: %m", order_file_name);
+    }
+
   if (! targetm.have_named_sections)
     {
       if (flag_function_sections)
@@ -2167,6 +2194,14 @@ finalize (void)
 	unlink (aux_info_file_name);
     }
 
+  if (order_file)
+    {
+      if (ferror (order_file) != 0)
+	fatal_error ("error writing to %s: %m", order_file_name);
+      if (fclose (order_file) != 0)
+	fatal_error ("error closing %s: %m", order_file_name);
+    }
+
   /* Close non-debugging input and output files.  Take special care to note
      whether fclose returns an error, since the pages might still be on the
      buffer chain while the file is open.  */
@@ -1873,6 +1873,52 @@ save_body (tree fn, tree *arg_copy, tree *sc_copy)
   return body;
 }
 
+/* Give CLONE, a new FUNCTION_DECL made from FN by the callgraph, its own
+   copies of the arguments, result and body of FN, and a fresh outermost
+   BLOCK.  The callgraph edges of FN are duplicated for the node of CLONE,
+   which must exist already.  */
+
+void
+copy_function_body (tree clone, tree fn)
+{
+  inline_data id;
+  tree *parg, result;
+
+  memset (&id, 0, sizeof (id));
+  VARRAY_TREE_INIT (id.fns, 2, "fns");
+  VARRAY_PUSH_TREE (id.fns, clone);
+  VARRAY_PUSH_TREE (id.fns, fn);
+  id.node = cgraph_node (clone);
+  id.current_node = cgraph_node (fn);
+  id.decl_map = splay_tree_new (splay_tree_compare_pointers, NULL, NULL);
+
+  DECL_ARGUMENTS (clone) = DECL_ARGUMENTS (fn);
+  for (parg = &DECL_ARGUMENTS (clone); *parg; parg = &TREE_CHAIN (*parg))
+    {
+      tree new = copy_node (*parg);
+
+      lang_hooks.dup_lang_specific_decl (new);
+      DECL_CONTEXT (new) = clone;
+      insert_decl_map (&id, *parg, new);
+      TREE_CHAIN (new) = TREE_CHAIN (*parg);
+      *parg = new;
+    }
+
+  result = copy_node (DECL_RESULT (fn));
+  DECL_CONTEXT (result) = clone;
+  insert_decl_map (&id, DECL_RESULT (fn), result);
+  DECL_RESULT (clone) = result;
+
+  /* The blocks of the copied body are chained after this one; the block
+     tree is rebuilt from the block notes when CLONE is expanded.  */
+  DECL_INITIAL (clone) = make_node (BLOCK);
+  TREE_USED (DECL_INITIAL (clone)) = 1;
+
+  DECL_SAVED_TREE (clone) = copy_body (&id);
+
+  splay_tree_delete (id.decl_map);
+}
+
 #define WALK_SUBTREE(NODE)				\
   do							\
     {							\
@@ -29,6 +29,7 @@ bool tree_inlinable_function_p (tree);
 tree copy_tree_r (tree *, int *, void *);
 void clone_body (tree, tree, void *);
 tree save_body (tree, tree *, tree *);
+void copy_function_body (tree, tree);
 void remap_save_expr (tree *, void *, int *);
 int estimate_num_insns (tree expr);
 
@@ -664,6 +664,12 @@ tree_rest_of_compilation (tree fndecl)
       DECL_ARGUMENTS (fndecl) = cfun->saved_args;
       cfun->static_chain_decl = cfun->saved_static_chain_decl;
 
+      /* The passes may have added edges for the calls of the optimized
+	 body, such as the calls made direct by value profiling.  They
+	 do not belong to the restored body.  */
+      while (node->callees)
+	cgraph_remove_edge (node->callees);
+
       /* When not in unit-at-a-time mode, we must preserve out of line copy
 	 representing node before inlining.  Restore original outgoing edges
 	 using clone we created earlier.  */
@@ -671,8 +677,6 @@ tree_rest_of_compilation (tree fndecl)
 	{
 	  struct cgraph_edge *e;
 
-	  while (node->callees)
-	    cgraph_remove_edge (node->callees);
 	  node->callees = saved_node->callees;
 	  saved_node->callees = NULL;
 	  update_inlined_to_pointers (node, node);
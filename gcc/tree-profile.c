@@ -67,8 +67,78 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 #include "tree-pass.h"
 #include "timevar.h"
 #include "value-prof.h"
+#include "cgraph.h"
+#include "ggc.h"
 
+/* Decl of the libgcov routine used to update arc counters atomically.  */
+static GTY(()) tree tree_atomic_add_fn;
+
+/* Decls of the libgcov value profilers.  */
+static GTY(()) tree tree_pow2_profiler_fn;
+static GTY(()) tree tree_one_value_profiler_fn;
+static GTY(()) tree tree_indirect_call_profiler_fn;
+
+/* The target of the last instrumented indirect call of this unit, and the
+   counters of its call site.  */
+static GTY(()) tree ic_callee_var;
+static GTY(()) tree ic_counters_var;
 
+/* Return the decl of the libgcov function NAME of TYPE.  */
+
+static tree
+build_libgcov_fn_decl (const char *name, tree type)
+{
+  tree fn = build_decl (FUNCTION_DECL, get_identifier (name), type);
+
+  DECL_EXTERNAL (fn) = 1;
+  TREE_PUBLIC (fn) = 1;
+  DECL_ARTIFICIAL (fn) = 1;
+  TREE_NOTHROW (fn) = 1;
+  return fn;
+}
+
+/* Output the atomic add instruction of the target, or else a call to the
+   libgcov routine, that increments the edge execution count EDGENO, and
+   insert it on E.  Used for -fprofile-update=atomic and locked, so that
+   the counters of a multi-threaded program are not corrupted by racing
+   updates.  process_options makes sure that only -fprofile-update=locked
+   gets here without the instruction; the routine may take a lock for
+   every update.  */
+
+static void
+tree_gen_atomic_edge_profiler (int edgeno, edge e)
+{
+  tree ref, addr, tmp, args;
+
+  /* Use the atomic add instruction of the target, if it has one.  */
+  tmp = tree_coverage_counter_atomic_inc (GCOV_COUNTER_ARCS, edgeno);
+  if (tmp)
+    {
+      bsi_insert_on_edge (e, tmp);
+      return;
+    }
+
+  gcc_assert (flag_profile_update == PROFILE_UPDATE_LOCKED);
+  ref = tree_coverage_counter_ref (GCOV_COUNTER_ARCS, edgeno);
+  addr = build_fold_addr_expr (ref);
+  tmp = create_tmp_var (TREE_TYPE (addr), "PROF");
+  if (!tree_atomic_add_fn)
+    {
+      tree fn_type
+	= build_function_type_list (void_type_node,
+				    build_pointer_type (GCOV_TYPE_NODE),
+				    GCOV_TYPE_NODE, NULL_TREE);
+      tree_atomic_add_fn = build_libgcov_fn_decl ("__gcov_atomic_add",
+						  fn_type);
+    }
+
+  args = tree_cons (NULL_TREE, tmp,
+		    tree_cons (NULL_TREE, build_int_cst (GCOV_TYPE_NODE, 1),
+			       NULL_TREE));
+  bsi_insert_on_edge (e, build2 (MODIFY_EXPR, TREE_TYPE (addr), tmp, addr));
+  bsi_insert_on_edge (e, build_function_call_expr (tree_atomic_add_fn, args));
+}
+
 /* Output instructions as GIMPLE trees to increment the edge 
    execution count, and insert them on E.  We rely on 
    bsi_insert_on_edge to preserve the order.  */
@@ -76,14 +146,22 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 static void
 tree_gen_edge_profiler (int edgeno, edge e)
 {
-  tree tmp1 = create_tmp_var (GCOV_TYPE_NODE, "PROF");
-  tree tmp2 = create_tmp_var (GCOV_TYPE_NODE, "PROF");
-  tree ref = tree_coverage_counter_ref (GCOV_COUNTER_ARCS, edgeno);
-  tree stmt1 = build (MODIFY_EXPR, GCOV_TYPE_NODE, tmp1, ref);
-  tree stmt2 = build (MODIFY_EXPR, GCOV_TYPE_NODE, tmp2,
-		      build (PLUS_EXPR, GCOV_TYPE_NODE, 
-			     tmp1, integer_one_node));
-  tree stmt3 = build (MODIFY_EXPR, GCOV_TYPE_NODE, ref, tmp2);
+  tree tmp1, tmp2, ref, stmt1, stmt2, stmt3;
+
+  if (flag_profile_update != PROFILE_UPDATE_SINGLE)
+    {
+      tree_gen_atomic_edge_profiler (edgeno, e);
+      return;
+    }
+
+  tmp1 = create_tmp_var (GCOV_TYPE_NODE, "PROF");
+  tmp2 = create_tmp_var (GCOV_TYPE_NODE, "PROF");
+  ref = tree_coverage_counter_ref (GCOV_COUNTER_ARCS, edgeno);
+  stmt1 = build (MODIFY_EXPR, GCOV_TYPE_NODE, tmp1, ref);
+  stmt2 = build (MODIFY_EXPR, GCOV_TYPE_NODE, tmp2,
+		 build (PLUS_EXPR, GCOV_TYPE_NODE, 
+			tmp1, integer_one_node));
+  stmt3 = build (MODIFY_EXPR, GCOV_TYPE_NODE, ref, tmp2);
   bsi_insert_on_edge (e, stmt1);
   bsi_insert_on_edge (e, stmt2);
   bsi_insert_on_edge (e, stmt3);
@@ -105,20 +183,115 @@ tree_gen_interval_profiler (histogram_value value ATTRIBUTE_UNUSED,
   gcc_unreachable ();
 }
 
+/* Return a reference to the variable NAME of TYPE, through which the
+   indirect call profilers communicate.  It is defined once in libgcov,
+   next to __gcov_indirect_call_profiler, so that a call from one unit to
+   a function of another is recorded too.  */
+
+static tree
+build_ic_var (const char *name, tree type)
+{
+  tree var = build_decl (VAR_DECL, get_identifier (name), type);
+
+  TREE_PUBLIC (var) = 1;
+  DECL_EXTERNAL (var) = 1;
+  TREE_USED (var) = 1;
+  DECL_ARTIFICIAL (var) = 1;
+  DECL_IGNORED_P (var) = 1;
+  return var;
+}
+
+/* Create the decls used by the value profilers, if not done yet.  */
+
+static void
+tree_init_value_profilers (void)
+{
+  tree gcov_type_ptr, fn_type;
+
+  if (tree_one_value_profiler_fn)
+    return;
+
+  gcov_type_ptr = build_pointer_type (GCOV_TYPE_NODE);
+
+  /* void (*) (gcov_type *, gcov_type)  */
+  fn_type = build_function_type_list (void_type_node,
+				      gcov_type_ptr, GCOV_TYPE_NODE,
+				      NULL_TREE);
+  tree_pow2_profiler_fn
+    = build_libgcov_fn_decl ("__gcov_pow2_profiler", fn_type);
+  tree_one_value_profiler_fn
+    = build_libgcov_fn_decl ("__gcov_one_value_profiler", fn_type);
+
+  /* void (*) (gcov_type *, gcov_type, void *, void *)  */
+  fn_type = build_function_type_list (void_type_node,
+				      gcov_type_ptr, GCOV_TYPE_NODE,
+				      ptr_type_node, ptr_type_node,
+				      NULL_TREE);
+  tree_indirect_call_profiler_fn
+    = build_libgcov_fn_decl ("__gcov_indirect_call_profiler", fn_type);
+
+  ic_callee_var = build_ic_var ("__gcov_indirect_call_callee",
+				ptr_type_node);
+  ic_counters_var = build_ic_var ("__gcov_indirect_call_counters",
+				  gcov_type_ptr);
+}
+
+/* Insert before BSI the computation of VALUE converted to TYPE into a new
+   temporary, and return the temporary.  */
+
+static tree
+tree_prof_gimple_value (block_stmt_iterator *bsi, tree type, tree value)
+{
+  tree tmp = create_tmp_var (type, "PROF");
+  tree stmt = build2 (MODIFY_EXPR, type, tmp, fold_convert (type, value));
+
+  bsi_insert_before (bsi, stmt, BSI_SAME_STMT);
+  return tmp;
+}
+
+/* Insert before BSI the computation of the address of the counter BASE in
+   the section TAG into a new temporary, and return the temporary.  */
+
+static tree
+tree_prof_counter_address (block_stmt_iterator *bsi, unsigned tag,
+			   unsigned base)
+{
+  tree ref = tree_coverage_counter_ref (tag, base);
+  tree addr = build_fold_addr_expr (ref);
+  tree tmp = create_tmp_var (TREE_TYPE (addr), "PROF");
+
+  bsi_insert_before (bsi, build2 (MODIFY_EXPR, TREE_TYPE (addr), tmp, addr),
+		     BSI_SAME_STMT);
+  return tmp;
+}
+
+/* Insert before the statement profiled by VALUE a call to the libgcov
+   profiler FN, passing it the counters starting at BASE in the section TAG
+   and the profiled value.  */
+
+static void
+tree_gen_value_profiler_call (tree fn, histogram_value value, unsigned tag,
+			      unsigned base)
+{
+  block_stmt_iterator bsi = stmt_for_bsi (value->insn);
+  tree ref_ptr = tree_prof_counter_address (&bsi, tag, base);
+  tree val = tree_prof_gimple_value (&bsi, GCOV_TYPE_NODE, value->value);
+  tree args = tree_cons (NULL_TREE, ref_ptr,
+			 tree_cons (NULL_TREE, val, NULL_TREE));
+
+  bsi_insert_before (&bsi, build_function_call_expr (fn, args),
+		     BSI_SAME_STMT);
+}
+
 /* Output instructions as GIMPLE trees to increment the power of two histogram 
    counter.  VALUE is the expression whose value is profiled.  TAG is the tag 
    of the section for counters, BASE is offset of the counter position.  */
 
 static void
-tree_gen_pow2_profiler (histogram_value value ATTRIBUTE_UNUSED, 
-			unsigned tag ATTRIBUTE_UNUSED,
-			unsigned base ATTRIBUTE_UNUSED)
+tree_gen_pow2_profiler (histogram_value value, unsigned tag, unsigned base)
 {
-  /* FIXME implement this.  */
-#ifdef ENABLE_CHECKING
-  internal_error ("unimplemented functionality");
-#endif
-  gcc_unreachable ();
+  tree_init_value_profilers ();
+  tree_gen_value_profiler_call (tree_pow2_profiler_fn, value, tag, base);
 }
 
 /* Output instructions as GIMPLE trees for code to find the most common value.
@@ -126,15 +299,82 @@ tree_gen_pow2_profiler (histogram_value value ATTRIBUTE_UNUSED,
    section for counters, BASE is offset of the counter position.  */
 
 static void
-tree_gen_one_value_profiler (histogram_value value ATTRIBUTE_UNUSED, 
-			    unsigned tag ATTRIBUTE_UNUSED,
-			    unsigned base ATTRIBUTE_UNUSED)
+tree_gen_one_value_profiler (histogram_value value, unsigned tag,
+			     unsigned base)
 {
-  /* FIXME implement this.  */
-#ifdef ENABLE_CHECKING
-  internal_error ("unimplemented functionality");
-#endif
-  gcc_unreachable ();
+  tree_init_value_profilers ();
+  tree_gen_value_profiler_call (tree_one_value_profiler_fn, value, tag, base);
+}
+
+/* Output instructions as GIMPLE trees for code to find the most common
+   target of an indirect call.  The call site only publishes its counters
+   and the called address; the histogram is updated by the code that
+   tree_gen_ic_func_profiler places at the entry of the callee.  VALUE is
+   the address that is called.  TAG is the tag of the section for counters,
+   BASE is offset of the counter position.  */
+
+static void
+tree_gen_ic_profiler (histogram_value value, unsigned tag, unsigned base)
+{
+  block_stmt_iterator bsi = stmt_for_bsi (value->insn);
+  tree ref_ptr, callee;
+
+  tree_init_value_profilers ();
+  ref_ptr = tree_prof_counter_address (&bsi, tag, base);
+  callee = tree_prof_gimple_value (&bsi, ptr_type_node, value->value);
+  bsi_insert_before (&bsi,
+		     build2 (MODIFY_EXPR, TREE_TYPE (ic_counters_var),
+			     ic_counters_var, ref_ptr),
+		     BSI_SAME_STMT);
+  bsi_insert_before (&bsi,
+		     build2 (MODIFY_EXPR, ptr_type_node,
+			     ic_callee_var, callee),
+		     BSI_SAME_STMT);
+}
+
+/* Output instructions as GIMPLE trees at the entry of the current function
+   that record it as the target of the instrumented indirect call that has
+   just been made, if any.  */
+
+static void
+tree_gen_ic_func_profiler (void)
+{
+  tree stmts = NULL_TREE;
+  tree counters, callee, cur_func, args;
+
+  tree_init_value_profilers ();
+
+  counters = create_tmp_var (TREE_TYPE (ic_counters_var), "PROF");
+  append_to_statement_list (build2 (MODIFY_EXPR, TREE_TYPE (counters),
+				    counters, ic_counters_var), &stmts);
+  callee = create_tmp_var (ptr_type_node, "PROF");
+  append_to_statement_list (build2 (MODIFY_EXPR, ptr_type_node,
+				    callee, ic_callee_var), &stmts);
+  cur_func = create_tmp_var (ptr_type_node, "PROF");
+  append_to_statement_list (build2 (MODIFY_EXPR, ptr_type_node, cur_func,
+				    fold_convert (ptr_type_node,
+						  build_fold_addr_expr
+						    (current_function_decl))),
+			    &stmts);
+
+  args = tree_cons (NULL_TREE, callee, NULL_TREE);
+  args = tree_cons (NULL_TREE, cur_func, args);
+  args = tree_cons (NULL_TREE,
+		    build_int_cst_type (GCOV_TYPE_NODE,
+					indirect_call_profile_id
+					  (current_function_decl)),
+		    args);
+  args = tree_cons (NULL_TREE, counters, args);
+  append_to_statement_list (build_function_call_expr
+			      (tree_indirect_call_profiler_fn, args),
+			    &stmts);
+
+  /* Do not attribute later direct calls to the same indirect call.  */
+  append_to_statement_list (build2 (MODIFY_EXPR, ptr_type_node,
+				    ic_callee_var, null_pointer_node),
+			    &stmts);
+
+  bsi_insert_on_edge_immediate (EDGE_SUCC (ENTRY_BLOCK_PTR, 0), stmts);
 }
 
 /* Output instructions as GIMPLE trees for code to find the most common value 
@@ -154,6 +394,30 @@ tree_gen_const_delta_profiler (histogram_value value ATTRIBUTE_UNUSED,
   gcc_unreachable ();
 }
 
+/* Instrument the current function, or read its profile back and use the
+   value histograms.  Execute function of pass_tree_profile.  */
+
+static void
+tree_profiling (void)
+{
+  branch_prob ();
+
+  /* Functions whose address may be taken have to tell the indirect call
+     sites of the unit that they were reached.  */
+  if (profile_arc_flag
+      && flag_profile_values
+      && flag_value_profile_transformations
+      && !cgraph_local_info (current_function_decl)->local
+      && !DECL_STATIC_CONSTRUCTOR (current_function_decl)
+      && !DECL_STATIC_DESTRUCTOR (current_function_decl))
+    tree_gen_ic_func_profiler ();
+
+  if (flag_branch_probabilities
+      && flag_profile_values
+      && flag_value_profile_transformations)
+    value_profile_transformations ();
+}
+
 /* Return 1 if tree-based profiling is in effect, else 0.
    If it is, set up hooks for tree-based profiling.
    Gate for pass_tree_profile.  */
@@ -180,7 +444,7 @@ struct tree_opt_pass pass_tree_profile =
 {
   "tree_profile",			/* name */
   do_tree_profiling,			/* gate */
-  branch_prob,				/* execute */
+  tree_profiling,			/* execute */
   NULL,					/* sub */
   NULL,					/* next */
   0,					/* static_pass_number */
@@ -200,5 +464,8 @@ struct profile_hooks tree_profile_hooks =
   tree_gen_pow2_profiler,       /* gen_pow2_profiler */
   tree_gen_one_value_profiler,  /* gen_one_value_profiler */
   tree_gen_const_delta_profiler,/* gen_const_delta_profiler */
+  tree_gen_ic_profiler,		/* gen_ic_profiler */
   tree_profile_dump_file	/* profile_dump_file */
 };
+
+#include "gt-tree-profile.h"
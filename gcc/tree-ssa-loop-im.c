@@ -837,28 +837,20 @@ maybe_queue_var (tree var, struct loop *loop,
   queue[(*in_queue)++] = stmt;
 }
 
-/* If COMMON_REF is NULL, set COMMON_REF to *OP and return true.
-   Otherwise return true if the memory reference *OP is equal to COMMON_REF.
-   Record the reference OP to list MEM_REFS.  STMT is the statement in that
+/* Record the reference OP to list MEM_REFS.  STMT is the statement in that
    the reference occurs.  */
 
 struct sra_data
 {
   struct mem_ref **mem_refs;
-  tree common_ref;
   tree stmt;
 };
 
 static bool
-fem_single_reachable_address (tree *op, void *data)
+fem_reachable_address (tree *op, void *data)
 {
   struct sra_data *sra_data = data;
 
-  if (sra_data->common_ref
-      && !operand_equal_p (*op, sra_data->common_ref, 0))
-    return false;
-  sra_data->common_ref = *op;
-
   record_mem_ref (sra_data->mem_refs, sra_data->stmt, op);
   return true;
 }
@@ -913,17 +905,18 @@ for_each_memref (tree stmt, bool (*callback)(tree *, void *), void *data)
   return true;
 }
 
-/* Determine whether all memory references inside the LOOP that correspond
-   to virtual ssa names defined in statement STMT are equal.
-   If so, store the list of the references to MEM_REFS, and return one
-   of them.  Otherwise store NULL to MEM_REFS and return NULL_TREE.
-   *SEEN_CALL_STMT is set to true if the virtual operands suggest
-   that the reference might be clobbered by a call inside the LOOP.  */
-
-static tree
-single_reachable_address (struct loop *loop, tree stmt,
-			  struct mem_ref **mem_refs,
-			  bool *seen_call_stmt)
+/* Collect the memory references inside the LOOP that correspond to virtual
+   ssa names defined in statement STMT.  If all the statements that use or
+   define these names are ones we understand, store the list of the
+   references to MEM_REFS and return true.  Otherwise store NULL to MEM_REFS
+   and return false.  *SEEN_CALL_STMT is set to true if the virtual operands
+   suggest that the references might be clobbered by a call inside the
+   LOOP.  */
+
+static bool
+reachable_addresses (struct loop *loop, tree stmt,
+		     struct mem_ref **mem_refs,
+		     bool *seen_call_stmt)
 {
   unsigned max_uid = max_stmt_uid + num_ssa_names;
   tree *queue = xmalloc (sizeof (tree) * max_uid);
@@ -940,7 +933,6 @@ single_reachable_address (struct loop *loop, tree stmt,
 
   *mem_refs = NULL;
   sra_data.mem_refs = mem_refs;
-  sra_data.common_ref = NULL_TREE;
 
   queue[0] = stmt;
   SET_BIT (seen, get_stmt_uid (stmt));
@@ -960,14 +952,13 @@ single_reachable_address (struct loop *loop, tree stmt,
 	case MODIFY_EXPR:
 	case CALL_EXPR:
 	case RETURN_EXPR:
-	  if (!for_each_memref (stmt, fem_single_reachable_address,
-				&sra_data))
+	  if (!for_each_memref (stmt, fem_reachable_address, &sra_data))
 	    goto fail;
 
 	  /* If this is a function that may depend on the memory location,
 	     record the fact.  We cannot directly refuse call clobbered
-	     operands here, since sra_data.common_ref did not have
-	     to be set yet.  */
+	     operands here, since we do not know yet which of the
+	     references will be moved.  */
 	  call = get_call_expr_in (stmt);
 	  if (call
 	      && !(call_expr_flags (call) & ECF_CONST))
@@ -1013,7 +1004,7 @@ single_reachable_address (struct loop *loop, tree stmt,
   free (queue);
   sbitmap_free (seen);
 
-  return sra_data.common_ref;
+  return true;
 
 fail:
   free_mem_refs (*mem_refs);
@@ -1021,7 +1012,7 @@ fail:
   free (queue);
   sbitmap_free (seen);
 
-  return NULL;
+  return false;
 }
 
 /* Rewrites memory references in list MEM_REFS by variable TMP_VAR.  */
@@ -1132,42 +1123,74 @@ is_call_clobbered_ref (tree ref)
   gcc_unreachable ();
 }
 
-/* Determine whether all memory references inside LOOP corresponding to the
-   virtual ssa name REG are equal to each other, and whether the address of
-   this common reference can be hoisted outside of the loop.  If this is true,
-   prepare the statements that load the value of the memory reference to a
-   temporary variable in the loop preheader, store it back on the loop exits,
-   and replace all the references inside LOOP by this temporary variable.
-   LOOP has N_EXITS stored in EXITS.  */
+/* Returns true if the memory references REF1 and REF2 are known not to
+   overlap, i.e. if they are based on two different decls, or on the same
+   decl or pointer with constant offsets that select disjoint parts of
+   it.  */
+
+static bool
+refs_independent_p (tree ref1, tree ref2)
+{
+  HOST_WIDE_INT bitsize1, bitpos1, bitsize2, bitpos2;
+  tree base1, base2, offset1, offset2;
+  enum machine_mode mode;
+  int unsignedp, volatilep;
+
+  base1 = get_inner_reference (ref1, &bitsize1, &bitpos1, &offset1,
+			       &mode, &unsignedp, &volatilep);
+  base2 = get_inner_reference (ref2, &bitsize2, &bitpos2, &offset2,
+			       &mode, &unsignedp, &volatilep);
+
+  if (DECL_P (base1) && DECL_P (base2))
+    {
+      if (base1 != base2)
+	return true;
+    }
+  else if (INDIRECT_REF_P (base1) && INDIRECT_REF_P (base2))
+    {
+      if (!operand_equal_p (TREE_OPERAND (base1, 0),
+			    TREE_OPERAND (base2, 0), 0))
+	return false;
+    }
+  else
+    return false;
+
+  if (offset1 || offset2
+      || bitsize1 <= 0 || bitsize2 <= 0)
+    return false;
+
+  return (bitpos1 + bitsize1 <= bitpos2
+	  || bitpos2 + bitsize2 <= bitpos1);
+}
+
+/* Determine whether the address of the memory reference REF can be hoisted
+   outside of the LOOP, and whether its value can be kept in a register.
+   If this is true, prepare the statements that load the value of the memory
+   reference to a temporary variable in the loop preheader, store it back on
+   the loop exits, and replace all the occurrences of REF inside LOOP, listed
+   in MEM_REFS, by this temporary variable.  LOOP has N_EXITS stored in
+   EXITS.  SEES_CALL is true if the reference may be clobbered by a call
+   inside LOOP.  */
 
 static void
-determine_lsm_reg (struct loop *loop, edge *exits, unsigned n_exits, tree reg)
+determine_lsm_ref (struct loop *loop, edge *exits, unsigned n_exits,
+		   tree ref, struct mem_ref *mem_refs, bool sees_call)
 {
-  tree ref;
-  struct mem_ref *mem_refs, *aref;
+  struct mem_ref *aref;
   struct loop *must_exec;
-  bool sees_call;
-  
-  if (is_gimple_reg (reg))
-    return;
-  
-  ref = single_reachable_address (loop, SSA_NAME_DEF_STMT (reg), &mem_refs,
-				  &sees_call);
-  if (!ref)
-    return;
 
   /* If we cannot create a ssa name for the result, give up.  */
   if (!is_gimple_reg_type (TREE_TYPE (ref))
       || TREE_THIS_VOLATILE (ref))
-    goto fail;
+    return;
 
   /* If there is a call that may use the location, give up as well.  */
   if (sees_call
       && is_call_clobbered_ref (ref))
-    goto fail;
+    return;
 
   if (!for_each_index (&ref, may_move_till, loop))
-    goto fail;
+    return;
 
   if (tree_could_trap_p (ref))
     {
@@ -1197,13 +1220,84 @@ determine_lsm_reg (struct loop *loop, edge *exits, unsigned n_exits, tree reg)
 	}
 
       if (!aref)
-	goto fail;
+	return;
     }
 
   schedule_sm (loop, exits, n_exits, ref, mem_refs);
+}
+
+/* A group of the memory references inside a loop that are equal to each
+   other.  */
+
+struct mem_ref_group
+{
+  tree ref;			/* The common reference.  */
+  struct mem_ref *refs;		/* Its occurrences.  */
+  bool independent;		/* True if the reference does not overlap
+				   the references in the other groups.  */
+  struct mem_ref_group *next;	/* Next group in the chain.  */
+};
+
+/* Split the memory references inside LOOP corresponding to the virtual ssa
+   name REG into groups of equal references.  Each group whose reference is
+   independent of the references in all the other groups is a candidate for
+   store motion, see determine_lsm_ref.  LOOP has N_EXITS stored in
+   EXITS.  */
+
+static void
+determine_lsm_reg (struct loop *loop, edge *exits, unsigned n_exits, tree reg)
+{
+  struct mem_ref *mem_refs, *aref, *next;
+  struct mem_ref_group *groups = NULL, *group, *other;
+  bool sees_call;
+  
+  if (is_gimple_reg (reg))
+    return;
+  
+  if (!reachable_addresses (loop, SSA_NAME_DEF_STMT (reg), &mem_refs,
+			    &sees_call))
+    return;
+
+  for (aref = mem_refs; aref; aref = next)
+    {
+      next = aref->next;
+
+      for (group = groups; group; group = group->next)
+	if (operand_equal_p (*aref->ref, group->ref, 0))
+	  break;
 
-fail: ;
-  free_mem_refs (mem_refs);
+      if (!group)
+	{
+	  group = xmalloc (sizeof (struct mem_ref_group));
+	  group->ref = *aref->ref;
+	  group->refs = NULL;
+	  group->independent = true;
+	  group->next = groups;
+	  groups = group;
+	}
+
+      aref->next = group->refs;
+      group->refs = aref;
+    }
+
+  /* Decide which of the groups are independent before any of them is
+     rewritten.  */
+  for (group = groups; group; group = group->next)
+    for (other = group->next; other; other = other->next)
+      if (!refs_independent_p (group->ref, other->ref))
+	group->independent = other->independent = false;
+
+  while (groups)
+    {
+      group = groups;
+      groups = groups->next;
+
+      if (group->independent)
+	determine_lsm_ref (loop, exits, n_exits, group->ref, group->refs,
+			   sees_call);
+      free_mem_refs (group->refs);
+      free (group);
+    }
 }
 
 /* Checks whether LOOP (with N_EXITS exits stored in EXITS array) is suitable
@@ -1268,8 +1362,8 @@ determine_lsm (struct loops *loops)
   compute_immediate_uses (TDFA_USE_VOPS, NULL);
 
   /* Pass the loops from the outermost.  For each virtual operand loop phi node
-     check whether all the references inside the loop correspond to a single
-     address, and if so, move them.  */
+     split the references inside the loop by their address, and move those
+     whose address does not overlap with the others.  */
 
   loop = loops->tree_root->inner;
   while (1)
@@ -1641,8 +1641,7 @@ add_call_clobber_ops (tree stmt, tree callee)
 	 each static if the call being processed does not read or
 	 write that variable.  */
 
-      /* ??? Turn off the optimization until it gets fixed.  */
-      if (0 && callee)
+      if (callee)
 	{
 	  not_read_b = get_global_statics_not_read (callee);
 	  not_written_b = get_global_statics_not_written (callee);
@@ -50,10 +50,10 @@ Boston, MA 02111-1307, USA.  */
    1. Avail sets can be shared by making an avail_find_leader that
       walks up the dominator tree and looks in those avail sets.
       This might affect code optimality, it's unclear right now.
-   2. Load motion can be performed by value numbering the loads the
-      same as we do other expressions.  This requires iterative
-      hashing the vuses into the values.  Right now we simply assign
-      a new value every time we see a statement with a vuse.
+   2. Load motion only handles references whose address is computed
+      from a single SSA_NAME or from a decl, with invariant array
+      indices.  Variable indices would require translating more than
+      one operand of the reference through the PHIs.
    3. Strength reduction can be performed by anticipating expressions
       we can repair later on.
    4. Our canonicalization of expressions during lookups don't take
@@ -259,6 +259,11 @@ typedef struct bb_value_sets
      AVAIL_OUT set of blocks with the new insertions performed during
      the current iteration.  */
   bitmap_set_t new_sets;
+
+  /* True if the block contains a call.  The call may not return, so
+     loads are not anticipatable across it: hoisting one above the
+     call could introduce a trap.  */
+  bool contains_call;
 } *bb_value_sets_t;
 
 #define EXP_GEN(BB)	((bb_value_sets_t) ((BB)->aux))->exp_gen
@@ -267,6 +272,12 @@ typedef struct bb_value_sets
 #define AVAIL_OUT(BB)	((bb_value_sets_t) ((BB)->aux))->avail_out
 #define ANTIC_IN(BB)	((bb_value_sets_t) ((BB)->aux))->antic_in
 #define NEW_SETS(BB)	((bb_value_sets_t) ((BB)->aux))->new_sets
+#define CONTAINS_CALL(BB) ((bb_value_sets_t) ((BB)->aux))->contains_call
+
+/* The virtual operands of the load represented by the reference value
+   expression EXPR.  They are kept in the annotation of the value
+   expression, which is private to PRE.  */
+#define REFERENCE_VUSES(EXPR) ((vuse_optype) tree_ann (EXPR)->common.aux)
 
 /* This structure is used to keep track of statistics on what
    optimization PRE was able to perform.  */
@@ -280,6 +291,9 @@ static struct
 
   /* The number of new PHI nodes added by PRE.  */
   int phis;
+
+  /* The number of loads inserted by PRE.  */
+  int loads;
 } pre_stats;
 
 
@@ -305,7 +319,6 @@ static alloc_pool bitmap_set_pool;
 static alloc_pool value_set_node_pool;
 static alloc_pool binary_node_pool;
 static alloc_pool unary_node_pool;
-static alloc_pool reference_node_pool;
 static struct obstack grand_bitmap_obstack;
 
 /* Set of blocks with statements that have had its EH information
@@ -841,6 +854,116 @@ debug_value_set (value_set_t set, const char *setname, int blockindex)
   print_value_set (stderr, set, setname, blockindex);
 }
 
+/* Return true if REF is a memory reference whose loads PRE can move:
+   a chain of COMPONENT_REFs and ARRAY_REFs with invariant indices,
+   based either on a decl or on an INDIRECT_REF of a single name (an
+   SSA_NAME in the IL, or its VALUE_HANDLE in a value expression).
+   If BASE_P is not NULL, set it to the address of that name, or to
+   NULL if the reference is based on a decl.  */
+
+static bool
+pre_reference_p (tree ref, tree **base_p)
+{
+  if (base_p)
+    *base_p = NULL;
+
+  while (1)
+    switch (TREE_CODE (ref))
+      {
+      case COMPONENT_REF:
+	if (TREE_OPERAND (ref, 2))
+	  return false;
+	ref = TREE_OPERAND (ref, 0);
+	break;
+
+      case ARRAY_REF:
+	if (TREE_OPERAND (ref, 2)
+	    || TREE_OPERAND (ref, 3)
+	    || !is_gimple_min_invariant (TREE_OPERAND (ref, 1)))
+	  return false;
+	ref = TREE_OPERAND (ref, 0);
+	break;
+
+      case INDIRECT_REF:
+	if (TREE_CODE (TREE_OPERAND (ref, 0)) != SSA_NAME
+	    && TREE_CODE (TREE_OPERAND (ref, 0)) != VALUE_HANDLE)
+	  return false;
+	if (base_p)
+	  *base_p = &TREE_OPERAND (ref, 0);
+	return true;
+
+      case VAR_DECL:
+      case PARM_DECL:
+      case RESULT_DECL:
+	return true;
+
+      default:
+	return false;
+      }
+}
+
+/* Translate the virtual operands VUSES of a load through the PHI
+   nodes in PHIBLOCK, so that they describe the memory state at the
+   end of PRED.  Return VUSES itself if none of them is defined by a
+   PHI in PHIBLOCK.  */
+
+static vuse_optype
+translate_vuses_through_block (vuse_optype vuses, basic_block pred,
+			       basic_block phiblock)
+{
+  vuse_optype result = vuses;
+  size_t i;
+  int j;
+
+  for (i = 0; i < NUM_VUSES (vuses); i++)
+    {
+      tree phi = SSA_NAME_DEF_STMT (VUSE_OP (vuses, i));
+
+      if (TREE_CODE (phi) != PHI_NODE
+	  || bb_for_stmt (phi) != phiblock)
+	continue;
+
+      for (j = 0; j < PHI_NUM_ARGS (phi); j++)
+	if (PHI_ARG_EDGE (phi, j)->src == pred)
+	  {
+	    if (result == vuses)
+	      {
+		size_t size = (sizeof (struct vuse_optype_d)
+			       + (NUM_VUSES (vuses) - 1) * sizeof (tree));
+		result = obstack_alloc (&grand_bitmap_obstack, size);
+		memcpy (result, vuses, size);
+	      }
+	    SET_VUSE_OP (result, i, PHI_ARG_DEF (phi, j));
+	    break;
+	  }
+    }
+
+  return result;
+}
+
+/* Return true if one of the virtual operands VUSES is defined by a
+   statement in BLOCK, i.e. if the memory the load reads is clobbered
+   between the start of BLOCK and the load.  Definitions by PHI nodes
+   of BLOCK do not count, they are translated by phi_translate.  */
+
+static bool
+vuses_killed_in_block_p (vuse_optype vuses, basic_block block)
+{
+  size_t i;
+
+  for (i = 0; i < NUM_VUSES (vuses); i++)
+    {
+      tree def = SSA_NAME_DEF_STMT (VUSE_OP (vuses, i));
+
+      if (TREE_CODE (def) != PHI_NODE
+	  && !IS_EMPTY_STMT (def)
+	  && bb_for_stmt (def) == block)
+	return true;
+    }
+
+  return false;
+}
+
 /* Translate EXPR using phis in PHIBLOCK, so that it has the values of
    the phis in PRED.  Return NULL if we can't find a leader for each
    part of the translated expression.  */
@@ -866,8 +989,43 @@ phi_translate (tree expr, value_set_t set, basic_block pred,
   switch (TREE_CODE_CLASS (TREE_CODE (expr)))
     {
     case tcc_reference:
-      /* XXX: Until we have PRE of loads working, none will be ANTIC. */
-      return NULL;
+      {
+	tree *base_p;
+	tree oldbase = NULL;
+	tree newbase = NULL;
+	vuse_optype oldvuses = REFERENCE_VUSES (expr);
+	vuse_optype newvuses;
+	tree newexpr;
+
+	pre_reference_p (expr, &base_p);
+	if (base_p)
+	  {
+	    oldbase = *base_p;
+	    newbase = phi_translate (find_leader (set, oldbase),
+				     set, pred, phiblock);
+	    /* We need a name to dereference, an invariant address
+	       would give us an invalid INDIRECT_REF.  */
+	    if (newbase == NULL || is_gimple_min_invariant (newbase))
+	      return NULL;
+	    newbase = get_value_handle (newbase);
+	  }
+
+	newvuses = translate_vuses_through_block (oldvuses, pred, phiblock);
+	if (newbase != oldbase || newvuses != oldvuses)
+	  {
+	    newexpr = unshare_expr (expr);
+	    if (base_p)
+	      {
+		pre_reference_p (newexpr, &base_p);
+		*base_p = newbase;
+	      }
+	    get_tree_ann (newexpr)->common.aux = newvuses;
+	    vn_lookup_or_add (newexpr, newvuses);
+	    expr = newexpr;
+	    phi_trans_add (oldexpr, newexpr, pred);
+	  }
+      }
+      return expr;
 
     case tcc_binary:
       {
@@ -1042,9 +1200,11 @@ find_leader (value_set_t set, tree val)
   return NULL;
 }
 
-/* Determine if the expression EXPR is valid in SET.  This means that
-   we have a leader for each part of the expression (if it consists of
-   values), or the expression is an SSA_NAME.  
+/* Determine if the expression EXPR is valid in SET, the ANTIC_IN set
+   of BLOCK.  This means that we have a leader for each part of the
+   expression (if it consists of values), or the expression is an
+   SSA_NAME.  Loads are additionally invalid if the memory they read
+   is clobbered in BLOCK, or if BLOCK contains a call.
 
    NB:  We never should run into a case where we have SSA_NAME +
    SSA_NAME or SSA_NAME + value.  The sets valid_in_set is called on,
@@ -1052,7 +1212,7 @@ find_leader (value_set_t set, tree val)
    expression (IE VALUE1 + VALUE2)  */
 
 static bool
-valid_in_set (value_set_t set, tree expr)
+valid_in_set (value_set_t set, tree expr, basic_block block)
 {
   switch (TREE_CODE_CLASS (TREE_CODE (expr)))
     {
@@ -1070,8 +1230,15 @@ valid_in_set (value_set_t set, tree expr)
       }
 
     case tcc_reference:
-      /* XXX: Until PRE of loads works, no reference nodes are ANTIC.  */
-      return false;
+      {
+	tree *base_p;
+
+	if (CONTAINS_CALL (block)
+	    || vuses_killed_in_block_p (REFERENCE_VUSES (expr), block))
+	  return false;
+	pre_reference_p (expr, &base_p);
+	return !base_p || set_contains_value (set, *base_p);
+      }
 
     case tcc_exceptional:
       gcc_assert (TREE_CODE (expr) == SSA_NAME);
@@ -1083,12 +1250,12 @@ valid_in_set (value_set_t set, tree expr)
    }
 }
 
-/* Clean the set of expressions that are no longer valid in SET.  This
-   means expressions that are made up of values we have no leaders for
-   in SET.  */
+/* Clean the set of expressions that are no longer valid in SET, the
+   ANTIC_IN set of BLOCK.  This means expressions that are made up of
+   values we have no leaders for in SET, and loads killed in BLOCK.  */
 
 static void
-clean (value_set_t set)
+clean (value_set_t set, basic_block block)
 {
   value_set_node_t node;
   value_set_node_t next;
@@ -1096,7 +1263,7 @@ clean (value_set_t set)
   while (node)
     {
       next = node->next;
-      if (!valid_in_set (set, node->expr))	
+      if (!valid_in_set (set, node->expr, block))
 	set_remove (set, node->expr);
       node = next;
     }
@@ -1215,7 +1382,7 @@ compute_antic_aux (basic_block block)
     {
       value_insert_into_set (ANTIC_IN (block), node->expr);
     }
-  clean (ANTIC_IN (block));
+  clean (ANTIC_IN (block), block);
   
 
   if (!set_equal (old, ANTIC_IN (block)))
@@ -1370,6 +1537,40 @@ create_expression_by_pieces (basic_block block, tree expr, tree stmts)
 	tsi_link_after (&tsi, newexpr, TSI_CONTINUE_LINKING);
 	pre_stats.insertions++;
 
+	break;
+      }
+    case tcc_reference:
+      {
+	tree_stmt_iterator tsi;
+	tree *base_p;
+	tree temp, op;
+	ssa_op_iter iter;
+
+	newexpr = unshare_expr (expr);
+	pre_reference_p (newexpr, &base_p);
+	if (base_p)
+	  *base_p = find_or_generate_expression (block, *base_p, stmts);
+	temp = create_tmp_var (TREE_TYPE (expr), "pretmp");
+	add_referenced_tmp_var (temp);
+	newexpr = build (MODIFY_EXPR, TREE_TYPE (expr),
+			 temp, newexpr);
+	name = make_ssa_name (temp, newexpr);
+	TREE_OPERAND (newexpr, 0) = name;
+
+	/* The new load reads memory; have its virtual operands put into
+	   SSA form once we are done.  */
+	get_stmt_operands (newexpr);
+	FOR_EACH_SSA_TREE_OPERAND (op, newexpr, iter, SSA_OP_VUSE)
+	  {
+	    if (!DECL_P (op))
+	      op = SSA_NAME_VAR (op);
+	    bitmap_set_bit (vars_to_rename, var_ann (op)->uid);
+	  }
+
+	tsi = tsi_last (stmts);
+	tsi_link_after (&tsi, newexpr, TSI_CONTINUE_LINKING);
+	pre_stats.insertions++;
+	pre_stats.loads++;
 	break;
       }
     default:
@@ -1432,7 +1633,8 @@ insert_aux (basic_block block)
 		   node = node->next)
 		{
 		  if (BINARY_CLASS_P (node->expr)
-		      || UNARY_CLASS_P (node->expr))
+		      || UNARY_CLASS_P (node->expr)
+		      || REFERENCE_CLASS_P (node->expr))
 		    {
 		      tree *avail;
 		      tree val;
@@ -1534,7 +1736,8 @@ insert_aux (basic_block block)
 			      bprime = pred->src;
 			      eprime = avail[bprime->index];
 			      if (BINARY_CLASS_P (eprime)
-				  || UNARY_CLASS_P (eprime))
+				  || UNARY_CLASS_P (eprime)
+				  || REFERENCE_CLASS_P (eprime))
 				{
 				  builtexpr = create_expression_by_pieces (bprime,
 									   eprime,
@@ -1657,26 +1860,20 @@ add_to_sets (tree var, tree expr, vuse_optype vuses, bitmap_set_t s1,
 /* Given a unary or binary expression EXPR, create and return a new
    expression with the same structure as EXPR but with its operands
    replaced with the value handles of each of the operands of EXPR.
-   Insert EXPR's operands into the EXP_GEN set for BLOCK.
-
-   VUSES represent the virtual use operands associated with EXPR (if
-   any). They are used when computing the hash value for EXPR.  */
+   Insert EXPR's operands into the EXP_GEN set for BLOCK.  */
 
 static inline tree
-create_value_expr_from (tree expr, basic_block block, vuse_optype vuses)
+create_value_expr_from (tree expr, basic_block block)
 {
   int i;
   enum tree_code code = TREE_CODE (expr);
   tree vexpr;
 
   gcc_assert (TREE_CODE_CLASS (code) == tcc_unary
-	      || TREE_CODE_CLASS (code) == tcc_binary
-	      || TREE_CODE_CLASS (code) == tcc_reference);
+	      || TREE_CODE_CLASS (code) == tcc_binary);
 
   if (TREE_CODE_CLASS (code) == tcc_unary)
     vexpr = pool_alloc (unary_node_pool);
-  else if (TREE_CODE_CLASS (code) == tcc_reference)
-    vexpr = pool_alloc (reference_node_pool);
   else
     vexpr = pool_alloc (binary_node_pool);
 
@@ -1687,7 +1884,7 @@ create_value_expr_from (tree expr, basic_block block, vuse_optype vuses)
       tree op = TREE_OPERAND (expr, i);
       if (op != NULL)
 	{
-	  tree val = vn_lookup_or_add (op, vuses);
+	  tree val = vn_lookup_or_add (op, NULL);
 	  if (!is_undefined_value (op))
 	    value_insert_into_set (EXP_GEN (block), op);
 	  if (TREE_CODE (val) == VALUE_HANDLE)
@@ -1700,6 +1897,83 @@ create_value_expr_from (tree expr, basic_block block, vuse_optype vuses)
 }
 
 
+/* Given a memory reference EXPR accepted by pre_reference_p, create
+   and return a copy of it with the name its address is computed from
+   replaced by the value handle of that name.  Insert the name into
+   the EXP_GEN set for BLOCK.
+
+   VUSES represent the virtual use operands of the load of EXPR.  They
+   are remembered in the value expression, and used when computing the
+   hash value for it.  */
+
+static tree
+create_reference_value_expr_from (tree expr, basic_block block,
+				  vuse_optype vuses)
+{
+  tree vexpr = unshare_expr (expr);
+  tree *base_p;
+
+  pre_reference_p (vexpr, &base_p);
+  if (base_p)
+    {
+      tree op = *base_p;
+      tree val = vn_lookup_or_add (op, NULL);
+      if (!is_undefined_value (op))
+	value_insert_into_set (EXP_GEN (block), op);
+      *base_p = val;
+    }
+
+  get_tree_ann (vexpr)->common.aux = vuses;
+  return vexpr;
+}
+
+
+/* STMT stores an SSA_NAME or an invariant into a memory reference
+   accepted by pre_reference_p.  A load from that reference which sees
+   the memory state STMT creates yields the stored value, so enter the
+   reference into the value table with the value of the stored operand
+   and the results of STMT's virtual definitions as its VUSES.  This
+   makes later loads of the reference redundant with the store.  */
+
+static void
+record_store_value (tree stmt, basic_block block)
+{
+  tree lhs = TREE_OPERAND (stmt, 0);
+  tree rhs = TREE_OPERAND (stmt, 1);
+  v_may_def_optype v_may_defs = STMT_V_MAY_DEF_OPS (stmt);
+  v_must_def_optype v_must_defs = STMT_V_MUST_DEF_OPS (stmt);
+  size_t n_may = NUM_V_MAY_DEFS (v_may_defs);
+  size_t n_must = NUM_V_MUST_DEFS (v_must_defs);
+  vuse_optype vuses;
+  tree vexpr;
+  size_t i;
+
+  /* A store into a bit-field truncates the stored value, so a load of
+     the field does not yield it.  Do as DOM does and record nothing
+     (gcc.c-torture/execute/921016-1.c).  */
+  if (n_may + n_must == 0
+      || (TREE_CODE (lhs) == COMPONENT_REF
+	  && DECL_BIT_FIELD (TREE_OPERAND (lhs, 1)))
+      || (TREE_CODE (rhs) == SSA_NAME
+	  && SSA_NAME_OCCURS_IN_ABNORMAL_PHI (rhs))
+      || !lang_hooks.types_compatible_p (TREE_TYPE (lhs), TREE_TYPE (rhs)))
+    return;
+
+  vuses = obstack_alloc (&grand_bitmap_obstack,
+			 sizeof (struct vuse_optype_d)
+			 + (n_may + n_must - 1) * sizeof (tree));
+  vuses->num_vuses = n_may + n_must;
+  for (i = 0; i < n_may; i++)
+    SET_VUSE_OP (vuses, i, V_MAY_DEF_RESULT (v_may_defs, i));
+  for (i = 0; i < n_must; i++)
+    SET_VUSE_OP (vuses, n_may + i, V_MUST_DEF_RESULT (v_must_defs, i));
+
+  vexpr = create_reference_value_expr_from (lhs, block, vuses);
+  if (vn_lookup (vexpr, vuses) == NULL)
+    vn_add (vexpr, vn_lookup_or_add (rhs, NULL), vuses);
+}
+
+
 /* Compute the AVAIL set for BLOCK.
    This function performs value numbering of the statements in BLOCK. 
    The AVAIL sets are built from information we glean while doing this
@@ -1764,6 +2038,9 @@ compute_avail (basic_block block)
 	  ann = stmt_ann (stmt);
 	  get_stmt_operands (stmt);
 
+	  if (get_call_expr_in (stmt))
+	    CONTAINS_CALL (block) = true;
+
 	  /* We are only interested in assignments of the form
 	     X_i = EXPR, where EXPR represents an "interesting"
 	     computation, it has no volatile operands and X_i
@@ -1792,20 +2069,37 @@ compute_avail (basic_block block)
 		    value_insert_into_set (EXP_GEN (block), rhs);
 		  continue;
 		}	   
-	      else if (UNARY_CLASS_P (rhs) || BINARY_CLASS_P (rhs)
-		       || TREE_CODE (rhs) == INDIRECT_REF)
+	      else if (UNARY_CLASS_P (rhs) || BINARY_CLASS_P (rhs))
 		{
-		  /* For binary, unary, and reference expressions,
-		     create a duplicate expression with the operands
-		     replaced with the value handles of the original
-		     RHS.  */
-		  tree newt = create_value_expr_from (rhs, block, vuses);
+		  /* For binary and unary expressions, create a
+		     duplicate expression with the operands replaced
+		     with the value handles of the original RHS.  */
+		  tree newt = create_value_expr_from (rhs, block);
+		  add_to_sets (lhs, newt, vuses, TMP_GEN (block),
+			       AVAIL_OUT (block));
+		  value_insert_into_set (EXP_GEN (block), newt);
+		  continue;
+		}
+	      else if (REFERENCE_CLASS_P (rhs)
+		       && pre_reference_p (rhs, NULL))
+		{
+		  /* For loads, the value depends on the address and on
+		     the memory state, which the VUSES describe.  */
+		  tree newt = create_reference_value_expr_from (rhs, block,
+								vuses);
 		  add_to_sets (lhs, newt, vuses, TMP_GEN (block),
 			       AVAIL_OUT (block));
 		  value_insert_into_set (EXP_GEN (block), newt);
 		  continue;
 		}
 	    }
+	  else if (TREE_CODE (stmt) == MODIFY_EXPR
+		   && !ann->has_volatile_ops
+		   && (TREE_CODE (TREE_OPERAND (stmt, 1)) == SSA_NAME
+		       || is_gimple_min_invariant (TREE_OPERAND (stmt, 1)))
+		   && REFERENCE_CLASS_P (TREE_OPERAND (stmt, 0))
+		   && pre_reference_p (TREE_OPERAND (stmt, 0), NULL))
+	    record_store_value (stmt, block);
 
 	  /* For any other statement that we don't recognize, simply
 	     make the names generated by the statement available in
@@ -1940,8 +2234,6 @@ init_pre (void)
 				        tree_code_size (PLUS_EXPR), 30);
   unary_node_pool = create_alloc_pool ("Unary tree nodes",
 				       tree_code_size (NEGATE_EXPR), 30);
-  reference_node_pool = create_alloc_pool ("Reference tree nodes",
-					   tree_code_size (COMPONENT_REF), 30);
   FOR_ALL_BB (bb)
     {
       EXP_GEN (bb) = set_new (true);
@@ -1969,7 +2261,6 @@ fini_pre (void)
   free_alloc_pool (bitmap_set_pool);
   free_alloc_pool (value_set_node_pool);
   free_alloc_pool (binary_node_pool);
-  free_alloc_pool (reference_node_pool);
   free_alloc_pool (unary_node_pool);
   htab_delete (phi_translate_table);
   remove_fake_exit_edges ();
@@ -2051,6 +2342,7 @@ execute_pre (bool do_fre)
     {
       fprintf (dump_file, "Insertions:%d\n", pre_stats.insertions);
       fprintf (dump_file, "New PHIs:%d\n", pre_stats.phis);
+      fprintf (dump_file, "Inserted loads:%d\n", pre_stats.loads);
       fprintf (dump_file, "Eliminated:%d\n", pre_stats.eliminations);
     }
 
@@ -2086,7 +2378,8 @@ struct tree_opt_pass pass_pre =
   0,					/* properties_provided */
   0,					/* properties_destroyed */
   0,					/* todo_flags_start */
-  TODO_dump_func | TODO_ggc_collect | TODO_verify_ssa, /* todo_flags_finish */
+  TODO_rename_vars | TODO_dump_func
+    | TODO_ggc_collect | TODO_verify_ssa, /* todo_flags_finish */
   0					/* letter */
 };
 
@@ -84,6 +84,208 @@ struct unw_eh_frame_hdr
   unsigned char table_enc;
 };
 
+/* FDPIC load bases are not a single address, so we do not cache them.  */
+#ifndef __FRV_FDPIC__
+
+/* Newer glibc passes these two counters after the fields of struct
+   dl_phdr_info we otherwise use.  They count the objects loaded and
+   unloaded so far, so as long as they do not change, program headers
+   found earlier are still valid.  */
+
+struct ext_dl_phdr_info
+{
+  ElfW(Addr) dlpi_addr;
+  const char *dlpi_name;
+  const ElfW(Phdr) *dlpi_phdr;
+  ElfW(Half) dlpi_phnum;
+  unsigned long long int dlpi_adds;
+  unsigned long long int dlpi_subs;
+};
+
+/* A cache of the segments in which we recently found a PC, and of the
+   headers we need to search the unwind info of their object.  Without
+   it every frame of every throw walks the program headers of all the
+   loaded objects with the loader lock held.  The entries are chained
+   in most recently used order.  The cache is protected by
+   frame_hdr_cache_mutex, which is never held across a call to
+   dl_iterate_phdr, so that a lookup that hits does not wait for the
+   loader lock longer than it takes to read the two counters.  */
+
+#define FRAME_HDR_CACHE_SIZE 8
+
+static struct frame_hdr_cache_element
+{
+  _Unwind_Ptr pc_low;
+  _Unwind_Ptr pc_high;
+  _Unwind_Ptr load_base;
+  const ElfW(Phdr) *p_eh_frame_hdr;
+  const ElfW(Phdr) *p_dynamic;
+  struct frame_hdr_cache_element *link;
+} frame_hdr_cache[FRAME_HDR_CACHE_SIZE];
+
+static struct frame_hdr_cache_element *frame_hdr_cache_head;
+
+/* The values of dlpi_adds and dlpi_subs the cache is valid for.  */
+static unsigned long long int frame_hdr_cache_adds = -1ULL;
+static unsigned long long int frame_hdr_cache_subs;
+
+#ifdef __GTHREAD_MUTEX_INIT
+static __gthread_mutex_t frame_hdr_cache_mutex = __GTHREAD_MUTEX_INIT;
+#else
+static __gthread_mutex_t frame_hdr_cache_mutex;
+#endif
+
+#ifdef __GTHREAD_MUTEX_INIT_FUNCTION
+static void
+init_frame_hdr_cache_mutex (void)
+{
+  __GTHREAD_MUTEX_INIT_FUNCTION (&frame_hdr_cache_mutex);
+}
+
+static void
+init_frame_hdr_cache_mutex_once (void)
+{
+  static __gthread_once_t once = __GTHREAD_ONCE_INIT;
+  __gthread_once (&once, init_frame_hdr_cache_mutex);
+}
+#else
+#define init_frame_hdr_cache_mutex_once()
+#endif
+
+/* The counters of loaded and unloaded objects, as read by
+   _Unwind_PhdrCountsCallback.  */
+
+struct unw_phdr_counts
+{
+  unsigned long long int adds;
+  unsigned long long int subs;
+};
+
+/* Look for the segment containing PC in the cache.  On a hit, copy the
+   entry to *ENTRY, the counters the cache is valid for to *COUNTS, and
+   make the entry the most recently used one.  */
+
+static int
+frame_hdr_cache_lookup (_Unwind_Ptr pc,
+			struct frame_hdr_cache_element *entry,
+			struct unw_phdr_counts *counts)
+{
+  struct frame_hdr_cache_element *cache_entry;
+  struct frame_hdr_cache_element *prev_cache_entry = NULL;
+  int found = 0;
+
+  init_frame_hdr_cache_mutex_once ();
+  __gthread_mutex_lock (&frame_hdr_cache_mutex);
+
+  for (cache_entry = frame_hdr_cache_head;
+       cache_entry;
+       cache_entry = cache_entry->link)
+    {
+      if (pc >= cache_entry->pc_low && pc < cache_entry->pc_high)
+	{
+	  *entry = *cache_entry;
+	  counts->adds = frame_hdr_cache_adds;
+	  counts->subs = frame_hdr_cache_subs;
+	  found = 1;
+
+	  /* Move the entry we are using to the head.  */
+	  if (cache_entry != frame_hdr_cache_head)
+	    {
+	      prev_cache_entry->link = cache_entry->link;
+	      cache_entry->link = frame_hdr_cache_head;
+	      frame_hdr_cache_head = cache_entry;
+	    }
+	  break;
+	}
+
+      /* Stop at the first unused entry.  */
+      if ((cache_entry->pc_low | cache_entry->pc_high) == 0)
+	break;
+      prev_cache_entry = cache_entry;
+    }
+
+  __gthread_mutex_unlock (&frame_hdr_cache_mutex);
+  return found;
+}
+
+/* Remember that the segment [PC_LOW, PC_HIGH) of the object loaded at
+   LOAD_BASE has the headers P_EH_FRAME_HDR and P_DYNAMIC, replacing the
+   least recently used entry.  COUNTS are the current counters of loaded
+   and unloaded objects; if they changed, the cache is emptied first.  */
+
+static void
+frame_hdr_cache_insert (const struct unw_phdr_counts *counts,
+			_Unwind_Ptr pc_low, _Unwind_Ptr pc_high,
+			_Unwind_Ptr load_base,
+			const ElfW(Phdr) *p_eh_frame_hdr,
+			const ElfW(Phdr) *p_dynamic)
+{
+  struct frame_hdr_cache_element *cache_entry;
+  struct frame_hdr_cache_element *prev_cache_entry = NULL;
+  int n;
+
+  init_frame_hdr_cache_mutex_once ();
+  __gthread_mutex_lock (&frame_hdr_cache_mutex);
+
+  if (counts->adds != frame_hdr_cache_adds
+      || counts->subs != frame_hdr_cache_subs)
+    {
+      /* An object was loaded or unloaded.  Start over with an empty
+	 cache, chained in array order.  */
+      for (n = 0; n < FRAME_HDR_CACHE_SIZE; n++)
+	{
+	  frame_hdr_cache[n].pc_low = 0;
+	  frame_hdr_cache[n].pc_high = 0;
+	  frame_hdr_cache[n].link = &frame_hdr_cache[n + 1];
+	}
+      frame_hdr_cache[FRAME_HDR_CACHE_SIZE - 1].link = NULL;
+      frame_hdr_cache_head = &frame_hdr_cache[0];
+      frame_hdr_cache_adds = counts->adds;
+      frame_hdr_cache_subs = counts->subs;
+    }
+
+  for (cache_entry = frame_hdr_cache_head;
+       cache_entry->link;
+       cache_entry = cache_entry->link)
+    prev_cache_entry = cache_entry;
+
+  if (prev_cache_entry != NULL)
+    {
+      prev_cache_entry->link = NULL;
+      cache_entry->link = frame_hdr_cache_head;
+      frame_hdr_cache_head = cache_entry;
+    }
+
+  cache_entry->pc_low = pc_low;
+  cache_entry->pc_high = pc_high;
+  cache_entry->load_base = load_base;
+  cache_entry->p_eh_frame_hdr = p_eh_frame_hdr;
+  cache_entry->p_dynamic = p_dynamic;
+
+  __gthread_mutex_unlock (&frame_hdr_cache_mutex);
+}
+
+/* Read the counters of loaded and unloaded objects into the struct
+   unw_phdr_counts PTR.  They are the same for every object, so stop
+   at the first one.  */
+
+static int
+_Unwind_PhdrCountsCallback (struct dl_phdr_info *info, size_t size,
+			    void *ptr)
+{
+  struct unw_phdr_counts *counts = (struct unw_phdr_counts *) ptr;
+  struct ext_dl_phdr_info *einfo = (struct ext_dl_phdr_info *) info;
+
+  if (size < sizeof (struct ext_dl_phdr_info))
+    return -1;
+
+  counts->adds = einfo->dlpi_adds;
+  counts->subs = einfo->dlpi_subs;
+  return 1;
+}
+
+#endif /* !__FRV_FDPIC__ */
+
 /* Like base_of_encoded_value, but take the base from a struct
    unw_eh_callback_data instead of an _Unwind_Context.  */
 
@@ -108,57 +310,30 @@ base_from_cb_data (unsigned char encoding, struct unw_eh_callback_data *data)
   abort ();
 }
 
-static int
-_Unwind_IteratePhdrCallback (struct dl_phdr_info *info, size_t size, void *ptr)
-{
-  struct unw_eh_callback_data *data = (struct unw_eh_callback_data *) ptr;
-  const ElfW(Phdr) *phdr, *p_eh_frame_hdr, *p_dynamic;
-  long n, match;
+/* Search the unwind info of the object loaded at LOAD_BASE, whose
+   PT_GNU_EH_FRAME and PT_DYNAMIC headers are P_EH_FRAME_HDR and
+   P_DYNAMIC, for the FDE of DATA->pc, and store the result in DATA.  */
+
+static void
+search_eh_frame_hdr (struct unw_eh_callback_data *data,
 #ifdef __FRV_FDPIC__
-  struct elf32_fdpic_loadaddr load_base;
+		     struct elf32_fdpic_loadaddr load_base,
 #else
-  _Unwind_Ptr load_base;
+		     _Unwind_Ptr load_base,
 #endif
+		     const ElfW(Phdr) *p_eh_frame_hdr,
+		     const ElfW(Phdr) *p_dynamic)
+{
   const unsigned char *p;
   const struct unw_eh_frame_hdr *hdr;
   _Unwind_Ptr eh_frame;
   struct object ob;
 
-  /* Make sure struct dl_phdr_info is at least as big as we need.  */
-  if (size < offsetof (struct dl_phdr_info, dlpi_phnum)
-	     + sizeof (info->dlpi_phnum))
-    return -1;
-
-  match = 0;
-  phdr = info->dlpi_phdr;
-  load_base = info->dlpi_addr;
-  p_eh_frame_hdr = NULL;
-  p_dynamic = NULL;
-
-  /* See if PC falls into one of the loaded segments.  Find the eh_frame
-     segment at the same time.  */
-  for (n = info->dlpi_phnum; --n >= 0; phdr++)
-    {
-      if (phdr->p_type == PT_LOAD)
-	{
-	  _Unwind_Ptr vaddr = (_Unwind_Ptr)
-	    __RELOC_POINTER (phdr->p_vaddr, load_base);
-	  if (data->pc >= vaddr && data->pc < vaddr + phdr->p_memsz)
-	    match = 1;
-	}
-      else if (phdr->p_type == PT_GNU_EH_FRAME)
-	p_eh_frame_hdr = phdr;
-      else if (phdr->p_type == PT_DYNAMIC)
-	p_dynamic = phdr;
-    }
-  if (!match || !p_eh_frame_hdr)
-    return 0;
-
   /* Read .eh_frame_hdr header.  */
   hdr = (const struct unw_eh_frame_hdr *)
     __RELOC_POINTER (p_eh_frame_hdr->p_vaddr, load_base);
   if (hdr->version != 1)
-    return 1;
+    return;
 
 #ifdef CRT_GET_RFIB_DATA
 # ifdef __i386__
@@ -204,7 +379,7 @@ _Unwind_IteratePhdrCallback (struct dl_phdr_info *info, size_t size, void *ptr)
 					p, &fde_count);
       /* Shouldn't happen.  */
       if (fde_count == 0)
-	return 1;
+	return;
       if ((((_Unwind_Ptr) p) & 3) == 0)
 	{
 	  struct fde_table {
@@ -220,7 +395,7 @@ _Unwind_IteratePhdrCallback (struct dl_phdr_info *info, size_t size, void *ptr)
 
 	  mid = fde_count - 1;
 	  if (data->pc < table[0].initial_loc + data_base)
-	    return 1;
+	    return;
 	  else if (data->pc < table[mid].initial_loc + data_base)
 	    {
 	      lo = 0;
@@ -249,7 +424,7 @@ _Unwind_IteratePhdrCallback (struct dl_phdr_info *info, size_t size, void *ptr)
 	  if (data->pc < table[mid].initial_loc + data_base + range)
 	    data->ret = f;
 	  data->func = (void *) (table[mid].initial_loc + data_base);
-	  return 1;
+	  return;
 	}
     }
 
@@ -271,6 +446,74 @@ _Unwind_IteratePhdrCallback (struct dl_phdr_info *info, size_t size, void *ptr)
 				    data->ret->pc_begin,
 				    (_Unwind_Ptr *)&data->func);
     }
+}
+
+static int
+_Unwind_IteratePhdrCallback (struct dl_phdr_info *info, size_t size, void *ptr)
+{
+  struct unw_eh_callback_data *data = (struct unw_eh_callback_data *) ptr;
+  const ElfW(Phdr) *phdr, *p_eh_frame_hdr, *p_dynamic;
+  long n, match;
+#ifdef __FRV_FDPIC__
+  struct elf32_fdpic_loadaddr load_base;
+#else
+  _Unwind_Ptr load_base;
+#endif
+#ifdef FRAME_HDR_CACHE_SIZE
+  _Unwind_Ptr pc_low = 0, pc_high = 0;
+#endif
+
+  /* Make sure struct dl_phdr_info is at least as big as we need.  */
+  if (size < offsetof (struct dl_phdr_info, dlpi_phnum)
+	     + sizeof (info->dlpi_phnum))
+    return -1;
+
+  match = 0;
+  phdr = info->dlpi_phdr;
+  load_base = info->dlpi_addr;
+  p_eh_frame_hdr = NULL;
+  p_dynamic = NULL;
+
+  /* See if PC falls into one of the loaded segments.  Find the eh_frame
+     segment at the same time.  */
+  for (n = info->dlpi_phnum; --n >= 0; phdr++)
+    {
+      if (phdr->p_type == PT_LOAD)
+	{
+	  _Unwind_Ptr vaddr = (_Unwind_Ptr)
+	    __RELOC_POINTER (phdr->p_vaddr, load_base);
+	  if (data->pc >= vaddr && data->pc < vaddr + phdr->p_memsz)
+	    {
+	      match = 1;
+#ifdef FRAME_HDR_CACHE_SIZE
+	      pc_low = vaddr;
+	      pc_high = vaddr + phdr->p_memsz;
+#endif
+	    }
+	}
+      else if (phdr->p_type == PT_GNU_EH_FRAME)
+	p_eh_frame_hdr = phdr;
+      else if (phdr->p_type == PT_DYNAMIC)
+	p_dynamic = phdr;
+    }
+  if (!match || !p_eh_frame_hdr)
+    return 0;
+
+#ifdef FRAME_HDR_CACHE_SIZE
+  /* Remember the segment for the next lookups.  */
+  if (size >= sizeof (struct ext_dl_phdr_info))
+    {
+      struct ext_dl_phdr_info *einfo = (struct ext_dl_phdr_info *) info;
+      struct unw_phdr_counts counts;
+
+      counts.adds = einfo->dlpi_adds;
+      counts.subs = einfo->dlpi_subs;
+      frame_hdr_cache_insert (&counts, pc_low, pc_high, load_base,
+			      p_eh_frame_hdr, p_dynamic);
+    }
+#endif
+
+  search_eh_frame_hdr (data, load_base, p_eh_frame_hdr, p_dynamic);
   return 1;
 }
 
@@ -279,6 +522,10 @@ _Unwind_Find_FDE (void *pc, struct dwarf_eh_bases *bases)
 {
   struct unw_eh_callback_data data;
   const fde *ret;
+#ifdef FRAME_HDR_CACHE_SIZE
+  struct frame_hdr_cache_element entry;
+  struct unw_phdr_counts cached, current;
+#endif
 
   ret = _Unwind_Find_registered_FDE (pc, bases);
   if (ret != NULL)
@@ -290,6 +537,20 @@ _Unwind_Find_FDE (void *pc, struct dwarf_eh_bases *bases)
   data.func = NULL;
   data.ret = NULL;
 
+#ifdef FRAME_HDR_CACHE_SIZE
+  /* If the cache knows the segment PC is in, and no object was loaded
+     or unloaded since, search its unwind info directly.  Checking the
+     counters only needs the first object from dl_iterate_phdr.  An
+     object cannot be unloaded while we unwind through its code, so the
+     headers stay valid after the loader lock is released.  */
+  if (frame_hdr_cache_lookup (data.pc, &entry, &cached)
+      && dl_iterate_phdr (_Unwind_PhdrCountsCallback, &current) > 0
+      && current.adds == cached.adds
+      && current.subs == cached.subs)
+    search_eh_frame_hdr (&data, entry.load_base, entry.p_eh_frame_hdr,
+			 entry.p_dynamic);
+  else
+#endif
   if (dl_iterate_phdr (_Unwind_IteratePhdrCallback, &data) < 0)
     return NULL;
 
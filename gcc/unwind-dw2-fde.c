@@ -48,6 +48,14 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 static struct object *unseen_objects;
 static struct object *seen_objects;
 
+/* Nonzero once any object has been registered.  On targets that find
+   unwind info through the program headers nothing is usually ever
+   registered, and this lets _Unwind_Find_FDE avoid object_mutex on
+   every frame of every throw.  The flag is only ever set, and it is
+   written before the registered code can run: a thread unwinding
+   through an object's code has necessarily seen its registration.  */
+static int any_objects_registered;
+
 #ifdef __GTHREAD_MUTEX_INIT
 static __gthread_mutex_t object_mutex = __GTHREAD_MUTEX_INIT;
 #else
@@ -96,6 +104,7 @@ __register_frame_info_bases (const void *begin, struct object *ob,
 
   ob->next = unseen_objects;
   unseen_objects = ob;
+  any_objects_registered = 1;
 
   __gthread_mutex_unlock (&object_mutex);
 }
@@ -140,6 +149,7 @@ __register_frame_info_table_bases (void *begin, struct object *ob,
 
   ob->next = unseen_objects;
   unseen_objects = ob;
+  any_objects_registered = 1;
 
   __gthread_mutex_unlock (&object_mutex);
 }
@@ -976,6 +986,9 @@ _Unwind_Find_FDE (void *pc, struct dwarf_eh_bases *bases)
   struct object *ob;
   const fde *f = NULL;
 
+  if (!any_objects_registered)
+    return NULL;
+
   init_object_mutex_once ();
   __gthread_mutex_lock (&object_mutex);
 
@@ -945,6 +945,89 @@ execute_cfa_program (const unsigned char *insn_ptr,
     }
 }
 
+/* Decoding the CIE and FDE of a frame is much more expensive than finding
+   them, and the same few frames tend to be unwound over and over: once in
+   phase 1 and once in phase 2 of every throw, and by every throw through
+   the same call chain.  So we keep a small per-thread cache of decoded
+   frame states, indexed by return address.  An entry is only used when
+   the FDE and function start found for the return address are the ones
+   it was decoded from.  */
+
+#define FRAME_STATE_CACHE_SIZE 16
+
+struct frame_state_cache_entry
+{
+  void *ra;
+  const struct dwarf_fde *fde;
+  void *func;
+  void *lsda;
+  _Unwind_Word args_size;
+  _Unwind_FrameState fs;
+};
+
+struct frame_state_cache
+{
+  struct frame_state_cache_entry entries[FRAME_STATE_CACHE_SIZE];
+};
+
+static struct frame_state_cache frame_state_cache_static;
+
+#if __GTHREADS
+static __gthread_key_t frame_state_cache_key;
+static int use_frame_state_cache_key = -1;
+
+static void
+frame_state_cache_key_init (void)
+{
+  use_frame_state_cache_key
+    = __gthread_key_create (&frame_state_cache_key, free) == 0;
+}
+
+static void
+frame_state_cache_key_init_once (void)
+{
+  static __gthread_once_t once = __GTHREAD_ONCE_INIT;
+  if (__gthread_once (&once, frame_state_cache_key_init) != 0
+      || use_frame_state_cache_key < 0)
+    use_frame_state_cache_key = 0;
+}
+#endif
+
+/* Return the frame state cache of the calling thread, or NULL if we
+   could not allocate one.  */
+
+static struct frame_state_cache *
+get_frame_state_cache (void)
+{
+#if __GTHREADS
+  if (__gthread_active_p ())
+    {
+      struct frame_state_cache *cache;
+
+      if (use_frame_state_cache_key < 0)
+	frame_state_cache_key_init_once ();
+      if (!use_frame_state_cache_key)
+	return NULL;
+
+      cache = __gthread_getspecific (frame_state_cache_key);
+      if (cache == NULL)
+	{
+	  cache = malloc (sizeof (struct frame_state_cache));
+	  if (cache == NULL)
+	    return NULL;
+	  memset (cache, 0, sizeof (struct frame_state_cache));
+	  if (__gthread_setspecific (frame_state_cache_key, cache) != 0)
+	    {
+	      free (cache);
+	      return NULL;
+	    }
+	}
+      return cache;
+    }
+#endif
+  return &frame_state_cache_static;
+}
+
 /* Given the _Unwind_Context CONTEXT for a stack frame, look up the FDE for
    its caller and decode it into FS.  This function also sets the
    args_size and lsda members of CONTEXT, as they are really information
@@ -956,6 +1039,8 @@ uw_frame_state_for (struct _Unwind_Context *context, _Unwind_FrameState *fs)
   const struct dwarf_fde *fde;
   const struct dwarf_cie *cie;
   const unsigned char *aug, *insn, *end;
+  struct frame_state_cache *cache;
+  struct frame_state_cache_entry *entry = NULL;
 
   memset (fs, 0, sizeof (*fs));
   context->args_size = 0;
@@ -977,6 +1062,22 @@ uw_frame_state_for (struct _Unwind_Context *context, _Unwind_FrameState *fs)
 #endif
     }
 
+  cache = get_frame_state_cache ();
+  if (cache)
+    {
+      entry = &cache->entries[((_Unwind_Ptr) context->ra >> 2)
+			      % FRAME_STATE_CACHE_SIZE];
+      if (entry->ra == context->ra
+	  && entry->fde == fde
+	  && entry->func == context->bases.func)
+	{
+	  *fs = entry->fs;
+	  context->lsda = entry->lsda;
+	  context->args_size = entry->args_size;
+	  return _URC_NO_REASON;
+	}
+    }
+
   fs->pc = context->bases.func;
 
   cie = get_cie (fde);
@@ -1009,6 +1110,20 @@ uw_frame_state_for (struct _Unwind_Context *context, _Unwind_FrameState *fs)
   end = (unsigned char *) next_fde (fde);
   execute_cfa_program (insn, end, context, fs);
 
+  if (entry)
+    {
+      /* Invalidate the entry while it is being filled in.  */
+      entry->ra = 0;
+      entry->fde = fde;
+      entry->func = context->bases.func;
+      entry->lsda = context->lsda;
+      entry->args_size = context->args_size;
+      entry->fs = *fs;
+      /* The remember_state stack lived in execute_cfa_program.  */
+      entry->fs.regs.prev = NULL;
+      entry->ra = context->ra;
+    }
+
   return _URC_NO_REASON;
 }
 
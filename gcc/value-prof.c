@@ -34,6 +34,11 @@ Software Foundation, 59 Temple Place - Suite 330, Boston, MA
 #include "optabs.h"
 #include "regs.h"
 #include "ggc.h"
+#include "tree.h"
+#include "tree-flow.h"
+#include "tree-gimple.h"
+#include "diagnostic.h"
+#include "cgraph.h"
 
 static struct value_prof_hooks *value_prof_hooks;
 
@@ -1008,7 +1013,7 @@ struct value_prof_hooks {
   bool (*value_profile_transformations) (void);  
 };
 
-/* Hooks for RTL-based versions (the only ones that currently work).  */
+/* Hooks for RTL-based versions.  */
 static struct value_prof_hooks rtl_value_prof_hooks =
 {
   rtl_find_values_to_profile,
@@ -1023,17 +1028,610 @@ rtl_register_value_prof_hooks (void)
     abort ();
 }
 
-/* Tree-based versions are stubs for now.  */
+/* Tree based versions.  The histograms of the function being compiled;
+   the transformations consume them right after branch_prob has read them
+   in, within pass_tree_profile.  */
+static histogram_values tree_histograms;
+
+/* Allocate a histogram of TYPE measuring VALUE before STMT and add it to
+   VALUES.  */
+static histogram_value
+tree_new_histogram (histogram_values *values, enum hist_type type,
+		    tree value, tree stmt)
+{
+  histogram_value hist = ggc_alloc_cleared (sizeof (*hist));
+
+  hist->value = value;
+  hist->mode = TYPE_MODE (TREE_TYPE (value));
+  hist->insn = stmt;
+  hist->type = type;
+  VEC_safe_push (histogram_value, *values, hist);
+  return hist;
+}
+
+/* Return the string operation CALL performs when it is a block copy or
+   clear whose size is worth specializing, and store the position of the
+   size argument to *SIZE_ARG.  Return END_BUILTINS otherwise.  */
+static enum built_in_function
+tree_stringop_code (tree call, int *size_arg)
+{
+  tree fndecl = get_callee_fndecl (call);
+
+  if (!fndecl || DECL_BUILT_IN_CLASS (fndecl) != BUILT_IN_NORMAL)
+    return END_BUILTINS;
+
+  switch (DECL_FUNCTION_CODE (fndecl))
+    {
+    case BUILT_IN_MEMCPY:
+    case BUILT_IN_MEMPCPY:
+    case BUILT_IN_MEMSET:
+      *size_arg = 2;
+      return DECL_FUNCTION_CODE (fndecl);
+
+    case BUILT_IN_BZERO:
+      *size_arg = 1;
+      return DECL_FUNCTION_CODE (fndecl);
+
+    default:
+      return END_BUILTINS;
+    }
+}
+
+/* Return the address called by the indirect CALL, or NULL_TREE when CALL
+   is a direct call.  */
+static tree
+tree_indirect_call_target (tree call)
+{
+  tree fn = TREE_OPERAND (call, 0);
+
+  if (TREE_CODE (fn) == OBJ_TYPE_REF)
+    fn = OBJ_TYPE_REF_EXPR (fn);
+  if (TREE_CODE (fn) == ADDR_EXPR
+      && TREE_CODE (TREE_OPERAND (fn, 0)) == FUNCTION_DECL)
+    return NULL_TREE;
+  return fn;
+}
+
+/* Find values inside STMT for that we want to measure histograms and store
+   them to VALUES.  */
+static void
+tree_values_to_profile (tree stmt, histogram_values *values)
+{
+  histogram_value hist;
+  tree op, call, arg;
+  int size_arg, i;
+
+  if (!flag_value_profile_transformations)
+    return;
+
+  call = get_call_expr_in (stmt);
+  if (call)
+    {
+      /* Indirect call targets.  */
+      arg = tree_indirect_call_target (call);
+      if (arg)
+	{
+	  tree_new_histogram (values, HIST_TYPE_INDIR_CALL, arg, stmt);
+	  return;
+	}
+
+      /* Sizes of block copies and clears.  */
+      if (tree_stringop_code (call, &size_arg) != END_BUILTINS)
+	{
+	  for (arg = TREE_OPERAND (call, 1), i = 0;
+	       arg && i < size_arg;
+	       arg = TREE_CHAIN (arg), i++)
+	    continue;
+	  if (arg && !TREE_CONSTANT (TREE_VALUE (arg)))
+	    tree_new_histogram (values, HIST_TYPE_SINGLE_VALUE,
+				TREE_VALUE (arg), stmt);
+	}
+      return;
+    }
+
+  if (TREE_CODE (stmt) != MODIFY_EXPR)
+    return;
+
+  /* Divisors.  */
+  op = TREE_OPERAND (stmt, 1);
+  if (!INTEGRAL_TYPE_P (TREE_TYPE (op)))
+    return;
+
+  switch (TREE_CODE (op))
+    {
+    case TRUNC_DIV_EXPR:
+    case TRUNC_MOD_EXPR:
+      if (TREE_CONSTANT (TREE_OPERAND (op, 1)))
+	return;
+
+      /* Check for a special case where the divisor is power of 2.  */
+      if (TREE_CODE (op) == TRUNC_MOD_EXPR && TYPE_UNSIGNED (TREE_TYPE (op)))
+	{
+	  hist = tree_new_histogram (values, HIST_TYPE_POW2,
+				     TREE_OPERAND (op, 1), stmt);
+	  hist->hdata.pow2.may_be_other = 1;
+	}
+
+      /* Check whether the divisor is not in fact a constant.  */
+      tree_new_histogram (values, HIST_TYPE_SINGLE_VALUE,
+			  TREE_OPERAND (op, 1), stmt);
+      return;
+
+    default:
+      return;
+    }
+}
+
+/* Find list of values for that we want to measure histograms.  */
 static void
-tree_find_values_to_profile (histogram_values *values ATTRIBUTE_UNUSED)
+tree_find_values_to_profile (histogram_values *values)
 {
-  abort ();
+  basic_block bb;
+  block_stmt_iterator bsi;
+  histogram_value hist;
+  unsigned i;
+
+  *values = VEC_alloc (histogram_value, 0);
+  FOR_EACH_BB (bb)
+    for (bsi = bsi_start (bb); !bsi_end_p (bsi); bsi_next (&bsi))
+      tree_values_to_profile (bsi_stmt (bsi), values);
+  tree_histograms = *values;
+
+  for (i = 0; i < VEC_length (histogram_value, *values); i++)
+    {
+      hist = VEC_index (histogram_value, *values, i);
+
+      switch (hist->type)
+	{
+	case HIST_TYPE_POW2:
+	  hist->n_counters = GET_MODE_BITSIZE (hist->mode) + 1;
+	  break;
+
+	case HIST_TYPE_SINGLE_VALUE:
+	case HIST_TYPE_INDIR_CALL:
+	  hist->n_counters = 3;
+	  break;
+
+	default:
+	  gcc_unreachable ();
+	}
+
+      if (dump_file)
+	{
+	  fprintf (dump_file, "%s counter for ",
+		   hist->type == HIST_TYPE_POW2 ? "Pow2"
+		   : hist->type == HIST_TYPE_SINGLE_VALUE ? "Single value"
+		   : "Indirect call");
+	  print_generic_expr (dump_file, hist->value, TDF_SLIM);
+	  fprintf (dump_file, " in ");
+	  print_generic_stmt (dump_file, hist->insn, TDF_SLIM);
+	}
+    }
+}
+
+/* Make STMT conditional: split its basic block so that FAST (a statement
+   or a list of statements) is executed instead of STMT when COND is true.
+   PRE are statements computing the operands of COND, or NULL_TREE.  COUNT
+   is the number of times COND is expected to hold out of ALL executions
+   of STMT, PROB the corresponding probability.  The last statement of FAST
+   may throw to the same handler as STMT.  */
+static void
+tree_guard_stmt (tree stmt, tree pre, tree cond, tree fast,
+		 int prob, gcov_type count, gcov_type all)
+{
+  tree label_decl1 = create_artificial_label ();
+  tree label_decl2 = create_artificial_label ();
+  tree cond_stmt, bb2end;
+  block_stmt_iterator bsi, bsi2;
+  basic_block bb, bb2, bb3, bb4;
+  edge e12, e13, e23, e24, e34;
+  int region = lookup_stmt_eh_region (stmt);
+
+  bb = bb_for_stmt (stmt);
+  bsi = stmt_for_bsi (stmt);
+
+  if (pre)
+    bsi_insert_before (&bsi, pre, BSI_SAME_STMT);
+  cond_stmt = build3 (COND_EXPR, void_type_node, cond,
+		      build1 (GOTO_EXPR, void_type_node, label_decl1),
+		      build1 (GOTO_EXPR, void_type_node, label_decl2));
+  bsi_insert_before (&bsi, cond_stmt, BSI_SAME_STMT);
+
+  bsi_insert_before (&bsi, build1 (LABEL_EXPR, void_type_node, label_decl1),
+		     BSI_SAME_STMT);
+  bsi_insert_before (&bsi, fast, BSI_SAME_STMT);
+  bsi2 = bsi;
+  bsi_prev (&bsi2);
+  bb2end = bsi_stmt (bsi2);
+  if (region > 0 && tree_could_throw_p (bb2end))
+    add_stmt_to_eh_region (bb2end, region);
+
+  bsi_insert_before (&bsi, build1 (LABEL_EXPR, void_type_node, label_decl2),
+		     BSI_SAME_STMT);
+
+  /* Fix CFG.  */
+  e12 = split_block (bb, cond_stmt);
+  bb2 = e12->dest;
+  e23 = split_block (bb2, bb2end);
+  bb3 = e23->dest;
+  e34 = split_block (bb3, stmt);
+  bb4 = e34->dest;
+
+  bb2->count = count;
+  bb2->frequency = (bb->frequency * prob + REG_BR_PROB_BASE / 2)
+		   / REG_BR_PROB_BASE;
+  bb3->count = all - count;
+  bb3->frequency = bb->frequency - bb2->frequency;
+
+  e12->flags &= ~EDGE_FALLTHRU;
+  e12->flags |= EDGE_TRUE_VALUE;
+  e12->probability = prob;
+  e12->count = count;
+
+  e13 = make_edge (bb, bb3, EDGE_FALSE_VALUE);
+  e13->probability = REG_BR_PROB_BASE - prob;
+  e13->count = all - count;
+
+  remove_edge (e23);
+
+  e24 = make_edge (bb2, bb4, EDGE_FALLTHRU);
+  e24->probability = REG_BR_PROB_BASE;
+  e24->count = count;
+
+  e34->probability = REG_BR_PROB_BASE;
+  e34->count = all - count;
+
+  /* STMT used to end BB if it could throw; its EH edges now leave BB4.  */
+  if (region > 0)
+    {
+      tree_purge_dead_eh_edges (bb4);
+      if (tree_could_throw_p (stmt))
+	make_eh_edges (stmt);
+      if (tree_could_throw_p (bb2end))
+	make_eh_edges (bb2end);
+    }
+}
+
+/* Return the probability of the value recorded in a single value
+   histogram COUNTERS, or -1 if it is not common enough to specialize for:
+   it must have been seen in at least 1/DIV of all evaluations.  */
+static int
+tree_single_value_prob (gcov_type *counters, int div)
+{
+  gcov_type count = counters[1], all = counters[2];
+
+  if (all <= 0 || count * div < all * (div - 1))
+    return -1;
+  return (count * REG_BR_PROB_BASE + all / 2) / all;
+}
+
+/* Do transform 1) on STMT using the single value histogram HIST.  */
+static bool
+tree_divmod_fixed_value_transform (tree stmt, histogram_value hist)
+{
+  tree op, op1, op2, optype, val, fast;
+  int prob;
+
+  if (TREE_CODE (stmt) != MODIFY_EXPR)
+    return false;
+  op = TREE_OPERAND (stmt, 1);
+  if (TREE_CODE (op) != TRUNC_DIV_EXPR && TREE_CODE (op) != TRUNC_MOD_EXPR)
+    return false;
+  optype = TREE_TYPE (op);
+  op1 = TREE_OPERAND (op, 0);
+  op2 = TREE_OPERAND (op, 1);
+
+  /* We require that count is at least half of all; this means
+     that for the transformation to fire the value must be constant
+     at least 50% of time (and 75% gives the guarantee of usage).  */
+  prob = tree_single_value_prob (hist->counters, 2);
+  if (op2 != hist->value || prob < 0 || !hist->counters[0])
+    return false;
+
+  if (dump_file)
+    {
+      fprintf (dump_file, "Div/mod by constant transformation on stmt ");
+      print_generic_stmt (dump_file, stmt, TDF_SLIM);
+    }
+
+  val = build_int_cst_type (optype, hist->counters[0]);
+  fast = build2 (MODIFY_EXPR, TREE_TYPE (stmt),
+		 unshare_expr (TREE_OPERAND (stmt, 0)),
+		 build2 (TREE_CODE (op), optype, unshare_expr (op1), val));
+  tree_guard_stmt (stmt, NULL_TREE,
+		   build2 (EQ_EXPR, boolean_type_node, op2, val), fast,
+		   prob, hist->counters[1], hist->counters[2]);
+  return true;
 }
 
+/* Do transform 2) on STMT using the power of 2 histogram HIST.  */
+static bool
+tree_mod_pow2_value_transform (tree stmt, histogram_value hist)
+{
+  tree op, op2, optype, tmp1, tmp2, pre = NULL_TREE, fast;
+  gcov_type count = 0, wrong_values, all;
+  unsigned i;
+  int prob;
+
+  if (TREE_CODE (stmt) != MODIFY_EXPR)
+    return false;
+  op = TREE_OPERAND (stmt, 1);
+  optype = TREE_TYPE (op);
+  if (TREE_CODE (op) != TRUNC_MOD_EXPR || !TYPE_UNSIGNED (optype))
+    return false;
+  op2 = TREE_OPERAND (op, 1);
+  if (op2 != hist->value)
+    return false;
+
+  wrong_values = hist->counters[0];
+  for (i = 1; i < hist->n_counters; i++)
+    count += hist->counters[i];
+
+  /* We require that we hit a power of two at least half of all
+     evaluations.  */
+  all = count + wrong_values;
+  if (!all || count < wrong_values)
+    return false;
+
+  if (dump_file)
+    {
+      fprintf (dump_file, "Mod power of 2 transformation on stmt ");
+      print_generic_stmt (dump_file, stmt, TDF_SLIM);
+    }
+
+  /* Compute probability of taking the optimal path.  */
+  prob = (count * REG_BR_PROB_BASE + all / 2) / all;
+
+  tmp1 = create_tmp_var (optype, "PROF");
+  tmp2 = create_tmp_var (optype, "PROF");
+  append_to_statement_list (build2 (MODIFY_EXPR, optype, tmp1,
+				    build2 (MINUS_EXPR, optype, op2,
+					    build_int_cst (optype, 1))),
+			    &pre);
+  append_to_statement_list (build2 (MODIFY_EXPR, optype, tmp2,
+				    build2 (BIT_AND_EXPR, optype, tmp1, op2)),
+			    &pre);
+  fast = build2 (MODIFY_EXPR, TREE_TYPE (stmt),
+		 unshare_expr (TREE_OPERAND (stmt, 0)),
+		 build2 (BIT_AND_EXPR, optype,
+			 unshare_expr (TREE_OPERAND (op, 0)), tmp1));
+  tree_guard_stmt (stmt, pre,
+		   build2 (EQ_EXPR, boolean_type_node, tmp2,
+			   build_int_cst (optype, 0)),
+		   fast, prob, count, all);
+  return true;
+}
+
+/* Return the profile identifier of the function FNDECL, used in indirect
+   call histograms.  It depends on the assembler name only, so that it is
+   the same in the instrumented and in the optimized compilation.  */
+unsigned
+indirect_call_profile_id (tree fndecl)
+{
+  return htab_hash_string (IDENTIFIER_POINTER (DECL_ASSEMBLER_NAME (fndecl)));
+}
+
+/* Return the function of this unit whose profile identifier is ID, or
+   NULL if there is none.  */
+static struct cgraph_node *
+find_func_by_profile_id (unsigned id)
+{
+  struct cgraph_node *node;
+
+  for (node = cgraph_nodes; node; node = node->next)
+    if (node->local.finalized
+	&& !node->global.inlined_to
+	&& indirect_call_profile_id (node->decl) == id)
+      return node;
+  return NULL;
+}
+
+/* Return true if CALL, calling through a pointer of type FNPTR_TYPE, may be
+   turned into a direct call to FNDECL.  */
+static bool
+check_ic_target (tree fnptr_type, tree fndecl)
+{
+  tree calltype = TREE_TYPE (fnptr_type);
+  tree fntype = TREE_TYPE (fndecl);
+
+  if (TREE_CODE (calltype) != FUNCTION_TYPE
+      && TREE_CODE (calltype) != METHOD_TYPE)
+    return false;
+  return (TYPE_MODE (TREE_TYPE (calltype)) == TYPE_MODE (TREE_TYPE (fntype))
+	  && (list_length (TYPE_ARG_TYPES (calltype))
+	      == list_length (TYPE_ARG_TYPES (fntype))));
+}
+
+/* Promote the indirect call in STMT to a direct call guarded by a check
+   of the called address, using the indirect call histogram HIST.
+
+   x = (*p) (args);
+
+   where p is almost always &f is transformed to
+
+   if (p == &f)
+     x = f (args);
+   else
+     x = (*p) (args);
+
+   which lets the direct call be predicted, and expanded like any other
+   call to f.  The direct call gets an edge in the call graph like the
+   calls written in the source.  The profile is read after the inliner
+   ran on this function, so the edge records why the call stays out of
+   line.  */
+static bool
+tree_ic_transform (tree stmt, histogram_value hist)
+{
+  tree call = get_call_expr_in (stmt);
+  tree fn, fast, tmp1, tmp2, pre = NULL_TREE;
+  struct cgraph_node *direct;
+  struct cgraph_edge *e;
+  int prob;
+
+  if (!call)
+    return false;
+  fn = tree_indirect_call_target (call);
+  if (fn != hist->value)
+    return false;
+
+  /* The target must account for at least 75% of the calls.  */
+  prob = tree_single_value_prob (hist->counters, 4);
+  if (prob < 0)
+    return false;
+
+  direct = find_func_by_profile_id ((unsigned) hist->counters[0]);
+  if (!direct || !check_ic_target (TREE_TYPE (fn), direct->decl))
+    return false;
+
+  if (dump_file)
+    {
+      fprintf (dump_file, "Indirect call -> direct call to %s on stmt ",
+	       cgraph_node_name (direct));
+      print_generic_stmt (dump_file, stmt, TDF_SLIM);
+    }
+
+  tmp1 = create_tmp_var (ptr_type_node, "PROF");
+  tmp2 = create_tmp_var (ptr_type_node, "PROF");
+  append_to_statement_list (build2 (MODIFY_EXPR, ptr_type_node, tmp1,
+				    fold_convert (ptr_type_node, fn)),
+			    &pre);
+  append_to_statement_list (build2 (MODIFY_EXPR, ptr_type_node, tmp2,
+				    fold_convert (ptr_type_node,
+						  build_fold_addr_expr
+						    (direct->decl))),
+			    &pre);
+
+  fast = unshare_expr (stmt);
+  TREE_OPERAND (get_call_expr_in (fast), 0)
+    = build_fold_addr_expr (direct->decl);
+
+  tree_guard_stmt (stmt, pre,
+		   build2 (EQ_EXPR, boolean_type_node, tmp1, tmp2),
+		   fast, prob, hist->counters[1], hist->counters[2]);
+  e = cgraph_create_edge (cgraph_node (current_function_decl), direct,
+			  get_call_expr_in (fast));
+  if (direct->local.inlinable)
+    e->inline_failed = N_("call promoted after the inlining decisions");
+  return true;
+}
+
+/* Specialize the block copy or clear in STMT on its most common size,
+   using the single value histogram HIST.
+
+   memcpy (d, s, n);
+
+   where n is almost always N is transformed to
+
+   if (n == N)
+     memcpy (d, s, N);
+   else
+     memcpy (d, s, n);
+
+   so that the constant size copy can be expanded inline.  */
+static bool
+tree_stringop_fixed_value_transform (tree stmt, histogram_value hist)
+{
+  tree call = get_call_expr_in (stmt);
+  tree arg, size, val, fast;
+  int size_arg, i, prob;
+
+  if (!call || tree_stringop_code (call, &size_arg) == END_BUILTINS)
+    return false;
+  for (arg = TREE_OPERAND (call, 1), i = 0;
+       arg && i < size_arg;
+       arg = TREE_CHAIN (arg), i++)
+    continue;
+  if (!arg || TREE_VALUE (arg) != hist->value)
+    return false;
+  size = TREE_VALUE (arg);
+
+  prob = tree_single_value_prob (hist->counters, 2);
+  if (prob < 0 || hist->counters[0] < 0)
+    return false;
+
+  if (dump_file)
+    {
+      fprintf (dump_file, "Block operation of constant size transformation"
+	       " on stmt ");
+      print_generic_stmt (dump_file, stmt, TDF_SLIM);
+    }
+
+  val = build_int_cst_type (TREE_TYPE (size), hist->counters[0]);
+  fast = unshare_expr (stmt);
+  for (arg = TREE_OPERAND (get_call_expr_in (fast), 1), i = 0;
+       i < size_arg;
+       arg = TREE_CHAIN (arg), i++)
+    continue;
+  TREE_VALUE (arg) = val;
+
+  tree_guard_stmt (stmt, NULL_TREE,
+		   build2 (EQ_EXPR, boolean_type_node, size, val),
+		   fast, prob, hist->counters[1], hist->counters[2]);
+  return true;
+}
+
+/* Main entry point on trees.  Uses the histograms read in by branch_prob
+   to perform transformations 1) and 2) described at
+   rtl_value_profile_transformations, indirect call promotion and
+   specialization of block operations on their most common size.  */
 static bool
 tree_value_profile_transformations (void)
 {
-  abort ();
+  histogram_value hist;
+  unsigned i, j;
+  tree stmt;
+  bool changed = false;
+
+  for (i = 0; i < VEC_length (histogram_value, tree_histograms); i++)
+    {
+      hist = VEC_index (histogram_value, tree_histograms, i);
+      stmt = hist->insn;
+      if (!stmt || !hist->counters)
+	continue;
+
+      /* Ignore cold areas -- we are growing a code.  */
+      if (!maybe_hot_bb_p (bb_for_stmt (stmt)))
+	continue;
+
+      switch (hist->type)
+	{
+	case HIST_TYPE_SINGLE_VALUE:
+	  if (!tree_divmod_fixed_value_transform (stmt, hist)
+	      && !tree_stringop_fixed_value_transform (stmt, hist))
+	    continue;
+	  break;
+
+	case HIST_TYPE_POW2:
+	  if (!tree_mod_pow2_value_transform (stmt, hist))
+	    continue;
+	  break;
+
+	case HIST_TYPE_INDIR_CALL:
+	  if (!tree_ic_transform (stmt, hist))
+	    continue;
+	  break;
+
+	default:
+	  gcc_unreachable ();
+	}
+
+      /* STMT now lives on the slow path only; do not transform it again.  */
+      changed = true;
+      for (j = i + 1; j < VEC_length (histogram_value, tree_histograms); j++)
+	if (VEC_index (histogram_value, tree_histograms, j)->insn == stmt)
+	  VEC_index (histogram_value, tree_histograms, j)->insn = NULL;
+    }
+
+  for (i = 0; i < VEC_length (histogram_value, tree_histograms); i++)
+    {
+      hist = VEC_index (histogram_value, tree_histograms, i);
+      if (hist->counters)
+	free (hist->counters);
+      hist->counters = NULL;
+    }
+  tree_histograms = NULL;
+
+  return changed;
 }
 
 static struct value_prof_hooks tree_value_prof_hooks = {
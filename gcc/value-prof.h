@@ -29,8 +29,10 @@ enum hist_type
   HIST_TYPE_POW2,	/* Histogram of power of 2 values.  */
   HIST_TYPE_SINGLE_VALUE, /* Tries to identify the value that is (almost)
 			   always constant.  */
-  HIST_TYPE_CONST_DELTA	/* Tries to identify the (almost) always constant
+  HIST_TYPE_CONST_DELTA,	/* Tries to identify the (almost) always constant
 			   difference between two evaluations of a value.  */
+  HIST_TYPE_INDIR_CALL	/* Tries to identify the function that is (almost)
+			   always called through an indirect call.  */
 };
 
 #define COUNTER_FOR_HIST_TYPE(TYPE) ((int) (TYPE) + GCOV_FIRST_VALUE_COUNTER)
@@ -62,6 +64,10 @@ struct histogram_value_t GTY(())
 	  int may_be_other;	/* If the value may be non-positive or not 2^k.  */
 	} pow2;		/* Power of 2 histogram data.  */
     } hdata;		/* Profiled information specific data.  */
+  gcov_type * GTY ((skip (""))) counters;
+			/* Counters read from the profile; only used
+			   on trees, where there are no REG_VALUE_PROFILE
+			   notes to carry them.  */
 };
 
 typedef struct histogram_value_t *histogram_value;
@@ -77,6 +83,9 @@ extern void tree_register_value_prof_hooks (void);
 /* IR-independent entry points.  */
 extern void find_values_to_profile (histogram_values *);
 extern bool value_profile_transformations (void);
+
+/* Identifier of a function in indirect call histograms.  */
+extern unsigned indirect_call_profile_id (tree);
 
 /* External declarations for edge-based profiling.  */
 struct profile_hooks {
@@ -95,6 +104,9 @@ struct profile_hooks {
   /* Insert code to find the most common value of a difference between two
      evaluations of an expression.  */
   void (*gen_const_delta_profiler) (histogram_value, unsigned, unsigned);
+
+  /* Insert code to find the most common target of an indirect call.  */
+  void (*gen_ic_profiler) (histogram_value, unsigned, unsigned);
   FILE * (*profile_dump_file) (void);
 };
 
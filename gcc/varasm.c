@@ -1282,6 +1282,20 @@ assemble_start_function (tree decl, const char *fnname)
       ASM_OUTPUT_LABEL (asm_out_file, unlikely_section_label);
       unlikely_section_label_printed = true;
     }
+
+  /* Record the function for the linker order file.  Functions the
+     profile shows are never executed are left out, so that the linker
+     places them after all the listed ones.  */
+  if (order_file
+      && cfun->function_frequency != FUNCTION_FREQUENCY_UNLIKELY_EXECUTED)
+    {
+      const char *name = targetm.strip_name_encoding (fnname);
+
+      if (fnname[0] == '*')
+	fprintf (order_file, "%s\n", name);
+      else
+	fprintf (order_file, "%s%s\n", user_label_prefix, name);
+    }
 }
 
 /* Output assembler code associated with defining the size of the
@@ -32,4 +32,16 @@
 
 typedef int _Atomic_word;
 
+// A target may define the following two macros using the appropriate
+// memory barrier instructions; code that needs them falls back to
+// taking a lock when they are not defined.
+
+// Prevent loads from being hoisted across the barrier (load-load,
+// i.e. an acquire barrier).
+// #define _GLIBCXX_READ_MEM_BARRIER __asm __volatile ("":::"memory")
+
+// Prevent stores from being sunk across the barrier (store-store,
+// i.e. a release barrier).
+// #define _GLIBCXX_WRITE_MEM_BARRIER __asm __volatile ("":::"memory")
+
 #endif 
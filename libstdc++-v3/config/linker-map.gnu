@@ -273,6 +273,16 @@ GLIBCXX_3.4.3 {
  
 } GLIBCXX_3.4.2;
 
+GLIBCXX_3.4.4 {
+
+    _ZNK9__gnu_cxx6__poolILb1EE12_M_get_statsEv;
+    _ZN9__gnu_cxx6__poolILb1EE27_M_get_unused_thread_recordEv;
+
+    # __gnu_cxx::__get_eh_alloc_stats(__gnu_cxx::__eh_alloc_stats*)
+    _ZN9__gnu_cxx20__get_eh_alloc_statsEPNS_16__eh_alloc_statsE;
+
+} GLIBCXX_3.4.3;
+
 # Symbols in the support library (libsupc++) have their own tag.
 CXXABI_1.3 {
 
@@ -1,6 +1,6 @@
 // Wrapper for underlying C-language localization -*- C++ -*-
 
-// Copyright (C) 2001, 2002, 2003 Free Software Foundation, Inc.
+// Copyright (C) 2001, 2002, 2003, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -42,6 +42,35 @@
 #include <ieeefp.h>
 #endif
 
+namespace __gnu_internal
+{
+  // Only LC_NUMERIC affects the conversions below.  Most programs
+  // never change it from "C", and then we skip switching it, which
+  // is much more expensive than the conversion itself: returns the
+  // name of the previous LC_NUMERIC locale if it had to be switched
+  // to "C", otherwise NULL.
+  inline char*
+  set_numeric_c_locale()
+  {
+    const char* __old = std::setlocale(LC_NUMERIC, NULL);
+    if (!std::strcmp(__old, "C"))
+      return NULL;
+    char* __sav = strdup(__old);
+    std::setlocale(LC_NUMERIC, "C");
+    return __sav;
+  }
+
+  inline void
+  restore_numeric_locale(char* __sav)
+  {
+    if (__sav)
+      {
+	std::setlocale(LC_NUMERIC, __sav);
+	free(__sav);
+      }
+  }
+}
+
 namespace std 
 {
   // Specializations for all types used in num_get.
@@ -53,8 +82,7 @@ namespace std
       if (!(__err & ios_base::failbit))
 	{
 	  // Assumes __s formatted for "C" locale.
-	  char* __old = strdup(setlocale(LC_ALL, NULL));
-	  setlocale(LC_ALL, "C");
+	  char* __old = __gnu_internal::set_numeric_c_locale();
 	  char* __sanity;
 	  errno = 0;
 #if defined(_GLIBCXX_USE_C99)
@@ -80,8 +108,7 @@ namespace std
 	    __v = __f;
 	  else
 	    __err |= ios_base::failbit;
-	  setlocale(LC_ALL, __old);
-	  free(__old);
+	  __gnu_internal::restore_numeric_locale(__old);
 	}
     }
 
@@ -93,8 +120,7 @@ namespace std
       if (!(__err & ios_base::failbit))
 	{
 	  // Assumes __s formatted for "C" locale.
-	  char* __old = strdup(setlocale(LC_ALL, NULL));
-	  setlocale(LC_ALL, "C");
+	  char* __old = __gnu_internal::set_numeric_c_locale();
 	  char* __sanity;
 	  errno = 0;
 	  double __d = strtod(__s, &__sanity);
@@ -102,8 +128,7 @@ namespace std
 	    __v = __d;
 	  else
 	    __err |= ios_base::failbit;
-	  setlocale(LC_ALL, __old);
-	  free(__old);
+	  __gnu_internal::restore_numeric_locale(__old);
 	}
     }
 
@@ -115,8 +140,7 @@ namespace std
       if (!(__err & ios_base::failbit))
 	{
 	  // Assumes __s formatted for "C" locale.
-	  char* __old = strdup(setlocale(LC_ALL, NULL));
-	  setlocale(LC_ALL, "C");
+	  char* __old = __gnu_internal::set_numeric_c_locale();
 #if defined(_GLIBCXX_USE_C99)
 	  char* __sanity;
 	  errno = 0;
@@ -134,8 +158,7 @@ namespace std
 #endif
 	  else
 	    __err |= ios_base::failbit;
-	  setlocale(LC_ALL, __old);
-	  free(__old);
+	  __gnu_internal::restore_numeric_locale(__old);
 	}
     }
 
@@ -1,6 +1,6 @@
 // Wrapper for underlying C-language localization -*- C++ -*-
 
-// Copyright (C) 2001, 2002, 2003, 2004 Free Software Foundation, Inc.
+// Copyright (C) 2001, 2002, 2003, 2004, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -51,26 +51,35 @@ namespace std
   // Convert numeric value of type _Tv to string and return length of
   // string.  If snprintf is available use it, otherwise fall back to
   // the unsafe sprintf which, in general, can be dangerous and should
-  // be avoided.
+  // be avoided.  Only LC_NUMERIC affects the conversion: most
+  // programs never change it from "C", and then we skip switching it,
+  // which is much more expensive than the conversion itself.
   template<typename _Tv>
     int
-    __convert_from_v(char* __out, 
+    __convert_from_v(char* __out,
 		     const int __size __attribute__((__unused__)),
 		     const char* __fmt,
 		     _Tv __v, const __c_locale&, int __prec)
     {
-      char* __old = std::setlocale(LC_ALL, NULL);
-      char* __sav = new char[std::strlen(__old) + 1];
-      std::strcpy(__sav, __old);
-      std::setlocale(LC_ALL, "C");
+      char* __old = std::setlocale(LC_NUMERIC, NULL);
+      char* __sav = NULL;
+      if (std::strcmp(__old, "C"))
+	{
+	  __sav = new char[std::strlen(__old) + 1];
+	  std::strcpy(__sav, __old);
+	  std::setlocale(LC_NUMERIC, "C");
+	}
 
 #ifdef _GLIBCXX_USE_C99
       const int __ret = std::snprintf(__out, __size, __fmt, __prec, __v);
 #else
       const int __ret = std::sprintf(__out, __fmt, __prec, __v);
 #endif
-      std::setlocale(LC_ALL, __sav);
-      delete [] __sav;
+      if (__sav)
+	{
+	  std::setlocale(LC_NUMERIC, __sav);
+	  delete [] __sav;
+	}
       return __ret;
     }
 }
@@ -1,6 +1,6 @@
 // std::codecvt implementation details, GNU version -*- C++ -*-
 
-// Copyright (C) 2002, 2003 Free Software Foundation, Inc.
+// Copyright (C) 2002, 2003, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -34,8 +34,187 @@
 // Written by Benjamin Kosnik <bkoz@redhat.com>
 
 #include <locale>
+#include <cstring>
+#include <langinfo.h>
 #include <bits/c++locale_internal.h>
 
+#if defined(_GLIBCXX_USE_WCHAR_T) \
+    && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ > 2))
+namespace __gnu_internal
+{
+  // In the common UTF-8 locales, the conversions are done here
+  // without switching locales: the ASCII characters a word at a time,
+  // and well formed sequences with a table of their lengths.  Anything
+  // else, malformed, incomplete, overlong or beyond U+10FFFF, stops
+  // them and is left to the C library, with the state, as before.
+  inline bool
+  __is_utf8(std::__c_locale __cloc)
+  {
+    return (sizeof(wchar_t) == 4
+	    && std::strcmp(__nl_langinfo_l(CODESET, __cloc), "UTF-8") == 0);
+  }
+
+  // Length of the sequence by its first byte, 0 if invalid.
+  static const unsigned char __utf8_len[256] =
+  {
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    4, 4, 4, 4, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  };
+
+  // The code point of the sequence of length __len at __s, or 0 if
+  // it is not well formed.
+  inline wchar_t
+  __utf8_decode(const unsigned char* __s, int __len)
+  {
+    wchar_t __c = __s[0] & (0x7f >> __len);
+    for (int __i = 1; __i < __len; ++__i)
+      {
+	if ((__s[__i] & 0xc0) != 0x80)
+	  return 0;
+	__c = (__c << 6) | (__s[__i] & 0x3f);
+      }
+    if ((__len == 3 && (__c < 0x800 || (__c >= 0xd800 && __c < 0xe000)))
+	|| (__len == 4 && (__c < 0x10000 || __c > 0x10ffff)))
+      return 0;
+    return __c;
+  }
+
+  const unsigned long __high_bits = ~0ul / 0xff * 0x80;
+
+  // Converts as much of [__from, __from_end) as possible into
+  // [__to, __to_end), up to the first sequence left to the library.
+  inline void
+  __utf8_in(const char*& __from, const char* __from_end,
+	    wchar_t*& __to, wchar_t* __to_end)
+  {
+    const unsigned char* __s = reinterpret_cast<const unsigned char*>(__from);
+    const unsigned char* __e =
+      reinterpret_cast<const unsigned char*>(__from_end);
+    wchar_t* __d = __to;
+    const std::size_t __word = sizeof(unsigned long);
+    while (__s < __e && __d < __to_end)
+      {
+	while (std::size_t(__e - __s) >= __word
+	       && std::size_t(__to_end - __d) >= __word)
+	  {
+	    unsigned long __w;
+	    std::memcpy(&__w, __s, __word);
+	    if (__w & __high_bits)
+	      break;
+	    for (std::size_t __i = 0; __i < __word; ++__i)
+	      __d[__i] = __s[__i];
+	    __s += __word;
+	    __d += __word;
+	  }
+	if (__s == __e || __d == __to_end)
+	  break;
+
+	const int __len = __utf8_len[*__s];
+	if (__len == 1)
+	  *__d++ = *__s++;
+	else
+	  {
+	    if (__len == 0 || __e - __s < __len)
+	      break;
+	    const wchar_t __c = __utf8_decode(__s, __len);
+	    if (!__c)
+	      break;
+	    *__d++ = __c;
+	    __s += __len;
+	  }
+      }
+    __from = reinterpret_cast<const char*>(__s);
+    __to = __d;
+  }
+
+  // Likewise, from wide characters.
+  inline void
+  __utf8_out(const wchar_t*& __from, const wchar_t* __from_end,
+	     char*& __to, char* __to_end)
+  {
+    const wchar_t* __s = __from;
+    unsigned char* __d = reinterpret_cast<unsigned char*>(__to);
+    unsigned char* __e = reinterpret_cast<unsigned char*>(__to_end);
+    for (; __s < __from_end; ++__s)
+      {
+	const unsigned long __c = static_cast<unsigned long>(*__s);
+	if (__c < 0x80)
+	  {
+	    if (__d == __e)
+	      break;
+	    *__d++ = __c;
+	  }
+	else if (__c < 0x800)
+	  {
+	    if (__e - __d < 2)
+	      break;
+	    *__d++ = 0xc0 | (__c >> 6);
+	    *__d++ = 0x80 | (__c & 0x3f);
+	  }
+	else if (__c < 0x10000)
+	  {
+	    if ((__c >= 0xd800 && __c < 0xe000) || __e - __d < 3)
+	      break;
+	    *__d++ = 0xe0 | (__c >> 12);
+	    *__d++ = 0x80 | ((__c >> 6) & 0x3f);
+	    *__d++ = 0x80 | (__c & 0x3f);
+	  }
+	else if (__c < 0x110000)
+	  {
+	    if (__e - __d < 4)
+	      break;
+	    *__d++ = 0xf0 | (__c >> 18);
+	    *__d++ = 0x80 | ((__c >> 12) & 0x3f);
+	    *__d++ = 0x80 | ((__c >> 6) & 0x3f);
+	    *__d++ = 0x80 | (__c & 0x3f);
+	  }
+	else
+	  break;
+      }
+    __from = __s;
+    __to = reinterpret_cast<char*>(__d);
+  }
+
+  // Skips at most __max characters of [__from, __end), returning
+  // their number.
+  inline std::size_t
+  __utf8_length(const char*& __from, const char* __end, std::size_t __max)
+  {
+    const unsigned char* __s = reinterpret_cast<const unsigned char*>(__from);
+    const unsigned char* __e = reinterpret_cast<const unsigned char*>(__end);
+    std::size_t __n = 0;
+    while (__s < __e && __n < __max)
+      {
+	const int __len = __utf8_len[*__s];
+	if (__len == 1)
+	  ++__s;
+	else if (__len == 0 || __e - __s < __len
+		 || !__utf8_decode(__s, __len))
+	  break;
+	else
+	  __s += __len;
+	++__n;
+      }
+    __from = reinterpret_cast<const char*>(__s);
+    return __n;
+  }
+} // namespace __gnu_internal
+#endif
+
 namespace std
 {
   // Specializations.
@@ -51,6 +230,20 @@ namespace std
     state_type __tmp_state(__state);
 
 #if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ > 2)
+    if (mbsinit(&__state) && __gnu_internal::__is_utf8(_M_c_locale_codecvt))
+      {
+	__from_next = __from;
+	__to_next = __to;
+	__gnu_internal::__utf8_out(__from_next, __from_end, __to_next, __to_end);
+	if (__from_next == __from_end)
+	  return __ret;
+	// As below, filling __to is partial, unless with a NUL.
+	if (__to_next == __to_end && __to_next != __to)
+	  return __from_next[-1] ? partial : __ret;
+	__from = __from_next;
+	__to = __to_next;
+      }
+
     __c_locale __old = __uselocale(_M_c_locale_codecvt);
 #endif
 
@@ -126,6 +319,19 @@ namespace std
     state_type __tmp_state(__state);
 
 #if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ > 2)
+    if (mbsinit(&__state) && __gnu_internal::__is_utf8(_M_c_locale_codecvt))
+      {
+	__from_next = __from;
+	__to_next = __to;
+	__gnu_internal::__utf8_in(__from_next, __from_end, __to_next, __to_end);
+	if (__from_next == __from_end)
+	  return __ret;
+	if (__to_next == __to_end && __to_next != __to)
+	  return __to_next[-1] ? partial : __ret;
+	__from = __from_next;
+	__to = __to_next;
+      }
+
     __c_locale __old = __uselocale(_M_c_locale_codecvt);
 #endif
 
@@ -239,6 +445,15 @@ namespace std
     state_type __tmp_state(__state);
 
 #if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ > 2)
+    if (mbsinit(&__state) && __gnu_internal::__is_utf8(_M_c_locale_codecvt))
+      {
+	const extern_type* __start = __from;
+	__max -= __gnu_internal::__utf8_length(__from, __end, __max);
+	__ret = __from - __start;
+	if (__from == __end || !__max)
+	  return __ret;
+      }
+
     __c_locale __old = __uselocale(_M_c_locale_codecvt);
 #endif
 
@@ -1,6 +1,6 @@
 // Components for manipulating sequences of characters -*- C++ -*-
 
-// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004
+// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -1008,7 +1008,7 @@ namespace std
       iterator
       insert(iterator __p, _CharT __c)
       {
-	_GLIBCXX_DEBUG_PEDASSERT(__p >= _M_ibegin() && __p <= _M_iend());
+	__glibcxx_requires_insert_position(__p, _M_ibegin(), _M_iend());
 	const size_type __pos = __p - _M_ibegin();
 	_M_replace_aux(__pos, size_type(0), size_type(1), __c);
 	_M_rep()->_M_set_leaked();
@@ -1045,8 +1045,8 @@ namespace std
       iterator
       erase(iterator __position)
       {
-	_GLIBCXX_DEBUG_PEDASSERT(__position >= _M_ibegin()
-				 && __position < _M_iend());
+	__glibcxx_requires_erase_positions(__position, __position + 1,
+					   _M_ibegin(), _M_iend());
 	const size_type __pos = __position - _M_ibegin();
 	_M_replace_safe(__pos, size_type(1), NULL, size_type(0));
 	_M_rep()->_M_set_leaked();
@@ -1065,8 +1065,8 @@ namespace std
       iterator
       erase(iterator __first, iterator __last)
       {
-	_GLIBCXX_DEBUG_PEDASSERT(__first >= _M_ibegin() && __first <= __last
-				 && __last <= _M_iend());
+	__glibcxx_requires_erase_positions(__first, __last,
+					   _M_ibegin(), _M_iend());
         const size_type __pos = __first - _M_ibegin();
 	_M_replace_safe(__pos, __last - __first, NULL, size_type(0));
 	_M_rep()->_M_set_leaked();
@@ -1,6 +1,6 @@
 // File based streams -*- C++ -*-
 
-// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004
+// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -475,7 +475,7 @@ namespace std
 	  if (__r == codecvt_base::partial && __elen == __plen)
 	    {
 	      const char_type* __iresume = __iend;
-	      streamsize __rlen = this->pptr() - __iend;
+	      streamsize __rlen = __ilen - (__iend - __ibuf);
 	      __r = _M_codecvt->out(_M_state_cur, __iresume,
 				    __iresume + __rlen, __iend, __buf,
 				    __buf + __blen, __bend);
@@ -512,14 +512,12 @@ namespace std
 	   _M_destroy_pback();
 	 }
        
-       // Optimization in the always_noconv() case, to be generalized in the
-       // future: when __n > __buflen we read directly instead of using the
-       // buffer repeatedly.
+       // Optimization: when __n > __buflen we read directly instead of
+       // using the buffer repeatedly.
        const bool __testin = this->_M_mode & ios_base::in;
        const streamsize __buflen = this->_M_buf_size > 1 ? this->_M_buf_size - 1
 	                                                 : 1;
-       if (__n > __buflen && __check_facet(_M_codecvt).always_noconv()
-	   && __testin && !_M_writing)
+       if (__n > __buflen && __testin && !_M_writing)
 	 {
 	   // First, copy the chars already present in the buffer.
 	   const streamsize __avail = this->egptr() - this->gptr();
@@ -535,27 +533,73 @@ namespace std
 	       __n -= __avail;
 	     }
 
-	   const streamsize __len = _M_file.xsgetn(reinterpret_cast<char*>(__s),
-						   __n);
-	   if (__len == -1)
-	     __throw_ios_failure(__N("basic_filebuf::xsgetn "
-				     "error reading the file"));
-	   __ret += __len;
-	   if (__len == __n)
+	   if (__check_facet(_M_codecvt).always_noconv())
 	     {
-	       _M_set_buffer(0);
-	       _M_reading = true;
+	       const streamsize __len = _M_file.xsgetn(reinterpret_cast<char*>(__s),
+						       __n);
+	       if (__len == -1)
+		 __throw_ios_failure(__N("basic_filebuf::xsgetn "
+					 "error reading the file"));
+	       __ret += __len;
+	       if (__len == __n)
+		 {
+		   _M_set_buffer(0);
+		   _M_reading = true;
+		 }
+	       else if (__len == 0)
+		 {
+		   // If end of file is reached, set 'uncommitted'
+		   // mode, thus allowing an immediate write without
+		   // an intervening seek.
+		   _M_set_buffer(-1);
+		   _M_reading = false;
+		 }
+	       __n = 0;
 	     }
-	   else if (__len == 0)
+	   else
 	     {
-	       // If end of file is reached, set 'uncommitted'
-	       // mode, thus allowing an immediate write without
-	       // an intervening seek.
-	       _M_set_buffer(-1);
-	       _M_reading = false;
+	       // underflow converts into the get area: make it __s, a
+	       // buffer at a time, then the chars converted are consumed.
+	       try
+		 {
+		   while (__n >= __buflen)
+		     {
+		       // Not as after an imbue (see underflow).
+		       this->setg(__s, __s, __s);
+		       _M_reading = false;
+		       if (traits_type::eq_int_type(basic_filebuf::underflow(),
+						    traits_type::eof()))
+			 break;
+		       const streamsize __len = this->egptr() - this->eback();
+		       __s += __len;
+		       __ret += __len;
+		       __n -= __len;
+		       this->setg(this->eback(), this->egptr(), this->egptr());
+		     }
+		 }
+	       catch(...)
+		 {
+		   _M_set_buffer(-1);
+		   _M_reading = false;
+		   __throw_exception_again;
+		 }
+
+	       // As after reading a whole get area, except that the
+	       // external chars left are moved to the front, so that
+	       // _M_state_last corresponds to _M_ext_buf (see seekoff).
+	       if (_M_reading)
+		 {
+		   const streamsize __remainder = _M_ext_end - _M_ext_next;
+		   if (__remainder)
+		     std::memmove(_M_ext_buf, _M_ext_next, __remainder);
+		   _M_ext_next = _M_ext_buf;
+		   _M_ext_end = _M_ext_buf + __remainder;
+		   _M_state_last = _M_state_cur;
+		   _M_set_buffer(0);
+		 }
 	     }
 	 }
-       else
+       if (__n > 0)
 	 __ret += __streambuf_type::xsgetn(__s, __n);
 
        return __ret;
@@ -566,13 +610,11 @@ namespace std
      basic_filebuf<_CharT, _Traits>::
      xsputn(const _CharT* __s, streamsize __n)
      {
-       // Optimization in the always_noconv() case, to be generalized in the
-       // future: when __n is sufficiently large we write directly instead of
-       // using the buffer.
+       // Optimization: when __n is sufficiently large we write directly
+       // instead of using the buffer.
        streamsize __ret = 0;
        const bool __testout = this->_M_mode & ios_base::out;
-       if (__check_facet(_M_codecvt).always_noconv()
-	   && __testout && !_M_reading)
+       if (__testout && !_M_reading)
 	{
 	  // Measurement would reveal the best choice.
 	  const streamsize __chunk = 1ul << 10;
@@ -583,7 +625,28 @@ namespace std
 	    __bufavail = this->_M_buf_size - 1;
 
 	  const streamsize __limit = std::min(__chunk, __bufavail);
-	  if (__n >= __limit)
+	  if (__n >= __limit && !__check_facet(_M_codecvt).always_noconv())
+	    {
+	      // Flush the put area, then convert from __s, a chunk at
+	      // a time.
+	      const streamsize __buffill = this->pptr() - this->pbase();
+	      if (!__buffill
+		  || _M_convert_to_external(this->pbase(), __buffill))
+		{
+		  _M_set_buffer(0);
+		  _M_writing = true;
+		  while (__ret < __n)
+		    {
+		      const streamsize __len = std::min(__chunk, __n - __ret);
+		      if (!_M_convert_to_external(const_cast<char_type*>(__s
+									 + __ret),
+						  __len))
+			break;
+		      __ret += __len;
+		    }
+		}
+	    }
+	  else if (__n >= __limit)
 	    {
 	      const streamsize __buffill = this->pptr() - this->pbase();
 	      const char* __buf = reinterpret_cast<const char*>(this->pbase());
@@ -1,6 +1,6 @@
 // The template and inlines for the -*- C++ -*- gslice_array class.
 
-// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2004
+// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -164,8 +164,8 @@ namespace std
     inline void
     gslice_array<_Tp>::operator=(const valarray<_Tp>& __v) const
     {
-      std::__valarray_copy(_Array<_Tp>(__v), __v.size(),
-			   _M_array, _Array<size_t>(_M_index));
+      std::__valarray_gslice_copy(_Array<_Tp>(__v), __v.size(),
+				  _M_array, _Array<size_t>(_M_index));
     }
 
   template<typename _Tp>
@@ -1,6 +1,6 @@
 // List implementation (out of line) -*- C++ -*-
 
-// Copyright (C) 2001, 2002, 2003, 2004 Free Software Foundation, Inc.
+// Copyright (C) 2001, 2002, 2003, 2004, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -63,6 +63,87 @@
 
 namespace _GLIBCXX_STD
 {
+  // Orderings of list nodes, by the values they hold, for the sorts.
+  template<typename _Tp>
+    struct _List_node_less
+    {
+      bool
+      operator()(_List_node_base* __x, _List_node_base* __y) const
+      {
+	return (static_cast<_List_node<_Tp>*>(__x)->_M_data
+		< static_cast<_List_node<_Tp>*>(__y)->_M_data);
+      }
+    };
+
+  template<typename _Tp, typename _StrictWeakOrdering>
+    struct _List_node_compare
+    {
+      _StrictWeakOrdering _M_comp;
+
+      _List_node_compare(_StrictWeakOrdering __comp)
+      : _M_comp(__comp) { }
+
+      bool
+      operator()(_List_node_base* __x, _List_node_base* __y)
+      {
+	return _M_comp(static_cast<_List_node<_Tp>*>(__x)->_M_data,
+		       static_cast<_List_node<_Tp>*>(__y)->_M_data);
+      }
+    };
+
+  // Stable sort of the __n nodes at __a, with __buf, as large, for
+  // scratch space: insertion sort of short runs, then bottom-up merges
+  // back and forth between the two arrays.
+  template<typename _NodeCompare>
+    void
+    __list_sort_nodes(_List_node_base** __a, size_t __n,
+		      _List_node_base** __buf, _NodeCompare& __comp)
+    {
+      const size_t __run = 8;
+      for (size_t __i = 0; __i < __n; __i += __run)
+	{
+	  const size_t __e = std::min(__i + __run, __n);
+	  for (size_t __j = __i + 1; __j < __e; ++__j)
+	    {
+	      _List_node_base* __v = __a[__j];
+	      size_t __k = __j;
+	      for (; __k > __i && __comp(__v, __a[__k - 1]); --__k)
+		__a[__k] = __a[__k - 1];
+	      __a[__k] = __v;
+	    }
+	}
+
+      _List_node_base** __from = __a;
+      _List_node_base** __to = __buf;
+      for (size_t __w = __run; __w < __n; __w *= 2)
+	{
+	  for (size_t __i = 0; __i < __n; __i += 2 * __w)
+	    {
+	      const size_t __m = std::min(__i + __w, __n);
+	      const size_t __e = std::min(__i + 2 * __w, __n);
+	      size_t __l = __i;
+	      size_t __r = __m;
+	      size_t __o = __i;
+	      // Runs already in order are just copied.
+	      if (__r < __e && __comp(__from[__r], __from[__r - 1]))
+		{
+		  while (__l < __m && __r < __e)
+		    if (__comp(__from[__r], __from[__l]))
+		      __to[__o++] = __from[__r++];
+		    else
+		      __to[__o++] = __from[__l++];
+		}
+	      while (__l < __m)
+		__to[__o++] = __from[__l++];
+	      while (__r < __e)
+		__to[__o++] = __from[__r++];
+	    }
+	  std::swap(__from, __to);
+	}
+      if (__from != __a)
+	std::copy(__from, __from + __n, __a);
+    }
+
   template<typename _Tp, typename _Alloc>
     void
     _List_base<_Tp, _Alloc>::
@@ -231,6 +312,63 @@ namespace _GLIBCXX_STD
 	}
     }
 
+  template<typename _Tp, typename _Alloc>
+    template <typename _NodeCompare>
+      bool
+      list<_Tp, _Alloc>::
+      _M_sort_nodes(_NodeCompare __comp)
+      {
+	_List_node_base* const __head = &this->_M_impl._M_node;
+	size_t __n = 0;
+	for (_List_node_base* __p = __head->_M_next; __p != __head;
+	     __p = __p->_M_next)
+	  ++__n;
+
+	// Short lists are sorted on the stack.
+	enum { _S_local_nodes = 32 };
+	_List_node_base* __local[2 * _S_local_nodes];
+	_List_node_base** __a = __local;
+	if (__n > _S_local_nodes)
+	  {
+	    __a = static_cast<_List_node_base**>(
+	      ::operator new(2 * __n * sizeof(_List_node_base*), std::nothrow));
+	    if (!__a)
+	      return false;
+	  }
+
+	_List_node_base** __p = __a;
+	for (_List_node_base* __x = __head->_M_next; __x != __head;
+	     __x = __x->_M_next)
+	  *__p++ = __x;
+
+	// Until the relinking, the list itself is untouched: if a
+	// comparison throws, it is left as it was.
+	try
+	  {
+	    __list_sort_nodes(__a, __n, __a + __n, __comp);
+	  }
+	catch(...)
+	  {
+	    if (__a != __local)
+	      ::operator delete(__a);
+	    __throw_exception_again;
+	  }
+
+	_List_node_base* __prev = __head;
+	for (size_t __i = 0; __i < __n; ++__i)
+	  {
+	    __prev->_M_next = __a[__i];
+	    __a[__i]->_M_prev = __prev;
+	    __prev = __a[__i];
+	  }
+	__prev->_M_next = __head;
+	__head->_M_prev = __prev;
+
+	if (__a != __local)
+	  ::operator delete(__a);
+	return true;
+      }
+
   template<typename _Tp, typename _Alloc>
     void
     list<_Tp, _Alloc>::
@@ -238,8 +376,10 @@ namespace _GLIBCXX_STD
     {
       // Do nothing if the list has length 0 or 1.
       if (this->_M_impl._M_node._M_next != &this->_M_impl._M_node
-	  && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node)
+	  && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node
+	  && !_M_sort_nodes(_List_node_less<_Tp>()))
       {
+	// Out of memory for the array: merge sublists instead.
         list __carry;
         list __tmp[64];
         list * __fill = &__tmp[0];
@@ -343,8 +483,11 @@ namespace _GLIBCXX_STD
       {
 	// Do nothing if the list has length 0 or 1.
 	if (this->_M_impl._M_node._M_next != &this->_M_impl._M_node
-	    && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node)
+	    && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node
+	    && !_M_sort_nodes(_List_node_compare<_Tp,
+			      _StrictWeakOrdering>(__comp)))
 	  {
+	    // Out of memory for the array: merge sublists instead.
 	    list __carry;
 	    list __tmp[64];
 	    list * __fill = &__tmp[0];
@@ -1,6 +1,6 @@
 // Locale support -*- C++ -*-
 
-// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004
+// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -285,7 +285,8 @@ namespace std
     // The (shared) implementation
     _Impl*		_M_impl;
 
-    // The "C" reference locale
+    // The "C" reference locale.  It is never destroyed, thus the
+    // locales sharing it do not count their references.
     static _Impl*       _S_classic;
 
     // Current global locale
@@ -1,6 +1,6 @@
 // Locale support -*- C++ -*-
 
-// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004
+// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -267,13 +267,53 @@ namespace std
   __verify_grouping(const char* __grouping, size_t __grouping_size,
 		    const string& __grouping_tmp);
 
+  // True if the ten decimal digits starting at __lit_zero are
+  // consecutive characters, as they are with any ctype that widens
+  // "0123456789" to a run of code points.
+  template<typename _CharT>
+    inline bool
+    __consecutive_digits(const _CharT* __lit_zero)
+    {
+      for (int __i = 1; __i < 10; ++__i)
+	if (__lit_zero[__i] != __lit_zero[0] + __i)
+	  return false;
+      return true;
+    }
+
+  // Returns the value of __c as one of the first __len digits of
+  // _M_atoms_in, which start at __lit_zero, or -1.  When the decimal
+  // digits are __consecutive they are recognized by a subtraction;
+  // only the hexadecimal letters are then searched for.
+  template<typename _CharT>
+    inline int
+    __digit_value(_CharT __c, const _CharT* __lit_zero, size_t __len,
+		  bool __consecutive)
+    {
+      if (__consecutive)
+	{
+	  const unsigned long __d = (static_cast<unsigned long>(__c)
+				     - static_cast<unsigned long>(*__lit_zero));
+	  if (__d < 10)
+	    return __d < __len ? static_cast<int>(__d) : -1;
+	  if (__len <= 10)
+	    return -1;
+	}
+
+      const _CharT* __q = char_traits<_CharT>::find(__lit_zero, __len, __c);
+      if (!__q)
+	return -1;
+      int __digit = __q - __lit_zero;
+      if (__digit > 15)
+	__digit -= 6;
+      return __digit;
+    }
+
   template<typename _CharT, typename _InIter>
     _InIter
     num_get<_CharT, _InIter>::
     _M_extract_float(_InIter __beg, _InIter __end, ios_base& __io,
 		     ios_base::iostate& __err, string& __xtrc) const
     {
-      typedef char_traits<_CharT>			__traits_type;
       typedef typename numpunct<_CharT>::__cache_type	__cache_type;
       __use_cache<__cache_type> __uc;
       const locale& __loc = __io._M_getloc();
@@ -325,6 +365,7 @@ namespace std
 	__found_grouping.reserve(32);
       int __sep_pos = 0;
       const char_type* __lit_zero = __lit + __num_base::_S_izero;
+      const bool __consecutive = std::__consecutive_digits(__lit_zero);
       while (__beg != __end)
         {
 	  // According to 22.2.2.1.2, p8-9, first look for thousands_sep
@@ -369,10 +410,12 @@ namespace std
 	    }
           else
 	    {
-	      const char_type* __q = __traits_type::find(__lit_zero, 10, __c);
-	      if (__q)
+	      const int __digit = std::__digit_value(__c, __lit_zero, 10,
+						     __consecutive);
+	      if (__digit >= 0)
 		{
-		  __xtrc += __num_base::_S_atoms_in[__q - __lit];
+		  __xtrc += __num_base::_S_atoms_in[__num_base::_S_izero
+						    + __digit];
 		  __found_mantissa = true;
 		  ++__sep_pos;
 		  ++__beg;
@@ -434,7 +477,6 @@ namespace std
       _M_extract_int(_InIter __beg, _InIter __end, ios_base& __io,
 		     ios_base::iostate& __err, _ValueT& __v) const
       {
-        typedef char_traits<_CharT>			__traits_type;
 	typedef typename numpunct<_CharT>::__cache_type __cache_type;
 	__use_cache<__cache_type> __uc;
 	const locale& __loc = __io._M_getloc();
@@ -511,6 +553,7 @@ namespace std
 	bool __overflow = false;
 	_ValueT __result = 0;
 	const char_type* __lit_zero = __lit + __num_base::_S_izero;
+	const bool __consecutive = std::__consecutive_digits(__lit_zero);
 	if (__negative)
 	  {
 	    const _ValueT __min = numeric_limits<_ValueT>::min() / __base;
@@ -538,13 +581,11 @@ namespace std
 		  break;
 		else
 		  {
-		    const char_type* __q = __traits_type::find(__lit_zero, 
-							       __len, __c);
-		    if (__q)
+		    const int __digit = std::__digit_value(__c, __lit_zero,
+							   __len,
+							   __consecutive);
+		    if (__digit >= 0)
 		      {
-			int __digit = __q - __lit_zero;
-			if (__digit > 15)
-			  __digit -= 6;
 			if (__result < __min)
 			  __overflow = true;
 			else
@@ -586,13 +627,11 @@ namespace std
 		  break;
 		else
 		  {
-		    const char_type* __q = __traits_type::find(__lit_zero,
-							       __len, __c);    
-		    if (__q)
+		    const int __digit = std::__digit_value(__c, __lit_zero,
+							   __len,
+							   __consecutive);
+		    if (__digit >= 0)
 		      {
-			int __digit = __q - __lit_zero;
-			if (__digit > 15)
-			  __digit -= 6;
 			if (__result > __max)
 			  __overflow = true;
 			else
@@ -881,13 +920,21 @@ namespace std
       if (__builtin_expect(__basefield != ios_base::oct &&
 			   __basefield != ios_base::hex, true))
 	{
-	  // Decimal.
-	  do
+	  // Decimal.  Two digits per division of __v, which is the
+	  // expensive part for the wider types: the pair itself is
+	  // split by cheap arithmetic on an int.
+	  const _CharT* __lit_digits = __lit + __num_base::_S_odigits;
+	  while (__v >= 100)
 	    {
-	      *__buf-- = __lit[(__v % 10) + __num_base::_S_odigits];
-	      __v /= 10;
+	      const int __pair = static_cast<int>(__v % 100);
+	      __v /= 100;
+	      *__buf-- = __lit_digits[__pair % 10];
+	      *__buf-- = __lit_digits[__pair / 10];
 	    }
-	  while (__v != 0);
+	  const int __rest = static_cast<int>(__v);
+	  *__buf-- = __lit_digits[__rest % 10];
+	  if (__rest >= 10)
+	    *__buf-- = __lit_digits[__rest / 10];
 	  if (__neg)
 	    *__buf-- = __lit[__num_base::_S_ominus];
 	  else if (__flags & ios_base::showpos)
@@ -1,6 +1,6 @@
 // Algorithm implementation -*- C++ -*-
 
-// Copyright (C) 2001, 2002, 2003, 2004 Free Software Foundation, Inc.
+// Copyright (C) 2001, 2002, 2003, 2004, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -65,6 +65,10 @@
 #include <bits/stl_tempbuf.h>     // for _Temporary_buffer
 #include <debug/debug.h>
 
+#ifdef _GLIBCXX_PARALLEL
+# include <parallel/algorithmfwd.h>
+#endif
+
 // See concept_check.h for the __glibcxx_*_requires macros.
 
 namespace std
@@ -154,6 +158,10 @@ namespace std
       // concept requirements
       __glibcxx_function_requires(_InputIteratorConcept<_InputIterator>)
       __glibcxx_requires_valid_range(__first, __last);
+#ifdef _GLIBCXX_PARALLEL
+      if (__gnu_parallel::__for_each(__first, __last, __f))
+	return __f;
+#endif
       for ( ; __first != __last; ++__first)
 	__f(*__first);
       return __f;
@@ -785,6 +793,12 @@ namespace std
             __typeof__(__unary_op(*__first))>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      _OutputIterator __ret = __result;
+      if (__gnu_parallel::__transform(__first, __last, __result, __unary_op,
+				      __ret))
+	return __ret;
+#endif
       for ( ; __first != __last; ++__first, ++__result)
 	*__result = __unary_op(*__first);
       return __result;
@@ -822,6 +836,12 @@ namespace std
             __typeof__(__binary_op(*__first1,*__first2))>)
       __glibcxx_requires_valid_range(__first1, __last1);
 
+#ifdef _GLIBCXX_PARALLEL
+      _OutputIterator __ret = __result;
+      if (__gnu_parallel::__transform(__first1, __last1, __first2, __result,
+				      __binary_op, __ret))
+	return __ret;
+#endif
       for ( ; __first1 != __last1; ++__first1, ++__first2, ++__result)
 	*__result = __binary_op(*__first1, *__first2);
       return __result;
@@ -2269,6 +2289,10 @@ namespace std
       __glibcxx_requires_valid_range(__first, __middle);
       __glibcxx_requires_valid_range(__middle, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      if (__gnu_parallel::__partial_sort(__first, __middle, __last))
+	return;
+#endif
       std::make_heap(__first, __middle);
       for (_RandomAccessIterator __i = __middle; __i < __last; ++__i)
 	if (*__i < *__first)
@@ -2312,6 +2336,10 @@ namespace std
       __glibcxx_requires_valid_range(__first, __middle);
       __glibcxx_requires_valid_range(__middle, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      if (__gnu_parallel::__partial_sort(__first, __middle, __last, __comp))
+	return;
+#endif
       std::make_heap(__first, __middle, __comp);
       for (_RandomAccessIterator __i = __middle; __i < __last; ++__i)
 	if (__comp(*__i, *__first))
@@ -2548,6 +2576,10 @@ namespace std
       __glibcxx_function_requires(_LessThanComparableConcept<_ValueType>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      if (__gnu_parallel::__sort(__first, __last))
+	return;
+#endif
       if (__first != __last)
 	{
 	  std::__introsort_loop(__first, __last, __lg(__last - __first) * 2);
@@ -2584,6 +2616,10 @@ namespace std
 				  _ValueType>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      if (__gnu_parallel::__sort(__first, __last, __comp))
+	return;
+#endif
       if (__first != __last)
 	{
 	  std::__introsort_loop(__first, __last, __lg(__last - __first) * 2,
@@ -3610,6 +3646,10 @@ namespace std
       __glibcxx_function_requires(_LessThanComparableConcept<_ValueType>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      if (__gnu_parallel::__stable_sort(__first, __last))
+	return;
+#endif
       _Temporary_buffer<_RandomAccessIterator, _ValueType>
 	buf(__first, __last);
       if (buf.begin() == 0)
@@ -3654,6 +3694,10 @@ namespace std
 				  _ValueType>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      if (__gnu_parallel::__stable_sort(__first, __last, __comp))
+	return;
+#endif
       _Temporary_buffer<_RandomAccessIterator, _ValueType> buf(__first, __last);
       if (buf.begin() == 0)
 	std::__inplace_stable_sort(__first, __last, __comp);
@@ -5148,4 +5192,8 @@ namespace std
 
 } // namespace std
 
+#ifdef _GLIBCXX_PARALLEL
+# include <parallel/algo.h>
+#endif
+
 #endif /* _ALGO_H */
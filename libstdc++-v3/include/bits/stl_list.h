@@ -1,6 +1,6 @@
 // List implementation -*- C++ -*-
 
-// Copyright (C) 2001, 2002, 2003, 2004 Free Software Foundation, Inc.
+// Copyright (C) 2001, 2002, 2003, 2004, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -1115,8 +1115,12 @@ namespace _GLIBCXX_STD
 			   _InputIterator __first, _InputIterator __last,
 			   __false_type)
         {
+	  // The new nodes are linked together apart, then spliced in
+	  // at once: if a copy throws, the list is left unchanged.
+	  list __tmp(get_allocator());
 	  for (; __first != __last; ++__first)
-	    _M_insert(__pos, *__first);
+	    __tmp._M_insert(__tmp.end(), *__first);
+	  splice(__pos, __tmp);
 	}
 
       // Called by insert(p,n,x), and the range insert when it turns out
@@ -1124,10 +1128,19 @@ namespace _GLIBCXX_STD
       void
       _M_fill_insert(iterator __pos, size_type __n, const value_type& __x)
       {
+	list __tmp(get_allocator());
 	for (; __n > 0; --__n)
-	  _M_insert(__pos, __x);
+	  __tmp._M_insert(__tmp.end(), __x);
+	splice(__pos, __tmp);
       }
 
+      // Sorts the nodes by sorting an array of pointers to them, then
+      // relinking them in order.  Returns false, doing nothing, if
+      // the array can't be allocated.
+      template<typename _NodeCompare>
+        bool
+        _M_sort_nodes(_NodeCompare __comp);
+
 
       // Moves the elements from [first,last) before position.
       void
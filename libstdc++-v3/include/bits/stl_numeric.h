@@ -1,6 +1,6 @@
 // Numeric functions implementation -*- C++ -*-
 
-// Copyright (C) 2001, 2004 Free Software Foundation, Inc.
+// Copyright (C) 2001, 2004, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -63,6 +63,10 @@
 
 #include <debug/debug.h>
 
+#ifdef _GLIBCXX_PARALLEL
+# include <parallel/numericfwd.h>
+#endif
+
 namespace std
 {
 
@@ -85,6 +89,10 @@ namespace std
       __glibcxx_function_requires(_InputIteratorConcept<_InputIterator>)
       __glibcxx_requires_valid_range(__first, __last);
 
+#ifdef _GLIBCXX_PARALLEL
+      if (__gnu_parallel::__accumulate(__first, __last, __init))
+	return __init;
+#endif
       for ( ; __first != __last; ++__first)
 	__init = __init + *__first;
       return __init;
@@ -141,6 +149,10 @@ namespace std
       __glibcxx_function_requires(_InputIteratorConcept<_InputIterator2>)
       __glibcxx_requires_valid_range(__first1, __last1);
 
+#ifdef _GLIBCXX_PARALLEL
+      if (__gnu_parallel::__inner_product(__first1, __last1, __first2, __init))
+	return __init;
+#endif
       for ( ; __first1 != __last1; ++__first1, ++__first2)
 	__init = __init + (*__first1 * *__first2);
       return __init;
@@ -207,6 +219,11 @@ namespace std
       __glibcxx_requires_valid_range(__first, __last);
 
       if (__first == __last) return __result;
+#ifdef _GLIBCXX_PARALLEL
+      _OutputIterator __ret = __result;
+      if (__gnu_parallel::__partial_sum(__first, __last, __result, __ret))
+	return __ret;
+#endif
       *__result = *__first;
       _ValueType __value = *__first;
       while (++__first != __last) {
@@ -323,4 +340,8 @@ namespace std
 
 } // namespace std
 
+#ifdef _GLIBCXX_PARALLEL
+# include <parallel/numeric.h>
+#endif
+
 #endif /* _STL_NUMERIC_H */
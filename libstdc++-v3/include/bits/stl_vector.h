@@ -1,6 +1,6 @@
 // Vector implementation -*- C++ -*-
 
-// Copyright (C) 2001, 2002, 2003, 2004 Free Software Foundation, Inc.
+// Copyright (C) 2001, 2002, 2003, 2004, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -492,7 +492,10 @@ namespace _GLIBCXX_STD
        */
       reference
       operator[](size_type __n)
-      { return *(begin() + __n); }
+      {
+	__glibcxx_requires_subscript(__n);
+	return *(begin() + __n);
+      }
 
       /**
        *  @brief  Subscript access to the data contained in the %vector.
@@ -507,7 +510,10 @@ namespace _GLIBCXX_STD
        */
       const_reference
       operator[](size_type __n) const
-      { return *(begin() + __n); }
+      {
+	__glibcxx_requires_subscript(__n);
+	return *(begin() + __n);
+      }
 
     protected:
       /// @if maint Safety check used only from at().  @endif
@@ -561,7 +567,10 @@ namespace _GLIBCXX_STD
        */
       reference
       front()
-      { return *begin(); }
+      {
+	__glibcxx_requires_nonempty();
+	return *begin();
+      }
 
       /**
        *  Returns a read-only (constant) reference to the data at the first
@@ -569,7 +578,10 @@ namespace _GLIBCXX_STD
        */
       const_reference
       front() const
-      { return *begin(); }
+      {
+	__glibcxx_requires_nonempty();
+	return *begin();
+      }
 
       /**
        *  Returns a read/write reference to the data at the last
@@ -577,7 +589,10 @@ namespace _GLIBCXX_STD
        */
       reference
       back()
-      { return *(end() - 1); }
+      {
+	__glibcxx_requires_nonempty();
+	return *(end() - 1);
+      }
       
       /**
        *  Returns a read-only (constant) reference to the data at the
@@ -585,7 +600,10 @@ namespace _GLIBCXX_STD
        */
       const_reference
       back() const
-      { return *(end() - 1); }
+      {
+	__glibcxx_requires_nonempty();
+	return *(end() - 1);
+      }
 
       // [23.2.4.3] modifiers
       /**
@@ -622,6 +640,7 @@ namespace _GLIBCXX_STD
       void
       pop_back()
       {
+	__glibcxx_requires_nonempty();
 	--this->_M_impl._M_finish;
 	this->_M_impl.destroy(this->_M_impl._M_finish);
       }
@@ -655,7 +674,10 @@ namespace _GLIBCXX_STD
        */
       void
       insert(iterator __position, size_type __n, const value_type& __x)
-      { _M_fill_insert(__position, __n, __x); }
+      {
+	__glibcxx_requires_insert_position(__position, begin(), end());
+	_M_fill_insert(__position, __n, __x);
+      }
 
       /**
        *  @brief  Inserts a range into the %vector.
@@ -676,6 +698,7 @@ namespace _GLIBCXX_STD
         insert(iterator __position, _InputIterator __first,
 	       _InputIterator __last)
         {
+	  __glibcxx_requires_insert_position(__position, begin(), end());
 	  // Check whether it's an integral type.  If so, it's not an iterator.
 	  typedef typename _Is_integer<_InputIterator>::_Integral _Integral;
 	  _M_insert_dispatch(__position, __first, __last, _Integral());
@@ -1,6 +1,6 @@
 // The template and inlines for the -*- C++ -*- internal _Meta class.
 
-// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004
+// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -272,6 +272,8 @@ namespace std
       size_t __n = _M_closure.size();
       if (__n == 0)
 	return _Tp();
+      else if (__is_arithmetic<_Tp>::_M_type && __n >= 4)
+	return std::__valarray_sum_4<_Tp>(_M_closure, __n);
       else
 	{
 	  _Tp __s = _M_closure[--__n];
@@ -1,6 +1,6 @@
 // The template and inlines for the -*- C++ -*- internal _Array helper class.
 
-// Copyright (C) 1997, 1998, 1999, 2000, 2003, 2004
+// Copyright (C) 1997, 1998, 1999, 2000, 2003, 2004, 2005
 //  Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -181,7 +181,9 @@ namespace std
     __valarray_copy_construct (const _Tp* __restrict__ __a, size_t __n,
 			       size_t __s, _Tp* __restrict__ __o)
     {
-      if (__is_fundamental<_Tp>::_M_type)
+      if (__s == 1)
+	std::__valarray_copy_construct(__a, __a + __n, __o);
+      else if (__is_fundamental<_Tp>::_M_type)
 	while (__n--)
 	  {
 	    *__o++ = *__a;
@@ -238,8 +240,11 @@ namespace std
     __valarray_fill(_Tp* __restrict__ __a, size_t __n,
 		    size_t __s, const _Tp& __t)
     { 
-      for (size_t __i = 0; __i < __n; ++__i, __a += __s)
-	*__a = __t;
+      if (__s == 1)
+	std::__valarray_fill(__a, __n, __t);
+      else
+	for (size_t __i = 0; __i < __n; ++__i, __a += __s)
+	  *__a = __t;
     }
 
   // fill indir   ect array __a[__i[<__n>]] with __i
@@ -289,8 +294,11 @@ namespace std
     __valarray_copy(const _Tp* __restrict__ __a, size_t __n, size_t __s,
 		    _Tp* __restrict__ __b)
     {
-      for (size_t __i = 0; __i < __n; ++__i, ++__b, __a += __s)
-	*__b = *__a;
+      if (__s == 1)
+	std::__valarray_copy(__a, __n, __b);
+      else
+	for (size_t __i = 0; __i < __n; ++__i, ++__b, __a += __s)
+	  *__b = *__a;
     }
 
   // Copy a plain array  __a[<__n>] into a strided array __b[<__n : __s>]
@@ -299,8 +307,11 @@ namespace std
     __valarray_copy(const _Tp* __restrict__ __a, _Tp* __restrict__ __b,
 		    size_t __n, size_t __s)
     {
-      for (size_t __i = 0; __i < __n; ++__i, ++__a, __b += __s)
-	*__b = *__a;
+      if (__s == 1)
+	std::__valarray_copy(__a, __n, __b);
+      else
+	for (size_t __i = 0; __i < __n; ++__i, ++__a, __b += __s)
+	  *__b = *__a;
     }
 
   // Copy strided array __src[<__n : __s1>] into another
@@ -347,6 +358,171 @@ namespace std
 	__dst[*__j++] = __src[*__i++];
     }
 
+  // The index array of a gslice enumerates its innermost dimensions
+  // fastest, thus is made of blocks of equal length which only differ
+  // by their first index.  When the innermost strides are 1, these
+  // blocks are runs of consecutive indices, and the elements can be
+  // moved a block at a time.  Returns the length of the runs of
+  // __i[<__n>], or 1 if they are too short to be worth it.
+  inline size_t
+  __valarray_gslice_block(const size_t* __restrict__ __i, size_t __n)
+  {
+    size_t __k = 1;
+    while (__k < __n && __i[__k] == __i[0] + __k)
+      ++__k;
+    return (__k < 8 || __n % __k) ? 1 : __k;
+  }
+
+  // Copy the gslice __a[__i[<__n>]] in plain array __b[<__n>]
+  template<typename _Tp>
+    inline void
+    __valarray_gslice_copy(const _Tp* __restrict__ __a,
+			   const size_t* __restrict__ __i,
+			   _Tp* __restrict__ __b, size_t __n)
+    {
+      const size_t __k = std::__valarray_gslice_block(__i, __n);
+      if (__k == 1)
+	std::__valarray_copy(__a, __i, __b, __n);
+      else
+	for (size_t __j = 0; __j < __n; __j += __k)
+	  std::__valarray_copy(__a + __i[__j], __k, __b + __j);
+    }
+
+  // Copy a plain array __a[<__n>] in the gslice __b[__i[<__n>]]
+  template<typename _Tp>
+    inline void
+    __valarray_gslice_copy(const _Tp* __restrict__ __a, size_t __n,
+			   _Tp* __restrict__ __b,
+			   const size_t* __restrict__ __i)
+    {
+      const size_t __k = std::__valarray_gslice_block(__i, __n);
+      if (__k == 1)
+	std::__valarray_copy(__a, __n, __b, __i);
+      else
+	for (size_t __j = 0; __j < __n; __j += __k)
+	  std::__valarray_copy(__a + __j, __k, __b + __i[__j]);
+    }
+
+  //
+  // Element-wise kernels __o[<__n>] = __a[<__n>] op __b[<__n>] for
+  // the closures v op w, v op t and t op v of two valarrays or of a
+  // valarray and a scalar.  Unlike the generic evaluation through
+  // _Expr<>::operator[], they see the plain arrays, which lets the
+  // vectorizer map the loop onto SIMD registers.
+  //
+  template<class _Oper, typename _Tp>
+    inline void
+    __valarray_binary(const _Tp* __restrict__ __a,
+		      const _Tp* __restrict__ __b, size_t __n,
+		      _Tp* __restrict__ __o)
+    {
+      const _Oper __op = _Oper();
+      for (size_t __i = 0; __i < __n; ++__i)
+	__o[__i] = __op(__a[__i], __b[__i]);
+    }
+
+  template<class _Oper, typename _Tp>
+    inline void
+    __valarray_binary(const _Tp* __restrict__ __a, const _Tp& __t,
+		      size_t __n, _Tp* __restrict__ __o)
+    {
+      const _Oper __op = _Oper();
+      const _Tp __b = __t;
+      for (size_t __i = 0; __i < __n; ++__i)
+	__o[__i] = __op(__a[__i], __b);
+    }
+
+  template<class _Oper, typename _Tp>
+    inline void
+    __valarray_binary(const _Tp& __t, const _Tp* __restrict__ __b,
+		      size_t __n, _Tp* __restrict__ __o)
+    {
+      const _Oper __op = _Oper();
+      const _Tp __a = __t;
+      for (size_t __i = 0; __i < __n; ++__i)
+	__o[__i] = __op(__a, __b[__i]);
+    }
+
+  //
+  // Reductions of arrays __a[<__n>] of at least 4 elements of
+  // arithmetic type.  They keep four partial results, i.e. as many
+  // independent chains of operations, which the processor can
+  // overlap and the vectorizer can map onto the lanes of a SIMD
+  // register.  The order of the additions of sum() is unspecified
+  // [26.3.2.7]: only the rounding of floating point sums may differ
+  // from a sequential evaluation.
+  //
+  template<typename _Tp, typename _Ta>
+    inline _Tp
+    __valarray_sum_4(const _Ta& __a, size_t __n)
+    {
+      _Tp __r0 = __a[0], __r1 = __a[1], __r2 = __a[2], __r3 = __a[3];
+      size_t __i = 4;
+      for (; __i + 4 <= __n; __i += 4)
+	{
+	  __r0 += __a[__i];
+	  __r1 += __a[__i + 1];
+	  __r2 += __a[__i + 2];
+	  __r3 += __a[__i + 3];
+	}
+      for (; __i < __n; ++__i)
+	__r0 += __a[__i];
+      __r0 += __r1;
+      __r2 += __r3;
+      __r0 += __r2;
+      return __r0;
+    }
+
+  template<typename _Tp, typename _Ta>
+    inline _Tp
+    __valarray_min_4(const _Ta& __a, size_t __n)
+    {
+      _Tp __r0 = __a[0], __r1 = __a[1], __r2 = __a[2], __r3 = __a[3];
+      size_t __i = 4;
+      for (; __i + 4 <= __n; __i += 4)
+	{
+	  const _Tp __t0 = __a[__i], __t1 = __a[__i + 1];
+	  const _Tp __t2 = __a[__i + 2], __t3 = __a[__i + 3];
+	  __r0 = __t0 < __r0 ? __t0 : __r0;
+	  __r1 = __t1 < __r1 ? __t1 : __r1;
+	  __r2 = __t2 < __r2 ? __t2 : __r2;
+	  __r3 = __t3 < __r3 ? __t3 : __r3;
+	}
+      for (; __i < __n; ++__i)
+	{
+	  const _Tp __t = __a[__i];
+	  __r0 = __t < __r0 ? __t : __r0;
+	}
+      __r0 = __r1 < __r0 ? __r1 : __r0;
+      __r2 = __r3 < __r2 ? __r3 : __r2;
+      return __r2 < __r0 ? __r2 : __r0;
+    }
+
+  template<typename _Tp, typename _Ta>
+    inline _Tp
+    __valarray_max_4(const _Ta& __a, size_t __n)
+    {
+      _Tp __r0 = __a[0], __r1 = __a[1], __r2 = __a[2], __r3 = __a[3];
+      size_t __i = 4;
+      for (; __i + 4 <= __n; __i += 4)
+	{
+	  const _Tp __t0 = __a[__i], __t1 = __a[__i + 1];
+	  const _Tp __t2 = __a[__i + 2], __t3 = __a[__i + 3];
+	  __r0 = __r0 < __t0 ? __t0 : __r0;
+	  __r1 = __r1 < __t1 ? __t1 : __r1;
+	  __r2 = __r2 < __t2 ? __t2 : __r2;
+	  __r3 = __r3 < __t3 ? __t3 : __r3;
+	}
+      for (; __i < __n; ++__i)
+	{
+	  const _Tp __t = __a[__i];
+	  __r0 = __r0 < __t ? __t : __r0;
+	}
+      __r0 = __r0 < __r1 ? __r1 : __r0;
+      __r2 = __r2 < __r3 ? __r3 : __r2;
+      return __r0 < __r2 ? __r2 : __r0;
+    }
+
   //
   // Compute the sum of elements in range [__f, __l)
   // This is a naive algorithm.  It suffers from cancelling.
@@ -358,6 +534,9 @@ namespace std
     inline _Tp
     __valarray_sum(const _Tp* __restrict__ __f, const _Tp* __restrict__ __l)
     {
+      if (__is_arithmetic<_Tp>::_M_type && __l - __f >= 4)
+	return std::__valarray_sum_4<_Tp>(__f, __l - __f);
+
       _Tp __r = _Tp();
       while (__f != __l)
 	__r += *__f++;
@@ -383,6 +562,9 @@ namespace std
     {
       size_t __s = __a.size();
       typedef typename _Ta::value_type _Value_type;
+      if (__is_arithmetic<_Value_type>::_M_type && __s >= 4)
+	return std::__valarray_min_4<_Value_type>(__a, __s);
+
       _Value_type __r = __s == 0 ? _Value_type() : __a[0];
       for (size_t __i = 1; __i < __s; ++__i)
 	{
@@ -399,6 +581,9 @@ namespace std
     {
       size_t __s = __a.size();
       typedef typename _Ta::value_type _Value_type;
+      if (__is_arithmetic<_Value_type>::_M_type && __s >= 4)
+	return std::__valarray_max_4<_Value_type>(__a, __s);
+
       _Value_type __r = __s == 0 ? _Value_type() : __a[0];
       for (size_t __i = 1; __i < __s; ++__i)
 	{
@@ -495,6 +680,26 @@ namespace std
 		    __dst._M_data, __j._M_data);
     }
 
+  // Copy the gslice __a[__i[<__n>]] in plain array __b[<__n>]
+  template<typename _Tp>
+    inline void
+    __valarray_gslice_copy(_Array<_Tp> __a, _Array<size_t> __i,
+			   _Array<_Tp> __b, size_t __n)
+    {
+      std::__valarray_gslice_copy(__a._M_data, __i._M_data,
+				  __b._M_data, __n);
+    }
+
+  // Copy a plain array __a[<__n>] in the gslice __b[__i[<__n>]]
+  template<typename _Tp>
+    inline void
+    __valarray_gslice_copy(_Array<_Tp> __a, size_t __n, _Array<_Tp> __b,
+			   _Array<size_t> __i)
+    {
+      std::__valarray_gslice_copy(__a._M_data, __n,
+				  __b._M_data, __i._M_data);
+    }
+
   template<typename _Tp>
     inline
     _Array<_Tp>::_Array(size_t __n)
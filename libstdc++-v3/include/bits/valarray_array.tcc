@@ -144,6 +144,37 @@ namespace std
 	*__p = __e[__i];
     }
 
+  // Same, for the closures v op w, v op t and t op v of arithmetic
+  // operators, evaluated by the kernels __valarray_binary.
+  template<typename _Tp, class _Oper>
+    inline void
+    __valarray_copy(const _Expr<_BinClos<_Oper, _ValArray, _ValArray,
+		    _Tp, _Tp>, _Tp>& __e, size_t __n, _Array<_Tp> __a)
+    {
+      std::__valarray_binary<_Oper>(_Array<_Tp>(__e()._M_arg1())._M_data,
+				    _Array<_Tp>(__e()._M_arg2())._M_data,
+				    __n, __a._M_data);
+    }
+
+  template<typename _Tp, class _Oper>
+    inline void
+    __valarray_copy(const _Expr<_BinClos<_Oper, _ValArray, _Constant,
+		    _Tp, _Tp>, _Tp>& __e, size_t __n, _Array<_Tp> __a)
+    {
+      std::__valarray_binary<_Oper>(_Array<_Tp>(__e()._M_arg1())._M_data,
+				    __e()._M_arg2(), __n, __a._M_data);
+    }
+
+  template<typename _Tp, class _Oper>
+    inline void
+    __valarray_copy(const _Expr<_BinClos<_Oper, _Constant, _ValArray,
+		    _Tp, _Tp>, _Tp>& __e, size_t __n, _Array<_Tp> __a)
+    {
+      std::__valarray_binary<_Oper>(__e()._M_arg1(),
+				    _Array<_Tp>(__e()._M_arg2())._M_data,
+				    __n, __a._M_data);
+    }
+
   // Copy n consecutive elements of e into elements of a using stride
   // s.  I.e., a[0] = e[0], a[s] = e[1], a[2*s] = e[2].
   template<typename _Tp, class _Dom>
@@ -528,6 +528,9 @@ namespace std
 
       size_t size() const { return _M_expr1.size(); }
 
+      const _FirstArg& _M_arg1() const { return _M_expr1; }
+      const _SecondArg& _M_arg2() const { return _M_expr2; }
+
     private:
       const _FirstArg& _M_expr1;
       const _SecondArg& _M_expr2;
@@ -549,6 +552,9 @@ namespace std
 
       size_t size() const { return _M_expr1.size(); }
 
+      const _Clos& _M_arg1() const { return _M_expr1; }
+      const _Vt& _M_arg2() const { return _M_expr2; }
+
     private:
       const _Clos& _M_expr1;
       const _Vt& _M_expr2;
@@ -569,6 +575,9 @@ namespace std
 
       size_t size() const { return _M_expr2.size(); }
 
+      const _Vt& _M_arg1() const { return _M_expr1; }
+      const _Clos& _M_arg2() const { return _M_expr2; }
+
     private:
       const _Vt& _M_expr1;
       const _Clos& _M_expr2;
@@ -1,6 +1,6 @@
 // Vector implementation (out of line) -*- C++ -*-
 
-// Copyright (C) 2001, 2002, 2003, 2004 Free Software Foundation, Inc.
+// Copyright (C) 2001, 2002, 2003, 2004, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -92,6 +92,7 @@ namespace _GLIBCXX_STD
     vector<_Tp, _Alloc>::
     insert(iterator __position, const value_type& __x)
     {
+      __glibcxx_requires_insert_position(__position, begin(), end());
       const size_type __n = __position - begin();
       if (this->_M_impl._M_finish != this->_M_impl._M_end_of_storage
 	  && __position == end())
@@ -109,6 +110,8 @@ namespace _GLIBCXX_STD
     vector<_Tp, _Alloc>::
     erase(iterator __position)
     {
+      __glibcxx_requires_erase_positions(__position, __position + 1,
+					 begin(), end());
       if (__position + 1 != end())
         std::copy(__position + 1, end(), __position);
       --this->_M_impl._M_finish;
@@ -121,6 +124,7 @@ namespace _GLIBCXX_STD
     vector<_Tp, _Alloc>::
     erase(iterator __first, iterator __last)
     {
+      __glibcxx_requires_erase_positions(__first, __last, begin(), end());
       iterator __i(copy(__last, end(), __first));
       std::_Destroy(__i, end(), this->get_allocator());
       this->_M_impl._M_finish = this->_M_impl._M_finish - (__last - __first);
@@ -1,6 +1,6 @@
 // Debugging support implementation -*- C++ -*-
 
-// Copyright (C) 2003
+// Copyright (C) 2003, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -216,14 +216,44 @@ _GLIBCXX_DEBUG_VERIFY(::std::__is_heap(_First, _Last, _Pred),		\
 #  define __glibcxx_check_string_len(_String,_Len)
 #endif
 
+/** Verify that the iterator _Position, passed to insert, lies in
+ *  [_Begin, _End], the current range of a container whose iterators
+ *  are not tracked.  An iterator invalidated by a reallocation most
+ *  likely points outside of the new storage.
+*/
+#define __glibcxx_check_insert_position(_Position,_Begin,_End)		\
+_GLIBCXX_DEBUG_VERIFY(_Begin <= _Position && _Position <= _End,	\
+		      _M_message(::__gnu_debug::__msg_insert_outside)	\
+		      ._M_sequence(*this, "this")			\
+		      ._M_iterator(_Position, #_Position))
+
+/** Verify that the iterator range [_First, _Last), passed to erase,
+ *  lies in [_Begin, _End], the current range of a container whose
+ *  iterators are not tracked.
+*/
+#define __glibcxx_check_erase_positions(_First,_Last,_Begin,_End)	\
+_GLIBCXX_DEBUG_VERIFY(_Begin <= _First && _First <= _Last		\
+		      && _Last <= _End,					\
+		      _M_message(::__gnu_debug::__msg_erase_outside)	\
+		      ._M_sequence(*this, "this")			\
+		      ._M_iterator(_First, #_First)			\
+		      ._M_iterator(_Last, #_Last))
+
 /** Macros used by the implementation outside of debug wrappers to
  *  verify certain properties. The __glibcxx_requires_xxx macros are
  *  merely wrappers around the __glibcxx_check_xxx wrappers when we
  *  are compiling with debug mode, but disappear when we are in
  *  release mode so that there is no checking performed in, e.g., the
  *  standard library algorithms.
+ *
+ *  Defining _GLIBCXX_DEBUG_LIGHT instead of _GLIBCXX_DEBUG keeps the
+ *  release containers and iterators, thus the ABI and most of the
+ *  speed of release mode, but enables the checks which take constant
+ *  time: subscripts, accesses to empty containers and positions
+ *  passed to vector and string.  There is no tracking of iterators,
+ *  hence no global bookkeeping nor locking.
 */
-#ifdef _GLIBCXX_DEBUG
+#if defined(_GLIBCXX_DEBUG) || defined(_GLIBCXX_DEBUG_LIGHT)
 #  define _GLIBCXX_DEBUG_ASSERT(_Condition) assert(_Condition)
 
 #  ifdef _GLIBXX_DEBUG_PEDANTIC
@@ -235,6 +265,30 @@ _GLIBCXX_DEBUG_VERIFY(::std::__is_heap(_First, _Last, _Pred),		\
 #  define __glibcxx_requires_cond(_Cond,_Msg) _GLIBCXX_DEBUG_VERIFY(_Cond,_Msg)
 #  define __glibcxx_requires_valid_range(_First,_Last) \
      __glibcxx_check_valid_range(_First,_Last)
+#  define __glibcxx_requires_nonempty() __glibcxx_check_nonempty()
+#  define __glibcxx_requires_string(_String) __glibcxx_check_string(_String)
+#  define __glibcxx_requires_string_len(_String,_Len)	\
+     __glibcxx_check_string_len(_String,_Len)
+#  define __glibcxx_requires_subscript(_N) __glibcxx_check_subscript(_N)
+#  define __glibcxx_requires_insert_position(_Position,_Begin,_End) \
+     __glibcxx_check_insert_position(_Position,_Begin,_End)
+#  define __glibcxx_requires_erase_positions(_First,_Last,_Begin,_End) \
+     __glibcxx_check_erase_positions(_First,_Last,_Begin,_End)
+#else
+#  define _GLIBCXX_DEBUG_ASSERT(_Condition)
+#  define _GLIBCXX_DEBUG_PEDASSERT(_Condition)
+#  define __glibcxx_requires_cond(_Cond,_Msg)
+#  define __glibcxx_requires_valid_range(_First,_Last)
+#  define __glibcxx_requires_nonempty()
+#  define __glibcxx_requires_string(_String)
+#  define __glibcxx_requires_string_len(_String,_Len)
+#  define __glibcxx_requires_subscript(_N)
+#  define __glibcxx_requires_insert_position(_Position,_Begin,_End)
+#  define __glibcxx_requires_erase_positions(_First,_Last,_Begin,_End)
+#endif
+
+// These checks take linear time, thus are not part of the light mode.
+#ifdef _GLIBCXX_DEBUG
 #  define __glibcxx_requires_sorted(_First,_Last) \
      __glibcxx_check_sorted(_First,_Last)
 #  define __glibcxx_requires_sorted_pred(_First,_Last,_Pred) \
@@ -247,26 +301,13 @@ _GLIBCXX_DEBUG_VERIFY(::std::__is_heap(_First, _Last, _Pred),		\
      __glibcxx_check_heap(_First,_Last)
 #  define __glibcxx_requires_heap_pred(_First,_Last,_Pred) \
      __glibcxx_check_heap_pred(_First,_Last,_Pred)
-#  define __glibcxx_requires_nonempty() __glibcxx_check_nonempty()
-#  define __glibcxx_requires_string(_String) __glibcxx_check_string(_String)
-#  define __glibcxx_requires_string_len(_String,_Len)	\
-     __glibcxx_check_string_len(_String,_Len)
-#  define __glibcxx_requires_subscript(_N) __glibcxx_check_subscript(_N)
 #else
-#  define _GLIBCXX_DEBUG_ASSERT(_Condition)
-#  define _GLIBCXX_DEBUG_PEDASSERT(_Condition)
-#  define __glibcxx_requires_cond(_Cond,_Msg)
-#  define __glibcxx_requires_valid_range(_First,_Last)
 #  define __glibcxx_requires_sorted(_First,_Last)
 #  define __glibcxx_requires_sorted_pred(_First,_Last,_Pred)
 #  define __glibcxx_requires_partitioned(_First,_Last,_Value)
 #  define __glibcxx_requires_partitioned_pred(_First,_Last,_Value,_Pred)
 #  define __glibcxx_requires_heap(_First,_Last)
 #  define __glibcxx_requires_heap_pred(_First,_Last,_Pred)
-#  define __glibcxx_requires_nonempty()
-#  define __glibcxx_requires_string(_String)
-#  define __glibcxx_requires_string_len(_String,_Len)
-#  define __glibcxx_requires_subscript(_N)
 #endif
 
 #include <cassert> // TBD: temporary
@@ -523,7 +564,7 @@ namespace __gnu_debug
     }
 } // namespace __gnu_debug
 
-#ifdef _GLIBCXX_DEBUG
+#if defined(_GLIBCXX_DEBUG) || defined(_GLIBCXX_DEBUG_LIGHT)
 // We need the error formatter
 #  include <debug/formatter.h>
 #endif
@@ -1,6 +1,6 @@
 // Debug-mode error formatting implementation -*- C++ -*-
 
-// Copyright (C) 2003, 2004
+// Copyright (C) 2003, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -111,7 +111,10 @@ namespace __gnu_debug
     __msg_output_ostream,
     // istreambuf_iterator
     __msg_deref_istreambuf,
-    __msg_inc_istreambuf
+    __msg_inc_istreambuf,
+    // positions passed to containers whose iterators are not tracked
+    __msg_insert_outside,
+    __msg_erase_outside
   };
 
   class _Error_formatter
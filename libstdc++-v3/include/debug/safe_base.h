@@ -1,6 +1,6 @@
 // Safe sequence/iterator base implementation  -*- C++ -*-
 
-// Copyright (C) 2003, 2004
+// Copyright (C) 2003, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -141,6 +141,10 @@ namespace __gnu_debug
    * iterators, one for constant iterators and one for mutable
    * iterators, and a version number that allows very fast
    * invalidation of all iterators that reference the container.
+   * Attaching and detaching iterators may be done from several
+   * threads at once: the two lists are protected by a mutex which the
+   * library picks from a small pool according to the address of the
+   * sequence.
    *
    * This class must ensure that no operation on it may throw an
    * exception, otherwise "safe" sequences may fail to provide the
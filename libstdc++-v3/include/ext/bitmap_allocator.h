@@ -1,6 +1,6 @@
 // Bitmapped Allocator. -*- C++ -*-
 
-// Copyright (C) 2004 Free Software Foundation, Inc.
+// Copyright (C) 2004, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -29,831 +29,625 @@
 
 
 
-#if !defined _BITMAP_ALLOCATOR_H
+/** @file ext/bitmap_allocator.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _BITMAP_ALLOCATOR_H
 #define _BITMAP_ALLOCATOR_H 1
 
 #include <cstddef>
-//For std::size_t, and ptrdiff_t.
-#include <utility>
-//For std::pair.
-#include <algorithm>
-//std::find_if, and std::lower_bound.
-#include <vector>
-//For the free list of exponentially growing memory blocks. At max,
-//size of the vector should be  not more than the number of bits in an
-//integer or an unsigned integer.
-#include <functional>
-//For greater_equal, and less_equal.
 #include <new>
-//For operator new.
-#include <bits/gthr.h>
-//For __gthread_mutex_t, __gthread_mutex_lock and __gthread_mutex_unlock.
-#include <ext/new_allocator.h>
-//For __gnu_cxx::new_allocator for std::vector.
-
-#include <cassert>
-#define NDEBUG
-
-//#define CHECK_FOR_ERRORS
-//#define __CPU_HAS_BACKWARD_BRANCH_PREDICTION
+#include <bits/functexcept.h>
+#include <bits/concurrence.h>
 
 namespace __gnu_cxx
 {
-  namespace {
-#if defined __GTHREADS
-    bool const __threads_enabled = __gthread_active_p();
-#endif
-
-  }
-
-#if defined __GTHREADS
-  class _Mutex {
-    __gthread_mutex_t _M_mut;
-    //Prevent Copying and assignment.
-    _Mutex (_Mutex const&);
-    _Mutex& operator= (_Mutex const&);
-  public:
-    _Mutex ()
-    {
-      if (__threads_enabled)
-	{
-#if !defined __GTHREAD_MUTEX_INIT
-	  __GTHREAD_MUTEX_INIT_FUNCTION(&_M_mut);
-#else
-	  __gthread_mutex_t __mtemp = __GTHREAD_MUTEX_INIT;
-	  _M_mut = __mtemp;
-#endif
-	}
-    }
-    ~_Mutex ()
-    {
-      //Gthreads does not define a Mutex Destruction Function.
-    }
-    __gthread_mutex_t *_M_get() { return &_M_mut; }
-  };
-
-  class _Lock {
-    _Mutex* _M_pmt;
-    bool _M_locked;
-    //Prevent Copying and assignment.
-    _Lock (_Lock const&);
-    _Lock& operator= (_Lock const&);
-  public:
-    _Lock(_Mutex* __mptr)
-      : _M_pmt(__mptr), _M_locked(false)
-    { this->_M_lock(); }
-    void _M_lock()
-    {
-      if (__threads_enabled)
-	{
-	  _M_locked = true;
-	  __gthread_mutex_lock(_M_pmt->_M_get());
-	}
-    }
-    void _M_unlock()
-    {
-      if (__threads_enabled)
-	{
-	  if (__builtin_expect(_M_locked, true))
-	    {
-	      __gthread_mutex_unlock(_M_pmt->_M_get());
-	      _M_locked = false;
-	    }
-	}
-    }
-    ~_Lock() { this->_M_unlock(); }
-  };
-#endif
+  using std::size_t;
+  using std::ptrdiff_t;
 
-
-
-  namespace __aux_balloc {
-    static const unsigned int _Bits_Per_Byte = 8;
-    static const unsigned int _Bits_Per_Block = sizeof(unsigned int) * _Bits_Per_Byte;
-
-    template <typename _Addr_Pair_t>
-    inline size_t __balloc_num_blocks (_Addr_Pair_t __ap)
+  namespace __aux_balloc
+  {
+    // The memory of the allocator comes in blocks of _S_block_bytes,
+    // aligned on that size, so that the block of an object is found
+    // from its address alone.  Each block holds objects of one size,
+    // following the header and three bitmaps, 1 meaning free: the
+    // summary, with one bit per word of the free map set if that word
+    // has a free object, thus found by two "find first set"
+    // operations; the free map, of one bit per object; and the remote
+    // map, of the objects freed by other threads and not merged yet.
+    //
+    // Each size class has a bin per thread, which owns the blocks it
+    // allocates from: its thread allocates and frees without locking.
+    // Another thread freeing an object sets its bit in the remote map,
+    // under the lock of the bin, which the owner merges when its free
+    // blocks run out.  The ids of the threads, hence their bins, are
+    // reused by the threads started after they exit; the threads
+    // beyond _S_max_threads, if any, share the bins of id 0, under
+    // their lock.  The blocks freed are kept for any bin, not given
+    // back to the system.
+    typedef unsigned long _Word;
+
+    enum
+      {
+	_S_word_bits = sizeof(_Word) * __CHAR_BIT__,
+	_S_block_bytes = 16 * 1024,
+	_S_chunk_blocks = 16,
+	_S_align = 16,
+	// Objects of 1, 2, 4, 8 bytes, then multiples of 8 up to 512.
+	_S_max_bytes = 512,
+	_S_classes = 3 + _S_max_bytes / 8,
+	_S_max_threads = 1024
+      };
+
+    inline size_t
+    _S_bit_scan_forward(_Word __w)
+    { return __builtin_ctzl(__w); }
+
+    struct _Bin;
+
+    // Followed, in the block, by the bitmaps and the objects.
+    struct _Block
     {
-      return (__ap.second - __ap.first) + 1;
-    }
+      _Bin*		_M_bin;
+      _Block*		_M_next;
+      _Block*		_M_prev;
+      _Block*		_M_remote_next;
+      // Objects allocated, and not freed to the owner yet.
+      size_t		_M_used;
+      // Objects in the remote map.
+      size_t		_M_remote;
+
+      _Word*
+      _M_summary()
+      { return reinterpret_cast<_Word*>(this + 1); }
+    };
 
-    template <typename _Addr_Pair_t>
-    inline size_t __balloc_num_bit_maps (_Addr_Pair_t __ap)
+    struct _Bin
     {
-      return __balloc_num_blocks(__ap) / _Bits_Per_Block;
-    }
-
-    //T should be a pointer type.
-    template <typename _Tp>
-    class _Inclusive_between : public std::unary_function<typename std::pair<_Tp, _Tp>, bool> {
-      typedef _Tp pointer;
-      pointer _M_ptr_value;
-      typedef typename std::pair<_Tp, _Tp> _Block_pair;
-
-    public:
-      _Inclusive_between (pointer __ptr) : _M_ptr_value(__ptr) { }
-      bool operator () (_Block_pair __bp) const throw ()
+      // Blocks with free objects, allocated from first.  The owner
+      // only uses it.
+      _Block*		_M_avail;
+      // Blocks with remote frees, and their count.
+      _Block*		_M_remote_list;
+      volatile size_t	_M_remote;
+      size_t		_M_thread_id;
+      // The layout of the blocks.
+      size_t		_M_size;
+      size_t		_M_count;
+      size_t		_M_words;
+      size_t		_M_summary_words;
+      size_t		_M_offset;
+      mutex_type	_M_mutex;
+
+      void
+      _M_initialize(size_t __thread_id, size_t __size);
+
+      void*
+      _M_allocate();
+
+      void
+      _M_deallocate(_Block* __b, void* __p);
+
+      void
+      _M_deallocate_remote(_Block* __b, void* __p);
+
+    private:
+      _Block*
+      _M_refill();
+
+      void
+      _M_merge_remote();
+
+      void
+      _M_link(_Block* __b)
       {
-	if (std::less_equal<pointer> ()(_M_ptr_value, __bp.second) && 
-	    std::greater_equal<pointer> ()(_M_ptr_value, __bp.first))
-	  return true;
-	else
-	  return false;
+	__b->_M_prev = 0;
+	__b->_M_next = _M_avail;
+	if (_M_avail)
+	  _M_avail->_M_prev = __b;
+	_M_avail = __b;
       }
-    };
-  
-    //Used to pass a Functor to functions by reference.
-    template <typename _Functor>
-    class _Functor_Ref : 
-      public std::unary_function<typename _Functor::argument_type, typename _Functor::result_type> {
-      _Functor& _M_fref;
-    
-    public:
-      typedef typename _Functor::argument_type argument_type;
-      typedef typename _Functor::result_type result_type;
-
-      _Functor_Ref (_Functor& __fref) : _M_fref(__fref) { }
-      result_type operator() (argument_type __arg) { return _M_fref (__arg); }
-    };
-
-
-    //T should be a pointer type, and A is the Allocator for the vector.
-    template <typename _Tp, typename _Alloc>
-    class _Ffit_finder 
-      : public std::unary_function<typename std::pair<_Tp, _Tp>, bool> {
-      typedef typename std::vector<std::pair<_Tp, _Tp>, _Alloc> _BPVector;
-      typedef typename _BPVector::difference_type _Counter_type;
-      typedef typename std::pair<_Tp, _Tp> _Block_pair;
-
-      unsigned int *_M_pbitmap;
-      unsigned int _M_data_offset;
 
-    public:
-      _Ffit_finder () 
-	: _M_pbitmap (0), _M_data_offset (0)
-      { }
-
-      bool operator() (_Block_pair __bp) throw()
+      void
+      _M_unlink(_Block* __b)
       {
-	//Set the _rover to the last unsigned integer, which is the
-	//bitmap to the first free block. Thus, the bitmaps are in exact
-	//reverse order of the actual memory layout. So, we count down
-	//the bimaps, which is the same as moving up the memory.
-
-	//If the used count stored at the start of the Bit Map headers
-	//is equal to the number of Objects that the current Block can
-	//store, then there is definitely no space for another single
-	//object, so just return false.
-	_Counter_type __diff = __gnu_cxx::__aux_balloc::__balloc_num_bit_maps (__bp);
-
-	assert (*(reinterpret_cast<unsigned int*>(__bp.first) - (__diff + 1)) <= 
-		__gnu_cxx::__aux_balloc::__balloc_num_blocks (__bp));
-
-	if (*(reinterpret_cast<unsigned int*>(__bp.first) - (__diff + 1)) == 
-	    __gnu_cxx::__aux_balloc::__balloc_num_blocks (__bp))
-	  return false;
-
-	unsigned int *__rover = reinterpret_cast<unsigned int*>(__bp.first) - 1;
-	for (_Counter_type __i = 0; __i < __diff; ++__i)
-	  {
-	    _M_data_offset = __i;
-	    if (*__rover)
-	      {
-		_M_pbitmap = __rover;
-		return true;
-	      }
-	    --__rover;
-	  }
-	return false;
-      }
-    
-      unsigned int *_M_get () { return _M_pbitmap; }
-      unsigned int _M_offset () { return _M_data_offset * _Bits_Per_Block; }
-    };
-  
-    //T should be a pointer type.
-    template <typename _Tp, typename _Alloc>
-    class _Bit_map_counter {
-    
-      typedef typename std::vector<std::pair<_Tp, _Tp>, _Alloc> _BPVector;
-      typedef typename _BPVector::size_type _Index_type;
-      typedef _Tp pointer;
-    
-      _BPVector& _M_vbp;
-      unsigned int *_M_curr_bmap;
-      unsigned int *_M_last_bmap_in_block;
-      _Index_type _M_curr_index;
-    
-    public:
-      //Use the 2nd parameter with care. Make sure that such an entry
-      //exists in the vector before passing that particular index to
-      //this ctor.
-      _Bit_map_counter (_BPVector& Rvbp, int __index = -1) 
-	: _M_vbp(Rvbp)
-      {
-	this->_M_reset(__index);
-      }
-    
-      void _M_reset (int __index = -1) throw()
-      {
-	if (__index == -1)
-	  {
-	    _M_curr_bmap = 0;
-	    _M_curr_index = (_Index_type)-1;
-	    return;
-	  }
-
-	_M_curr_index = __index;
-	_M_curr_bmap = reinterpret_cast<unsigned int*>(_M_vbp[_M_curr_index].first) - 1;
-
-	assert (__index <= (int)_M_vbp.size() - 1);
-	
-	_M_last_bmap_in_block = _M_curr_bmap - 
-	  ((_M_vbp[_M_curr_index].second - _M_vbp[_M_curr_index].first + 1) / _Bits_Per_Block - 1);
-      }
-    
-      //Dangerous Function! Use with extreme care. Pass to this
-      //function ONLY those values that are known to be correct,
-      //otherwise this will mess up big time.
-      void _M_set_internal_bit_map (unsigned int *__new_internal_marker) throw()
-      {
-	_M_curr_bmap = __new_internal_marker;
-      }
-    
-      bool _M_finished () const throw()
-      {
-	return (_M_curr_bmap == 0);
-      }
-    
-      _Bit_map_counter& operator++ () throw()
-      {
-	if (_M_curr_bmap == _M_last_bmap_in_block)
-	  {
-	    if (++_M_curr_index == _M_vbp.size())
-	      {
-		_M_curr_bmap = 0;
-	      }
-	    else
-	      {
-		this->_M_reset (_M_curr_index);
-	      }
-	  }
+	if (__b->_M_prev)
+	  __b->_M_prev->_M_next = __b->_M_next;
 	else
-	  {
-	    --_M_curr_bmap;
-	  }
-	return *this;
-      }
-    
-      unsigned int *_M_get ()
-      {
-	return _M_curr_bmap;
+	  _M_avail = __b->_M_next;
+	if (__b->_M_next)
+	  __b->_M_next->_M_prev = __b->_M_prev;
       }
-    
-      pointer _M_base () { return _M_vbp[_M_curr_index].first; }
-      unsigned int _M_offset ()
+
+      // Position of __p in the maps of __b.
+      void
+      _M_index(_Block* __b, void* __p, size_t& __word, _Word& __bit)
       {
-	return _Bits_Per_Block * ((reinterpret_cast<unsigned int*>(this->_M_base()) - _M_curr_bmap) - 1);
+	const size_t __i = ((static_cast<char*>(__p)
+			     - reinterpret_cast<char*>(__b) - _M_offset)
+			    / _M_size);
+	__word = __i / _S_word_bits;
+	__bit = _Word(1) << (__i % _S_word_bits);
       }
-    
-      unsigned int _M_where () { return _M_curr_index; }
     };
-  }
 
-  //Generic Version of the bsf instruction.
-  typedef unsigned int _Bit_map_type;
-  static inline unsigned int _Bit_scan_forward (register _Bit_map_type __num)
-  {
-    return static_cast<unsigned int>(__builtin_ctz(__num));
-  }
-
-  struct _OOM_handler {
-    static std::new_handler _S_old_handler;
-    static bool _S_handled_oom;
-    typedef void (*_FL_clear_proc)(void);
-    static _FL_clear_proc _S_oom_fcp;
-    
-    _OOM_handler (_FL_clear_proc __fcp)
-    {
-      _S_oom_fcp = __fcp;
-      _S_old_handler = std::set_new_handler (_S_handle_oom_proc);
-      _S_handled_oom = false;
-    }
+    // The state shared by all the bitmap_allocators.  A template, for
+    // its static members to be defined in this header.
+    template<int _Inst>
+      struct _Pool
+      {
+	// The bins of each thread id, allocated on its first use.
+	static _Bin*		_S_bins[_S_max_threads];
 
-    static void _S_handle_oom_proc()
-    {
-      _S_oom_fcp();
-      std::set_new_handler (_S_old_handler);
-      _S_handled_oom = true;
-    }
+	// Blocks ready for any bin, linked through their first word.
+	static void*		_S_free_blocks;
 
-    ~_OOM_handler ()
-    {
-      if (!_S_handled_oom)
-	std::set_new_handler (_S_old_handler);
-    }
-  };
-  
-  std::new_handler _OOM_handler::_S_old_handler;
-  bool _OOM_handler::_S_handled_oom = false;
-  _OOM_handler::_FL_clear_proc _OOM_handler::_S_oom_fcp = 0;
-  
-
-  class _BA_free_list_store {
-    struct _LT_pointer_compare {
-      template <typename _Tp>
-      bool operator() (_Tp* __pt, _Tp const& __crt) const throw()
-      {
-	return *__pt < __crt;
-      }
-    };
+	// For the thread ids and the bins of id 0.
+	static mutex_type	_S_mutex;
 
-#if defined __GTHREADS
-    static _Mutex _S_bfl_mutex;
-#endif
-    static std::vector<unsigned int*> _S_free_list;
-    typedef std::vector<unsigned int*>::iterator _FLIter;
+	// For _S_free_blocks.
+	static mutex_type	_S_block_mutex;
 
-    static void _S_validate_free_list(unsigned int *__addr) throw()
-    {
-      const unsigned int __max_size = 64;
-      if (_S_free_list.size() >= __max_size)
+#ifdef __GTHREADS
+	static __gthread_key_t	_S_key;
+	static __gthread_once_t	_S_once;
+	static size_t		_S_free_ids[_S_max_threads];
+	static size_t		_S_nfree_ids;
+	static size_t		_S_next_id;
+
+	static void
+	_S_create_key()
+	{ __gthread_key_create(&_S_key, _S_release_id); }
+
+	static void
+	_S_release_id(void* __v)
 	{
-	  //Ok, the threshold value has been reached.
-	  //We determine which block to remove from the list of free
-	  //blocks.
-	  if (*__addr >= *_S_free_list.back())
+	  const size_t __id = reinterpret_cast<size_t>(__v);
+	  if (__id < _S_max_threads)
 	    {
-	      //Ok, the new block is greater than or equal to the last
-	      //block in the list of free blocks. We just free the new
-	      //block.
-	      operator delete((void*)__addr);
-	      return;
+	      lock __l(_S_mutex);
+	      _S_free_ids[_S_nfree_ids++] = __id;
 	    }
-	  else
+	}
+#endif
+
+	// 0 when the threads are not active, or too many.
+	static size_t
+	_S_thread_id()
+	{
+#ifdef __GTHREADS
+	  if (__gthread_active_p())
 	    {
-	      //Deallocate the last block in the list of free lists, and
-	      //insert the new one in it's correct position.
-	      operator delete((void*)_S_free_list.back());
-	      _S_free_list.pop_back();
+	      __gthread_once(&_S_once, _S_create_key);
+	      size_t __id = reinterpret_cast<size_t>(__gthread_getspecific(_S_key));
+	      if (__builtin_expect(__id == 0, false))
+		{
+		  {
+		    lock __l(_S_mutex);
+		    if (_S_nfree_ids)
+		      __id = _S_free_ids[--_S_nfree_ids];
+		    else if (_S_next_id < _S_max_threads)
+		      __id = _S_next_id++;
+		    else
+		      __id = _S_max_threads;
+		  }
+		  __gthread_setspecific(_S_key, reinterpret_cast<void*>(__id));
+		}
+	      return __id < _S_max_threads ? __id : 0;
 	    }
+#endif
+	  return 0;
 	}
-	  
-      //Just add the block to the list of free lists
-      //unconditionally.
-      _FLIter __temp = std::lower_bound(_S_free_list.begin(), _S_free_list.end(), 
-					*__addr, _LT_pointer_compare ());
-      //We may insert the new free list before _temp;
-      _S_free_list.insert(__temp, __addr);
-    }
 
-    static bool _S_should_i_give(unsigned int __block_size, unsigned int __required_size) throw()
-    {
-      const unsigned int __max_wastage_percentage = 36;
-      if (__block_size >= __required_size && 
-	  (((__block_size - __required_size) * 100 / __block_size) < __max_wastage_percentage))
-	return true;
-      else
-	return false;
-    }
+	static size_t
+	_S_class(size_t __bytes)
+	{
+	  if (__bytes <= 8)
+	    return __bytes <= 2 ? __bytes - 1 : __bytes <= 4 ? 2 : 3;
+	  return 2 + (__bytes + 7) / 8;
+	}
 
-  public:
-    typedef _BA_free_list_store _BFL_type;
+	static size_t
+	_S_class_size(size_t __c)
+	{ return __c < 4 ? size_t(1) << __c : (__c - 2) * 8; }
 
-    static inline void _S_insert_free_list(unsigned int *__addr) throw()
-    {
-#if defined __GTHREADS
-      _Lock __bfl_lock(&_S_bfl_mutex);
-#endif
-      //Call _S_validate_free_list to decide what should be done with this
-      //particular free list.
-      _S_validate_free_list(--__addr);
-    }
-    
-    static unsigned int *_S_get_free_list(unsigned int __sz) throw (std::bad_alloc)
-    {
-#if defined __GTHREADS
-      _Lock __bfl_lock(&_S_bfl_mutex);
-#endif
-      _FLIter __temp = std::lower_bound(_S_free_list.begin(), _S_free_list.end(), 
-					__sz, _LT_pointer_compare());
-      if (__temp == _S_free_list.end() || !_S_should_i_give (**__temp, __sz))
+	static _Bin*
+	_S_bins_of(size_t __id)
 	{
-	  //We hold the lock because the OOM_Handler is a stateless
-	  //entity.
-	  _OOM_handler __set_handler(_BFL_type::_S_clear);
-	  unsigned int *__ret_val = reinterpret_cast<unsigned int*>
-	    (operator new (__sz + sizeof(unsigned int)));
-	  *__ret_val = __sz;
-	  return ++__ret_val;
+	  _Bin* __bins = _S_bins[__id];
+	  if (__builtin_expect(!__bins, false))
+	    {
+	      // Only the thread of __id gets here, but for id 0.
+	      void* __v = ::operator new(sizeof(_Bin) * _S_classes);
+	      __bins = static_cast<_Bin*>(__v);
+	      for (size_t __c = 0; __c < _S_classes; ++__c)
+		__bins[__c]._M_initialize(__id, _S_class_size(__c));
+	      _S_bins[__id] = __bins;
+	    }
+	  return __bins;
 	}
-      else
+
+	static void*
+	_S_allocate(size_t __bytes)
 	{
-	  unsigned int* __ret_val = *__temp;
-	  _S_free_list.erase (__temp);
-	  return ++__ret_val;
+	  const size_t __id = _S_thread_id();
+	  if (__id)
+	    return _S_bins_of(__id)[_S_class(__bytes)]._M_allocate();
+
+	  lock __l(_S_mutex);
+	  return _S_bins_of(0)[_S_class(__bytes)]._M_allocate();
 	}
-    }
 
-    //This function just clears the internal Free List, and gives back
-    //all the memory to the OS.
-    static void _S_clear()
-    {
-#if defined __GTHREADS
-      _Lock __bfl_lock(&_S_bfl_mutex);
-#endif
-      _FLIter __iter = _S_free_list.begin();
-      while (__iter != _S_free_list.end())
+	static void
+	_S_deallocate(void* __p)
 	{
-	  operator delete((void*)*__iter);
-	  ++__iter;
+	  const size_t __addr = reinterpret_cast<size_t>(__p);
+	  _Block* __b = reinterpret_cast<_Block*>(__addr & ~size_t(_S_block_bytes
+								  - 1));
+	  _Bin* __bin = __b->_M_bin;
+	  const size_t __id = _S_thread_id();
+	  if (__id && __bin->_M_thread_id == __id)
+	    __bin->_M_deallocate(__b, __p);
+	  else if (__bin->_M_thread_id == 0)
+	    {
+	      lock __l(_S_mutex);
+	      __bin->_M_deallocate(__b, __p);
+	    }
+	  else
+	    __bin->_M_deallocate_remote(__b, __p);
 	}
-      _S_free_list.clear();
-    }
-
-  };
-
-#if defined __GTHREADS
-  _Mutex _BA_free_list_store::_S_bfl_mutex;
-#endif
-  std::vector<unsigned int*> _BA_free_list_store::_S_free_list;
-
-  template <typename _Tp> class bitmap_allocator;
-  // specialize for void:
-  template <> class bitmap_allocator<void> {
-  public:
-    typedef void*       pointer;
-    typedef const void* const_pointer;
-    //  reference-to-void members are impossible.
-    typedef void  value_type;
-    template <typename _Tp1> struct rebind { typedef bitmap_allocator<_Tp1> other; };
-  };
-
-  template <typename _Tp> class bitmap_allocator : private _BA_free_list_store {
-  public:
-    typedef size_t    size_type;
-    typedef ptrdiff_t difference_type;
-    typedef _Tp*        pointer;
-    typedef const _Tp*  const_pointer;
-    typedef _Tp&        reference;
-    typedef const _Tp&  const_reference;
-    typedef _Tp         value_type;
-    template <typename _Tp1> struct rebind { typedef bitmap_allocator<_Tp1> other; };
-
-  private:
-    static const unsigned int _Bits_Per_Byte = 8;
-    static const unsigned int _Bits_Per_Block = sizeof(unsigned int) * _Bits_Per_Byte;
-
-    static inline void _S_bit_allocate(unsigned int *__pbmap, unsigned int __pos) throw()
-    {
-      unsigned int __mask = 1 << __pos;
-      __mask = ~__mask;
-      *__pbmap &= __mask;
-    }
-  
-    static inline void _S_bit_free(unsigned int *__pbmap, unsigned int __pos) throw()
-    {
-      unsigned int __mask = 1 << __pos;
-      *__pbmap |= __mask;
-    }
-
-    static inline void *_S_memory_get(size_t __sz) throw (std::bad_alloc)
-    {
-      return operator new(__sz);
-    }
-
-    static inline void _S_memory_put(void *__vptr) throw ()
-    {
-      operator delete(__vptr);
-    }
-
-    typedef typename std::pair<pointer, pointer> _Block_pair;
-    typedef typename __gnu_cxx::new_allocator<_Block_pair> _BPVec_allocator_type;
-    typedef typename std::vector<_Block_pair, _BPVec_allocator_type> _BPVector;
-
 
-#if defined CHECK_FOR_ERRORS
-    //Complexity: O(lg(N)). Where, N is the number of block of size
-    //sizeof(value_type).
-    static void _S_check_for_free_blocks() throw()
-    {
-      typedef typename __gnu_cxx::__aux_balloc::_Ffit_finder<pointer, _BPVec_allocator_type> _FFF;
-      _FFF __fff;
-      typedef typename _BPVector::iterator _BPiter;
-      _BPiter __bpi = std::find_if(_S_mem_blocks.begin(), _S_mem_blocks.end(), 
-				   __gnu_cxx::__aux_balloc::_Functor_Ref<_FFF>(__fff));
-      assert(__bpi == _S_mem_blocks.end());
-    }
-#endif
+	static _Block*
+	_S_get_block()
+	{
+	  lock __l(_S_block_mutex);
+	  if (!_S_free_blocks)
+	    {
+	      // The first and last blocks of a chunk may be cut by the
+	      // alignment.
+	      const size_t __bytes = _S_chunk_blocks * size_t(_S_block_bytes);
+	      char* __chunk = static_cast<char*>(::operator new(__bytes));
+	      char* __end = __chunk + __bytes;
+	      const size_t __mask = _S_block_bytes - 1;
+	      char* __b = __chunk + ((_S_block_bytes
+				     - (reinterpret_cast<size_t>(__chunk)
+					& __mask)) & __mask);
+	      for (; __end - __b >= ptrdiff_t(_S_block_bytes);
+		   __b += _S_block_bytes)
+		{
+		  *reinterpret_cast<void**>(__b) = _S_free_blocks;
+		  _S_free_blocks = __b;
+		}
+	    }
+	  void* __ret = _S_free_blocks;
+	  _S_free_blocks = *static_cast<void**>(__ret);
+	  return static_cast<_Block*>(__ret);
+	}
 
+	static void
+	_S_put_block(_Block* __b)
+	{
+	  lock __l(_S_block_mutex);
+	  *reinterpret_cast<void**>(__b) = _S_free_blocks;
+	  _S_free_blocks = __b;
+	}
+      };
 
-    //Complexity: O(1), but internally depends upon the complexity of
-    //the function _BA_free_list_store::_S_get_free_list. The part
-    //where the bitmap headers are written is of worst case complexity:
-    //O(X),where X is the number of blocks of size sizeof(value_type)
-    //within the newly acquired block. Having a tight bound.
-    static void _S_refill_pool() throw (std::bad_alloc)
-    {
-#if defined CHECK_FOR_ERRORS
-      _S_check_for_free_blocks();
-#endif
+    template<int _Inst>
+      _Bin* _Pool<_Inst>::_S_bins[_S_max_threads];
 
-      const unsigned int __num_bit_maps = _S_block_size / _Bits_Per_Block;
-      const unsigned int __size_to_allocate = sizeof(unsigned int) + 
-	_S_block_size * sizeof(value_type) + __num_bit_maps*sizeof(unsigned int);
+    template<int _Inst>
+      void* _Pool<_Inst>::_S_free_blocks;
 
-      unsigned int *__temp = 
-	reinterpret_cast<unsigned int*>(_BA_free_list_store::_S_get_free_list(__size_to_allocate));
-      *__temp = 0;
-      ++__temp;
+    template<int _Inst>
+      __glibcxx_mutex_define_initialized(_Pool<_Inst>::_S_mutex);
 
-      //The Header information goes at the Beginning of the Block.
-      _Block_pair __bp = std::make_pair(reinterpret_cast<pointer>(__temp + __num_bit_maps), 
-				       reinterpret_cast<pointer>(__temp + __num_bit_maps) 
-					+ _S_block_size - 1);
+    template<int _Inst>
+      __glibcxx_mutex_define_initialized(_Pool<_Inst>::_S_block_mutex);
 
-      //Fill the Vector with this information.
-      _S_mem_blocks.push_back(__bp);
+#ifdef __GTHREADS
+    template<int _Inst>
+      __gthread_key_t _Pool<_Inst>::_S_key;
 
-      unsigned int __bit_mask = 0; //0 Indicates all Allocated.
-      __bit_mask = ~__bit_mask; //1 Indicates all Free.
+    template<int _Inst>
+      __gthread_once_t _Pool<_Inst>::_S_once = __GTHREAD_ONCE_INIT;
 
-      for (unsigned int __i = 0; __i < __num_bit_maps; ++__i)
-	__temp[__i] = __bit_mask;
+    template<int _Inst>
+      size_t _Pool<_Inst>::_S_free_ids[_S_max_threads];
 
-      //On some implementations, operator new might throw bad_alloc, or
-      //malloc might fail if the size passed is too large, therefore, we
-      //limit the size passed to malloc or operator new.
-      _S_block_size *= 2;
-    }
+    template<int _Inst>
+      size_t _Pool<_Inst>::_S_nfree_ids;
 
-    static _BPVector _S_mem_blocks;
-    static unsigned int _S_block_size;
-    static __gnu_cxx::__aux_balloc::_Bit_map_counter<pointer, _BPVec_allocator_type> _S_last_request;
-    static typename _BPVector::size_type _S_last_dealloc_index;
-#if defined __GTHREADS
-    static _Mutex _S_mut;
+    // Id 0 is the shared one.
+    template<int _Inst>
+      size_t _Pool<_Inst>::_S_next_id = 1;
 #endif
 
-    //Complexity: Worst case complexity is O(N), but that is hardly ever
-    //hit. if and when this particular case is encountered, the next few
-    //cases are guaranteed to have a worst case complexity of O(1)!
-    //That's why this function performs very well on the average. you
-    //can consider this function to be having a complexity refrred to
-    //commonly as: Amortized Constant time.
-    static pointer _S_allocate_single_object()
+    inline void
+    _Bin::_M_initialize(size_t __thread_id, size_t __size)
     {
-#if defined __GTHREADS
-      _Lock __bit_lock(&_S_mut);
+      _M_avail = 0;
+      _M_remote_list = 0;
+      _M_remote = 0;
+      _M_thread_id = __thread_id;
+      _M_size = __size;
+#ifdef __GTHREAD_MUTEX_INIT
+      mutex_type __tmp = __GTHREAD_MUTEX_INIT;
+      _M_mutex = __tmp;
+#else
+      ::new(&_M_mutex) mutex_type;
 #endif
 
-      //The algorithm is something like this: The last_requst variable
-      //points to the last accessed Bit Map. When such a condition
-      //occurs, we try to find a free block in the current bitmap, or
-      //succeeding bitmaps until the last bitmap is reached. If no free
-      //block turns up, we resort to First Fit method.
-
-      //WARNING: Do not re-order the condition in the while statement
-      //below, because it relies on C++'s short-circuit
-      //evaluation. The return from _S_last_request->_M_get() will NOT
-      //be dereferenceable if _S_last_request->_M_finished() returns
-      //true. This would inevitibly lead to a NULL pointer dereference
-      //if tinkered with.
-      while (_S_last_request._M_finished() == false && (*(_S_last_request._M_get()) == 0))
+      // As many objects as fit after the header and the maps, of two
+      // bits per object, and a bit more for the summary.
+      size_t __count = ((_S_block_bytes - sizeof(_Block) - _S_align)
+			* __CHAR_BIT__ / (__size * __CHAR_BIT__ + 2));
+      for (;;)
 	{
-	  _S_last_request.operator++();
+	  _M_words = (__count + _S_word_bits - 1) / _S_word_bits;
+	  _M_summary_words = (_M_words + _S_word_bits - 1) / _S_word_bits;
+	  _M_offset = (sizeof(_Block)
+		       + (_M_summary_words + 2 * _M_words) * sizeof(_Word)
+		       + _S_align - 1) & ~size_t(_S_align - 1);
+	  const size_t __need = _M_offset + __count * __size;
+	  if (__need <= _S_block_bytes)
+	    break;
+	  __count -= (__need - _S_block_bytes + __size - 1) / __size;
 	}
-
-      if (__builtin_expect(_S_last_request._M_finished() == true, false))
-	{
-	  //Fall Back to First Fit algorithm.
-	  typedef typename __gnu_cxx::__aux_balloc::_Ffit_finder<pointer, _BPVec_allocator_type> _FFF;
-	  _FFF __fff;
-	  typedef typename _BPVector::iterator _BPiter;
-	  _BPiter __bpi = std::find_if(_S_mem_blocks.begin(), _S_mem_blocks.end(), 
-				      __gnu_cxx::__aux_balloc::_Functor_Ref<_FFF>(__fff));
-
-	  if (__bpi != _S_mem_blocks.end())
-	    {
-	      //Search was successful. Ok, now mark the first bit from
-	      //the right as 0, meaning Allocated. This bit is obtained
-	      //by calling _M_get() on __fff.
-	      unsigned int __nz_bit = _Bit_scan_forward(*__fff._M_get());
-	      _S_bit_allocate(__fff._M_get(), __nz_bit);
-
-	      _S_last_request._M_reset(__bpi - _S_mem_blocks.begin());
-
-	      //Now, get the address of the bit we marked as allocated.
-	      pointer __ret_val = __bpi->first + __fff._M_offset() + __nz_bit;
-	      unsigned int *__puse_count = reinterpret_cast<unsigned int*>(__bpi->first) - 
-		(__gnu_cxx::__aux_balloc::__balloc_num_bit_maps(*__bpi) + 1);
-	      ++(*__puse_count);
-	      return __ret_val;
-	    }
-	  else
-	    {
-	      //Search was unsuccessful. We Add more memory to the pool
-	      //by calling _S_refill_pool().
-	      _S_refill_pool();
-
-	      //_M_Reset the _S_last_request structure to the first free
-	      //block's bit map.
-	      _S_last_request._M_reset(_S_mem_blocks.size() - 1);
-
-	      //Now, mark that bit as allocated.
-	    }
-	}
-      //_S_last_request holds a pointer to a valid bit map, that points
-      //to a free block in memory.
-      unsigned int __nz_bit = _Bit_scan_forward(*_S_last_request._M_get());
-      _S_bit_allocate(_S_last_request._M_get(), __nz_bit);
-
-      pointer __ret_val = _S_last_request._M_base() + _S_last_request._M_offset() + __nz_bit;
-
-      unsigned int *__puse_count = reinterpret_cast<unsigned int*>
-	(_S_mem_blocks[_S_last_request._M_where()].first) - 
-	(__gnu_cxx::__aux_balloc::__balloc_num_bit_maps(_S_mem_blocks[_S_last_request._M_where()]) + 1);
-      ++(*__puse_count);
-      return __ret_val;
+      _M_count = __count;
     }
 
-    //Complexity: O(lg(N)), but the worst case is hit quite often! I
-    //need to do something about this. I'll be able to work on it, only
-    //when I have some solid figures from a few real apps.
-    static void _S_deallocate_single_object(pointer __p) throw()
+    inline void*
+    _Bin::_M_allocate()
     {
-#if defined __GTHREADS
-      _Lock __bit_lock(&_S_mut);
-#endif
-
-      typedef typename _BPVector::iterator _Iterator;
-      typedef typename _BPVector::difference_type _Difference_type;
-
-      _Difference_type __diff;
-      int __displacement;
-
-      assert(_S_last_dealloc_index >= 0);
+      _Block* __b = _M_avail;
+      if (__builtin_expect(!__b, false))
+	__b = _M_refill();
+
+      _Word* __summary = __b->_M_summary();
+      _Word* __map = __summary + _M_summary_words;
+      size_t __s = 0;
+      while (!__summary[__s])
+	++__s;
+      const size_t __w = __s * _S_word_bits
+	                 + _S_bit_scan_forward(__summary[__s]);
+      const size_t __i = __w * _S_word_bits + _S_bit_scan_forward(__map[__w]);
+      __map[__w] &= __map[__w] - 1;
+      if (!__map[__w])
+	__summary[__s] &= __summary[__s] - 1;
+
+      if (++__b->_M_used == _M_count)
+	_M_unlink(__b);
+      return reinterpret_cast<char*>(__b) + _M_offset + __i * _M_size;
+    }
 
-      if (__gnu_cxx::__aux_balloc::_Inclusive_between<pointer>(__p)(_S_mem_blocks[_S_last_dealloc_index]))
+    inline void
+    _Bin::_M_deallocate(_Block* __b, void* __p)
+    {
+      size_t __w;
+      _Word __bit;
+      _M_index(__b, __p, __w, __bit);
+      _Word* __summary = __b->_M_summary();
+      _Word* __map = __summary + _M_summary_words;
+      if (!__map[__w])
+	__summary[__w / _S_word_bits] |= _Word(1) << (__w % _S_word_bits);
+      __map[__w] |= __bit;
+
+      if (__b->_M_used-- == _M_count)
+	_M_link(__b);
+      else if (__b->_M_used == 0 && (__b->_M_prev || __b->_M_next))
 	{
-	  assert(_S_last_dealloc_index <= _S_mem_blocks.size() - 1);
-
-	  //Initial Assumption was correct!
-	  __diff = _S_last_dealloc_index;
-	  __displacement = __p - _S_mem_blocks[__diff].first;
+	  // Keep one block at least.
+	  _M_unlink(__b);
+	  _Pool<0>::_S_put_block(__b);
 	}
-      else
-	{
-	  _Iterator _iter = (std::find_if(_S_mem_blocks.begin(), _S_mem_blocks.end(), 
-					  __gnu_cxx::__aux_balloc::_Inclusive_between<pointer>(__p)));
-	  assert(_iter != _S_mem_blocks.end());
+    }
 
-	  __diff = _iter - _S_mem_blocks.begin();
-	  __displacement = __p - _S_mem_blocks[__diff].first;
-	  _S_last_dealloc_index = __diff;
+    inline void
+    _Bin::_M_deallocate_remote(_Block* __b, void* __p)
+    {
+      size_t __w;
+      _Word __bit;
+      _M_index(__b, __p, __w, __bit);
+      _Word* __remote = __b->_M_summary() + _M_summary_words + _M_words;
+
+      lock __l(_M_mutex);
+      __remote[__w] |= __bit;
+      if (__b->_M_remote++ == 0)
+	{
+	  __b->_M_remote_next = _M_remote_list;
+	  _M_remote_list = __b;
 	}
+      ++_M_remote;
+    }
 
-      //Get the position of the iterator that has been found.
-      const unsigned int __rotate = __displacement % _Bits_Per_Block;
-      unsigned int *__bit_mapC = reinterpret_cast<unsigned int*>(_S_mem_blocks[__diff].first) - 1;
-      __bit_mapC -= (__displacement / _Bits_Per_Block);
-      
-      _S_bit_free(__bit_mapC, __rotate);
-      unsigned int *__puse_count = reinterpret_cast<unsigned int*>
-	(_S_mem_blocks[__diff].first) - 
-	(__gnu_cxx::__aux_balloc::__balloc_num_bit_maps(_S_mem_blocks[__diff]) + 1);
-
-      assert(*__puse_count != 0);
-
-      --(*__puse_count);
-
-      if (__builtin_expect(*__puse_count == 0, false))
+    inline void
+    _Bin::_M_merge_remote()
+    {
+      lock __l(_M_mutex);
+      _Block* __next;
+      for (_Block* __b = _M_remote_list; __b; __b = __next)
 	{
-	  _S_block_size /= 2;
-	  
-	  //We may safely remove this block.
-	  _Block_pair __bp = _S_mem_blocks[__diff];
-	  _S_insert_free_list(__puse_count);
-	  _S_mem_blocks.erase(_S_mem_blocks.begin() + __diff);
-
-	  //We reset the _S_last_request variable to reflect the erased
-	  //block. We do this to protect future requests after the last
-	  //block has been removed from a particular memory Chunk,
-	  //which in turn has been returned to the free list, and
-	  //hence had been erased from the vector, so the size of the
-	  //vector gets reduced by 1.
-	  if ((_Difference_type)_S_last_request._M_where() >= __diff--)
-	    {
-	      _S_last_request._M_reset(__diff);
-	      //	      assert(__diff >= 0);
-	    }
+	  __next = __b->_M_remote_next;
+	  _Word* __summary = __b->_M_summary();
+	  _Word* __map = __summary + _M_summary_words;
+	  _Word* __remote = __map + _M_words;
+	  for (size_t __w = 0; __w < _M_words; ++__w)
+	    if (__remote[__w])
+	      {
+		if (!__map[__w])
+		  __summary[__w / _S_word_bits] |= (_Word(1)
+						    << (__w % _S_word_bits));
+		__map[__w] |= __remote[__w];
+		__remote[__w] = 0;
+	      }
 
-	  //If the Index into the vector of the region of memory that
-	  //might hold the next address that will be passed to
-	  //deallocated may have been invalidated due to the above
-	  //erase procedure being called on the vector, hence we try
-	  //to restore this invariant too.
-	  if (_S_last_dealloc_index >= _S_mem_blocks.size())
+	  // Only full blocks are not linked already.
+	  if (__b->_M_used == _M_count)
+	    _M_link(__b);
+	  __b->_M_used -= __b->_M_remote;
+	  __b->_M_remote = 0;
+	  if (__b->_M_used == 0 && (__b->_M_prev || __b->_M_next))
 	    {
-	      _S_last_dealloc_index =(__diff != -1 ? __diff : 0);
-	      assert(_S_last_dealloc_index >= 0);
+	      _M_unlink(__b);
+	      _Pool<0>::_S_put_block(__b);
 	    }
 	}
+      _M_remote_list = 0;
+      _M_remote = 0;
     }
 
-  public:
-    bitmap_allocator() throw()
-    { }
+    inline _Block*
+    _Bin::_M_refill()
+    {
+      if (_M_remote)
+	_M_merge_remote();
+      if (_M_avail)
+	return _M_avail;
+
+      _Block* __b = _Pool<0>::_S_get_block();
+      __b->_M_bin = this;
+      __b->_M_remote_next = 0;
+      __b->_M_used = 0;
+      __b->_M_remote = 0;
+
+      // All the objects free, none remote.
+      _Word* __summary = __b->_M_summary();
+      _Word* __map = __summary + _M_summary_words;
+      for (size_t __s = 0; __s < _M_summary_words; ++__s)
+	__summary[__s] = 0;
+      for (size_t __w = 0; __w < _M_words; ++__w)
+	{
+	  const size_t __first = __w * _S_word_bits;
+	  const size_t __n = _M_count - __first;
+	  __map[__w] = (__n >= size_t(_S_word_bits)
+			? ~_Word(0) : (_Word(1) << __n) - 1);
+	  __map[_M_words + __w] = 0;
+	  __summary[__w / _S_word_bits] |= _Word(1) << (__w % _S_word_bits);
+	}
+      _M_link(__b);
+      return __b;
+    }
+  } // namespace __aux_balloc
 
-    bitmap_allocator(const bitmap_allocator&) { }
+  template<typename _Tp>
+    class bitmap_allocator;
 
-    template <typename _Tp1> bitmap_allocator(const bitmap_allocator<_Tp1>&) throw()
-    { }
+  /// bitmap_allocator specialization for void.
+  template<>
+    class bitmap_allocator<void>
+    {
+    public:
+      typedef void*       pointer;
+      typedef const void* const_pointer;
 
-    ~bitmap_allocator() throw()
-    { }
+      // Reference-to-void members are impossible.
+      typedef void        value_type;
 
-    //Complexity: O(1), but internally the complexity depends upon the
-    //complexity of the function(s) _S_allocate_single_object and
-    //_S_memory_get.
-    pointer allocate(size_type __n)
-    {
-      if (__builtin_expect(__n == 1, true))
-	return _S_allocate_single_object();
-      else
-	return reinterpret_cast<pointer>(_S_memory_get(__n * sizeof(value_type)));
-    }
+      template<typename _Tp1>
+        struct rebind
+        { typedef bitmap_allocator<_Tp1> other; };
+    };
 
-    //Complexity: Worst case complexity is O(N) where N is the number of
-    //blocks of size sizeof(value_type) within the free lists that the
-    //allocator holds. However, this worst case is hit only when the
-    //user supplies a bogus argument to hint. If the hint argument is
-    //sensible, then the complexity drops to O(lg(N)), and in extreme
-    //cases, even drops to as low as O(1). So, if the user supplied
-    //argument is good, then this function performs very well.
-    pointer allocate(size_type __n, typename bitmap_allocator<void>::const_pointer)
+  /**
+   *  @brief  An allocator which keeps track of the free objects of
+   *  each block with a bitmap.
+   *
+   *  Requests of up to 512 bytes, for one object or a few, are served
+   *  from blocks of objects of their size class, owned by each thread,
+   *  anything else by operator new.  The objects freed by another
+   *  thread than their owner are handed back to it.
+   *
+   *  All the bitmap_allocators share the same blocks: they always
+   *  compare equal.
+   */
+  template<typename _Tp>
+    class bitmap_allocator
     {
-      return allocate(__n);
-    }
+    public:
+      typedef size_t     size_type;
+      typedef ptrdiff_t  difference_type;
+      typedef _Tp*       pointer;
+      typedef const _Tp* const_pointer;
+      typedef _Tp&       reference;
+      typedef const _Tp& const_reference;
+      typedef _Tp        value_type;
 
-    void deallocate(pointer __p, size_type __n) throw()
-    {
-      if (__builtin_expect(__n == 1, true))
-	_S_deallocate_single_object(__p);
-      else
-	_S_memory_put(__p);
-    }
+      template<typename _Tp1>
+        struct rebind
+        { typedef bitmap_allocator<_Tp1> other; };
 
-    pointer address(reference r) const { return &r; }
-    const_pointer address(const_reference r) const { return &r; }
+      bitmap_allocator() throw() { }
 
-    size_type max_size(void) const throw() { return (size_type()-1)/sizeof(value_type); }
+      bitmap_allocator(const bitmap_allocator&) throw() { }
 
-    void construct (pointer p, const_reference __data)
-    {
-      ::new(p) value_type(__data);
-    }
+      template<typename _Tp1>
+        bitmap_allocator(const bitmap_allocator<_Tp1>&) throw() { }
 
-    void destroy (pointer p)
-    {
-      p->~value_type();
-    }
+      ~bitmap_allocator() throw() { }
+
+      pointer
+      address(reference __x) const { return &__x; }
+
+      const_pointer
+      address(const_reference __x) const { return &__x; }
 
-  };
+      pointer
+      allocate(size_type __n, const void* = 0)
+      {
+	if (__builtin_expect(__n > this->max_size(), false))
+	  std::__throw_bad_alloc();
+
+	const size_t __bytes = __n * sizeof(_Tp);
+	if (_S_pooled(__bytes))
+	  return static_cast<_Tp*>(__aux_balloc::_Pool<0>::
+				   _S_allocate(__bytes));
+	return static_cast<_Tp*>(::operator new(__bytes));
+      }
 
-  template <typename _Tp>
-  typename bitmap_allocator<_Tp>::_BPVector bitmap_allocator<_Tp>::_S_mem_blocks;
+      void
+      deallocate(pointer __p, size_type __n)
+      {
+	if (_S_pooled(__n * sizeof(_Tp)))
+	  __aux_balloc::_Pool<0>::_S_deallocate(__p);
+	else
+	  ::operator delete(__p);
+      }
 
-  template <typename _Tp>
-  unsigned int bitmap_allocator<_Tp>::_S_block_size = bitmap_allocator<_Tp>::_Bits_Per_Block;
+      size_type
+      max_size() const throw()
+      { return size_t(-1) / sizeof(_Tp); }
 
-  template <typename _Tp>
-  typename __gnu_cxx::bitmap_allocator<_Tp>::_BPVector::size_type 
-  bitmap_allocator<_Tp>::_S_last_dealloc_index = 0;
+      void
+      construct(pointer __p, const _Tp& __val)
+      { ::new(__p) _Tp(__val); }
 
-  template <typename _Tp>
-  __gnu_cxx::__aux_balloc::_Bit_map_counter 
-  <typename bitmap_allocator<_Tp>::pointer, typename bitmap_allocator<_Tp>::_BPVec_allocator_type> 
-  bitmap_allocator<_Tp>::_S_last_request(_S_mem_blocks);
+      void
+      destroy(pointer __p) { __p->~_Tp(); }
 
-#if defined __GTHREADS
-  template <typename _Tp>
-  __gnu_cxx::_Mutex
-  bitmap_allocator<_Tp>::_S_mut;
-#endif
+    private:
+      // The objects of a class are at offsets multiple of its size from
+      // a boundary of _S_align.
+      static bool
+      _S_pooled(size_t __bytes)
+      {
+	return (__bytes && __bytes <= __aux_balloc::_S_max_bytes
+		&& __alignof__(_Tp) <= __aux_balloc::_S_align);
+      }
+    };
 
-  template <typename _Tp1, typename _Tp2>
-  bool operator== (const bitmap_allocator<_Tp1>&, const bitmap_allocator<_Tp2>&) throw()
-  {
-    return true;
-  }
-  
-  template <typename _Tp1, typename _Tp2>
-  bool operator!= (const bitmap_allocator<_Tp1>&, const bitmap_allocator<_Tp2>&) throw()
-  {
-    return false;
-  }
-}
+  template<typename _Tp1, typename _Tp2>
+    inline bool
+    operator==(const bitmap_allocator<_Tp1>&,
+	       const bitmap_allocator<_Tp2>&) throw()
+    { return true; }
 
+  template<typename _Tp1, typename _Tp2>
+    inline bool
+    operator!=(const bitmap_allocator<_Tp1>&,
+	       const bitmap_allocator<_Tp2>&) throw()
+    { return false; }
+} // namespace __gnu_cxx
 
-#endif //_BITMAP_ALLOCATOR_H
+#endif
@@ -0,0 +1,1059 @@
+// B-tree implementation -*- C++ -*-
+
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file ext/btree.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _BTREE_H
+#define _BTREE_H 1
+
+#pragma GCC system_header
+
+// B+ tree, used to implement the associative containers btree_set and
+// btree_map.
+//
+// The elements are stored in the leaves, several dozens to a leaf, and
+// the inner nodes hold copies of the keys which separate their
+// children: a search compares keys laid out next to each other instead
+// of following one pointer per comparison as in a red-black tree.  The
+// leaves are linked in a circular list through a header, which stands
+// for the end of the sequence.
+//
+// An element or separator never moves inside its node.  Each node has
+// a fixed slot for it and a permutation, _M_order, maps ranks to slots,
+// the first _M_count of them in increasing order and then the free
+// slots.  Inserting or erasing then shifts bytes of _M_order rather
+// than elements, which keeps the copy constructors and destructors out
+// of all but the splits.  Iterators designate a leaf and a slot, and
+// leaves also keep the inverse permutation, _M_rank.
+//
+// A node is split as soon as it is full.  Until the copies of the
+// upper half and of the separator going up are all made, the nodes
+// are only changed in ways which can be undone without copying, so
+// that an insertion either succeeds or leaves the tree unchanged.
+// When the new element goes after the last one, the split keeps the
+// left node full: a tree built from sorted input has full leaves.
+//
+// Erasing never copies an element, and thus never throws.  Nodes are
+// not merged: a leaf is freed when it becomes empty, together with
+// the separator on its left, and inner nodes left without children
+// are freed in turn.  This favours lookups and iteration over erasure:
+// after many erasures the nodes may be far from full, and the tree
+// should be rebuilt by a copy.
+//
+// Inserting invalidates iterators and references, since the upper
+// half of a full node moves to a new one; erasing invalidates only
+// those to the erased elements.
+
+#include <iterator>
+#include <bits/stl_algobase.h>
+#include <bits/stl_function.h>
+#include <bits/stl_construct.h>
+#include <bits/functexcept.h>
+
+namespace __gnu_cxx
+{
+  using std::size_t;
+  using std::ptrdiff_t;
+  using std::pair;
+
+  struct _Btree_node_base
+  {
+    _Btree_node_base*	_M_parent;
+    unsigned short	_M_count;
+    bool		_M_leaf;
+  };
+
+  struct _Btree_leaf_base : public _Btree_node_base
+  {
+    _Btree_leaf_base*	_M_prev;
+    _Btree_leaf_base*	_M_next;
+  };
+
+  // The elements follow the structure, in _S_cap slots.
+  template<typename _Val>
+    struct _Btree_leaf : public _Btree_leaf_base
+    {
+      enum
+	{
+	  _S_cap = (sizeof(_Val) <= 8 ? 64
+		    : 512 / sizeof(_Val) < 8 ? 8 : 512 / sizeof(_Val))
+	};
+
+      unsigned char	_M_order[_S_cap];
+      unsigned char	_M_rank[_S_cap];
+
+      static size_t
+      _S_offset()
+      {
+	return ((sizeof(_Btree_leaf) + __alignof__(_Val) - 1)
+		/ __alignof__(_Val) * __alignof__(_Val));
+      }
+
+      static size_t
+      _S_bytes()
+      { return _S_offset() + _S_cap * sizeof(_Val); }
+
+      _Val*
+      _M_values()
+      { return reinterpret_cast<_Val*>(reinterpret_cast<char*>(this)
+				       + _S_offset()); }
+
+      _Val&
+      _M_value(unsigned __r)
+      { return _M_values()[_M_order[__r]]; }
+    };
+
+  // Separator _M_key(i) is not greater than any element under child
+  // i + 1, and greater than all the elements under child i.  The keys
+  // follow the structure, in _S_cap slots.
+  template<typename _Key>
+    struct _Btree_inner : public _Btree_node_base
+    {
+      enum
+	{
+	  _S_cap = (sizeof(_Key) <= 8 ? 32
+		    : 256 / sizeof(_Key) < 4 ? 4 : 256 / sizeof(_Key))
+	};
+
+      _Btree_node_base*	_M_child[_S_cap + 1];
+      unsigned char	_M_order[_S_cap];
+
+      static size_t
+      _S_offset()
+      {
+	return ((sizeof(_Btree_inner) + __alignof__(_Key) - 1)
+		/ __alignof__(_Key) * __alignof__(_Key));
+      }
+
+      static size_t
+      _S_bytes()
+      { return _S_offset() + _S_cap * sizeof(_Key); }
+
+      _Key*
+      _M_keys()
+      { return reinterpret_cast<_Key*>(reinterpret_cast<char*>(this)
+				       + _S_offset()); }
+
+      _Key&
+      _M_key(unsigned __r)
+      { return _M_keys()[_M_order[__r]]; }
+    };
+
+  template<typename _Val, typename _Ref, typename _Ptr>
+    struct _Btree_iterator
+    {
+      typedef _Val value_type;
+      typedef _Ref reference;
+      typedef _Ptr pointer;
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef ptrdiff_t difference_type;
+
+      typedef _Btree_iterator<_Val, _Val&, _Val*> iterator;
+      typedef _Btree_iterator<_Val, const _Val&, const _Val*> const_iterator;
+      typedef _Btree_iterator<_Val, _Ref, _Ptr> _Self;
+      typedef _Btree_leaf<_Val> _Leaf;
+
+      // The header, which has no elements, for end().
+      _Btree_leaf_base*	_M_node;
+      unsigned		_M_slot;
+
+      _Btree_iterator() { }
+
+      _Btree_iterator(_Btree_leaf_base* __x, unsigned __s)
+      : _M_node(__x), _M_slot(__s) { }
+
+      _Btree_iterator(const iterator& __it)
+      : _M_node(__it._M_node), _M_slot(__it._M_slot) { }
+
+      reference
+      operator*() const
+      { return static_cast<_Leaf*>(_M_node)->_M_values()[_M_slot]; }
+
+      pointer
+      operator->() const
+      { return &(operator*()); }
+
+      _Self&
+      operator++()
+      {
+	_Leaf* __l = static_cast<_Leaf*>(_M_node);
+	const unsigned __r = __l->_M_rank[_M_slot] + 1;
+	if (__r < __l->_M_count)
+	  _M_slot = __l->_M_order[__r];
+	else
+	  {
+	    _M_node = __l->_M_next;
+	    _M_slot = (_M_node->_M_count
+		       ? static_cast<_Leaf*>(_M_node)->_M_order[0] : 0);
+	  }
+	return *this;
+      }
+
+      _Self
+      operator++(int)
+      {
+	_Self __tmp = *this;
+	++*this;
+	return __tmp;
+      }
+
+      _Self&
+      operator--()
+      {
+	_Leaf* __l = static_cast<_Leaf*>(_M_node);
+	if (__l->_M_count && __l->_M_rank[_M_slot])
+	  _M_slot = __l->_M_order[__l->_M_rank[_M_slot] - 1];
+	else
+	  {
+	    __l = static_cast<_Leaf*>(__l->_M_prev);
+	    _M_node = __l;
+	    _M_slot = __l->_M_order[__l->_M_count - 1];
+	  }
+	return *this;
+      }
+
+      _Self
+      operator--(int)
+      {
+	_Self __tmp = *this;
+	--*this;
+	return __tmp;
+      }
+    };
+
+  template<typename _Val, typename _Ref1, typename _Ptr1,
+	   typename _Ref2, typename _Ptr2>
+    inline bool
+    operator==(const _Btree_iterator<_Val, _Ref1, _Ptr1>& __x,
+	       const _Btree_iterator<_Val, _Ref2, _Ptr2>& __y)
+    { return __x._M_node == __y._M_node && __x._M_slot == __y._M_slot; }
+
+  template<typename _Val, typename _Ref1, typename _Ptr1,
+	   typename _Ref2, typename _Ptr2>
+    inline bool
+    operator!=(const _Btree_iterator<_Val, _Ref1, _Ptr1>& __x,
+	       const _Btree_iterator<_Val, _Ref2, _Ptr2>& __y)
+    { return !(__x == __y); }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc = std::allocator<_Val> >
+    class _Btree
+    {
+      typedef typename _Alloc::template rebind<char>::other _Char_allocator;
+      typedef _Btree_leaf<_Val> _Leaf;
+      typedef _Btree_inner<_Key> _Inner;
+
+    public:
+      typedef _Key key_type;
+      typedef _Val value_type;
+      typedef value_type* pointer;
+      typedef const value_type* const_pointer;
+      typedef value_type& reference;
+      typedef const value_type& const_reference;
+      typedef size_t size_type;
+      typedef ptrdiff_t difference_type;
+      typedef _Alloc allocator_type;
+
+      typedef _Btree_iterator<value_type, reference, pointer> iterator;
+      typedef _Btree_iterator<value_type, const_reference, const_pointer>
+      const_iterator;
+      typedef std::reverse_iterator<iterator> reverse_iterator;
+      typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+      struct _Btree_impl : public _Char_allocator
+      {
+	_Compare		_M_key_compare;
+	_Btree_leaf_base	_M_header;
+	_Btree_node_base*	_M_root;
+	size_type		_M_node_count;
+
+	_Btree_impl(const _Char_allocator& __a, const _Compare& __comp)
+	: _Char_allocator(__a), _M_key_compare(__comp), _M_root(0),
+	  _M_node_count(0)
+	{
+	  _M_header._M_parent = 0;
+	  _M_header._M_count = 0;
+	  _M_header._M_leaf = true;
+	  _M_header._M_prev = &_M_header;
+	  _M_header._M_next = &_M_header;
+	}
+      };
+
+      _Btree_impl _M_impl;
+
+    public:
+      _Btree(const _Compare& __comp, const allocator_type& __a)
+      : _M_impl(__a, __comp) { }
+
+      _Btree(const _Btree& __x)
+      : _M_impl(__x._M_impl, __x._M_impl._M_key_compare)
+      {
+	try
+	  { insert_unique(__x.begin(), __x.end()); }
+	catch(...)
+	  {
+	    clear();
+	    __throw_exception_again;
+	  }
+      }
+
+      ~_Btree()
+      { clear(); }
+
+      _Btree&
+      operator=(const _Btree& __x)
+      {
+	if (this != &__x)
+	  {
+	    clear();
+	    _M_impl._M_key_compare = __x._M_impl._M_key_compare;
+	    insert_unique(__x.begin(), __x.end());
+	  }
+	return *this;
+      }
+
+      allocator_type
+      get_allocator() const
+      { return *static_cast<const _Char_allocator*>(&_M_impl); }
+
+      _Compare
+      key_comp() const
+      { return _M_impl._M_key_compare; }
+
+      iterator
+      begin()
+      { return _S_first(_M_impl._M_header._M_next); }
+
+      const_iterator
+      begin() const
+      { return const_cast<_Btree*>(this)->begin(); }
+
+      iterator
+      end()
+      { return iterator(&_M_impl._M_header, 0); }
+
+      const_iterator
+      end() const
+      { return const_cast<_Btree*>(this)->end(); }
+
+      reverse_iterator
+      rbegin()
+      { return reverse_iterator(end()); }
+
+      const_reverse_iterator
+      rbegin() const
+      { return const_reverse_iterator(end()); }
+
+      reverse_iterator
+      rend()
+      { return reverse_iterator(begin()); }
+
+      const_reverse_iterator
+      rend() const
+      { return const_reverse_iterator(begin()); }
+
+      bool
+      empty() const
+      { return _M_impl._M_node_count == 0; }
+
+      size_type
+      size() const
+      { return _M_impl._M_node_count; }
+
+      size_type
+      max_size() const
+      { return size_type(-1) / sizeof(_Val); }
+
+      void
+      swap(_Btree& __t);
+
+      pair<iterator, bool>
+      insert_unique(const value_type& __v);
+
+      iterator
+      insert_unique(iterator __position, const value_type& __v);
+
+      template<typename _InputIterator>
+        void
+        insert_unique(_InputIterator __first, _InputIterator __last)
+        {
+	  for (; __first != __last; ++__first)
+	    insert_unique(end(), *__first);
+	}
+
+      void
+      erase(iterator __position);
+
+      size_type
+      erase(const key_type& __k)
+      {
+	iterator __i = find(__k);
+	if (__i == end())
+	  return 0;
+	erase(__i);
+	return 1;
+      }
+
+      void
+      erase(iterator __first, iterator __last)
+      {
+	if (__first == begin() && __last == end())
+	  clear();
+	else
+	  while (__first != __last)
+	    erase(__first++);
+      }
+
+      void
+      clear()
+      {
+	if (_M_impl._M_root)
+	  {
+	    _M_erase_subtree(_M_impl._M_root);
+	    _M_impl._M_root = 0;
+	    _M_impl._M_header._M_prev = &_M_impl._M_header;
+	    _M_impl._M_header._M_next = &_M_impl._M_header;
+	    _M_impl._M_node_count = 0;
+	  }
+      }
+
+      iterator
+      find(const key_type& __k)
+      {
+	if (_M_impl._M_root)
+	  {
+	    _Leaf* __l = _M_find_leaf(__k);
+	    const unsigned __r = _M_lower_rank(__l, __k);
+	    if (__r < __l->_M_count
+		&& !_M_impl._M_key_compare(__k, _S_key(__l, __r)))
+	      return iterator(__l, __l->_M_order[__r]);
+	  }
+	return end();
+      }
+
+      const_iterator
+      find(const key_type& __k) const
+      { return const_cast<_Btree*>(this)->find(__k); }
+
+      size_type
+      count(const key_type& __k) const
+      { return find(__k) == end() ? 0 : 1; }
+
+      iterator
+      lower_bound(const key_type& __k)
+      {
+	if (!_M_impl._M_root)
+	  return end();
+	_Leaf* __l = _M_find_leaf(__k);
+	return _S_at(__l, _M_lower_rank(__l, __k));
+      }
+
+      const_iterator
+      lower_bound(const key_type& __k) const
+      { return const_cast<_Btree*>(this)->lower_bound(__k); }
+
+      iterator
+      upper_bound(const key_type& __k)
+      {
+	if (!_M_impl._M_root)
+	  return end();
+	_Leaf* __l = _M_find_leaf(__k);
+	return _S_at(__l, _M_upper_rank(__l, __k));
+      }
+
+      const_iterator
+      upper_bound(const key_type& __k) const
+      { return const_cast<_Btree*>(this)->upper_bound(__k); }
+
+      pair<iterator, iterator>
+      equal_range(const key_type& __k)
+      {
+	iterator __i = lower_bound(__k);
+	iterator __j = __i;
+	if (__i != end() && !_M_impl._M_key_compare(__k, _KeyOfValue()(*__i)))
+	  ++__j;
+	return pair<iterator, iterator>(__i, __j);
+      }
+
+      pair<const_iterator, const_iterator>
+      equal_range(const key_type& __k) const
+      {
+	pair<iterator, iterator> __p
+	  = const_cast<_Btree*>(this)->equal_range(__k);
+	return pair<const_iterator, const_iterator>(__p.first, __p.second);
+      }
+
+    private:
+      static const _Key&
+      _S_key(_Leaf* __l, unsigned __r)
+      { return _KeyOfValue()(__l->_M_value(__r)); }
+
+      // The first element of a leaf, or end() for the header.
+      static iterator
+      _S_first(_Btree_leaf_base* __l)
+      {
+	return iterator(__l, __l->_M_count
+			? static_cast<_Leaf*>(__l)->_M_order[0] : 0);
+      }
+
+      // The element of rank __r of __l, or the first one of the next
+      // leaf if __r is past the end.
+      static iterator
+      _S_at(_Leaf* __l, unsigned __r)
+      {
+	if (__r < __l->_M_count)
+	  return iterator(__l, __l->_M_order[__r]);
+	return _S_first(__l->_M_next);
+      }
+
+      _Leaf*
+      _M_find_leaf(const _Key& __k) const
+      {
+	_Btree_node_base* __x = _M_impl._M_root;
+	while (!__x->_M_leaf)
+	  {
+	    // Go down the child after the separators not greater
+	    // than __k.
+	    _Inner* __n = static_cast<_Inner*>(__x);
+	    unsigned __lo = 0;
+	    unsigned __hi = __n->_M_count;
+	    while (__lo < __hi)
+	      {
+		const unsigned __mid = (__lo + __hi) / 2;
+		if (_M_impl._M_key_compare(__k, __n->_M_key(__mid)))
+		  __hi = __mid;
+		else
+		  __lo = __mid + 1;
+	      }
+	    __x = __n->_M_child[__lo];
+	  }
+	return static_cast<_Leaf*>(__x);
+      }
+
+      unsigned
+      _M_lower_rank(_Leaf* __l, const _Key& __k) const
+      {
+	unsigned __lo = 0;
+	unsigned __hi = __l->_M_count;
+	while (__lo < __hi)
+	  {
+	    const unsigned __mid = (__lo + __hi) / 2;
+	    if (_M_impl._M_key_compare(_S_key(__l, __mid), __k))
+	      __lo = __mid + 1;
+	    else
+	      __hi = __mid;
+	  }
+	return __lo;
+      }
+
+      unsigned
+      _M_upper_rank(_Leaf* __l, const _Key& __k) const
+      {
+	unsigned __lo = 0;
+	unsigned __hi = __l->_M_count;
+	while (__lo < __hi)
+	  {
+	    const unsigned __mid = (__lo + __hi) / 2;
+	    if (_M_impl._M_key_compare(__k, _S_key(__l, __mid)))
+	      __hi = __mid;
+	    else
+	      __lo = __mid + 1;
+	  }
+	return __lo;
+      }
+
+      static unsigned
+      _S_child_index(_Inner* __p, _Btree_node_base* __x)
+      {
+	unsigned __i = 0;
+	while (__p->_M_child[__i] != __x)
+	  ++__i;
+	return __i;
+      }
+
+      // Make the free slot __l->_M_order[__l->_M_count] that of rank __r.
+      static void
+      _S_leaf_insert(_Leaf* __l, unsigned __r)
+      {
+	unsigned char* __o = __l->_M_order;
+	const unsigned char __s = __o[__l->_M_count];
+	for (unsigned __j = __l->_M_count; __j > __r; --__j)
+	  {
+	    __o[__j] = __o[__j - 1];
+	    __l->_M_rank[__o[__j]] = __j;
+	  }
+	__o[__r] = __s;
+	__l->_M_rank[__s] = __r;
+	++__l->_M_count;
+      }
+
+      // Make the slot of rank __r, whose element is destroyed, free.
+      static void
+      _S_leaf_remove(_Leaf* __l, unsigned __r)
+      {
+	unsigned char* __o = __l->_M_order;
+	const unsigned char __s = __o[__r];
+	const unsigned __n = --__l->_M_count;
+	for (unsigned __j = __r; __j < __n; ++__j)
+	  {
+	    __o[__j] = __o[__j + 1];
+	    __l->_M_rank[__o[__j]] = __j;
+	  }
+	__o[__n] = __s;
+      }
+
+      // Same for the separators of an inner node.
+      static void
+      _S_inner_insert(_Inner* __p, unsigned __r)
+      {
+	unsigned char* __o = __p->_M_order;
+	const unsigned char __s = __o[__p->_M_count];
+	for (unsigned __j = __p->_M_count; __j > __r; --__j)
+	  __o[__j] = __o[__j - 1];
+	__o[__r] = __s;
+	++__p->_M_count;
+      }
+
+      static void
+      _S_inner_remove(_Inner* __p, unsigned __r)
+      {
+	unsigned char* __o = __p->_M_order;
+	const unsigned char __s = __o[__r];
+	const unsigned __n = --__p->_M_count;
+	for (unsigned __j = __r; __j < __n; ++__j)
+	  __o[__j] = __o[__j + 1];
+	__o[__n] = __s;
+      }
+
+      _Leaf*
+      _M_new_leaf()
+      {
+	_Leaf* __l = reinterpret_cast<_Leaf*>(_M_impl.allocate(_Leaf::
+							       _S_bytes()));
+	__l->_M_parent = 0;
+	__l->_M_count = 0;
+	__l->_M_leaf = true;
+	for (unsigned __i = 0; __i < _Leaf::_S_cap; ++__i)
+	  __l->_M_order[__i] = __l->_M_rank[__i] = __i;
+	return __l;
+      }
+
+      _Inner*
+      _M_new_inner()
+      {
+	_Inner* __p = reinterpret_cast<_Inner*>(_M_impl.allocate(_Inner::
+								 _S_bytes()));
+	__p->_M_parent = 0;
+	__p->_M_count = 0;
+	__p->_M_leaf = false;
+	for (unsigned __i = 0; __i < _Inner::_S_cap; ++__i)
+	  __p->_M_order[__i] = __i;
+	return __p;
+      }
+
+      void
+      _M_put_node(_Btree_node_base* __x)
+      {
+	if (__x->_M_leaf)
+	  _M_impl.deallocate(reinterpret_cast<char*>(__x), _Leaf::_S_bytes());
+	else
+	  _M_impl.deallocate(reinterpret_cast<char*>(__x), _Inner::_S_bytes());
+      }
+
+      iterator
+      _M_insert(_Leaf* __l, unsigned __r, const value_type& __v,
+		bool __at_end);
+
+      iterator
+      _M_split_leaf(_Leaf* __l, unsigned __r, bool __at_end);
+
+      void
+      _M_split_inner(_Inner* __p, bool __at_end);
+
+      void
+      _M_insert_parent(_Btree_node_base* __x, const _Key& __k,
+		       _Btree_node_base* __y, bool __at_end);
+
+      void
+      _M_remove_node(_Btree_node_base* __x);
+
+      void
+      _M_erase_subtree(_Btree_node_base* __x);
+    };
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    inline bool
+    operator==(const _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>& __x,
+	       const _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>& __y)
+    {
+      return (__x.size() == __y.size()
+	      && std::equal(__x.begin(), __x.end(), __y.begin()));
+    }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    inline bool
+    operator<(const _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>& __x,
+	      const _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>& __y)
+    {
+      return std::lexicographical_compare(__x.begin(), __x.end(),
+					  __y.begin(), __y.end());
+    }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    void
+    _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    swap(_Btree& __t)
+    {
+      std::swap(_M_impl._M_root, __t._M_impl._M_root);
+      std::swap(_M_impl._M_node_count, __t._M_impl._M_node_count);
+      std::swap(_M_impl._M_key_compare, __t._M_impl._M_key_compare);
+      std::swap(_M_impl._M_header._M_prev, __t._M_impl._M_header._M_prev);
+      std::swap(_M_impl._M_header._M_next, __t._M_impl._M_header._M_next);
+
+      // Hook the lists of leaves to their new headers.
+      _Btree_leaf_base* __h[2] = { &_M_impl._M_header,
+				   &__t._M_impl._M_header };
+      _Btree_node_base* __root[2] = { _M_impl._M_root, __t._M_impl._M_root };
+      for (int __i = 0; __i < 2; ++__i)
+	if (__root[__i])
+	  {
+	    __h[__i]->_M_next->_M_prev = __h[__i];
+	    __h[__i]->_M_prev->_M_next = __h[__i];
+	  }
+	else
+	  __h[__i]->_M_next = __h[__i]->_M_prev = __h[__i];
+    }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    pair<typename _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::iterator,
+	 bool>
+    _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    insert_unique(const _Val& __v)
+    {
+      typedef pair<iterator, bool> _Res;
+      if (!_M_impl._M_root)
+	return _Res(insert_unique(end(), __v), true);
+
+      const _Key& __k = _KeyOfValue()(__v);
+      _Leaf* __l = _M_find_leaf(__k);
+      const unsigned __r = _M_lower_rank(__l, __k);
+      if (__r < __l->_M_count
+	  && !_M_impl._M_key_compare(__k, _S_key(__l, __r)))
+	return _Res(iterator(__l, __l->_M_order[__r]), false);
+      const bool __at_end = (__l->_M_next == &_M_impl._M_header
+			     && __r == __l->_M_count);
+      return _Res(_M_insert(__l, __r, __v, __at_end), true);
+    }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    typename _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::iterator
+    _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    insert_unique(iterator __position, const _Val& __v)
+    {
+      const _Key& __k = _KeyOfValue()(__v);
+      if (!_M_impl._M_root)
+	{
+	  _Leaf* __l = _M_new_leaf();
+	  try
+	    { std::_Construct(__l->_M_values(), __v); }
+	  catch(...)
+	    {
+	      _M_put_node(__l);
+	      __throw_exception_again;
+	    }
+	  _S_leaf_insert(__l, 0);
+	  __l->_M_prev = __l->_M_next = &_M_impl._M_header;
+	  _M_impl._M_header._M_prev = _M_impl._M_header._M_next = __l;
+	  _M_impl._M_root = __l;
+	  _M_impl._M_node_count = 1;
+	  return iterator(__l, 0);
+	}
+
+      if (__position == end())
+	{
+	  // After the last element: append to the last leaf.
+	  _Leaf* __l = static_cast<_Leaf*>(_M_impl._M_header._M_prev);
+	  if (_M_impl._M_key_compare(_S_key(__l, __l->_M_count - 1), __k))
+	    return _M_insert(__l, __l->_M_count, __v, true);
+	}
+      else
+	{
+	  // Between the hint and the element before it in its leaf.
+	  _Leaf* __l = static_cast<_Leaf*>(__position._M_node);
+	  const unsigned __r = __l->_M_rank[__position._M_slot];
+	  if (__r > 0 && _M_impl._M_key_compare(_S_key(__l, __r - 1), __k)
+	      && _M_impl._M_key_compare(__k, _S_key(__l, __r)))
+	    return _M_insert(__l, __r, __v, false);
+	}
+      return insert_unique(__v).first;
+    }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    typename _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::iterator
+    _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    _M_insert(_Leaf* __l, unsigned __r, const _Val& __v, bool __at_end)
+    {
+      std::_Construct(__l->_M_values() + __l->_M_order[__l->_M_count], __v);
+      _S_leaf_insert(__l, __r);
+      iterator __ret(__l, __l->_M_order[__r]);
+      if (__l->_M_count == _Leaf::_S_cap)
+	{
+	  try
+	    { __ret = _M_split_leaf(__l, __r, __at_end); }
+	  catch(...)
+	    {
+	      std::_Destroy(&__l->_M_value(__r));
+	      _S_leaf_remove(__l, __r);
+	      __throw_exception_again;
+	    }
+	}
+      ++_M_impl._M_node_count;
+      return __ret;
+    }
+
+  // Moves the upper part of the full leaf __l to a new leaf, and
+  // returns the new position of the element of rank __r.
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    typename _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::iterator
+    _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    _M_split_leaf(_Leaf* __l, unsigned __r, bool __at_end)
+    {
+      const unsigned __n = __l->_M_count;
+      const unsigned __h = __at_end ? __n - 1 : __n / 2;
+      _Leaf* __y = _M_new_leaf();
+      _Val* __vals = __y->_M_values();
+      unsigned __i = __h;
+      try
+	{
+	  for (; __i < __n; ++__i)
+	    std::_Construct(__vals + (__i - __h), __l->_M_value(__i));
+	  _M_insert_parent(__l, _KeyOfValue()(__vals[0]), __y, __at_end);
+	}
+      catch(...)
+	{
+	  std::_Destroy(__vals, __vals + (__i - __h));
+	  _M_put_node(__y);
+	  __throw_exception_again;
+	}
+
+      // Nothing can throw from here on.
+      for (__i = __h; __i < __n; ++__i)
+	std::_Destroy(&__l->_M_value(__i));
+      __l->_M_count = __h;
+      __y->_M_count = __n - __h;
+      __y->_M_next = __l->_M_next;
+      __y->_M_prev = __l;
+      __l->_M_next->_M_prev = __y;
+      __l->_M_next = __y;
+      if (__r < __h)
+	return iterator(__l, __l->_M_order[__r]);
+      return iterator(__y, __r - __h);
+    }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    void
+    _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    _M_split_inner(_Inner* __p, bool __at_end)
+    {
+      const unsigned __n = __p->_M_count;
+      const unsigned __h = __at_end ? __n - 1 : __n / 2;
+      _Inner* __y = _M_new_inner();
+      _Key* __keys = __y->_M_keys();
+      unsigned __i = __h + 1;
+      try
+	{
+	  for (; __i < __n; ++__i)
+	    std::_Construct(__keys + (__i - __h - 1), __p->_M_key(__i));
+	  // Separator __h goes up.
+	  _M_insert_parent(__p, __p->_M_key(__h), __y, __at_end);
+	}
+      catch(...)
+	{
+	  std::_Destroy(__keys, __keys + (__i - __h - 1));
+	  _M_put_node(__y);
+	  __throw_exception_again;
+	}
+
+      for (__i = __h; __i < __n; ++__i)
+	std::_Destroy(&__p->_M_key(__i));
+      __p->_M_count = __h;
+      __y->_M_count = __n - __h - 1;
+      for (__i = 0; __i <= __y->_M_count; ++__i)
+	{
+	  __y->_M_child[__i] = __p->_M_child[__h + 1 + __i];
+	  __y->_M_child[__i]->_M_parent = __y;
+	}
+    }
+
+  // Inserts the new node __y after its left neighbour __x in their
+  // parent, with the separator __k, and splits the parent if it
+  // becomes full.  Leaves the tree unchanged if a copy throws.
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    void
+    _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    _M_insert_parent(_Btree_node_base* __x, const _Key& __k,
+		     _Btree_node_base* __y, bool __at_end)
+    {
+      _Inner* __p = static_cast<_Inner*>(__x->_M_parent);
+      if (!__p)
+	{
+	  __p = _M_new_inner();
+	  try
+	    { std::_Construct(__p->_M_keys(), __k); }
+	  catch(...)
+	    {
+	      _M_put_node(__p);
+	      __throw_exception_again;
+	    }
+	  _S_inner_insert(__p, 0);
+	  __p->_M_child[0] = __x;
+	  __p->_M_child[1] = __y;
+	  __x->_M_parent = __y->_M_parent = __p;
+	  _M_impl._M_root = __p;
+	  return;
+	}
+
+      const unsigned __i = _S_child_index(__p, __x);
+      std::_Construct(__p->_M_keys() + __p->_M_order[__p->_M_count], __k);
+      _S_inner_insert(__p, __i);
+      for (unsigned __j = __p->_M_count; __j > __i + 1; --__j)
+	__p->_M_child[__j] = __p->_M_child[__j - 1];
+      __p->_M_child[__i + 1] = __y;
+      __y->_M_parent = __p;
+      if (__p->_M_count == _Inner::_S_cap)
+	{
+	  try
+	    { _M_split_inner(__p, __at_end); }
+	  catch(...)
+	    {
+	      std::_Destroy(&__p->_M_key(__i));
+	      _S_inner_remove(__p, __i);
+	      for (unsigned __j = __i + 1; __j <= __p->_M_count; ++__j)
+		__p->_M_child[__j] = __p->_M_child[__j + 1];
+	      __throw_exception_again;
+	    }
+	}
+    }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    void
+    _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    erase(iterator __position)
+    {
+      _Leaf* __l = static_cast<_Leaf*>(__position._M_node);
+      std::_Destroy(&*__position);
+      _S_leaf_remove(__l, __l->_M_rank[__position._M_slot]);
+      --_M_impl._M_node_count;
+      if (__l->_M_count == 0)
+	{
+	  __l->_M_prev->_M_next = __l->_M_next;
+	  __l->_M_next->_M_prev = __l->_M_prev;
+	  _M_remove_node(__l);
+	}
+    }
+
+  // Frees the node __x, which has no elements, and removes it from its
+  // parent, together with a separator next to it.
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    void
+    _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    _M_remove_node(_Btree_node_base* __x)
+    {
+      _Inner* __p = static_cast<_Inner*>(__x->_M_parent);
+      _M_put_node(__x);
+      if (!__p)
+	{
+	  _M_impl._M_root = 0;
+	  return;
+	}
+
+      if (__p->_M_count == 0)
+	{
+	  _M_remove_node(__p);
+	  return;
+	}
+
+      const unsigned __i = _S_child_index(__p, __x);
+      const unsigned __r = __i ? __i - 1 : 0;
+      std::_Destroy(&__p->_M_key(__r));
+      _S_inner_remove(__p, __r);
+      for (unsigned __j = __i; __j <= __p->_M_count; ++__j)
+	__p->_M_child[__j] = __p->_M_child[__j + 1];
+
+      // A root with a single child goes away.
+      while (!_M_impl._M_root->_M_leaf && _M_impl._M_root->_M_count == 0)
+	{
+	  _Inner* __root = static_cast<_Inner*>(_M_impl._M_root);
+	  _M_impl._M_root = __root->_M_child[0];
+	  _M_impl._M_root->_M_parent = 0;
+	  _M_put_node(__root);
+	}
+    }
+
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare, typename _Alloc>
+    void
+    _Btree<_Key, _Val, _KeyOfValue, _Compare, _Alloc>::
+    _M_erase_subtree(_Btree_node_base* __x)
+    {
+      if (__x->_M_leaf)
+	{
+	  _Leaf* __l = static_cast<_Leaf*>(__x);
+	  for (unsigned __r = 0; __r < __l->_M_count; ++__r)
+	    std::_Destroy(&__l->_M_value(__r));
+	}
+      else
+	{
+	  _Inner* __p = static_cast<_Inner*>(__x);
+	  for (unsigned __i = 0; __i <= __p->_M_count; ++__i)
+	    _M_erase_subtree(__p->_M_child[__i]);
+	  for (unsigned __r = 0; __r < __p->_M_count; ++__r)
+	    std::_Destroy(&__p->_M_key(__r));
+	}
+      _M_put_node(__x);
+    }
+} // namespace __gnu_cxx
+
+#endif
@@ -0,0 +1,364 @@
+// Memory mapped input layer for filebuf -*- C++ -*-
+
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file ext/mmap_filebuf.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _MMAP_FILEBUF_H
+#define _MMAP_FILEBUF_H 1
+
+#pragma GCC system_header
+
+#include <fstream>
+
+#if defined(_GLIBCXX_HAVE_MMAP) && defined(_GLIBCXX_HAVE_S_ISREG) \
+    && defined(_GLIBCXX_HAVE_SYS_STAT_H)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#define _GLIBCXX_MMAP_FILEBUF 1
+#endif
+
+namespace __gnu_cxx
+{
+  /**
+   *  @class mmap_filebuf ext/mmap_filebuf.h <ext/mmap_filebuf.h>
+   *  @brief A filebuf reading regular files through a memory mapping.
+   *
+   *  This GNU extension behaves like a standard filebuf, except that
+   *  a regular file opened for input only, with a codecvt facet which
+   *  does no conversion, is mapped in memory and the whole mapping
+   *  becomes the get area: reads then never enter the kernel nor copy
+   *  the data through the internal buffer.  The size seen is that of
+   *  the file at open time, but the mapping is shared: changes made
+   *  to the file afterwards may show in the data read.  If the file
+   *  is truncated while mapped, reading past its new end raises
+   *  SIGBUS.  In every other case, or when the mapping fails, the
+   *  file is accessed exactly as by std::basic_filebuf.
+   *
+   *  Note that open() and close() are not virtual in the standard
+   *  filebuf, thus must be called on the mmap_filebuf itself.
+  */
+  template<typename _CharT, typename _Traits = std::char_traits<_CharT> >
+    class mmap_filebuf : public std::basic_filebuf<_CharT, _Traits>
+    {
+    public:
+      // Types:
+      typedef _CharT				        char_type;
+      typedef _Traits				        traits_type;
+      typedef typename traits_type::int_type		int_type;
+      typedef typename traits_type::pos_type		pos_type;
+      typedef typename traits_type::off_type		off_type;
+      typedef std::size_t                               size_t;
+
+      typedef std::basic_filebuf<char_type, traits_type> __filebuf_type;
+      typedef typename __filebuf_type::__codecvt_type	__codecvt_type;
+
+    private:
+      // Start and length, in bytes, of the mapping, if any.
+      char*		_M_map;
+      size_t		_M_map_size;
+
+    public:
+      mmap_filebuf() : __filebuf_type(), _M_map(0), _M_map_size(0) { }
+
+      /**
+       *  Closes the file, releasing the mapping.
+      */
+      virtual
+      ~mmap_filebuf()
+      { this->close(); }
+
+      /**
+       *  @brief  Opens an external file.
+       *  @param  s  The name of the file.
+       *  @param  mode  The open mode flags.
+       *  @return  @c this on success, NULL on failure
+       *
+       *  Same as std::basic_filebuf::open, then maps the file if
+       *  possible.
+      */
+      mmap_filebuf*
+      open(const char* __s, std::ios_base::openmode __mode)
+      {
+	mmap_filebuf* __ret = 0;
+	if (__filebuf_type::open(__s, __mode))
+	  {
+	    _M_map_file();
+	    __ret = this;
+	  }
+	return __ret;
+      }
+
+      /**
+       *  @brief  Closes the currently associated file.
+       *  @return  @c this on success, NULL on failure
+      */
+      mmap_filebuf*
+      close() throw()
+      {
+	_M_unmap();
+	return __filebuf_type::close() ? this : 0;
+      }
+
+      /**
+       *  @return  True if the get area is the mapped file.
+      */
+      bool
+      is_mapped() const
+      { return _M_map != 0; }
+
+    protected:
+      virtual std::streamsize
+      showmanyc();
+
+      virtual int_type
+      underflow();
+
+      virtual int_type
+      pbackfail(int_type __c = _Traits::eof());
+
+      virtual std::streamsize
+      xsgetn(char_type* __s, std::streamsize __n);
+
+      virtual pos_type
+      seekoff(off_type __off, std::ios_base::seekdir __way,
+	      std::ios_base::openmode __mode = std::ios_base::in
+	      | std::ios_base::out);
+
+      virtual pos_type
+      seekpos(pos_type __pos,
+	      std::ios_base::openmode __mode = std::ios_base::in
+	      | std::ios_base::out);
+
+      virtual void
+      imbue(const std::locale& __loc);
+
+    private:
+      void
+      _M_map_file();
+
+      // Drops the mapping, if any, and goes back to the buffered
+      // mode of basic_filebuf.  Returns the offset in the file
+      // corresponding to gptr().
+      off_type
+      _M_unmap();
+    };
+
+  template<typename _CharT, typename _Traits>
+    void
+    mmap_filebuf<_CharT, _Traits>::
+    _M_map_file()
+    {
+#ifdef _GLIBCXX_MMAP_FILEBUF
+      const std::ios_base::openmode __mode = this->_M_mode;
+      if (!(__mode & std::ios_base::in)
+	  || (__mode & (std::ios_base::out | std::ios_base::app))
+	  || sizeof(char_type) != 1
+	  || !std::__check_facet(this->_M_codecvt).always_noconv())
+	return;
+
+      const int __fd = this->_M_file.fd();
+      struct stat __st;
+      if (fstat(__fd, &__st) || !S_ISREG(__st.st_mode)
+	  || __st.st_size <= 0)
+	return;
+
+      // Don't bother if the size doesn't fit the address space.
+      const size_t __len = __st.st_size;
+      if (static_cast<off_t>(__len) != __st.st_size)
+	return;
+
+      // Open in ios_base::ate mode moved the file offset.
+      const std::streamoff __pos = this->_M_file.seekoff(0,
+							 std::ios_base::cur);
+      if (__pos < 0 || __pos > std::streamoff(__len))
+	return;
+
+      void* __p = mmap(0, __len, PROT_READ, MAP_SHARED, __fd, 0);
+      if (__p == MAP_FAILED)
+	return;
+
+      _M_map = static_cast<char*>(__p);
+      _M_map_size = __len;
+      char_type* __beg = reinterpret_cast<char_type*>(_M_map);
+      this->setg(__beg, __beg + __pos, __beg + __len);
+      this->_M_reading = true;
+#endif
+    }
+
+  template<typename _CharT, typename _Traits>
+    typename mmap_filebuf<_CharT, _Traits>::off_type
+    mmap_filebuf<_CharT, _Traits>::
+    _M_unmap()
+    {
+      off_type __ret = 0;
+#ifdef _GLIBCXX_MMAP_FILEBUF
+      if (_M_map)
+	{
+	  __ret = this->gptr() - this->eback();
+	  munmap(_M_map, _M_map_size);
+	  _M_map = 0;
+	  _M_map_size = 0;
+	  this->_M_reading = false;
+	  this->_M_set_buffer(-1);
+	}
+#endif
+      return __ret;
+    }
+
+  template<typename _CharT, typename _Traits>
+    std::streamsize
+    mmap_filebuf<_CharT, _Traits>::
+    showmanyc()
+    {
+      if (_M_map)
+	return this->egptr() - this->gptr();
+      return __filebuf_type::showmanyc();
+    }
+
+  template<typename _CharT, typename _Traits>
+    typename mmap_filebuf<_CharT, _Traits>::int_type
+    mmap_filebuf<_CharT, _Traits>::
+    underflow()
+    {
+      if (_M_map)
+	{
+	  // The whole file is in the get area already.
+	  int_type __ret = traits_type::eof();
+	  if (this->gptr() < this->egptr())
+	    __ret = traits_type::to_int_type(*this->gptr());
+	  return __ret;
+	}
+      return __filebuf_type::underflow();
+    }
+
+  template<typename _CharT, typename _Traits>
+    typename mmap_filebuf<_CharT, _Traits>::int_type
+    mmap_filebuf<_CharT, _Traits>::
+    pbackfail(int_type __i)
+    {
+      if (_M_map)
+	{
+	  // The mapping is read-only: only the char actually there can
+	  // be put back.
+	  int_type __ret = traits_type::eof();
+	  if (this->eback() < this->gptr())
+	    {
+	      const int_type __tmp =
+		traits_type::to_int_type(*(this->gptr() - 1));
+	      if (traits_type::eq_int_type(__i, __ret)
+		  || traits_type::eq_int_type(__i, __tmp))
+		{
+		  this->gbump(-1);
+		  __ret = traits_type::not_eof(__i);
+		}
+	    }
+	  return __ret;
+	}
+      return __filebuf_type::pbackfail(__i);
+    }
+
+  template<typename _CharT, typename _Traits>
+    std::streamsize
+    mmap_filebuf<_CharT, _Traits>::
+    xsgetn(char_type* __s, std::streamsize __n)
+    {
+      if (_M_map)
+	{
+	  // NB: gbump takes an int, useless for large mappings.
+	  const std::streamsize __ret = std::min(std::streamsize(this->egptr()
+								 - this->gptr()),
+						 __n);
+	  if (__ret > 0)
+	    {
+	      traits_type::copy(__s, this->gptr(), __ret);
+	      this->setg(this->eback(), this->gptr() + __ret, this->egptr());
+	    }
+	  return __ret;
+	}
+      return __filebuf_type::xsgetn(__s, __n);
+    }
+
+  template<typename _CharT, typename _Traits>
+    typename mmap_filebuf<_CharT, _Traits>::pos_type
+    mmap_filebuf<_CharT, _Traits>::
+    seekoff(off_type __off, std::ios_base::seekdir __way,
+	    std::ios_base::openmode __mode)
+    {
+      if (_M_map)
+	{
+	  // As in basic_filebuf, __mode is ignored: the get position is
+	  // the only file position.
+	  off_type __newoff = __off;
+	  if (__way == std::ios_base::cur)
+	    __newoff += this->gptr() - this->eback();
+	  else if (__way == std::ios_base::end)
+	    __newoff += this->egptr() - this->eback();
+
+	  pos_type __ret = pos_type(off_type(-1));
+	  if (__newoff >= 0 && __newoff <= this->egptr() - this->eback())
+	    {
+	      this->setg(this->eback(), this->eback() + __newoff,
+			 this->egptr());
+	      __ret = pos_type(__newoff);
+	    }
+	  return __ret;
+	}
+      return __filebuf_type::seekoff(__off, __way, __mode);
+    }
+
+  template<typename _CharT, typename _Traits>
+    typename mmap_filebuf<_CharT, _Traits>::pos_type
+    mmap_filebuf<_CharT, _Traits>::
+    seekpos(pos_type __pos, std::ios_base::openmode __mode)
+    {
+      if (_M_map)
+	return this->seekoff(off_type(__pos), std::ios_base::beg, __mode);
+      return __filebuf_type::seekpos(__pos, __mode);
+    }
+
+  template<typename _CharT, typename _Traits>
+    void
+    mmap_filebuf<_CharT, _Traits>::
+    imbue(const std::locale& __loc)
+    {
+      // A converting facet needs the external chars in _M_ext_buf:
+      // switch to the buffered mode, at the same file position.
+      if (_M_map && (!std::has_facet<__codecvt_type>(__loc)
+		     || !std::use_facet<__codecvt_type>(__loc).always_noconv()))
+	this->_M_file.seekoff(_M_unmap(), std::ios_base::beg);
+      __filebuf_type::imbue(__loc);
+    }
+} // namespace __gnu_cxx
+
+#undef _GLIBCXX_MMAP_FILEBUF
+
+#endif
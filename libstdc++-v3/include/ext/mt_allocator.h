@@ -1,6 +1,6 @@
 // MT-optimized allocator -*- C++ -*-
 
-// Copyright (C) 2003, 2004 Free Software Foundation, Inc.
+// Copyright (C) 2003, 2004, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -119,7 +119,28 @@ namespace __gnu_cxx
       _M_freelist_headroom(__headroom), _M_force_new(__force)
       { }
     };
-    
+
+    // Counters describing how the pool has been used, summed over
+    // all bins and thread ids.  They are only kept by the thread
+    // enabled pool, while threads are active, and are read without
+    // locking, so they are approximate while other threads allocate.
+    struct _Stats
+    {
+      // Blocks handed out by the pool.
+      size_t	_M_allocs;
+
+      // Blocks freed by a thread other than the one they were
+      // handed out to.
+      size_t	_M_remote_frees;
+
+      // Number of times a thread found a bin mutex held by another
+      // thread and had to wait for it.
+      size_t	_M_lock_waits;
+
+      _Stats()
+      : _M_allocs(0), _M_remote_frees(0), _M_lock_waits(0) { }
+    };
+
     const _Tune&
     _M_get_options() const
     { return _M_options; }
@@ -177,12 +198,14 @@ namespace __gnu_cxx
       // Each requesting thread is assigned an id ranging from 1 to
       // _S_max_threads. Thread id 0 is used as a global memory pool.
       // In order to get constant performance on the thread assignment
-      // routine, we keep a list of free ids. When a thread first
-      // requests memory we remove the first record in this list and
-      // stores the address in a __gthread_key. When initializing the
-      // __gthread_key we specify a destructor. When this destructor
-      // (i.e. the thread dies) is called, we return the thread id to
-      // the front of this list.
+      // routine, without a lock, ids are handed out in order with an
+      // atomic add. When a thread first requests memory we take the
+      // next record and store its address in a __gthread_key. When
+      // initializing the __gthread_key we specify a destructor. When
+      // this destructor (i.e. the thread dies) is called, we move the
+      // freelists of the thread to the global pool and return the
+      // thread id to the front of a list of free ids, from which ids
+      // are taken once all of them have been handed out.
       struct _Thread_record
       {
 	// Points to next free thread id record. NULL if last record in list.
@@ -212,6 +235,14 @@ namespace __gnu_cxx
 	// blocks that are on the freelist/used for each thread id.
 	// Memory to these "arrays" is allocated in _S_initialize() for
 	// _S_max_threads + global pool 0.
+	// - Note that the allocation for _M_used also hosts, after
+	//   _M_used itself, the statistics counters of each thread id
+	//   and the (atomic) counters of blocks freed by other threads,
+	//   see _M_get_frees() and below.  This keeps _Bin_record,
+	//   which inline code indexes, the same size.  Only the
+	//   library touches those counters: a program compiled with
+	//   these headers may run with an older library, which
+	//   allocates _M_used alone.
 	size_t* volatile                _M_free;
 	size_t* volatile                _M_used;
 	
@@ -251,8 +282,34 @@ namespace __gnu_cxx
       _M_get_bin(size_t __which)
       { return _M_bin[__which]; }
       
+      // Blocks each thread id gave back to the pool.
+      size_t*
+      _M_get_frees(const _Bin_record& __bin) const
+      { return __bin._M_used + (_M_options._M_max_threads + 1); }
+
+      // Blocks each thread id freed on behalf of another one.
+      size_t*
+      _M_get_remote_frees(const _Bin_record& __bin) const
+      { return __bin._M_used + 2 * (_M_options._M_max_threads + 1); }
+
+      // Waits of each thread id for the bin mutex.
+      size_t*
+      _M_get_lock_waits(const _Bin_record& __bin) const
+      { return __bin._M_used + 3 * (_M_options._M_max_threads + 1); }
+
+      // Blocks used by each thread id which other threads have
+      // freed, and which have not been subtracted from _M_used yet.
+      // Only the owner writes its _M_used entry; the others add to
+      // this counter instead, without taking any lock.
+      _Atomic_word*
+      _M_get_reclaimed(const _Bin_record& __bin) const
+      {
+	size_t* __p = __bin._M_used + 4 * (_M_options._M_max_threads + 1);
+	return reinterpret_cast<_Atomic_word*>(__p);
+      }
+
       void
-      _M_adjust_freelist(const _Bin_record& __bin, _Block_record* __block, 
+      _M_adjust_freelist(const _Bin_record& __bin, _Block_record* __block,
 			 size_t __thread_id)
       {
 	if (__gthread_active_p())
@@ -269,8 +326,11 @@ namespace __gnu_cxx
       size_t 
       _M_get_thread_id();
 
-      explicit __pool() 
-      : _M_bin(NULL), _M_bin_size(1), _M_thread_freelist(NULL) 
+      _Stats
+      _M_get_stats() const;
+
+      explicit __pool()
+      : _M_bin(NULL), _M_bin_size(1), _M_thread_freelist(NULL)
       {
 	// On some platforms, __gthread_once_t is an aggregate.
 	__gthread_once_t __tmp = __GTHREAD_ONCE_INIT;
@@ -287,8 +347,17 @@ namespace __gnu_cxx
       size_t 	       	     	_M_bin_size;
 
       __gthread_once_t 		_M_once;
-      
+
+      // Ids given back by threads which have exited.
       _Thread_record* 		_M_thread_freelist;
+
+      // Hand out the next thread id record never used, with an atomic
+      // add, or return NULL once all of them were; ids are only then
+      // taken from _M_thread_freelist.  The records and their count
+      // live in a side table in mt_allocator.cc, so that this class
+      // keeps its layout.
+      _Thread_record*
+      _M_get_unused_thread_record();
     };
 #endif
 
@@ -609,6 +678,11 @@ namespace __gnu_cxx
       void
       _M_set_options(__pool_base::_Tune __t)
       { this->_S_get_pool()._M_set_options(__t); }
+
+      // Only available with a thread enabled pool.
+      const __pool_base::_Stats
+      _M_get_stats()
+      { return this->_S_get_pool()._M_get_stats(); }
     };
 
   template<typename _Tp, typename _Poolp>
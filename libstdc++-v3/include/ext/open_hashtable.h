@@ -0,0 +1,846 @@
+// Open addressing hashtable implementation -*- C++ -*-
+
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file ext/open_hashtable.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _OPEN_HASHTABLE_H
+#define _OPEN_HASHTABLE_H 1
+
+#pragma GCC system_header
+
+// Hashtable class, used to implement the hashed associative containers
+// open_hash_set and open_hash_map.
+//
+// Unlike hashtable, which keeps one heap node per element on a chain
+// hanging off each bucket, this table stores the elements themselves
+// in one array of slots.  A collision moves on to another slot, found
+// by quadratic (triangular) probing over a power-of-two table.  A
+// second array holds one control byte per slot: empty, deleted, or
+// full together with seven bits of the element's hash, so that most
+// probes of the wrong slot are rejected without touching the element
+// or calling the key comparison.
+//
+// Erasing leaves a deleted marker behind, and never moves another
+// element; iterators and references to other elements stay valid.
+// Inserting may rehash, which moves every element and invalidates all
+// iterators, pointers and references into the table.
+
+#include <iterator>
+#include <bits/stl_algobase.h>
+#include <bits/stl_function.h>
+#include <bits/stl_construct.h>
+#include <bits/functexcept.h>
+#include <ext/hash_fun.h>
+
+namespace __gnu_cxx
+{
+  using std::size_t;
+  using std::ptrdiff_t;
+  using std::forward_iterator_tag;
+  using std::input_iterator_tag;
+  using std::distance;
+  using std::pair;
+  using std::__iterator_category;
+
+  // Spread the bits of a hash value over the whole word by multiplying
+  // by 2^N / phi, so that the table can use the top bits as the slot
+  // index.  This matters for functors such as hash<int>, which return
+  // the key itself.
+  inline size_t
+  __open_hash_mix(size_t __h)
+  {
+    if (sizeof(size_t) > 4)
+      return __h * static_cast<size_t>(0x9e3779b97f4a7c15ULL);
+    return __h * static_cast<size_t>(0x9e3779b9UL);
+  }
+
+  template <class _Val, class _Key, class _HashFcn, class _ExtractKey,
+	    class _EqualKey, class _Alloc = std::allocator<_Val> >
+    class open_hashtable;
+
+  template <class _Val, class _Key, class _HashFcn,
+	    class _ExtractKey, class _EqualKey, class _Alloc>
+    struct _Open_hashtable_iterator;
+
+  template <class _Val, class _Key, class _HashFcn,
+	    class _ExtractKey, class _EqualKey, class _Alloc>
+    struct _Open_hashtable_const_iterator;
+
+  template <class _Val, class _Key, class _HashFcn,
+	    class _ExtractKey, class _EqualKey, class _Alloc>
+    struct _Open_hashtable_iterator
+    {
+      typedef open_hashtable<_Val, _Key, _HashFcn, _ExtractKey,
+			     _EqualKey, _Alloc>
+        _Hashtable;
+      typedef _Open_hashtable_iterator<_Val, _Key, _HashFcn,
+				       _ExtractKey, _EqualKey, _Alloc>
+        iterator;
+      typedef _Open_hashtable_const_iterator<_Val, _Key, _HashFcn,
+					     _ExtractKey, _EqualKey, _Alloc>
+        const_iterator;
+      typedef forward_iterator_tag iterator_category;
+      typedef _Val value_type;
+      typedef ptrdiff_t difference_type;
+      typedef size_t size_type;
+      typedef _Val& reference;
+      typedef _Val* pointer;
+
+      _Val* _M_cur;
+      _Hashtable* _M_ht;
+
+      _Open_hashtable_iterator(_Val* __p, _Hashtable* __tab)
+      : _M_cur(__p), _M_ht(__tab) {}
+
+      _Open_hashtable_iterator() {}
+
+      reference
+      operator*() const
+      { return *_M_cur; }
+
+      pointer
+      operator->() const
+      { return &(operator*()); }
+
+      iterator&
+      operator++()
+      {
+	_M_cur = _M_ht->_M_next_full(_M_cur);
+	return *this;
+      }
+
+      iterator
+      operator++(int)
+      {
+	iterator __tmp = *this;
+	++*this;
+	return __tmp;
+      }
+
+      bool
+      operator==(const iterator& __it) const
+      { return _M_cur == __it._M_cur; }
+
+      bool
+      operator!=(const iterator& __it) const
+      { return _M_cur != __it._M_cur; }
+    };
+
+  template <class _Val, class _Key, class _HashFcn,
+	    class _ExtractKey, class _EqualKey, class _Alloc>
+    struct _Open_hashtable_const_iterator
+    {
+      typedef open_hashtable<_Val, _Key, _HashFcn, _ExtractKey,
+			     _EqualKey, _Alloc>
+        _Hashtable;
+      typedef _Open_hashtable_iterator<_Val, _Key, _HashFcn,
+				       _ExtractKey, _EqualKey, _Alloc>
+        iterator;
+      typedef _Open_hashtable_const_iterator<_Val, _Key, _HashFcn,
+					     _ExtractKey, _EqualKey, _Alloc>
+        const_iterator;
+      typedef forward_iterator_tag iterator_category;
+      typedef _Val value_type;
+      typedef ptrdiff_t difference_type;
+      typedef size_t size_type;
+      typedef const _Val& reference;
+      typedef const _Val* pointer;
+
+      const _Val* _M_cur;
+      const _Hashtable* _M_ht;
+
+      _Open_hashtable_const_iterator(const _Val* __p, const _Hashtable* __tab)
+      : _M_cur(__p), _M_ht(__tab) {}
+
+      _Open_hashtable_const_iterator() {}
+
+      _Open_hashtable_const_iterator(const iterator& __it)
+      : _M_cur(__it._M_cur), _M_ht(__it._M_ht) {}
+
+      reference
+      operator*() const
+      { return *_M_cur; }
+
+      pointer
+      operator->() const
+      { return &(operator*()); }
+
+      const_iterator&
+      operator++()
+      {
+	_M_cur = _M_ht->_M_next_full(_M_cur);
+	return *this;
+      }
+
+      const_iterator
+      operator++(int)
+      {
+	const_iterator __tmp = *this;
+	++*this;
+	return __tmp;
+      }
+
+      bool
+      operator==(const const_iterator& __it) const
+      { return _M_cur == __it._M_cur; }
+
+      bool
+      operator!=(const const_iterator& __it) const
+      { return _M_cur != __it._M_cur; }
+    };
+
+  template <class _Val, class _Key, class _HF, class _Ex,
+	    class _Eq, class _All>
+    bool
+    operator==(const open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>& __ht1,
+	       const open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>& __ht2);
+
+  template <class _Val, class _Key, class _HashFcn,
+	    class _ExtractKey, class _EqualKey, class _Alloc>
+    class open_hashtable
+    {
+    public:
+      typedef _Key key_type;
+      typedef _Val value_type;
+      typedef _HashFcn hasher;
+      typedef _EqualKey key_equal;
+
+      typedef size_t            size_type;
+      typedef ptrdiff_t         difference_type;
+      typedef value_type*       pointer;
+      typedef const value_type* const_pointer;
+      typedef value_type&       reference;
+      typedef const value_type& const_reference;
+
+      hasher
+      hash_funct() const
+      { return _M_hash; }
+
+      key_equal
+      key_eq() const
+      { return _M_equals; }
+
+    public:
+      typedef typename _Alloc::template rebind<value_type>::other allocator_type;
+      allocator_type
+      get_allocator() const
+      { return _M_slot_allocator; }
+
+    private:
+      typedef typename _Alloc::template rebind<unsigned char>::other
+        _Ctrl_Alloc;
+
+      // Values of the control bytes.  A full slot has the top bit set
+      // and seven bits of the mixed hash in the others.
+      enum
+      {
+	_S_empty = 0,
+	_S_deleted = 1,
+	_S_full = 0x80
+      };
+
+      // Resize when full and deleted slots together would pass
+      // _S_max_load_num / _S_max_load_den of the table.
+      enum
+      {
+	_S_max_load_num = 7,
+	_S_max_load_den = 8,
+	_S_min_slots = 8
+      };
+
+      static const size_type _S_npos = static_cast<size_type>(-1);
+
+      allocator_type        _M_slot_allocator;
+      hasher                _M_hash;
+      key_equal             _M_equals;
+      _ExtractKey           _M_get_key;
+      _Val*                 _M_slots;
+      unsigned char*        _M_ctrl;
+      size_type             _M_num_slots;
+      size_type             _M_shift;
+      size_type             _M_num_elements;
+      size_type             _M_num_deleted;
+
+    public:
+      typedef _Open_hashtable_iterator<_Val, _Key, _HashFcn, _ExtractKey,
+				       _EqualKey, _Alloc>
+        iterator;
+      typedef _Open_hashtable_const_iterator<_Val, _Key, _HashFcn,
+					     _ExtractKey, _EqualKey, _Alloc>
+        const_iterator;
+
+      friend struct
+      _Open_hashtable_iterator<_Val, _Key, _HashFcn, _ExtractKey,
+			       _EqualKey, _Alloc>;
+
+      friend struct
+      _Open_hashtable_const_iterator<_Val, _Key, _HashFcn, _ExtractKey,
+				     _EqualKey, _Alloc>;
+
+    public:
+      open_hashtable(size_type __n, const _HashFcn& __hf,
+		     const _EqualKey& __eql, const _ExtractKey& __ext,
+		     const allocator_type& __a = allocator_type())
+      : _M_slot_allocator(__a), _M_hash(__hf), _M_equals(__eql),
+	_M_get_key(__ext), _M_slots(0), _M_ctrl(0), _M_num_slots(0),
+	_M_shift(0), _M_num_elements(0), _M_num_deleted(0)
+      { _M_initialize_slots(_M_next_size(__n)); }
+
+      open_hashtable(size_type __n, const _HashFcn& __hf,
+		     const _EqualKey& __eql,
+		     const allocator_type& __a = allocator_type())
+      : _M_slot_allocator(__a), _M_hash(__hf), _M_equals(__eql),
+	_M_get_key(_ExtractKey()), _M_slots(0), _M_ctrl(0), _M_num_slots(0),
+	_M_shift(0), _M_num_elements(0), _M_num_deleted(0)
+      { _M_initialize_slots(_M_next_size(__n)); }
+
+      open_hashtable(const open_hashtable& __ht)
+      : _M_slot_allocator(__ht.get_allocator()), _M_hash(__ht._M_hash),
+	_M_equals(__ht._M_equals), _M_get_key(__ht._M_get_key),
+	_M_slots(0), _M_ctrl(0), _M_num_slots(0), _M_shift(0),
+	_M_num_elements(0), _M_num_deleted(0)
+      { _M_copy_from(__ht); }
+
+      open_hashtable&
+      operator=(const open_hashtable& __ht)
+      {
+	if (&__ht != this)
+	  {
+	    open_hashtable __tmp(__ht);
+	    this->swap(__tmp);
+	  }
+	return *this;
+      }
+
+      ~open_hashtable()
+      {
+	_M_destroy_elements();
+	_M_deallocate_slots(_M_slots, _M_ctrl, _M_num_slots);
+      }
+
+      size_type
+      size() const
+      { return _M_num_elements; }
+
+      size_type
+      max_size() const
+      { return max_bucket_count() / _S_max_load_den * _S_max_load_num; }
+
+      bool
+      empty() const
+      { return size() == 0; }
+
+      void
+      swap(open_hashtable& __ht)
+      {
+	std::swap(_M_hash, __ht._M_hash);
+	std::swap(_M_equals, __ht._M_equals);
+	std::swap(_M_get_key, __ht._M_get_key);
+	std::swap(_M_slots, __ht._M_slots);
+	std::swap(_M_ctrl, __ht._M_ctrl);
+	std::swap(_M_num_slots, __ht._M_num_slots);
+	std::swap(_M_shift, __ht._M_shift);
+	std::swap(_M_num_elements, __ht._M_num_elements);
+	std::swap(_M_num_deleted, __ht._M_num_deleted);
+      }
+
+      iterator
+      begin()
+      { return iterator(_M_first_full(), this); }
+
+      iterator
+      end()
+      { return iterator(0, this); }
+
+      const_iterator
+      begin() const
+      { return const_iterator(_M_first_full(), this); }
+
+      const_iterator
+      end() const
+      { return const_iterator(0, this); }
+
+      template <class _Vl, class _Ky, class _HF, class _Ex, class _Eq,
+		class _Al>
+        friend bool
+        operator==(const open_hashtable<_Vl, _Ky, _HF, _Ex, _Eq, _Al>&,
+		   const open_hashtable<_Vl, _Ky, _HF, _Ex, _Eq, _Al>&);
+
+    public:
+      // Each slot is a bucket that holds at most one element.
+      size_type
+      bucket_count() const
+      { return _M_num_slots; }
+
+      size_type
+      max_bucket_count() const
+      { return size_type(1) << (sizeof(size_type) * __CHAR_BIT__ - 1); }
+
+      size_type
+      elems_in_bucket(size_type __bucket) const
+      { return _M_ctrl[__bucket] & _S_full ? 1 : 0; }
+
+      pair<iterator, bool>
+      insert_unique(const value_type& __obj)
+      { return _M_insert_unique(__obj, true); }
+
+      pair<iterator, bool>
+      insert_unique_noresize(const value_type& __obj)
+      { return _M_insert_unique(__obj, false); }
+
+      template <class _InputIterator>
+        void
+        insert_unique(_InputIterator __f, _InputIterator __l)
+        { insert_unique(__f, __l, __iterator_category(__f)); }
+
+      template <class _InputIterator>
+        void
+        insert_unique(_InputIterator __f, _InputIterator __l,
+		      input_iterator_tag)
+        {
+	  for ( ; __f != __l; ++__f)
+	    insert_unique(*__f);
+	}
+
+      template <class _ForwardIterator>
+        void
+        insert_unique(_ForwardIterator __f, _ForwardIterator __l,
+		      forward_iterator_tag)
+        {
+	  size_type __n = distance(__f, __l);
+	  resize(_M_num_elements + __n);
+	  for ( ; __n > 0; --__n, ++__f)
+	    insert_unique(*__f);
+	}
+
+      reference
+      find_or_insert(const value_type& __obj)
+      { return *insert_unique(__obj).first; }
+
+      iterator
+      find(const key_type& __key)
+      {
+	const size_type __n = _M_find_slot(__key);
+	return iterator(__n == _S_npos ? 0 : _M_slots + __n, this);
+      }
+
+      const_iterator
+      find(const key_type& __key) const
+      {
+	const size_type __n = _M_find_slot(__key);
+	return const_iterator(__n == _S_npos ? 0 : _M_slots + __n, this);
+      }
+
+      size_type
+      count(const key_type& __key) const
+      { return _M_find_slot(__key) == _S_npos ? 0 : 1; }
+
+      pair<iterator, iterator>
+      equal_range(const key_type& __key)
+      {
+	iterator __first = find(__key);
+	iterator __last = __first;
+	if (__first != end())
+	  ++__last;
+	return pair<iterator, iterator>(__first, __last);
+      }
+
+      pair<const_iterator, const_iterator>
+      equal_range(const key_type& __key) const
+      {
+	const_iterator __first = find(__key);
+	const_iterator __last = __first;
+	if (__first != end())
+	  ++__last;
+	return pair<const_iterator, const_iterator>(__first, __last);
+      }
+
+      size_type
+      erase(const key_type& __key)
+      {
+	const size_type __n = _M_find_slot(__key);
+	if (__n == _S_npos)
+	  return 0;
+	_M_erase_slot(__n);
+	return 1;
+      }
+
+      void
+      erase(const iterator& __it)
+      {
+	if (__it._M_cur)
+	  _M_erase_slot(__it._M_cur - _M_slots);
+      }
+
+      void
+      erase(iterator __first, iterator __last)
+      {
+	while (__first != __last)
+	  erase(__first++);
+      }
+
+      void
+      erase(const const_iterator& __it)
+      {
+	if (__it._M_cur)
+	  _M_erase_slot(__it._M_cur - _M_slots);
+      }
+
+      void
+      erase(const_iterator __first, const_iterator __last)
+      {
+	while (__first != __last)
+	  erase(__first++);
+      }
+
+      void
+      resize(size_type __num_elements_hint);
+
+      void
+      clear()
+      {
+	_M_destroy_elements();
+	std::fill(_M_ctrl, _M_ctrl + _M_num_slots,
+		  static_cast<unsigned char>(_S_empty));
+	_M_num_elements = 0;
+	_M_num_deleted = 0;
+      }
+
+    private:
+      // The smallest table that holds __n elements under the maximum
+      // load factor.
+      size_type
+      _M_next_size(size_type __n) const
+      {
+	size_type __slots = _S_min_slots;
+	while (__slots / _S_max_load_den * _S_max_load_num < __n
+	       && __slots < max_bucket_count())
+	  __slots <<= 1;
+	return __slots;
+      }
+
+      bool
+      _M_over_load(size_type __n) const
+      { return __n > _M_num_slots / _S_max_load_den * _S_max_load_num; }
+
+      size_type
+      _M_slot_num(size_t __mixed) const
+      { return __mixed >> _M_shift; }
+
+      static unsigned char
+      _S_ctrl_byte(size_t __mixed, size_type __shift)
+      {
+	const size_t __bits = __shift >= 7 ? __mixed >> (__shift - 7) : __mixed;
+	return static_cast<unsigned char>(_S_full | (__bits & 0x7f));
+      }
+
+      const _Val*
+      _M_first_full() const
+      {
+	for (size_type __n = 0; __n < _M_num_slots; ++__n)
+	  if (_M_ctrl[__n] & _S_full)
+	    return _M_slots + __n;
+	return 0;
+      }
+
+      _Val*
+      _M_first_full()
+      {
+	for (size_type __n = 0; __n < _M_num_slots; ++__n)
+	  if (_M_ctrl[__n] & _S_full)
+	    return _M_slots + __n;
+	return 0;
+      }
+
+      _Val*
+      _M_next_full(const _Val* __p) const
+      {
+	for (size_type __n = __p - _M_slots + 1; __n < _M_num_slots; ++__n)
+	  if (_M_ctrl[__n] & _S_full)
+	    return _M_slots + __n;
+	return 0;
+      }
+
+      // The slot holding __key, or _S_npos.
+      size_type
+      _M_find_slot(const key_type& __key) const
+      {
+	const size_t __mixed = __open_hash_mix(_M_hash(__key));
+	const unsigned char __c = _S_ctrl_byte(__mixed, _M_shift);
+	const size_type __mask = _M_num_slots - 1;
+	size_type __n = _M_slot_num(__mixed);
+	for (size_type __step = 1; ; ++__step)
+	  {
+	    const unsigned char __cur = _M_ctrl[__n];
+	    if (__cur == __c && _M_equals(_M_get_key(_M_slots[__n]), __key))
+	      return __n;
+	    if (__cur == _S_empty)
+	      return _S_npos;
+	    __n = (__n + __step) & __mask;
+	  }
+      }
+
+      pair<iterator, bool>
+      _M_insert_unique(const value_type& __obj, bool __allow_resize);
+
+      void
+      _M_erase_slot(size_type __n)
+      {
+	_M_slot_allocator.destroy(_M_slots + __n);
+	_M_ctrl[__n] = _S_deleted;
+	--_M_num_elements;
+	++_M_num_deleted;
+	// Once nothing is left, the deleted markers need not slow down
+	// later lookups.
+	if (_M_num_elements == 0)
+	  clear();
+      }
+
+      void
+      _M_initialize_slots(size_type __n);
+
+      void
+      _M_deallocate_slots(_Val* __slots, unsigned char* __ctrl,
+			  size_type __n)
+      {
+	if (__slots)
+	  {
+	    _M_slot_allocator.deallocate(__slots, __n);
+	    _Ctrl_Alloc(_M_slot_allocator).deallocate(__ctrl, __n);
+	  }
+      }
+
+      void
+      _M_destroy_elements()
+      {
+	for (size_type __n = 0; __n < _M_num_slots; ++__n)
+	  if (_M_ctrl[__n] & _S_full)
+	    _M_slot_allocator.destroy(_M_slots + __n);
+      }
+
+      void
+      _M_rehash(size_type __n);
+
+      void
+      _M_copy_from(const open_hashtable& __ht);
+    };
+
+  template <class _Val, class _Key, class _HF, class _Ex, class _Eq, class _All>
+    bool
+    operator==(const open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>& __ht1,
+	       const open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>& __ht2)
+    {
+      typedef open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All> _Hashtable;
+
+      if (__ht1.size() != __ht2.size())
+	return false;
+
+      for (typename _Hashtable::const_iterator __it = __ht1.begin();
+	   __it != __ht1.end(); ++__it)
+	{
+	  typename _Hashtable::const_iterator __other
+	    = __ht2.find(__ht1._M_get_key(*__it));
+	  if (__other == __ht2.end() || !(*__it == *__other))
+	    return false;
+	}
+      return true;
+    }
+
+  template <class _Val, class _Key, class _HF, class _Ex, class _Eq, class _All>
+    inline bool
+    operator!=(const open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>& __ht1,
+	       const open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>& __ht2)
+    { return !(__ht1 == __ht2); }
+
+  template <class _Val, class _Key, class _HF, class _Extract, class _EqKey,
+	    class _All>
+    inline void
+    swap(open_hashtable<_Val, _Key, _HF, _Extract, _EqKey, _All>& __ht1,
+	 open_hashtable<_Val, _Key, _HF, _Extract, _EqKey, _All>& __ht2)
+    { __ht1.swap(__ht2); }
+
+  template <class _Val, class _Key, class _HF, class _Ex, class _Eq, class _All>
+    pair<typename open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>::iterator,
+	 bool>
+    open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>::
+    _M_insert_unique(const value_type& __obj, bool __allow_resize)
+    {
+      const key_type& __key = _M_get_key(__obj);
+      const size_t __mixed = __open_hash_mix(_M_hash(__key));
+      unsigned char __c = _S_ctrl_byte(__mixed, _M_shift);
+      size_type __mask = _M_num_slots - 1;
+      size_type __n = _M_slot_num(__mixed);
+      size_type __free = _S_npos;
+
+      // Look for the key, remembering the first slot it could go into.
+      for (size_type __step = 1; ; ++__step)
+	{
+	  const unsigned char __cur = _M_ctrl[__n];
+	  if (__cur == __c && _M_equals(_M_get_key(_M_slots[__n]), __key))
+	    return pair<iterator, bool>(iterator(_M_slots + __n, this), false);
+	  if (__cur == _S_deleted && __free == _S_npos)
+	    __free = __n;
+	  if (__cur == _S_empty)
+	    {
+	      if (__free == _S_npos)
+		__free = __n;
+	      break;
+	    }
+	  __n = (__n + __step) & __mask;
+	}
+
+      // Reusing a deleted slot leaves the load as it was; taking an
+      // empty one may push the table past its load factor.  Without
+      // resizing, one slot must always stay empty so that probing
+      // terminates.
+      if (_M_ctrl[__free] == _S_empty)
+	{
+	  const size_type __used = _M_num_elements + _M_num_deleted + 1;
+	  if ((__allow_resize && _M_over_load(__used))
+	      || __used >= _M_num_slots)
+	    {
+	      // Grow so that the table ends up at most half as loaded as
+	      // the limit, but never shrink it: a table full of deleted
+	      // markers is cleaned at its current size.
+	      _M_rehash(std::max(_M_num_slots,
+				 _M_next_size(2 * (_M_num_elements + 1))));
+	      __c = _S_ctrl_byte(__mixed, _M_shift);
+	      __mask = _M_num_slots - 1;
+	      __n = _M_slot_num(__mixed);
+	      for (size_type __step = 1; _M_ctrl[__n] != _S_empty; ++__step)
+		__n = (__n + __step) & __mask;
+	      __free = __n;
+	    }
+	}
+
+      _M_slot_allocator.construct(_M_slots + __free, __obj);
+      if (_M_ctrl[__free] == _S_deleted)
+	--_M_num_deleted;
+      _M_ctrl[__free] = __c;
+      ++_M_num_elements;
+      return pair<iterator, bool>(iterator(_M_slots + __free, this), true);
+    }
+
+  template <class _Val, class _Key, class _HF, class _Ex, class _Eq, class _All>
+    void
+    open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>::
+    resize(size_type __num_elements_hint)
+    {
+      if (_M_over_load(__num_elements_hint + _M_num_deleted))
+	_M_rehash(_M_next_size(__num_elements_hint));
+    }
+
+  template <class _Val, class _Key, class _HF, class _Ex, class _Eq, class _All>
+    void
+    open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>::
+    _M_initialize_slots(size_type __n)
+    {
+      _M_slots = _M_slot_allocator.allocate(__n);
+      try
+	{ _M_ctrl = _Ctrl_Alloc(_M_slot_allocator).allocate(__n); }
+      catch(...)
+	{
+	  _M_slot_allocator.deallocate(_M_slots, __n);
+	  _M_slots = 0;
+	  __throw_exception_again;
+	}
+      std::fill(_M_ctrl, _M_ctrl + __n, static_cast<unsigned char>(_S_empty));
+      _M_num_slots = __n;
+      _M_shift = sizeof(size_t) * __CHAR_BIT__;
+      for (; __n > 1; __n >>= 1)
+	--_M_shift;
+      _M_num_elements = 0;
+      _M_num_deleted = 0;
+    }
+
+  // Moves every element into a table of __n slots, which drops the
+  // deleted markers as well.  If copying an element throws, the table
+  // is left as it was.
+  template <class _Val, class _Key, class _HF, class _Ex, class _Eq, class _All>
+    void
+    open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>::
+    _M_rehash(size_type __n)
+    {
+      open_hashtable __tmp(__n / _S_max_load_den * _S_max_load_num,
+			   _M_hash, _M_equals, _M_get_key, _M_slot_allocator);
+
+      const size_type __mask = __n - 1;
+      for (size_type __i = 0; __i < _M_num_slots; ++__i)
+	if (_M_ctrl[__i] & _S_full)
+	  {
+	    const size_t __mixed
+	      = __open_hash_mix(_M_hash(_M_get_key(_M_slots[__i])));
+	    size_type __j = __tmp._M_slot_num(__mixed);
+	    for (size_type __step = 1; __tmp._M_ctrl[__j] != _S_empty; ++__step)
+	      __j = (__j + __step) & __mask;
+	    __tmp._M_slot_allocator.construct(__tmp._M_slots + __j,
+					      _M_slots[__i]);
+	    __tmp._M_ctrl[__j] = _S_ctrl_byte(__mixed, __tmp._M_shift);
+	    ++__tmp._M_num_elements;
+	  }
+      this->swap(__tmp);
+    }
+
+  template <class _Val, class _Key, class _HF, class _Ex, class _Eq, class _All>
+    void
+    open_hashtable<_Val, _Key, _HF, _Ex, _Eq, _All>::
+    _M_copy_from(const open_hashtable& __ht)
+    {
+      _M_initialize_slots(__ht._M_num_slots);
+      try
+	{
+	  for (size_type __n = 0; __n < __ht._M_num_slots; ++__n)
+	    {
+	      if (__ht._M_ctrl[__n] & _S_full)
+		{
+		  _M_slot_allocator.construct(_M_slots + __n,
+					      __ht._M_slots[__n]);
+		  ++_M_num_elements;
+		}
+	      _M_ctrl[__n] = __ht._M_ctrl[__n];
+	    }
+	  _M_num_deleted = __ht._M_num_deleted;
+	}
+      catch(...)
+	{
+	  _M_destroy_elements();
+	  _M_deallocate_slots(_M_slots, _M_ctrl, _M_num_slots);
+	  _M_slots = 0;
+	  _M_ctrl = 0;
+	  _M_num_slots = 0;
+	  __throw_exception_again;
+	}
+    }
+} // namespace __gnu_cxx
+
+#endif
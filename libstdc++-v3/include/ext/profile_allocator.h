@@ -0,0 +1,404 @@
+// Allocation profiling allocator -*- C++ -*-
+
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file ext/profile_allocator.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _PROFILE_ALLOCATOR_H
+#define _PROFILE_ALLOCATOR_H 1
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <typeinfo>
+#include <algorithm>
+#include <cxxabi.h>
+#include <bits/functexcept.h>
+#include <bits/concurrence.h>
+
+namespace __gnu_cxx
+{
+  using std::size_t;
+
+  /**
+   *  @brief  The statistics of the blocks of one type allocated from
+   *  one call site, through the profile_allocators.
+   *
+   *  The lifetimes are counted in allocations: the lifetime of a block
+   *  is the number of blocks allocated through all the
+   *  profile_allocators while it was alive.
+   */
+  struct __profile_record
+  {
+    enum { _S_size_buckets = 16 };
+
+    const std::type_info*	_M_type;
+    const void*			_M_site;
+    size_t			_M_allocs;
+    size_t			_M_deallocs;
+    // In bytes: all the blocks allocated, the live ones and their
+    // highest total.
+    size_t			_M_bytes;
+    size_t			_M_live_bytes;
+    size_t			_M_peak_bytes;
+    // In objects.
+    size_t			_M_max_request;
+    // The sum of the lifetimes of the blocks deallocated.
+    size_t			_M_lifetimes;
+    // Blocks deallocated after a larger block was allocated at the
+    // same site, as when a vector grows.
+    size_t			_M_regrowths;
+    // The number of objects and the time of the last allocation.
+    size_t			_M_last_request;
+    size_t			_M_last_tick;
+    // The requests of 1, 2 or 3, 4 to 7, ... objects.
+    size_t			_M_sizes[_S_size_buckets];
+  };
+
+  /**
+   *  @if maint
+   *  The records of all the profile_allocators, in a table of fixed
+   *  size: a type and a call site past its capacity are accounted in
+   *  its first record, whose type is null.  A template, for its static
+   *  members to be defined in this header.
+   *  @endif
+   */
+  template<int _Inst>
+    struct __profile_table
+    {
+      enum { _S_size = 1024 };
+
+      static __profile_record	_S_records[_S_size];
+      static size_t		_S_tick;
+      static bool		_S_initialized;
+      static mutex_type		_S_mutex;
+
+      // Stored in front of each block.
+      struct _Header
+      {
+	__profile_record*	_M_record;
+	size_t			_M_request;
+	size_t			_M_tick;
+      };
+
+      static void
+      _S_allocate(const std::type_info& __type, const void* __site,
+		  size_t __n, size_t __bytes, _Header* __h)
+      {
+	lock __l(_S_mutex);
+	if (__builtin_expect(!_S_initialized, false))
+	  _S_initialize();
+
+	__profile_record* __r = _S_find(__type, __site);
+	++__r->_M_allocs;
+	__r->_M_bytes += __bytes;
+	__r->_M_live_bytes += __bytes;
+	if (__r->_M_live_bytes > __r->_M_peak_bytes)
+	  __r->_M_peak_bytes = __r->_M_live_bytes;
+	if (__n > __r->_M_max_request)
+	  __r->_M_max_request = __n;
+	size_t __bucket = 0;
+	for (size_t __m = __n; __m > 1
+	       && __bucket < __profile_record::_S_size_buckets - 1; __m >>= 1)
+	  ++__bucket;
+	++__r->_M_sizes[__bucket];
+	__r->_M_last_request = __n;
+	__r->_M_last_tick = ++_S_tick;
+
+	__h->_M_record = __r;
+	__h->_M_request = __n;
+	__h->_M_tick = _S_tick;
+      }
+
+      static void
+      _S_deallocate(size_t __bytes, _Header* __h)
+      {
+	lock __l(_S_mutex);
+	__profile_record* __r = __h->_M_record;
+	++__r->_M_deallocs;
+	__r->_M_live_bytes -= __bytes;
+	__r->_M_lifetimes += _S_tick - __h->_M_tick;
+	if (__r->_M_last_tick > __h->_M_tick
+	    && __r->_M_last_request > __h->_M_request)
+	  ++__r->_M_regrowths;
+      }
+
+      static void
+      _S_report(std::FILE* __f);
+
+    private:
+      static __profile_record*
+      _S_find(const std::type_info& __type, const void* __site)
+      {
+	const size_t __hash = (reinterpret_cast<size_t>(&__type) >> 4
+			       ^ reinterpret_cast<size_t>(__site));
+	for (size_t __i = 0; __i < _S_size; ++__i)
+	  {
+	    __profile_record* __r = _S_records + (__hash + __i) % _S_size;
+	    if (__r == _S_records)
+	      continue;
+	    if (!__r->_M_type)
+	      {
+		__r->_M_type = &__type;
+		__r->_M_site = __site;
+		return __r;
+	      }
+	    if (__r->_M_site == __site && *__r->_M_type == __type)
+	      return __r;
+	  }
+	return _S_records;
+      }
+
+      // With GLIBCXX_PROFILE_ALLOC set in the environment, the report
+      // is written at exit to the file it names, or to stderr if empty.
+      static void
+      _S_initialize()
+      {
+	_S_initialized = true;
+	if (std::getenv("GLIBCXX_PROFILE_ALLOC"))
+	  std::atexit(_S_report_at_exit);
+      }
+
+      static void
+      _S_report_at_exit()
+      {
+	const char* __name = std::getenv("GLIBCXX_PROFILE_ALLOC");
+	if (__name && *__name)
+	  {
+	    if (std::FILE* __f = std::fopen(__name, "w"))
+	      {
+		_S_report(__f);
+		std::fclose(__f);
+	      }
+	  }
+	else
+	  _S_report(stderr);
+      }
+
+      static bool
+      _S_heavier(const __profile_record* __a, const __profile_record* __b)
+      { return __a->_M_peak_bytes > __b->_M_peak_bytes; }
+    };
+
+  template<int _Inst>
+    __profile_record __profile_table<_Inst>::_S_records[_S_size];
+
+  template<int _Inst>
+    size_t __profile_table<_Inst>::_S_tick;
+
+  template<int _Inst>
+    bool __profile_table<_Inst>::_S_initialized;
+
+  template<int _Inst>
+    __glibcxx_mutex_define_initialized(__profile_table<_Inst>::_S_mutex);
+
+  // One line per type and call site, the largest peaks first.
+  template<int _Inst>
+    void
+    __profile_table<_Inst>::
+    _S_report(std::FILE* __f)
+    {
+      lock __l(_S_mutex);
+      const __profile_record* __used[_S_size];
+      size_t __n = 0;
+      for (size_t __i = 0; __i < _S_size; ++__i)
+	if (_S_records[__i]._M_allocs)
+	  __used[__n++] = _S_records + __i;
+      std::sort(__used, __used + __n, _S_heavier);
+
+      std::fprintf(__f, "%-10s %-10s %-10s %-12s %-12s %-8s %-10s %-8s"
+		   " %-18s %s\n", "peak", "live", "allocs", "deallocs",
+		   "bytes", "max n", "lifetime", "regrow", "site", "type");
+      for (size_t __i = 0; __i < __n; ++__i)
+	{
+	  const __profile_record& __r = *__used[__i];
+	  const size_t __lifetime = (__r._M_deallocs
+				     ? __r._M_lifetimes / __r._M_deallocs : 0);
+	  int __status = -1;
+	  char* __name = 0;
+	  if (__r._M_type)
+	    __name = abi::__cxa_demangle(__r._M_type->name(), 0, 0, &__status);
+	  std::fprintf(__f, "%-10lu %-10lu %-10lu %-12lu %-12lu %-8lu %-10lu"
+		       " %-8lu %-18p %s\n",
+		       static_cast<unsigned long>(__r._M_peak_bytes),
+		       static_cast<unsigned long>(__r._M_live_bytes),
+		       static_cast<unsigned long>(__r._M_allocs),
+		       static_cast<unsigned long>(__r._M_deallocs),
+		       static_cast<unsigned long>(__r._M_bytes),
+		       static_cast<unsigned long>(__r._M_max_request),
+		       static_cast<unsigned long>(__lifetime),
+		       static_cast<unsigned long>(__r._M_regrowths),
+		       __r._M_site,
+		       __status == 0 ? __name
+		       : __r._M_type ? __r._M_type->name() : "(other)");
+	  std::free(__name);
+
+	  std::fprintf(__f, "  sizes:");
+	  for (size_t __b = 0; __b < __profile_record::_S_size_buckets; ++__b)
+	    if (__r._M_sizes[__b])
+	      std::fprintf(__f, " %lu%s:%lu", 1UL << __b,
+			   __b == __profile_record::_S_size_buckets - 1
+			   ? "+" : "",
+			   static_cast<unsigned long>(__r._M_sizes[__b]));
+	  std::fprintf(__f, "\n");
+	}
+      std::fflush(__f);
+    }
+
+  /**
+   *  @brief  Writes the statistics of all the profile_allocators to
+   *  @a f, one entry per type allocated and call site.
+   */
+  inline void
+  __profile_report(std::FILE* __f)
+  { __profile_table<0>::_S_report(__f); }
+
+  /**
+   *  @brief  A meta-allocator recording the allocations of the
+   *  containers using it.
+   *
+   *  Each block is allocated from _Alloc with room for a header in
+   *  front, which links it to the record of its type, rebound by the
+   *  container, and of the code which asked for it: the return
+   *  address of allocate(), in the container.  The records hold the
+   *  number of allocations, the bytes, the lifetimes of the blocks, the
+   *  sizes requested and how often a block is replaced by a larger one,
+   *  aggregated over all the containers.  They are written by
+   *  __profile_report(), or at exit when GLIBCXX_PROFILE_ALLOC is set
+   *  in the environment, to the file it names or to stderr.
+   *
+   *  For instance:
+   *  @code
+   *  std::vector<int, __gnu_cxx::profile_allocator<std::allocator<int> > >
+   *  @endcode
+   */
+  template<typename _Alloc>
+    class profile_allocator
+    {
+    public:
+      typedef typename _Alloc::size_type       	size_type;
+      typedef typename _Alloc::difference_type	difference_type;
+      typedef typename _Alloc::pointer       	pointer;
+      typedef typename _Alloc::const_pointer    const_pointer;
+      typedef typename _Alloc::reference       	reference;
+      typedef typename _Alloc::const_reference  const_reference;
+      typedef typename _Alloc::value_type       value_type;
+
+      template<typename _Tp1>
+        struct rebind
+        {
+	  typedef typename _Alloc::template rebind<_Tp1>::other _Other;
+	  typedef profile_allocator<_Other> other;
+	};
+
+    private:
+      typedef __profile_table<0> _Table;
+      typedef _Table::_Header _Header;
+
+      // The number of objects in front of each block for its header.
+      enum
+	{
+	  _S_extra = ((sizeof(_Header) + sizeof(value_type) - 1)
+		      / sizeof(value_type))
+	};
+
+      _Alloc			_M_allocator;
+
+      template<typename _Alloc1>
+        friend class profile_allocator;
+
+    public:
+      profile_allocator() throw() { }
+
+      profile_allocator(const profile_allocator& __a) throw()
+      : _M_allocator(__a._M_allocator) { }
+
+      template<typename _Alloc1>
+        profile_allocator(const profile_allocator<_Alloc1>& __a) throw()
+	: _M_allocator(__a._M_allocator) { }
+
+      ~profile_allocator() throw() { }
+
+      pointer
+      address(reference __x) const
+      { return _M_allocator.address(__x); }
+
+      const_pointer
+      address(const_reference __x) const
+      { return _M_allocator.address(__x); }
+
+      // Not inlined, for its return address to be in its caller.
+      __attribute__((__noinline__))
+      pointer
+      allocate(size_type __n, const void* __hint = 0)
+      {
+	if (__builtin_expect(__n > this->max_size(), false))
+	  std::__throw_bad_alloc();
+
+	pointer __res = _M_allocator.allocate(__n + _S_extra, __hint);
+	_Table::_S_allocate(typeid(value_type), __builtin_return_address(0),
+			    __n, __n * sizeof(value_type),
+			    reinterpret_cast<_Header*>(&*__res));
+	return __res + _S_extra;
+      }
+
+      void
+      deallocate(pointer __p, size_type __n)
+      {
+	pointer __real_p = __p - _S_extra;
+	_Table::_S_deallocate(__n * sizeof(value_type),
+			      reinterpret_cast<_Header*>(&*__real_p));
+	_M_allocator.deallocate(__real_p, __n + _S_extra);
+      }
+
+      size_type
+      max_size() const throw()
+      { return _M_allocator.max_size() - _S_extra; }
+
+      void
+      construct(pointer __p, const value_type& __val)
+      { _M_allocator.construct(__p, __val); }
+
+      void
+      destroy(pointer __p)
+      { _M_allocator.destroy(__p); }
+
+      friend bool
+      operator==(const profile_allocator& __a, const profile_allocator& __b)
+      { return __a._M_allocator == __b._M_allocator; }
+
+      friend bool
+      operator!=(const profile_allocator& __a, const profile_allocator& __b)
+      { return __a._M_allocator != __b._M_allocator; }
+    };
+} // namespace __gnu_cxx
+
+#endif
@@ -0,0 +1,387 @@
+// Red-black tree with nodes in per-container slabs -*- C++ -*-
+
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file ext/slab_tree.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _SLAB_TREE_H
+#define _SLAB_TREE_H 1
+
+#pragma GCC system_header
+
+// The red-black tree of std::map and std::set, used to implement the
+// associative containers slab_map and slab_set.
+//
+// Each container owns a __slab_pool, from which all its nodes are
+// carved: one slab after the other, each twice as large as the
+// previous one up to a limit.  Nodes allocated in sequence, by a
+// copy, a bulk build or a series of insertions, are thus adjacent in
+// memory, and an erased node is kept on a free list for the next
+// insertion.  The memory goes back to the system when the container
+// is cleared or destroyed.  A container built from a sorted range is
+// balanced directly, in linear time, and its nodes laid out in order.
+
+#include <new>
+#include <iterator>
+#include <bits/stl_tree.h>
+#include <bits/functexcept.h>
+
+namespace __gnu_cxx
+{
+  using std::size_t;
+  using std::ptrdiff_t;
+
+  /**
+   *  @if maint
+   *  A pool of blocks of one size, carved from slabs allocated with
+   *  operator new and released all at once.  Not thread safe: each
+   *  pool belongs to one container.
+   *  @endif
+   */
+  class __slab_pool
+  {
+    struct _Block
+    { _Block* _M_next; };
+
+    enum
+      {
+	_S_min_blocks = 16,
+	_S_max_bytes = 64 * 1024
+      };
+
+    size_t	_M_size;
+    size_t	_M_slab_blocks;
+    _Block*	_M_free;
+    _Block*	_M_slabs;
+    char*	_M_cur;
+    char*	_M_end;
+
+    __slab_pool(const __slab_pool&);
+
+    __slab_pool&
+    operator=(const __slab_pool&);
+
+  public:
+    // Blocks smaller than a pointer are never asked for: nodes hold
+    // several of them.
+    explicit
+    __slab_pool(size_t __size)
+    : _M_size(__size),
+      _M_slab_blocks(_S_min_blocks), _M_free(0), _M_slabs(0),
+      _M_cur(0), _M_end(0) { }
+
+    ~__slab_pool()
+    { _M_release(); }
+
+    size_t
+    _M_block_size() const
+    { return _M_size; }
+
+    void*
+    _M_allocate()
+    {
+      if (_M_free)
+	{
+	  _Block* __b = _M_free;
+	  _M_free = __b->_M_next;
+	  return __b;
+	}
+      if (_M_cur == _M_end)
+	_M_refill();
+      void* __ret = _M_cur;
+      _M_cur += _M_size;
+      return __ret;
+    }
+
+    void
+    _M_deallocate(void* __p)
+    {
+      _Block* __b = static_cast<_Block*>(__p);
+      __b->_M_next = _M_free;
+      _M_free = __b;
+    }
+
+    // Gives back all the slabs, whether their blocks are free or not.
+    void
+    _M_release()
+    {
+      while (_M_slabs)
+	{
+	  _Block* __s = _M_slabs;
+	  _M_slabs = __s->_M_next;
+	  ::operator delete(__s);
+	}
+      _M_slab_blocks = _S_min_blocks;
+      _M_free = 0;
+      _M_cur = _M_end = 0;
+    }
+
+    void
+    _M_swap(__slab_pool& __p)
+    {
+      std::swap(_M_slab_blocks, __p._M_slab_blocks);
+      std::swap(_M_free, __p._M_free);
+      std::swap(_M_slabs, __p._M_slabs);
+      std::swap(_M_cur, __p._M_cur);
+      std::swap(_M_end, __p._M_end);
+    }
+
+  private:
+    // The first block of each slab links it to the previous one.
+    void
+    _M_refill()
+    {
+      const size_t __n = _M_slab_blocks + 1;
+      char* __s = static_cast<char*>(::operator new(__n * _M_size));
+      reinterpret_cast<_Block*>(__s)->_M_next = _M_slabs;
+      _M_slabs = reinterpret_cast<_Block*>(__s);
+      _M_cur = __s + _M_size;
+      _M_end = __s + __n * _M_size;
+      if (2 * _M_slab_blocks * _M_size <= _S_max_bytes)
+	_M_slab_blocks *= 2;
+    }
+  };
+
+  /**
+   *  @if maint
+   *  The allocator of the slab containers.  Single objects of the
+   *  size of the blocks of its pool come from the pool; anything else,
+   *  and everything when there is no pool, from operator new.
+   *  @endif
+   */
+  template<typename _Tp>
+    class __slab_alloc
+    {
+    public:
+      typedef size_t     size_type;
+      typedef ptrdiff_t  difference_type;
+      typedef _Tp*       pointer;
+      typedef const _Tp* const_pointer;
+      typedef _Tp&       reference;
+      typedef const _Tp& const_reference;
+      typedef _Tp        value_type;
+
+      template<typename _Tp1>
+        struct rebind
+        { typedef __slab_alloc<_Tp1> other; };
+
+      __slab_pool* _M_pool;
+
+      __slab_alloc() throw() : _M_pool(0) { }
+
+      explicit
+      __slab_alloc(__slab_pool* __p) throw() : _M_pool(__p) { }
+
+      __slab_alloc(const __slab_alloc& __a) throw() : _M_pool(__a._M_pool) { }
+
+      template<typename _Tp1>
+        __slab_alloc(const __slab_alloc<_Tp1>& __a) throw()
+	: _M_pool(__a._M_pool) { }
+
+      ~__slab_alloc() throw() { }
+
+      pointer
+      address(reference __x) const { return &__x; }
+
+      const_pointer
+      address(const_reference __x) const { return &__x; }
+
+      pointer
+      allocate(size_type __n, const void* = 0)
+      {
+	if (_M_pooled(__n))
+	  return static_cast<_Tp*>(_M_pool->_M_allocate());
+	if (__builtin_expect(__n > this->max_size(), false))
+	  std::__throw_bad_alloc();
+	return static_cast<_Tp*>(::operator new(__n * sizeof(_Tp)));
+      }
+
+      void
+      deallocate(pointer __p, size_type __n)
+      {
+	if (_M_pooled(__n))
+	  _M_pool->_M_deallocate(__p);
+	else
+	  ::operator delete(__p);
+      }
+
+      size_type
+      max_size() const throw()
+      { return size_t(-1) / sizeof(_Tp); }
+
+      void
+      construct(pointer __p, const _Tp& __val)
+      { ::new(__p) _Tp(__val); }
+
+      void
+      destroy(pointer __p) { __p->~_Tp(); }
+
+    private:
+      bool
+      _M_pooled(size_type __n) const
+      {
+	return (__n == 1 && _M_pool
+		&& sizeof(_Tp) == _M_pool->_M_block_size());
+      }
+    };
+
+  template<typename _Tp>
+    inline bool
+    operator==(const __slab_alloc<_Tp>& __a, const __slab_alloc<_Tp>& __b)
+    { return __a._M_pool == __b._M_pool; }
+
+  template<typename _Tp>
+    inline bool
+    operator!=(const __slab_alloc<_Tp>& __a, const __slab_alloc<_Tp>& __b)
+    { return __a._M_pool != __b._M_pool; }
+
+  /**
+   *  @if maint
+   *  _Rb_tree, plus a linear build from a sorted range.
+   *  @endif
+   */
+  template<typename _Key, typename _Val, typename _KeyOfValue,
+	   typename _Compare>
+    class __slab_tree
+    : public std::_Rb_tree<_Key, _Val, _KeyOfValue, _Compare,
+			   __slab_alloc<_Val> >
+    {
+      typedef std::_Rb_tree<_Key, _Val, _KeyOfValue, _Compare,
+			    __slab_alloc<_Val> > _Base;
+      typedef typename _Base::_Link_type _Link_type;
+
+    public:
+      typedef typename _Base::size_type size_type;
+      typedef typename _Base::allocator_type allocator_type;
+
+      // The size of the blocks of the pool the nodes come from.
+      static size_t
+      _S_node_size()
+      { return sizeof(std::_Rb_tree_node<_Val>); }
+
+      __slab_tree(const _Compare& __comp, __slab_pool* __pool)
+      : _Base(__comp, allocator_type(__pool)) { }
+
+      /**
+       *  @if maint
+       *  Replaces the contents of an empty tree by the elements of
+       *  [first, last), whose keys must be strictly increasing.
+       *  Returns false, leaving the tree empty, if they are not.
+       *  @endif
+       */
+      template<typename _ForwardIterator>
+        bool
+        _M_build_unique(_ForwardIterator __first, _ForwardIterator __last)
+        {
+	  size_type __n = 0;
+	  if (__first != __last)
+	    {
+	      _ForwardIterator __prev = __first;
+	      for (_ForwardIterator __i = __first; ++__i != __last; __prev = __i)
+		if (!this->_M_impl._M_key_compare(_KeyOfValue()(*__prev),
+						  _KeyOfValue()(*__i)))
+		  return false;
+		else
+		  ++__n;
+	      ++__n;
+	    }
+	  if (__n == 0)
+	    return true;
+
+	  // The levels above the deepest one are complete: the nodes of
+	  // that one, if it is not complete too, are red.
+	  size_type __depth = 0;
+	  for (size_type __m = __n + 1; __m > 1; __m >>= 1)
+	    ++__depth;
+
+	  _Link_type __root = _M_build(__first, __n, 0, __depth);
+	  __root->_M_parent = this->_M_end();
+	  this->_M_root() = __root;
+	  this->_M_leftmost() = _Base::_S_minimum(__root);
+	  this->_M_rightmost() = _Base::_S_maximum(__root);
+	  this->_M_impl._M_node_count = __n;
+	  return true;
+	}
+
+    private:
+      // Builds the subtree of the next __n elements of __first, whose
+      // root is at depth __d, in order, so that the nodes come out of
+      // the pool in the order of the elements.
+      template<typename _ForwardIterator>
+        _Link_type
+        _M_build(_ForwardIterator& __first, size_type __n, size_type __d,
+		 size_type __red_depth)
+        {
+	  if (__n == 0)
+	    return 0;
+	  const size_type __nl = __n / 2;
+	  _Link_type __left = _M_build(__first, __nl, __d + 1, __red_depth);
+	  _Link_type __x = 0;
+	  try
+	    {
+	      __x = this->_M_create_node(*__first);
+	      ++__first;
+	      __x->_M_color = __d == __red_depth ? std::_S_red : std::_S_black;
+	      __x->_M_left = __left;
+	      __x->_M_right = 0;
+	      if (__left)
+		__left->_M_parent = __x;
+	      __x->_M_right = _M_build(__first, __n - __nl - 1, __d + 1,
+				       __red_depth);
+	      if (__x->_M_right)
+		__x->_M_right->_M_parent = __x;
+	    }
+	  catch(...)
+	    {
+	      _M_destroy_subtree(__left);
+	      if (__x)
+		this->destroy_node(__x);
+	      __throw_exception_again;
+	    }
+	  return __x;
+	}
+
+      void
+      _M_destroy_subtree(_Link_type __x)
+      {
+	while (__x)
+	  {
+	    _M_destroy_subtree(static_cast<_Link_type>(__x->_M_right));
+	    _Link_type __y = static_cast<_Link_type>(__x->_M_left);
+	    this->destroy_node(__x);
+	    __x = __y;
+	  }
+      }
+    };
+} // namespace __gnu_cxx
+
+#endif
@@ -0,0 +1,836 @@
+// String with the short-string optimization -*- C++ -*-
+
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file sso_stringimpl.h
+ *  This is an internal header file, included by other library headers.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _SSO_STRINGIMPL_H
+#define _SSO_STRINGIMPL_H 1
+
+#pragma GCC system_header
+
+namespace __gnu_cxx
+{
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    const typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::npos;
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    _CharT*
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    _M_create(size_type& __capacity, size_type __old_capacity)
+    {
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // 83.  String::npos vs. string::max_size()
+      if (__capacity > this->max_size())
+	std::__throw_length_error(__N("basic_sso_string::_M_create"));
+
+      // The below implements an exponential growth policy, necessary to
+      // meet amortized linear time requirements of the library: see
+      // http://gcc.gnu.org/ml/libstdc++/2001-07/msg00085.html.
+      if (__capacity > __old_capacity && __capacity < 2 * __old_capacity)
+	{
+	  __capacity = 2 * __old_capacity;
+	  if (__capacity > this->max_size())
+	    __capacity = this->max_size();
+	}
+
+      // NB: Need an array of char_type[__capacity], plus a terminating
+      // null char_type() element.
+      return _M_get_allocator().allocate(__capacity + 1);
+    }
+
+  // NB: This is the special case for Input Iterators, used in
+  // istreambuf_iterators, etc.
+  // Input Iterators have a cost structure very different from
+  // pointers, calling for a different coding style.
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    template<typename _InIterator>
+      void
+      basic_sso_string<_CharT, _Traits, _Alloc>::
+      _M_construct(_InIterator __beg, _InIterator __end,
+		   std::input_iterator_tag)
+      {
+	size_type __len = 0;
+	size_type __capacity = size_type(_S_local_capacity);
+
+	while (__beg != __end && __len < __capacity)
+	  {
+	    _M_data()[__len++] = *__beg;
+	    ++__beg;
+	  }
+
+	try
+	  {
+	    while (__beg != __end)
+	      {
+		if (__len == __capacity)
+		  {
+		    // Allocate more space.
+		    __capacity = __len + 1;
+		    _CharT* __another = _M_create(__capacity, __len);
+		    _S_copy(__another, _M_data(), __len);
+		    _M_dispose();
+		    _M_data(__another);
+		    _M_capacity(__capacity);
+		  }
+		_M_data()[__len++] = *__beg;
+		++__beg;
+	      }
+	  }
+	catch(...)
+	  {
+	    _M_dispose();
+	    __throw_exception_again;
+	  }
+
+	_M_set_length(__len);
+      }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    template<typename _FwdIterator>
+      void
+      basic_sso_string<_CharT, _Traits, _Alloc>::
+      _M_construct(_FwdIterator __beg, _FwdIterator __end,
+		   std::forward_iterator_tag)
+      {
+	// NB: Not required, but considered best practice.
+	if (__builtin_expect(std::__is_null_pointer(__beg)
+			     && __beg != __end, 0))
+	  std::__throw_logic_error(__N("basic_sso_string::"
+				       "_M_construct NULL not valid"));
+
+	size_type __dnew = static_cast<size_type>(std::distance(__beg, __end));
+
+	if (__dnew > size_type(_S_local_capacity))
+	  {
+	    _M_data(_M_create(__dnew, size_type(0)));
+	    _M_capacity(__dnew);
+	  }
+
+	// Check for out_of_range and length_error exceptions.
+	try
+	  { _S_copy_chars(_M_data(), __beg, __end); }
+	catch(...)
+	  {
+	    _M_dispose();
+	    __throw_exception_again;
+	  }
+
+	_M_set_length(__dnew);
+      }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    _M_construct(size_type __n, _CharT __c)
+    {
+      if (__n > size_type(_S_local_capacity))
+	{
+	  _M_data(_M_create(__n, size_type(0)));
+	  _M_capacity(__n);
+	}
+
+      if (__n)
+	_S_assign(_M_data(), __n, __c);
+
+      _M_set_length(__n);
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    _M_mutate(size_type __pos, size_type __len1, const _CharT* __s,
+	      size_type __len2)
+    {
+      const size_type __how_much = length() - __pos - __len1;
+
+      size_type __new_capacity = length() + __len2 - __len1;
+      _CharT* __r = _M_create(__new_capacity, capacity());
+
+      if (__pos)
+	_S_copy(__r, _M_data(), __pos);
+      if (__s && __len2)
+	_S_copy(__r + __pos, __s, __len2);
+      if (__how_much)
+	_S_copy(__r + __pos + __len2,
+		_M_data() + __pos + __len1, __how_much);
+
+      _M_dispose();
+      _M_data(__r);
+      _M_capacity(__new_capacity);
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    _M_erase(size_type __pos, size_type __n)
+    {
+      const size_type __how_much = length() - __pos - __n;
+
+      if (__how_much && __n)
+	_S_move(_M_data() + __pos, _M_data() + __pos + __n, __how_much);
+
+      _M_set_length(length() - __n);
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    basic_sso_string<_CharT, _Traits, _Alloc>&
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    _M_replace(size_type __pos, size_type __len1, const _CharT* __s,
+	       const size_type __len2)
+    {
+      _M_check_length(__len1, __len2, "basic_sso_string::_M_replace");
+
+      const size_type __old_size = this->size();
+      const size_type __new_size = __old_size + __len2 - __len1;
+
+      if (__new_size <= this->capacity())
+	{
+	  _CharT* __p = _M_data() + __pos;
+
+	  const size_type __how_much = __old_size - __pos - __len1;
+	  if (_M_disjunct(__s))
+	    {
+	      if (__how_much && __len1 != __len2)
+		_S_move(__p + __len2, __p + __len1, __how_much);
+	      if (__len2)
+		_S_copy(__p, __s, __len2);
+	    }
+	  else
+	    {
+	      // Work in-place: the source lies within this string, so
+	      // shuffle the tail first and then pick up the source from
+	      // wherever it ended up.
+	      if (__len2 && __len2 <= __len1)
+		_S_move(__p, __s, __len2);
+	      if (__how_much && __len1 != __len2)
+		_S_move(__p + __len2, __p + __len1, __how_much);
+	      if (__len2 > __len1)
+		{
+		  if (__s + __len2 <= __p + __len1)
+		    _S_move(__p, __s, __len2);
+		  else if (__s >= __p + __len1)
+		    _S_copy(__p, __s + __len2 - __len1, __len2);
+		  else
+		    {
+		      const size_type __nleft = (__p + __len1) - __s;
+		      _S_move(__p, __s, __nleft);
+		      _S_copy(__p + __nleft, __p + __len2,
+			      __len2 - __nleft);
+		    }
+		}
+	    }
+	}
+      else
+	_M_mutate(__pos, __len1, __s, __len2);
+
+      _M_set_length(__new_size);
+      return *this;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    basic_sso_string<_CharT, _Traits, _Alloc>&
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    _M_replace_aux(size_type __pos1, size_type __n1, size_type __n2,
+		   _CharT __c)
+    {
+      _M_check_length(__n1, __n2, "basic_sso_string::_M_replace_aux");
+
+      const size_type __old_size = this->size();
+      const size_type __new_size = __old_size + __n2 - __n1;
+
+      if (__new_size <= this->capacity())
+	{
+	  _CharT* __p = _M_data() + __pos1;
+
+	  const size_type __how_much = __old_size - __pos1 - __n1;
+	  if (__how_much && __n1 != __n2)
+	    _S_move(__p + __n2, __p + __n1, __how_much);
+	}
+      else
+	_M_mutate(__pos1, __n1, 0, __n2);
+
+      if (__n2)
+	_S_assign(_M_data() + __pos1, __n2, __c);
+
+      _M_set_length(__new_size);
+      return *this;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    template<typename _InputIterator>
+      basic_sso_string<_CharT, _Traits, _Alloc>&
+      basic_sso_string<_CharT, _Traits, _Alloc>::
+      _M_replace_dispatch(iterator __i1, iterator __i2, _InputIterator __k1,
+			  _InputIterator __k2, __false_type)
+      {
+	const basic_sso_string __s(__k1, __k2);
+	const size_type __n1 = __i2 - __i1;
+	return _M_replace(__i1 - begin(), __n1, __s._M_data(),
+			  __s.size());
+      }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    basic_sso_string<_CharT, _Traits, _Alloc>&
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    assign(const basic_sso_string& __str)
+    {
+      if (this != &__str)
+	{
+	  const size_type __rsize = __str.length();
+	  const size_type __capacity = capacity();
+
+	  if (__rsize > __capacity)
+	    {
+	      size_type __new_capacity = __rsize;
+	      _CharT* __tmp = _M_create(__new_capacity, __capacity);
+	      _M_dispose();
+	      _M_data(__tmp);
+	      _M_capacity(__new_capacity);
+	    }
+
+	  if (__rsize)
+	    _S_copy(_M_data(), __str._M_data(), __rsize);
+
+	  _M_set_length(__rsize);
+	}
+      return *this;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    basic_sso_string<_CharT, _Traits, _Alloc>&
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    append(const _CharT* __s, size_type __n)
+    {
+      __glibcxx_requires_string_len(__s, __n);
+      _M_check_length(size_type(0), __n, "basic_sso_string::append");
+      const size_type __len = __n + this->size();
+
+      if (__len <= this->capacity())
+	{
+	  if (__n)
+	    _S_copy(_M_data() + this->size(), __s, __n);
+	}
+      else
+	_M_mutate(this->size(), size_type(0), __s, __n);
+
+      _M_set_length(__len);
+      return *this;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    reserve(size_type __res)
+    {
+      // Make sure we don't shrink below the current size.
+      if (__res < length())
+	__res = length();
+
+      const size_type __capacity = capacity();
+      if (__res != __capacity)
+	{
+	  if (__res > __capacity
+	      || __res > size_type(_S_local_capacity))
+	    {
+	      _CharT* __tmp = _M_create(__res, __capacity);
+	      _S_copy(__tmp, _M_data(), length() + 1);
+	      _M_dispose();
+	      _M_data(__tmp);
+	      _M_capacity(__res);
+	    }
+	  else if (!_M_is_local())
+	    {
+	      _S_copy(_M_local_data(), _M_data(), length() + 1);
+	      _M_destroy(__capacity);
+	      _M_data(_M_local_data());
+	    }
+	}
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    resize(size_type __n, _CharT __c)
+    {
+      const size_type __size = this->size();
+      if (__size < __n)
+	this->append(__n - __size, __c);
+      else if (__n < __size)
+	_M_set_length(__n);
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    swap(basic_sso_string& __s)
+    {
+      if (this == &__s)
+	return;
+
+      // The code below can usually be optimized away.
+      if (this->get_allocator() != __s.get_allocator())
+	{
+	  const basic_sso_string __tmp1(begin(), end(), __s.get_allocator());
+	  const basic_sso_string __tmp2(__s.begin(), __s.end(),
+					this->get_allocator());
+	  *this = __tmp2;
+	  __s = __tmp1;
+	  return;
+	}
+
+      if (_M_is_local())
+	if (__s._M_is_local())
+	  {
+	    if (length() && __s.length())
+	      {
+		_CharT __tmp_data[_S_local_capacity + 1];
+		traits_type::copy(__tmp_data, __s._M_local_buf,
+				  _S_local_capacity + 1);
+		traits_type::copy(__s._M_local_buf, _M_local_buf,
+				  _S_local_capacity + 1);
+		traits_type::copy(_M_local_buf, __tmp_data,
+				  _S_local_capacity + 1);
+	      }
+	    else if (__s.length())
+	      {
+		traits_type::copy(_M_local_buf, __s._M_local_buf,
+				  _S_local_capacity + 1);
+		_M_length(__s.length());
+		__s._M_set_length(0);
+		return;
+	      }
+	    else if (length())
+	      {
+		traits_type::copy(__s._M_local_buf, _M_local_buf,
+				  _S_local_capacity + 1);
+		__s._M_length(length());
+		_M_set_length(0);
+		return;
+	      }
+	  }
+	else
+	  {
+	    const size_type __tmp_capacity = __s._M_allocated_capacity;
+	    traits_type::copy(__s._M_local_buf, _M_local_buf,
+			      _S_local_capacity + 1);
+	    _M_data(__s._M_data());
+	    __s._M_data(__s._M_local_buf);
+	    _M_capacity(__tmp_capacity);
+	  }
+      else
+	{
+	  const size_type __tmp_capacity = _M_allocated_capacity;
+	  if (__s._M_is_local())
+	    {
+	      traits_type::copy(_M_local_buf, __s._M_local_buf,
+				_S_local_capacity + 1);
+	      __s._M_data(_M_data());
+	      _M_data(_M_local_buf);
+	    }
+	  else
+	    {
+	      _CharT* __tmp_ptr = _M_data();
+	      _M_data(__s._M_data());
+	      __s._M_data(__tmp_ptr);
+	      _M_capacity(__s._M_allocated_capacity);
+	    }
+	  __s._M_capacity(__tmp_capacity);
+	}
+
+      const size_type __tmp_length = length();
+      _M_length(__s.length());
+      __s._M_length(__tmp_length);
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    copy(_CharT* __s, size_type __n, size_type __pos) const
+    {
+      _M_check(__pos, "basic_sso_string::copy");
+      __n = _M_limit(__pos, __n);
+      __glibcxx_requires_string_len(__s, __n);
+      if (__n)
+	_S_copy(__s, _M_data() + __pos, __n);
+      // 21.3.5.7 par 3: do not append null.  (good.)
+      return __n;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    basic_sso_string<_CharT, _Traits, _Alloc>
+    operator+(const _CharT* __lhs,
+	      const basic_sso_string<_CharT, _Traits, _Alloc>& __rhs)
+    {
+      __glibcxx_requires_string(__lhs);
+      typedef basic_sso_string<_CharT, _Traits, _Alloc> __string_type;
+      typedef typename __string_type::size_type	  __size_type;
+      const __size_type __len = _Traits::length(__lhs);
+      __string_type __str;
+      __str.reserve(__len + __rhs.size());
+      __str.append(__lhs, __len);
+      __str.append(__rhs);
+      return __str;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    basic_sso_string<_CharT, _Traits, _Alloc>
+    operator+(_CharT __lhs,
+	      const basic_sso_string<_CharT, _Traits, _Alloc>& __rhs)
+    {
+      typedef basic_sso_string<_CharT, _Traits, _Alloc> __string_type;
+      typedef typename __string_type::size_type	  __size_type;
+      __string_type __str;
+      const __size_type __len = __rhs.size();
+      __str.reserve(__len + 1);
+      __str.append(__size_type(1), __lhs);
+      __str.append(__rhs);
+      return __str;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    find(const _CharT* __s, size_type __pos, size_type __n) const
+    {
+      __glibcxx_requires_string_len(__s, __n);
+      size_type __ret = npos;
+      const size_type __size = this->size();
+      if (__pos + __n <= __size)
+	{
+	  const _CharT* __data = _M_data();
+	  const _CharT* __p = std::search(__data + __pos, __data + __size,
+					  __s, __s + __n, traits_type::eq);
+	  if (__p != __data + __size || __n == 0)
+	    __ret = __p - __data;
+	}
+      return __ret;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    find(_CharT __c, size_type __pos) const
+    {
+      size_type __ret = npos;
+      const size_type __size = this->size();
+      if (__pos < __size)
+	{
+	  const _CharT* __data = _M_data();
+	  const size_type __n = __size - __pos;
+	  const _CharT* __p = traits_type::find(__data + __pos, __n, __c);
+	  if (__p)
+	    __ret = __p - __data;
+	}
+      return __ret;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    rfind(const _CharT* __s, size_type __pos, size_type __n) const
+    {
+      __glibcxx_requires_string_len(__s, __n);
+      const size_type __size = this->size();
+      if (__n <= __size)
+	{
+	  __pos = std::min(size_type(__size - __n), __pos);
+	  const _CharT* __data = _M_data();
+	  do
+	    {
+	      if (traits_type::compare(__data + __pos, __s, __n) == 0)
+		return __pos;
+	    }
+	  while (__pos-- > 0);
+	}
+      return npos;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    rfind(_CharT __c, size_type __pos) const
+    {
+      size_type __size = this->size();
+      if (__size)
+	{
+	  if (--__size > __pos)
+	    __size = __pos;
+	  for (++__size; __size-- > 0; )
+	    if (traits_type::eq(_M_data()[__size], __c))
+	      return __size;
+	}
+      return npos;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    find_first_of(const _CharT* __s, size_type __pos, size_type __n) const
+    {
+      __glibcxx_requires_string_len(__s, __n);
+      for (; __n && __pos < this->size(); ++__pos)
+	{
+	  const _CharT* __p = traits_type::find(__s, __n, _M_data()[__pos]);
+	  if (__p)
+	    return __pos;
+	}
+      return npos;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    find_last_of(const _CharT* __s, size_type __pos, size_type __n) const
+    {
+      __glibcxx_requires_string_len(__s, __n);
+      size_type __size = this->size();
+      if (__size && __n)
+	{
+	  if (--__size > __pos)
+	    __size = __pos;
+	  do
+	    {
+	      if (traits_type::find(__s, __n, _M_data()[__size]))
+		return __size;
+	    }
+	  while (__size-- != 0);
+	}
+      return npos;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    find_first_not_of(const _CharT* __s, size_type __pos, size_type __n) const
+    {
+      __glibcxx_requires_string_len(__s, __n);
+      for (; __pos < this->size(); ++__pos)
+	if (!traits_type::find(__s, __n, _M_data()[__pos]))
+	  return __pos;
+      return npos;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    find_first_not_of(_CharT __c, size_type __pos) const
+    {
+      for (; __pos < this->size(); ++__pos)
+	if (!traits_type::eq(_M_data()[__pos], __c))
+	  return __pos;
+      return npos;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    find_last_not_of(const _CharT* __s, size_type __pos, size_type __n) const
+    {
+      __glibcxx_requires_string_len(__s, __n);
+      size_type __size = this->size();
+      if (__size)
+	{
+	  if (--__size > __pos)
+	    __size = __pos;
+	  do
+	    {
+	      if (!traits_type::find(__s, __n, _M_data()[__size]))
+		return __size;
+	    }
+	  while (__size--);
+	}
+      return npos;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    typename basic_sso_string<_CharT, _Traits, _Alloc>::size_type
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    find_last_not_of(_CharT __c, size_type __pos) const
+    {
+      size_type __size = this->size();
+      if (__size)
+	{
+	  if (--__size > __pos)
+	    __size = __pos;
+	  do
+	    {
+	      if (!traits_type::eq(_M_data()[__size], __c))
+		return __size;
+	    }
+	  while (__size--);
+	}
+      return npos;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    int
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    compare(size_type __pos, size_type __n,
+	    const basic_sso_string& __str) const
+    {
+      _M_check(__pos, "basic_sso_string::compare");
+      __n = _M_limit(__pos, __n);
+      const size_type __osize = __str.size();
+      const size_type __len = std::min(__n, __osize);
+      int __r = traits_type::compare(_M_data() + __pos, __str.data(), __len);
+      if (!__r)
+	__r = __n - __osize;
+      return __r;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    int
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    compare(size_type __pos1, size_type __n1, const basic_sso_string& __str,
+	    size_type __pos2, size_type __n2) const
+    {
+      _M_check(__pos1, "basic_sso_string::compare");
+      __str._M_check(__pos2, "basic_sso_string::compare");
+      __n1 = _M_limit(__pos1, __n1);
+      __n2 = __str._M_limit(__pos2, __n2);
+      const size_type __len = std::min(__n1, __n2);
+      int __r = traits_type::compare(_M_data() + __pos1,
+				     __str.data() + __pos2, __len);
+      if (!__r)
+	__r = __n1 - __n2;
+      return __r;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    int
+    basic_sso_string<_CharT, _Traits, _Alloc>::
+    compare(const _CharT* __s) const
+    {
+      __glibcxx_requires_string(__s);
+      const size_type __size = this->size();
+      const size_type __osize = traits_type::length(__s);
+      const size_type __len = std::min(__size, __osize);
+      int __r = traits_type::compare(_M_data(), __s, __len);
+      if (!__r)
+	__r = __size - __osize;
+      return __r;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    int
+    basic_sso_string <_CharT, _Traits, _Alloc>::
+    compare(size_type __pos, size_type __n1, const _CharT* __s) const
+    {
+      __glibcxx_requires_string(__s);
+      _M_check(__pos, "basic_sso_string::compare");
+      __n1 = _M_limit(__pos, __n1);
+      const size_type __osize = traits_type::length(__s);
+      const size_type __len = std::min(__n1, __osize);
+      int __r = traits_type::compare(_M_data() + __pos, __s, __len);
+      if (!__r)
+	__r = __n1 - __osize;
+      return __r;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    int
+    basic_sso_string <_CharT, _Traits, _Alloc>::
+    compare(size_type __pos, size_type __n1, const _CharT* __s,
+	    size_type __n2) const
+    {
+      __glibcxx_requires_string_len(__s, __n2);
+      _M_check(__pos, "basic_sso_string::compare");
+      __n1 = _M_limit(__pos, __n1);
+      const size_type __len = std::min(__n1, __n2);
+      int __r = traits_type::compare(_M_data() + __pos, __s, __len);
+      if (!__r)
+	__r = __n1 - __n2;
+      return __r;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    std::basic_ostream<_CharT, _Traits>&
+    operator<<(std::basic_ostream<_CharT, _Traits>& __out,
+	       const basic_sso_string<_CharT, _Traits, _Alloc>& __str)
+    {
+      typedef std::basic_ostream<_CharT, _Traits> __ostream_type;
+      typename __ostream_type::sentry __cerb(__out);
+      if (__cerb)
+	{
+	  const std::streamsize __w = __out.width();
+	  const std::streamsize __len
+	    = static_cast<std::streamsize>(__str.size());
+	  const std::streamsize __plen = __w > __len ? __w - __len : 0;
+	  const bool __left = ((__out.flags() & std::ios_base::adjustfield)
+			       == std::ios_base::left);
+	  const _CharT __fill = __out.fill();
+	  bool __ok = true;
+
+	  // _GLIBCXX_RESOLVE_LIB_DEFECTS
+	  // 25. String operator<< uses width() value wrong
+	  for (std::streamsize __i = 0; __ok && !__left && __i < __plen; ++__i)
+	    __ok = !_Traits::eq_int_type(__out.rdbuf()->sputc(__fill),
+					 _Traits::eof());
+	  if (__ok)
+	    __ok = __out.rdbuf()->sputn(__str.data(), __len) == __len;
+	  for (std::streamsize __i = 0; __ok && __left && __i < __plen; ++__i)
+	    __ok = !_Traits::eq_int_type(__out.rdbuf()->sputc(__fill),
+					 _Traits::eof());
+	  if (!__ok)
+	    __out.setstate(std::ios_base::badbit);
+	  __out.width(0);
+	}
+      return __out;
+    }
+
+  // The extractors go through std::basic_string, whose implementation
+  // in istream.tcc reads straight from the stream buffer.
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    std::basic_istream<_CharT, _Traits>&
+    operator>>(std::basic_istream<_CharT, _Traits>& __in,
+	       basic_sso_string<_CharT, _Traits, _Alloc>& __str)
+    {
+      std::basic_string<_CharT, _Traits, _Alloc> __tmp;
+      __in >> __tmp;
+      __str.assign(__tmp.data(), __tmp.size());
+      return __in;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    std::basic_istream<_CharT, _Traits>&
+    getline(std::basic_istream<_CharT, _Traits>& __in,
+	    basic_sso_string<_CharT, _Traits, _Alloc>& __str, _CharT __delim)
+    {
+      std::basic_string<_CharT, _Traits, _Alloc> __tmp;
+      std::getline(__in, __tmp, __delim);
+      __str.assign(__tmp.data(), __tmp.size());
+      return __in;
+    }
+} // namespace __gnu_cxx
+
+#endif /* _SSO_STRINGIMPL_H */
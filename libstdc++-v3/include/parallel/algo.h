@@ -0,0 +1,443 @@
+// Parallel mode implementation of <algorithm> -*- C++ -*-
+
+// Copyright (C) 2005
+// Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/algo.h
+ *  This file is a GNU parallel mode extension to the Standard C++ Library.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_ALGO_H
+#define _GLIBCXX_PARALLEL_ALGO_H 1
+
+#include <parallel/base.h>
+
+namespace __gnu_parallel
+{
+  template<typename _Tp>
+    struct _Less
+    {
+      bool
+      operator()(const _Tp& __x, const _Tp& __y) const
+      { return __x < __y; }
+    };
+
+  // for_each: each thread applies its own copy of the function.
+  template<typename _RandomAccessIterator, typename _Function>
+    struct _For_each_task
+    {
+      _RandomAccessIterator	_M_first;
+      _RandomAccessIterator	_M_last;
+      const _Function*		_M_f;
+
+      void
+      operator()()
+      {
+	_Function __f(*_M_f);
+	for (; _M_first != _M_last; ++_M_first)
+	  __f(*_M_first);
+      }
+    };
+
+  template<typename _InputIterator, typename _Function>
+    inline bool
+    __for_each(_InputIterator, _InputIterator, _Function,
+	       std::input_iterator_tag)
+    { return false; }
+
+  template<typename _RandomAccessIterator, typename _Function>
+    bool
+    __for_each(_RandomAccessIterator __first, _RandomAccessIterator __last,
+	       _Function __f, std::random_access_iterator_tag)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	difference_type _Distance;
+
+      const _Distance __n = __last - __first;
+      const unsigned int __p =
+	__gnu_parallel::__num_threads(__n,
+				      __get_settings()._M_loop_minimal_n);
+      if (__p < 2)
+	return false;
+
+      _For_each_task<_RandomAccessIterator, _Function>
+	__tasks[_S_max_threads];
+      for (unsigned int __i = 0; __i < __p; ++__i)
+	{
+	  __tasks[__i]._M_first = __first + __chunk_begin(__n, __p, __i);
+	  __tasks[__i]._M_last = __first + __chunk_begin(__n, __p, __i + 1);
+	  __tasks[__i]._M_f = &__f;
+	}
+      __gnu_parallel::__run_tasks(__tasks, __p);
+      return true;
+    }
+
+  template<typename _InputIterator, typename _Function>
+    bool
+    __for_each(_InputIterator __first, _InputIterator __last, _Function __f)
+    {
+      return __gnu_parallel::__for_each(__first, __last, __f,
+					std::__iterator_category(__first));
+    }
+
+  // transform, both forms.
+  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+	   typename _UnaryOperation>
+    struct _Transform_task
+    {
+      _RandomAccessIterator1	_M_first;
+      _RandomAccessIterator1	_M_last;
+      _RandomAccessIterator2	_M_result;
+      const _UnaryOperation*	_M_op;
+
+      void
+      operator()()
+      {
+	_UnaryOperation __op(*_M_op);
+	for (; _M_first != _M_last; ++_M_first, ++_M_result)
+	  *_M_result = __op(*_M_first);
+      }
+    };
+
+  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+	   typename _RandomAccessIterator3, typename _BinaryOperation>
+    struct _Transform2_task
+    {
+      _RandomAccessIterator1	_M_first1;
+      _RandomAccessIterator1	_M_last1;
+      _RandomAccessIterator2	_M_first2;
+      _RandomAccessIterator3	_M_result;
+      const _BinaryOperation*	_M_op;
+
+      void
+      operator()()
+      {
+	_BinaryOperation __op(*_M_op);
+	for (; _M_first1 != _M_last1; ++_M_first1, ++_M_first2, ++_M_result)
+	  *_M_result = __op(*_M_first1, *_M_first2);
+      }
+    };
+
+  template<typename _InputIterator, typename _OutputIterator,
+	   typename _UnaryOperation, typename _Tag1, typename _Tag2>
+    inline bool
+    __transform(_InputIterator, _InputIterator, _OutputIterator,
+		_UnaryOperation, _OutputIterator&, _Tag1, _Tag2)
+    { return false; }
+
+  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+	   typename _UnaryOperation>
+    bool
+    __transform(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last,
+		_RandomAccessIterator2 __result, _UnaryOperation __op,
+		_RandomAccessIterator2& __ret,
+		std::random_access_iterator_tag,
+		std::random_access_iterator_tag)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator1>::
+	difference_type _Distance;
+
+      const _Distance __n = __last - __first;
+      const unsigned int __p =
+	__gnu_parallel::__num_threads(__n,
+				      __get_settings()._M_loop_minimal_n);
+      if (__p < 2)
+	return false;
+
+      _Transform_task<_RandomAccessIterator1, _RandomAccessIterator2,
+		      _UnaryOperation> __tasks[_S_max_threads];
+      for (unsigned int __i = 0; __i < __p; ++__i)
+	{
+	  const _Distance __b = __chunk_begin(__n, __p, __i);
+	  __tasks[__i]._M_first = __first + __b;
+	  __tasks[__i]._M_last = __first + __chunk_begin(__n, __p, __i + 1);
+	  __tasks[__i]._M_result = __result + __b;
+	  __tasks[__i]._M_op = &__op;
+	}
+      __gnu_parallel::__run_tasks(__tasks, __p);
+      __ret = __result + __n;
+      return true;
+    }
+
+  template<typename _InputIterator, typename _OutputIterator,
+	   typename _UnaryOperation>
+    bool
+    __transform(_InputIterator __first, _InputIterator __last,
+		_OutputIterator __result, _UnaryOperation __op,
+		_OutputIterator& __ret)
+    {
+      return __gnu_parallel::__transform(__first, __last, __result, __op,
+					 __ret,
+					 std::__iterator_category(__first),
+					 std::__iterator_category(__result));
+    }
+
+  template<typename _InputIterator1, typename _InputIterator2,
+	   typename _OutputIterator, typename _BinaryOperation,
+	   typename _Tag1, typename _Tag2, typename _Tag3>
+    inline bool
+    __transform(_InputIterator1, _InputIterator1, _InputIterator2,
+		_OutputIterator, _BinaryOperation, _OutputIterator&,
+		_Tag1, _Tag2, _Tag3)
+    { return false; }
+
+  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+	   typename _RandomAccessIterator3, typename _BinaryOperation>
+    bool
+    __transform(_RandomAccessIterator1 __first1,
+		_RandomAccessIterator1 __last1,
+		_RandomAccessIterator2 __first2,
+		_RandomAccessIterator3 __result, _BinaryOperation __op,
+		_RandomAccessIterator3& __ret,
+		std::random_access_iterator_tag,
+		std::random_access_iterator_tag,
+		std::random_access_iterator_tag)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator1>::
+	difference_type _Distance;
+
+      const _Distance __n = __last1 - __first1;
+      const unsigned int __p =
+	__gnu_parallel::__num_threads(__n,
+				      __get_settings()._M_loop_minimal_n);
+      if (__p < 2)
+	return false;
+
+      _Transform2_task<_RandomAccessIterator1, _RandomAccessIterator2,
+		       _RandomAccessIterator3, _BinaryOperation>
+	__tasks[_S_max_threads];
+      for (unsigned int __i = 0; __i < __p; ++__i)
+	{
+	  const _Distance __b = __chunk_begin(__n, __p, __i);
+	  __tasks[__i]._M_first1 = __first1 + __b;
+	  __tasks[__i]._M_last1 = __first1 + __chunk_begin(__n, __p, __i + 1);
+	  __tasks[__i]._M_first2 = __first2 + __b;
+	  __tasks[__i]._M_result = __result + __b;
+	  __tasks[__i]._M_op = &__op;
+	}
+      __gnu_parallel::__run_tasks(__tasks, __p);
+      __ret = __result + __n;
+      return true;
+    }
+
+  template<typename _InputIterator1, typename _InputIterator2,
+	   typename _OutputIterator, typename _BinaryOperation>
+    bool
+    __transform(_InputIterator1 __first1, _InputIterator1 __last1,
+		_InputIterator2 __first2, _OutputIterator __result,
+		_BinaryOperation __op, _OutputIterator& __ret)
+    {
+      return __gnu_parallel::__transform(__first1, __last1, __first2,
+					 __result, __op, __ret,
+					 std::__iterator_category(__first1),
+					 std::__iterator_category(__first2),
+					 std::__iterator_category(__result));
+    }
+
+  // Sorting: the range is cut in one chunk per thread, the chunks
+  // are sorted concurrently, then merged pairwise, the merges of each
+  // round being concurrent too.  Merging is stable, thus so is the
+  // whole when the chunks are sorted stably.
+  template<typename _RandomAccessIterator, typename _Compare>
+    struct _Sort_task
+    {
+      _RandomAccessIterator	_M_first;
+      _RandomAccessIterator	_M_last;
+      const _Compare*		_M_comp;
+      bool			_M_stable;
+
+      void
+      operator()()
+      {
+	typedef typename std::iterator_traits<_RandomAccessIterator>::
+	  value_type _ValueType;
+	typedef typename std::iterator_traits<_RandomAccessIterator>::
+	  difference_type _DistanceType;
+
+	_Compare __comp(*_M_comp);
+	if (_M_stable)
+	  {
+	    std::_Temporary_buffer<_RandomAccessIterator, _ValueType>
+	      __buf(_M_first, _M_last);
+	    if (__buf.begin() == 0)
+	      std::__inplace_stable_sort(_M_first, _M_last, __comp);
+	    else
+	      std::__stable_sort_adaptive(_M_first, _M_last, __buf.begin(),
+					  _DistanceType(__buf.size()),
+					  __comp);
+	  }
+	else if (_M_first != _M_last)
+	  {
+	    std::__introsort_loop(_M_first, _M_last,
+				  std::__lg(_M_last - _M_first) * 2, __comp);
+	    std::__final_insertion_sort(_M_first, _M_last, __comp);
+	  }
+      }
+    };
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    struct _Merge_task
+    {
+      _RandomAccessIterator	_M_first;
+      _RandomAccessIterator	_M_middle;
+      _RandomAccessIterator	_M_last;
+      const _Compare*		_M_comp;
+
+      void
+      operator()()
+      { std::inplace_merge(_M_first, _M_middle, _M_last, *_M_comp); }
+    };
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    bool
+    __parallel_sort(_RandomAccessIterator __first,
+		    _RandomAccessIterator __last, _Compare __comp,
+		    bool __stable)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	difference_type _Distance;
+
+      const _Distance __n = __last - __first;
+      const unsigned int __p =
+	__gnu_parallel::__num_threads(__n,
+				      __get_settings()._M_sort_minimal_n);
+      if (__p < 2)
+	return false;
+
+      _RandomAccessIterator __bounds[_S_max_threads + 1];
+      for (unsigned int __i = 0; __i <= __p; ++__i)
+	__bounds[__i] = __first + __chunk_begin(__n, __p, __i);
+
+      _Sort_task<_RandomAccessIterator, _Compare> __sorts[_S_max_threads];
+      for (unsigned int __i = 0; __i < __p; ++__i)
+	{
+	  __sorts[__i]._M_first = __bounds[__i];
+	  __sorts[__i]._M_last = __bounds[__i + 1];
+	  __sorts[__i]._M_comp = &__comp;
+	  __sorts[__i]._M_stable = __stable;
+	}
+      __gnu_parallel::__run_tasks(__sorts, __p);
+
+      _Merge_task<_RandomAccessIterator, _Compare> __merges[_S_max_threads];
+      for (unsigned int __width = 1; __width < __p; __width *= 2)
+	{
+	  unsigned int __m = 0;
+	  for (unsigned int __i = 0; __i + __width < __p; __i += 2 * __width)
+	    {
+	      __merges[__m]._M_first = __bounds[__i];
+	      __merges[__m]._M_middle = __bounds[__i + __width];
+	      __merges[__m]._M_last = __bounds[std::min(__i + 2 * __width,
+							__p)];
+	      __merges[__m]._M_comp = &__comp;
+	      ++__m;
+	    }
+	  __gnu_parallel::__run_tasks(__merges, __m);
+	}
+      return true;
+    }
+
+  template<typename _RandomAccessIterator>
+    bool
+    __sort(_RandomAccessIterator __first, _RandomAccessIterator __last)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	value_type _ValueType;
+
+      return __gnu_parallel::__parallel_sort(__first, __last,
+					     _Less<_ValueType>(), false);
+    }
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    bool
+    __sort(_RandomAccessIterator __first, _RandomAccessIterator __last,
+	   _Compare __comp)
+    {
+      return __gnu_parallel::__parallel_sort(__first, __last, __comp,
+					     false);
+    }
+
+  template<typename _RandomAccessIterator>
+    bool
+    __stable_sort(_RandomAccessIterator __first, _RandomAccessIterator __last)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	value_type _ValueType;
+
+      return __gnu_parallel::__parallel_sort(__first, __last,
+					     _Less<_ValueType>(), true);
+    }
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    bool
+    __stable_sort(_RandomAccessIterator __first, _RandomAccessIterator __last,
+		  _Compare __comp)
+    {
+      return __gnu_parallel::__parallel_sort(__first, __last, __comp, true);
+    }
+
+  // partial_sort: select the smallest elements sequentially, in
+  // linear time, then sort them in parallel.
+  template<typename _RandomAccessIterator, typename _Compare>
+    bool
+    __partial_sort(_RandomAccessIterator __first,
+		   _RandomAccessIterator __middle,
+		   _RandomAccessIterator __last, _Compare __comp)
+    {
+      if (__gnu_parallel::__num_threads(__middle - __first,
+					__get_settings()._M_sort_minimal_n)
+	  < 2)
+	return false;
+
+      if (__middle != __last)
+	std::nth_element(__first, __middle, __last, __comp);
+      if (!__gnu_parallel::__parallel_sort(__first, __middle, __comp, false))
+	{
+	  // The settings changed meanwhile.
+	  _Sort_task<_RandomAccessIterator, _Compare> __task =
+	    { __first, __middle, &__comp, false };
+	  __task();
+	}
+      return true;
+    }
+
+  template<typename _RandomAccessIterator>
+    bool
+    __partial_sort(_RandomAccessIterator __first,
+		   _RandomAccessIterator __middle,
+		   _RandomAccessIterator __last)
+    {
+      typedef typename std::iterator_traits<_RandomAccessIterator>::
+	value_type _ValueType;
+
+      return __gnu_parallel::__partial_sort(__first, __middle, __last,
+					    _Less<_ValueType>());
+    }
+} // namespace __gnu_parallel
+
+#endif
@@ -0,0 +1,87 @@
+// Parallel mode declarations for <algorithm> -*- C++ -*-
+
+// Copyright (C) 2005
+// Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/algorithmfwd.h
+ *  This file is a GNU parallel mode extension to the Standard C++ Library.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_ALGORITHMFWD_H
+#define _GLIBCXX_PARALLEL_ALGORITHMFWD_H 1
+
+// Each of these runs the algorithm of the same name in parallel and
+// returns true, or does nothing and returns false when the range is
+// too short, or not random access, or threads are not available.
+namespace __gnu_parallel
+{
+  template<typename _InputIterator, typename _Function>
+    bool
+    __for_each(_InputIterator, _InputIterator, _Function);
+
+  template<typename _InputIterator, typename _OutputIterator,
+	   typename _UnaryOperation>
+    bool
+    __transform(_InputIterator, _InputIterator, _OutputIterator,
+		_UnaryOperation, _OutputIterator&);
+
+  template<typename _InputIterator1, typename _InputIterator2,
+	   typename _OutputIterator, typename _BinaryOperation>
+    bool
+    __transform(_InputIterator1, _InputIterator1, _InputIterator2,
+		_OutputIterator, _BinaryOperation, _OutputIterator&);
+
+  template<typename _RandomAccessIterator>
+    bool
+    __partial_sort(_RandomAccessIterator, _RandomAccessIterator,
+		   _RandomAccessIterator);
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    bool
+    __partial_sort(_RandomAccessIterator, _RandomAccessIterator,
+		   _RandomAccessIterator, _Compare);
+
+  template<typename _RandomAccessIterator>
+    bool
+    __sort(_RandomAccessIterator, _RandomAccessIterator);
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    bool
+    __sort(_RandomAccessIterator, _RandomAccessIterator, _Compare);
+
+  template<typename _RandomAccessIterator>
+    bool
+    __stable_sort(_RandomAccessIterator, _RandomAccessIterator);
+
+  template<typename _RandomAccessIterator, typename _Compare>
+    bool
+    __stable_sort(_RandomAccessIterator, _RandomAccessIterator, _Compare);
+} // namespace __gnu_parallel
+
+#endif
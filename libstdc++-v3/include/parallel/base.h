@@ -0,0 +1,174 @@
+// Parallel mode support: settings and threads -*- C++ -*-
+
+// Copyright (C) 2005
+// Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/base.h
+ *  This file is a GNU parallel mode extension to the Standard C++ Library.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_BASE_H
+#define _GLIBCXX_PARALLEL_BASE_H 1
+
+#include <cstddef>
+#include <exception_defines.h>
+#include <bits/gthr.h>
+
+/**
+ * The parallel mode is selected by defining _GLIBCXX_PARALLEL before
+ * including any library header.  The algorithms declared in
+ * parallel/algorithmfwd.h and parallel/numericfwd.h then split large
+ * random access ranges among several threads, and otherwise run the
+ * usual sequential code.  The parallel code requires:
+ *
+ *  - that the function objects passed to the algorithms neither throw
+ *    nor depend on the order in which they are applied: each thread
+ *    works with its own copy, and the copy returned by for_each is the
+ *    one passed in;
+ *  - for the numeric algorithms, which are only parallelized on
+ *    ranges of arithmetic types, that a different association of the
+ *    additions is acceptable, which is not the case for every
+ *    floating point computation.
+ *
+ * Threads are only available with the POSIX threads model.
+ */
+
+namespace __gnu_parallel
+{
+  /// Tunables of the parallel mode.
+  struct _Settings
+  {
+    // Number of threads to use, 0 meaning one per online processor.
+    unsigned int	_M_num_threads;
+
+    // Minimal length of the ranges sort, stable_sort and
+    // partial_sort process in parallel.
+    std::size_t		_M_sort_minimal_n;
+
+    // Minimal length of the ranges for_each, transform, accumulate,
+    // inner_product and partial_sum process in parallel.
+    std::size_t		_M_loop_minimal_n;
+
+    _Settings()
+    : _M_num_threads(0), _M_sort_minimal_n(1 << 15),
+      _M_loop_minimal_n(1 << 17) { }
+  };
+
+  /// The settings in effect, which may be changed at any time.
+  inline _Settings&
+  __get_settings()
+  {
+    static _Settings __settings;
+    return __settings;
+  }
+
+  enum { _S_max_threads = 64 };
+
+  // Number of threads to use for a range of length __n, 1 meaning
+  // the sequential code.
+  inline unsigned int
+  __num_threads(std::size_t __n, std::size_t __minimal_n)
+  {
+    unsigned int __ret = 1;
+#ifdef _GLIBCXX_GCC_GTHR_POSIX_H
+    if (__n >= __minimal_n && __n > 1 && __gthread_active_p())
+      {
+	__ret = __get_settings()._M_num_threads;
+	if (__ret == 0)
+	  {
+#ifdef _SC_NPROCESSORS_ONLN
+	    static const long __procs = sysconf(_SC_NPROCESSORS_ONLN);
+	    if (__procs > 0)
+	      __ret = __procs;
+#endif
+	  }
+	if (__ret > _S_max_threads)
+	  __ret = _S_max_threads;
+	if (__ret > __n)
+	  __ret = __n;
+	if (__ret == 0)
+	  __ret = 1;
+      }
+#endif
+    return __ret;
+  }
+
+  // Start of the __i-th of __p nearly equal parts of [0, __n).
+  template<typename _Distance>
+    inline _Distance
+    __chunk_begin(_Distance __n, unsigned int __p, unsigned int __i)
+    {
+      const _Distance __rem = __n % __p;
+      return __n / __p * __i + (_Distance(__i) < __rem ? _Distance(__i) : __rem);
+    }
+
+  template<typename _Task>
+    void*
+    __run_task(void* __task)
+    {
+      (*static_cast<_Task*>(__task))();
+      return 0;
+    }
+
+  // Runs the __n tasks at __tasks, the last one, and those for which
+  // no thread could be started, in the calling thread.  An exception
+  // thrown there is propagated once all the threads are finished.
+  template<typename _Task>
+    void
+    __run_tasks(_Task* __tasks, unsigned int __n)
+    {
+      unsigned int __started = 0;
+#ifdef _GLIBCXX_GCC_GTHR_POSIX_H
+      pthread_t __threads[_S_max_threads];
+      while (__started + 1 < __n
+	     && pthread_create(&__threads[__started], 0,
+			       &__run_task<_Task>, __tasks + __started) == 0)
+	++__started;
+#endif
+      try
+	{
+	  for (unsigned int __i = __started; __i < __n; ++__i)
+	    __tasks[__i]();
+	}
+      catch(...)
+	{
+#ifdef _GLIBCXX_GCC_GTHR_POSIX_H
+	  for (unsigned int __i = 0; __i < __started; ++__i)
+	    pthread_join(__threads[__i], 0);
+#endif
+	  __throw_exception_again;
+	}
+#ifdef _GLIBCXX_GCC_GTHR_POSIX_H
+      for (unsigned int __i = 0; __i < __started; ++__i)
+	pthread_join(__threads[__i], 0);
+#endif
+    }
+} // namespace __gnu_parallel
+
+#endif
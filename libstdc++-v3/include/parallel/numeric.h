@@ -0,0 +1,324 @@
+// Parallel mode implementation of <numeric> -*- C++ -*-
+
+// Copyright (C) 2005
+// Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/numeric.h
+ *  This file is a GNU parallel mode extension to the Standard C++ Library.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_NUMERIC_H
+#define _GLIBCXX_PARALLEL_NUMERIC_H 1
+
+#include <parallel/base.h>
+
+namespace __gnu_parallel
+{
+  // Reductions: each thread sums its chunk starting from zero, then
+  // the partial sums are added, in order, to the initial value.
+  template<typename _RandomAccessIterator, typename _Tp>
+    struct _Accumulate_task
+    {
+      _RandomAccessIterator	_M_first;
+      _RandomAccessIterator	_M_last;
+      _Tp			_M_sum;
+
+      void
+      operator()()
+      {
+	_Tp __sum = *_M_first;
+	while (++_M_first != _M_last)
+	  __sum = __sum + *_M_first;
+	_M_sum = __sum;
+      }
+    };
+
+  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+	   typename _Tp>
+    struct _Inner_product_task
+    {
+      _RandomAccessIterator1	_M_first1;
+      _RandomAccessIterator1	_M_last1;
+      _RandomAccessIterator2	_M_first2;
+      _Tp			_M_sum;
+
+      void
+      operator()()
+      {
+	_Tp __sum = *_M_first1 * *_M_first2;
+	while (++_M_first1 != _M_last1)
+	  __sum = __sum + (*_M_first1 * *++_M_first2);
+	_M_sum = __sum;
+      }
+    };
+
+  // Prefix sums, in two passes: first each chunk but the last is
+  // summed, then each chunk is scanned from the sum of the preceding
+  // ones.
+  template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+	   typename _Tp>
+    struct _Partial_sum_task
+    {
+      _RandomAccessIterator1	_M_first;
+      _RandomAccessIterator1	_M_last;
+      _RandomAccessIterator2	_M_result;
+      _Tp			_M_sum;
+      bool			_M_scan;
+      bool			_M_offset;
+
+      void
+      operator()()
+      {
+	if (!_M_scan)
+	  {
+	    _Tp __sum = *_M_first;
+	    while (++_M_first != _M_last)
+	      __sum = __sum + *_M_first;
+	    _M_sum = __sum;
+	  }
+	else
+	  {
+	    _Tp __value = *_M_first;
+	    if (_M_offset)
+	      __value = _M_sum + __value;
+	    *_M_result = __value;
+	    while (++_M_first != _M_last)
+	      {
+		__value = __value + *_M_first;
+		*++_M_result = __value;
+	      }
+	  }
+      }
+    };
+
+  // Only sums of values of the same arithmetic type are computed in
+  // parallel: otherwise the intermediate results could have another
+  // type, changing the result beyond rounding.
+  template<bool>
+    struct _Numeric_switch
+    {
+      template<typename _InputIterator, typename _Tp>
+	static bool
+	_S_accumulate(_InputIterator, _InputIterator, _Tp&)
+	{ return false; }
+
+      template<typename _InputIterator1, typename _InputIterator2,
+	       typename _Tp>
+	static bool
+	_S_inner_product(_InputIterator1, _InputIterator1, _InputIterator2,
+			 _Tp&)
+	{ return false; }
+
+      template<typename _InputIterator, typename _OutputIterator>
+	static bool
+	_S_partial_sum(_InputIterator, _InputIterator, _OutputIterator,
+		       _OutputIterator&)
+	{ return false; }
+    };
+
+  template<>
+    struct _Numeric_switch<true>
+    {
+      template<typename _RandomAccessIterator, typename _Tp>
+	static bool
+	_S_accumulate(_RandomAccessIterator __first,
+		      _RandomAccessIterator __last, _Tp& __init)
+	{
+	  typedef typename std::iterator_traits<_RandomAccessIterator>::
+	    difference_type _Distance;
+
+	  const _Distance __n = __last - __first;
+	  const unsigned int __p =
+	    __gnu_parallel::__num_threads(__n,
+					  __get_settings()._M_loop_minimal_n);
+	  if (__p < 2)
+	    return false;
+
+	  _Accumulate_task<_RandomAccessIterator, _Tp>
+	    __tasks[_S_max_threads];
+	  for (unsigned int __i = 0; __i < __p; ++__i)
+	    {
+	      __tasks[__i]._M_first = __first + __chunk_begin(__n, __p, __i);
+	      __tasks[__i]._M_last = __first + __chunk_begin(__n, __p,
+							     __i + 1);
+	    }
+	  __gnu_parallel::__run_tasks(__tasks, __p);
+	  for (unsigned int __i = 0; __i < __p; ++__i)
+	    __init = __init + __tasks[__i]._M_sum;
+	  return true;
+	}
+
+      template<typename _RandomAccessIterator1,
+	       typename _RandomAccessIterator2, typename _Tp>
+	static bool
+	_S_inner_product(_RandomAccessIterator1 __first1,
+			 _RandomAccessIterator1 __last1,
+			 _RandomAccessIterator2 __first2, _Tp& __init)
+	{
+	  typedef typename std::iterator_traits<_RandomAccessIterator1>::
+	    difference_type _Distance;
+
+	  const _Distance __n = __last1 - __first1;
+	  const unsigned int __p =
+	    __gnu_parallel::__num_threads(__n,
+					  __get_settings()._M_loop_minimal_n);
+	  if (__p < 2)
+	    return false;
+
+	  _Inner_product_task<_RandomAccessIterator1, _RandomAccessIterator2,
+			      _Tp> __tasks[_S_max_threads];
+	  for (unsigned int __i = 0; __i < __p; ++__i)
+	    {
+	      const _Distance __b = __chunk_begin(__n, __p, __i);
+	      __tasks[__i]._M_first1 = __first1 + __b;
+	      __tasks[__i]._M_last1 = __first1 + __chunk_begin(__n, __p,
+							       __i + 1);
+	      __tasks[__i]._M_first2 = __first2 + __b;
+	    }
+	  __gnu_parallel::__run_tasks(__tasks, __p);
+	  for (unsigned int __i = 0; __i < __p; ++__i)
+	    __init = __init + __tasks[__i]._M_sum;
+	  return true;
+	}
+
+      template<typename _RandomAccessIterator1,
+	       typename _RandomAccessIterator2>
+	static bool
+	_S_partial_sum(_RandomAccessIterator1 __first,
+		       _RandomAccessIterator1 __last,
+		       _RandomAccessIterator2 __result,
+		       _RandomAccessIterator2& __ret)
+	{
+	  typedef typename std::iterator_traits<_RandomAccessIterator1>::
+	    value_type _ValueType;
+	  typedef typename std::iterator_traits<_RandomAccessIterator1>::
+	    difference_type _Distance;
+
+	  const _Distance __n = __last - __first;
+	  const unsigned int __p =
+	    __gnu_parallel::__num_threads(__n,
+					  __get_settings()._M_loop_minimal_n);
+	  if (__p < 2)
+	    return false;
+
+	  _Partial_sum_task<_RandomAccessIterator1, _RandomAccessIterator2,
+			    _ValueType> __tasks[_S_max_threads];
+	  for (unsigned int __i = 0; __i < __p; ++__i)
+	    {
+	      const _Distance __b = __chunk_begin(__n, __p, __i);
+	      __tasks[__i]._M_first = __first + __b;
+	      __tasks[__i]._M_last = __first + __chunk_begin(__n, __p,
+							     __i + 1);
+	      __tasks[__i]._M_result = __result + __b;
+	      __tasks[__i]._M_scan = false;
+	    }
+	  __gnu_parallel::__run_tasks(__tasks, __p - 1);
+
+	  _ValueType __offset = __tasks[0]._M_sum;
+	  for (unsigned int __i = 0; __i < __p; ++__i)
+	    {
+	      __tasks[__i]._M_first = __first + __chunk_begin(__n, __p, __i);
+	      __tasks[__i]._M_scan = true;
+	      __tasks[__i]._M_offset = __i > 0;
+	      if (__i > 0)
+		{
+		  const _ValueType __sum = __offset;
+		  if (__i + 1 < __p)
+		    __offset = __offset + __tasks[__i]._M_sum;
+		  __tasks[__i]._M_sum = __sum;
+		}
+	    }
+	  __gnu_parallel::__run_tasks(__tasks, __p);
+	  __ret = __result + __n;
+	  return true;
+	}
+    };
+
+  template<typename _InputIterator, typename _Tp>
+    bool
+    __accumulate(_InputIterator __first, _InputIterator __last, _Tp& __init)
+    {
+      typedef typename std::iterator_traits<_InputIterator>::value_type
+	_ValueType;
+      typedef typename std::iterator_traits<_InputIterator>::
+	iterator_category _Category;
+
+      return _Numeric_switch<std::__is_arithmetic<_Tp>::_M_type
+	                     && std::__are_same<_Tp, _ValueType>::_M_type
+	                     && std::__are_same<_Category,
+			       std::random_access_iterator_tag>::_M_type>::
+	_S_accumulate(__first, __last, __init);
+    }
+
+  template<typename _InputIterator1, typename _InputIterator2, typename _Tp>
+    bool
+    __inner_product(_InputIterator1 __first1, _InputIterator1 __last1,
+		    _InputIterator2 __first2, _Tp& __init)
+    {
+      typedef typename std::iterator_traits<_InputIterator1>::value_type
+	_ValueType1;
+      typedef typename std::iterator_traits<_InputIterator2>::value_type
+	_ValueType2;
+      typedef typename std::iterator_traits<_InputIterator1>::
+	iterator_category _Category1;
+      typedef typename std::iterator_traits<_InputIterator2>::
+	iterator_category _Category2;
+
+      return _Numeric_switch<std::__is_arithmetic<_Tp>::_M_type
+	                     && std::__are_same<_Tp, _ValueType1>::_M_type
+	                     && std::__are_same<_Tp, _ValueType2>::_M_type
+	                     && std::__are_same<_Category1,
+			       std::random_access_iterator_tag>::_M_type
+	                     && std::__are_same<_Category2,
+			       std::random_access_iterator_tag>::_M_type>::
+	_S_inner_product(__first1, __last1, __first2, __init);
+    }
+
+  template<typename _InputIterator, typename _OutputIterator>
+    bool
+    __partial_sum(_InputIterator __first, _InputIterator __last,
+		  _OutputIterator __result, _OutputIterator& __ret)
+    {
+      typedef typename std::iterator_traits<_InputIterator>::value_type
+	_ValueType;
+      typedef typename std::iterator_traits<_InputIterator>::
+	iterator_category _Category1;
+      typedef typename std::iterator_traits<_OutputIterator>::
+	iterator_category _Category2;
+
+      return _Numeric_switch<std::__is_arithmetic<_ValueType>::_M_type
+	                     && std::__are_same<_Category1,
+			       std::random_access_iterator_tag>::_M_type
+	                     && std::__are_same<_Category2,
+			       std::random_access_iterator_tag>::_M_type>::
+	_S_partial_sum(__first, __last, __result, __ret);
+    }
+} // namespace __gnu_parallel
+
+#endif
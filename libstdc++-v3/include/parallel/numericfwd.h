@@ -0,0 +1,58 @@
+// Parallel mode declarations for <numeric> -*- C++ -*-
+
+// Copyright (C) 2005
+// Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/** @file parallel/numericfwd.h
+ *  This file is a GNU parallel mode extension to the Standard C++ Library.
+ *  You should not attempt to use it directly.
+ */
+
+#ifndef _GLIBCXX_PARALLEL_NUMERICFWD_H
+#define _GLIBCXX_PARALLEL_NUMERICFWD_H 1
+
+// As in parallel/algorithmfwd.h, each of these returns false when it
+// did nothing; the result is otherwise stored in the last argument.
+namespace __gnu_parallel
+{
+  template<typename _InputIterator, typename _Tp>
+    bool
+    __accumulate(_InputIterator, _InputIterator, _Tp&);
+
+  template<typename _InputIterator1, typename _InputIterator2, typename _Tp>
+    bool
+    __inner_product(_InputIterator1, _InputIterator1, _InputIterator2,
+		    _Tp&);
+
+  template<typename _InputIterator, typename _OutputIterator>
+    bool
+    __partial_sum(_InputIterator, _InputIterator, _OutputIterator,
+		  _OutputIterator&);
+} // namespace __gnu_parallel
+
+#endif
@@ -1,6 +1,6 @@
 // The template and inlines for the -*- C++ -*- valarray class.
 
-// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2004
+// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -56,6 +56,9 @@ namespace std
   template<typename _Tp1, typename _Tp2> 
     class _ValArray;    
 
+  template<typename _Tp1, typename _Tp2>
+    class _Constant;
+
   template<class _Oper, template<class, class> class _Meta, class _Dom>
     struct _UnClos;
 
@@ -595,7 +598,7 @@ namespace std
     : _M_size(__ga._M_index.size()),
       _M_data(__valarray_get_storage<_Tp>(_M_size))
     {
-      std::__valarray_copy
+      std::__valarray_gslice_copy
 	(__ga._M_array, _Array<size_t>(__ga._M_index),
 	 _Array<_Tp>(_M_data), _M_size);
     }
@@ -664,8 +667,9 @@ namespace std
     valarray<_Tp>::operator=(const gslice_array<_Tp>& __ga)
     {
       _GLIBCXX_DEBUG_ASSERT(_M_size == __ga._M_index.size());
-      std::__valarray_copy(__ga._M_array, _Array<size_t>(__ga._M_index),
-			   _Array<_Tp>(_M_data), _M_size);
+      std::__valarray_gslice_copy(__ga._M_array,
+				  _Array<size_t>(__ga._M_index),
+				  _Array<_Tp>(_M_data), _M_size);
       return *this;
     }
 
@@ -856,6 +860,8 @@ namespace std
     valarray<_Tp>::min() const
     {
       _GLIBCXX_DEBUG_ASSERT(_M_size > 0);
+      if (__is_arithmetic<_Tp>::_M_type && _M_size >= 4)
+	return std::__valarray_min_4<_Tp>(_M_data, _M_size);
       return *std::min_element(_M_data, _M_data+_M_size);
     }
 
@@ -864,6 +870,8 @@ namespace std
     valarray<_Tp>::max() const
     {
       _GLIBCXX_DEBUG_ASSERT(_M_size > 0);
+      if (__is_arithmetic<_Tp>::_M_type && _M_size >= 4)
+	return std::__valarray_max_4<_Tp>(_M_data, _M_size);
       return *std::max_element(_M_data, _M_data+_M_size);
     }
   
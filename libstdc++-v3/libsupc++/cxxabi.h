@@ -526,6 +526,31 @@ namespace __cxxabiv1
 // User programs should use the alias `abi'. 
 namespace abi = __cxxabiv1;
 
+namespace __gnu_cxx
+{
+  // Counts kept by __cxa_allocate_exception, for diagnostics.
+  struct __eh_alloc_stats
+  {
+    // Exception objects allocated since the program started, and how
+    // many of those reused an object cached by the allocating thread.
+    unsigned long __allocated;
+    unsigned long __cache_hits;
+
+    // Objects taken from the emergency pool when malloc failed, the
+    // number in use now, and the most ever in use at once.
+    unsigned long __emergency_allocated;
+    unsigned long __emergency_in_use;
+    unsigned long __emergency_peak;
+
+    // The size of the emergency pool.
+    unsigned long __emergency_obj_count;
+    unsigned long __emergency_obj_size;
+  };
+
+  void
+  __get_eh_alloc_stats(__eh_alloc_stats*) throw();
+} // namespace __gnu_cxx
+
 #endif // __cplusplus
 
 #pragma GCC visibility pop
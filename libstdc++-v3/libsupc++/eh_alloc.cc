@@ -1,5 +1,5 @@
 // -*- C++ -*- Allocate exception objects.
-// Copyright (C) 2001, 2004 Free Software Foundation, Inc.
+// Copyright (C) 2001, 2004, 2005 Free Software Foundation, Inc.
 //
 // This file is part of GCC.
 //
@@ -36,6 +36,7 @@
 #endif
 #include <climits>
 #include <exception>
+#include <cxxabi.h>
 #include "unwind-cxx.h"
 #include "bits/c++config.h"
 #include "bits/gthr.h"
@@ -44,6 +45,8 @@
 using std::free;
 using std::malloc;
 using std::memcpy;
+using std::getenv;
+using std::strtoul;
 #else
 // In a freestanding environment, these functions may not be
 // available -- but for now, we assume that they are.
@@ -85,76 +88,366 @@ using namespace __cxxabiv1;
 #define EMERGENCY_OBJ_COUNT 2
 /* APPLE LOCAL end reduce emergency buffer size */
 
-#if INT_MAX == 32767 || EMERGENCY_OBJ_COUNT <= 32
-typedef unsigned int bitmask_type;
-#else
-typedef unsigned long bitmask_type;
+// The emergency pool can be resized when the library is built, by
+// defining these in CXXFLAGS, and when the program starts, by setting
+// the environment variables of the same names without the leading
+// underscore (see emergency_pool_init below).
+#ifdef _GLIBCXX_EH_POOL_OBJ_SIZE
+# undef EMERGENCY_OBJ_SIZE
+# define EMERGENCY_OBJ_SIZE	_GLIBCXX_EH_POOL_OBJ_SIZE
+#endif
+#ifdef _GLIBCXX_EH_POOL_OBJ_COUNT
+# undef EMERGENCY_OBJ_COUNT
+# define EMERGENCY_OBJ_COUNT	_GLIBCXX_EH_POOL_OBJ_COUNT
 #endif
 
+// Freed exception objects are kept on small per-thread free lists,
+// CACHE_DEPTH deep for each of CACHE_CLASSES power-of-two size classes
+// starting at CACHE_MIN_SIZE bytes, so that code which throws often
+// does not go to malloc and free for every exception.
+#define CACHE_CLASSES		4
+#define CACHE_MIN_SIZE		128
+#define CACHE_DEPTH		4
+
+typedef unsigned long bitmask_type;
+#define BITMASK_BITS	(sizeof (bitmask_type) * CHAR_BIT)
 
 typedef char one_buffer[EMERGENCY_OBJ_SIZE] __attribute__((aligned));
 static one_buffer emergency_buffer[EMERGENCY_OBJ_COUNT];
-static bitmask_type emergency_used;
+static bitmask_type
+emergency_buffer_used[(EMERGENCY_OBJ_COUNT + BITMASK_BITS - 1) / BITMASK_BITS];
+
+// The pool in use: the static buffer above, or an arena obtained from
+// malloc at startup when the environment asks for another size.
+static char *emergency_arena = &emergency_buffer[0][0];
+static bitmask_type *emergency_used = emergency_buffer_used;
+static std::size_t emergency_obj_size = EMERGENCY_OBJ_SIZE;
+static unsigned int emergency_obj_count = EMERGENCY_OBJ_COUNT;
+
+static unsigned int emergency_in_use;
+static unsigned int emergency_peak;
+static unsigned long emergency_allocated;
+
+
+// Every block obtained from malloc starts with one of these, giving
+// the size class it was rounded up to, or CACHE_CLASSES if it is too
+// large to be cached.
+struct block_header
+{
+  std::size_t size_class;
+} __attribute__((aligned));
+
+// A thread's cache of freed blocks.  Each free list is threaded
+// through the first word of the blocks on it.
+struct thread_cache
+{
+  void *free_list[CACHE_CLASSES];
+  unsigned int count[CACHE_CLASSES];
+
+  // Statistics, only ever written by the owning thread.
+  unsigned long allocated;
+  unsigned long cache_hits;
+
+  // All live caches, so that the statistics can be summed.
+  thread_cache *next;
+  thread_cache **prev;
+};
+
+// Used until the program goes multi-threaded.
+static thread_cache single_cache;
+
+// Statistics of threads that have exited, and of allocations made
+// when no cache could be had.
+static unsigned long retired_allocated;
+static unsigned long retired_cache_hits;
 
 
 #ifdef __GTHREADS
 #ifdef __GTHREAD_MUTEX_INIT
 static __gthread_mutex_t emergency_mutex =__GTHREAD_MUTEX_INIT;
+static __gthread_mutex_t cache_list_mutex =__GTHREAD_MUTEX_INIT;
 #else 
 static __gthread_mutex_t emergency_mutex;
+static __gthread_mutex_t cache_list_mutex;
 #endif
 
-#ifdef __GTHREAD_MUTEX_INIT_FUNCTION
+static thread_cache *cache_list;
+static __gthread_key_t cache_key;
+static bool cache_key_valid;
+
+static void
+free_cache_blocks (thread_cache *c)
+{
+  for (unsigned int i = 0; i < CACHE_CLASSES; ++i)
+    while (c->free_list[i])
+      {
+	void *block = c->free_list[i];
+	c->free_list[i] = *(void **) block;
+	free (block);
+      }
+}
+
+static void
+cache_key_dtor (void *p)
+{
+  thread_cache *c = (thread_cache *) p;
+
+  __gthread_mutex_lock (&cache_list_mutex);
+  retired_allocated += c->allocated;
+  retired_cache_hits += c->cache_hits;
+  *c->prev = c->next;
+  if (c->next)
+    c->next->prev = c->prev;
+  __gthread_mutex_unlock (&cache_list_mutex);
+
+  free_cache_blocks (c);
+  free (c);
+}
+
 static void
-emergency_mutex_init ()
+eh_alloc_init ()
 {
+#ifdef __GTHREAD_MUTEX_INIT_FUNCTION
   __GTHREAD_MUTEX_INIT_FUNCTION (&emergency_mutex);
+  __GTHREAD_MUTEX_INIT_FUNCTION (&cache_list_mutex);
+#endif
+  cache_key_valid = __gthread_key_create (&cache_key, cache_key_dtor) == 0;
+}
+
+static void
+eh_alloc_init_once ()
+{
+  static __gthread_once_t once = __GTHREAD_ONCE_INIT;
+  __gthread_once (&once, eh_alloc_init);
 }
 #endif
+
+// Return the calling thread's cache, or null if it has none and
+// cannot get one.
+static thread_cache *
+get_thread_cache ()
+{
+#ifdef __GTHREADS
+  if (__gthread_active_p ())
+    {
+      eh_alloc_init_once ();
+      if (!cache_key_valid)
+	return 0;
+
+      thread_cache *c = (thread_cache *) __gthread_getspecific (cache_key);
+      if (c)
+	return c;
+
+      c = (thread_cache *) malloc (sizeof (thread_cache));
+      if (!c)
+	return 0;
+      memset (c, 0, sizeof (thread_cache));
+      if (__gthread_setspecific (cache_key, c) != 0)
+	{
+	  free (c);
+	  return 0;
+	}
+
+      __gthread_mutex_lock (&cache_list_mutex);
+      c->next = cache_list;
+      c->prev = &cache_list;
+      if (cache_list)
+	cache_list->prev = &c->next;
+      cache_list = c;
+      __gthread_mutex_unlock (&cache_list_mutex);
+      return c;
+    }
 #endif
+  return &single_cache;
+}
 
+static unsigned int
+size_class (std::size_t size)
+{
+  unsigned int cls = 0;
+  std::size_t class_size = CACHE_MIN_SIZE;
+  while (cls < CACHE_CLASSES && size > class_size)
+    {
+      ++cls;
+      class_size <<= 1;
+    }
+  return cls;
+}
 
-extern "C" void *
-__cxxabiv1::__cxa_allocate_exception(std::size_t thrown_size) throw()
+// The pool is claimed under its mutex rather than with atomic
+// operations, which libsupc++ does not have: it is only used once
+// malloc has failed.
+static void *
+emergency_allocate (std::size_t size)
 {
-  void *ret;
+  void *ret = 0;
 
-  thrown_size += sizeof (__cxa_exception);
-  ret = malloc (thrown_size);
+  if (size > emergency_obj_size)
+    return 0;
+
+#ifdef __GTHREADS
+  eh_alloc_init_once ();
+  __gthread_mutex_lock (&emergency_mutex);
+#endif
 
-  if (! ret)
+  for (unsigned int which = 0; which < emergency_obj_count; ++which)
     {
+      bitmask_type bit = (bitmask_type)1 << (which % BITMASK_BITS);
+      bitmask_type *word = &emergency_used[which / BITMASK_BITS];
+      if (!(*word & bit))
+	{
+	  *word |= bit;
+	  ret = emergency_arena + which * emergency_obj_size;
+	  ++emergency_allocated;
+	  if (++emergency_in_use > emergency_peak)
+	    emergency_peak = emergency_in_use;
+	  break;
+	}
+    }
+
 #ifdef __GTHREADS
-#ifdef __GTHREAD_MUTEX_INIT_FUNCTION
-      static __gthread_once_t once = __GTHREAD_ONCE_INIT;
-      __gthread_once (&once, emergency_mutex_init);
+  __gthread_mutex_unlock (&emergency_mutex);
 #endif
-      __gthread_mutex_lock (&emergency_mutex);
+  return ret;
+}
+
+static void
+emergency_free (char *ptr)
+{
+  unsigned int which
+    = (unsigned)((ptr - emergency_arena) / emergency_obj_size);
+
+#ifdef __GTHREADS
+  __gthread_mutex_lock (&emergency_mutex);
 #endif
+  emergency_used[which / BITMASK_BITS]
+    &= ~((bitmask_type)1 << (which % BITMASK_BITS));
+  --emergency_in_use;
+#ifdef __GTHREADS
+  __gthread_mutex_unlock (&emergency_mutex);
+#endif
+}
 
-      bitmask_type used = emergency_used;
-      unsigned int which = 0;
 
-      if (thrown_size > EMERGENCY_OBJ_SIZE)
-	goto failed;
-      while (used & 1)
-	{
-	  used >>= 1;
-	  if (++which >= EMERGENCY_OBJ_COUNT)
-	    goto failed;
-	}
+#if _GLIBCXX_HOSTED
+// Read the value of the environment variable NAME into *VALUE.  Leave
+// *VALUE alone if NAME is unset or not a positive number.
+static void
+emergency_pool_param (const char *name, unsigned long *value)
+{
+  const char *str = getenv (name);
+  if (!str)
+    return;
+
+  char *end;
+  unsigned long n = strtoul (str, &end, 10);
+  if (end != str && *end == '\0' && n > 0)
+    *value = n;
+}
+
+// Resize the emergency pool at startup from GLIBCXX_EH_POOL_OBJ_SIZE
+// and GLIBCXX_EH_POOL_OBJ_COUNT, the same way GLIBCXX_FORCE_NEW is read
+// by the allocators.  The arena and its bitmap are allocated together;
+// if that fails, or the pool was already used by a constructor run
+// earlier, the static buffer is kept.
+struct emergency_pool_init
+{
+  emergency_pool_init()
+  {
+    unsigned long size = EMERGENCY_OBJ_SIZE;
+    unsigned long count = EMERGENCY_OBJ_COUNT;
+    emergency_pool_param ("GLIBCXX_EH_POOL_OBJ_SIZE", &size);
+    emergency_pool_param ("GLIBCXX_EH_POOL_OBJ_COUNT", &count);
+    if (size == EMERGENCY_OBJ_SIZE && count == EMERGENCY_OBJ_COUNT)
+      return;
 
-      emergency_used |= (bitmask_type)1 << which;
-      ret = &emergency_buffer[which][0];
+    // Keep every object as aligned as those of the static buffer.
+    const std::size_t align = __alignof__ (one_buffer);
+    size = (size + align - 1) & ~(align - 1);
+    if (count > UINT_MAX - BITMASK_BITS || size > std::size_t(-1) / count)
+      return;
 
-    failed:;
+    std::size_t words = (count + BITMASK_BITS - 1) / BITMASK_BITS;
+    std::size_t bytes = size * count;
+    if (bytes > std::size_t(-1) - words * sizeof (bitmask_type))
+      return;
+    char *arena
+      = (char *) malloc (bytes + words * sizeof (bitmask_type));
+    if (!arena)
+      return;
+    memset (arena + bytes, 0, words * sizeof (bitmask_type));
+
+#ifdef __GTHREADS
+    eh_alloc_init_once ();
+    __gthread_mutex_lock (&emergency_mutex);
+#endif
+    bool unused = emergency_allocated == 0;
+    if (unused)
+      {
+	emergency_arena = arena;
+	emergency_used = (bitmask_type *) (arena + bytes);
+	emergency_obj_size = size;
+	emergency_obj_count = count;
+      }
 #ifdef __GTHREADS
-      __gthread_mutex_unlock (&emergency_mutex);
+    __gthread_mutex_unlock (&emergency_mutex);
+#endif
+    if (!unused)
+      free (arena);
+  }
+};
+
+static emergency_pool_init emergency_pool_init_instance;
 #endif
+
+
+extern "C" void *
+__cxxabiv1::__cxa_allocate_exception(std::size_t thrown_size) throw()
+{
+  void *ret = 0;
+  thread_cache *c = get_thread_cache ();
+
+  thrown_size += sizeof (__cxa_exception);
+
+  std::size_t block_size = thrown_size + sizeof (block_header);
+  unsigned int cls = size_class (block_size);
+  if (cls < CACHE_CLASSES)
+    block_size = (std::size_t) CACHE_MIN_SIZE << cls;
+
+  block_header *block = 0;
+  if (c && cls < CACHE_CLASSES && c->free_list[cls])
+    {
+      block = (block_header *) c->free_list[cls];
+      c->free_list[cls] = *(void **) block;
+      --c->count[cls];
+      ++c->cache_hits;
+    }
+  else
+    block = (block_header *) malloc (block_size);
+
+  if (block)
+    {
+      block->size_class = cls;
+      ret = block + 1;
+    }
+  else
+    {
+      ret = emergency_allocate (thrown_size);
       if (!ret)
 	std::terminate ();
     }
 
+  if (c)
+    ++c->allocated;
+#ifdef __GTHREADS
+  else
+    {
+      __gthread_mutex_lock (&cache_list_mutex);
+      ++retired_allocated;
+      __gthread_mutex_unlock (&cache_list_mutex);
+    }
+#endif
+
   memset (ret, 0, sizeof (__cxa_exception));
 
   return (void *)((char *)ret + sizeof (__cxa_exception));
@@ -164,21 +457,59 @@ __cxxabiv1::__cxa_allocate_exception(std::size_t thrown_size) throw()
 extern "C" void
 __cxxabiv1::__cxa_free_exception(void *vptr) throw()
 {
-  char *ptr = (char *) vptr;
-  if (ptr >= &emergency_buffer[0][0]
-      && ptr < &emergency_buffer[0][0] + sizeof (emergency_buffer))
+  char *ptr = (char *) vptr - sizeof (__cxa_exception);
+  if (ptr >= emergency_arena
+      && ptr < emergency_arena + emergency_obj_count * emergency_obj_size)
     {
-      unsigned int which
-	= (unsigned)(ptr - &emergency_buffer[0][0]) / EMERGENCY_OBJ_SIZE;
+      emergency_free (ptr);
+      return;
+    }
 
+  block_header *block = (block_header *) ptr - 1;
+  unsigned int cls = block->size_class;
+  if (cls < CACHE_CLASSES)
+    {
+      thread_cache *c = get_thread_cache ();
+      if (c && c->count[cls] < CACHE_DEPTH)
+	{
+	  *(void **) block = c->free_list[cls];
+	  c->free_list[cls] = block;
+	  ++c->count[cls];
+	  return;
+	}
+    }
+  free (block);
+}
+
+
+void
+__gnu_cxx::__get_eh_alloc_stats(__gnu_cxx::__eh_alloc_stats *stats) throw()
+{
 #ifdef __GTHREADS
-      __gthread_mutex_lock (&emergency_mutex);
-      emergency_used &= ~((bitmask_type)1 << which);
-      __gthread_mutex_unlock (&emergency_mutex);
-#else
-      emergency_used &= ~((bitmask_type)1 << which);
+  eh_alloc_init_once ();
+  __gthread_mutex_lock (&cache_list_mutex);
 #endif
+
+  stats->__allocated = retired_allocated + single_cache.allocated;
+  stats->__cache_hits = retired_cache_hits + single_cache.cache_hits;
+#ifdef __GTHREADS
+  // Other threads may be updating their counts as we read them, which
+  // is good enough for diagnostics.
+  for (thread_cache *c = cache_list; c; c = c->next)
+    {
+      stats->__allocated += c->allocated;
+      stats->__cache_hits += c->cache_hits;
     }
-  else
-    free (ptr - sizeof (__cxa_exception));
+  __gthread_mutex_unlock (&cache_list_mutex);
+
+  __gthread_mutex_lock (&emergency_mutex);
+#endif
+  stats->__emergency_allocated = emergency_allocated;
+  stats->__emergency_in_use = emergency_in_use;
+  stats->__emergency_peak = emergency_peak;
+#ifdef __GTHREADS
+  __gthread_mutex_unlock (&emergency_mutex);
+#endif
+  stats->__emergency_obj_count = emergency_obj_count;
+  stats->__emergency_obj_size = emergency_obj_size;
 }
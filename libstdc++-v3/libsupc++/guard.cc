@@ -1,4 +1,4 @@
-// Copyright (C) 2002 Free Software Foundation, Inc.
+// Copyright (C) 2002, 2005 Free Software Foundation, Inc.
 //  
 // This file is part of GCC.
 //
@@ -30,12 +30,19 @@
 
 #include <cxxabi.h>
 #include <exception>
+#include <cstdlib>
 #include <bits/c++config.h>
 #include <bits/gthr.h>
+#include <bits/atomic_word.h>
 
 // The IA64/generic ABI uses the first byte of the guard variable.
 // The ARM EABI uses the least significant bit.
 
+// The rest of the guard belongs to the library.  The second byte is
+// set while an initialization is in progress, and, where the threads
+// package provides condition variables, the third byte records that
+// another thread is waiting for that initialization to finish.
+
 // Thread-safe static local initialization support.
 #ifdef __GTHREADS
 namespace
@@ -44,9 +51,18 @@ namespace
   // This is a static class--the need for a static initialization function
   // to pass to __gthread_once precludes creating multiple instances, though
   // I suppose you could achieve the same effect with a template.
+  //
+  // With condition variables the mutex only protects the guard state
+  // and is never held while an initializer runs; a thread that finds
+  // another one initializing the same object sleeps until that guard
+  // changes, and initializations of different objects proceed in
+  // parallel.
   class static_mutex
   {
     static __gthread_recursive_mutex_t mutex;
+#ifdef __GTHREAD_HAS_COND
+    static __gthread_cond_t cond;
+#endif
 
 #ifdef __GTHREAD_RECURSIVE_MUTEX_INIT_FUNCTION
     static void init();
@@ -55,6 +71,10 @@ namespace
   public:
     static void lock();
     static void unlock();
+#ifdef __GTHREAD_HAS_COND
+    static void wait();
+    static void broadcast();
+#endif
   };
 
   __gthread_recursive_mutex_t static_mutex::mutex
@@ -63,6 +83,10 @@ namespace
 #endif
   ;
 
+#ifdef __GTHREAD_HAS_COND
+  __gthread_cond_t static_mutex::cond = __GTHREAD_COND_INIT;
+#endif
+
 #ifdef __GTHREAD_RECURSIVE_MUTEX_INIT_FUNCTION
   void static_mutex::init()
   {
@@ -83,6 +107,101 @@ namespace
   {
     __gthread_recursive_mutex_unlock (&mutex);
   }
+
+#ifdef __GTHREAD_HAS_COND
+  // Must be called with the mutex held exactly once.
+  void static_mutex::wait ()
+  {
+    __gthread_cond_wait_recursive (&cond, &mutex);
+  }
+
+  void static_mutex::broadcast ()
+  {
+    __gthread_cond_broadcast (&cond);
+  }
+
+  // Since an initializer runs without the mutex held, a thread that
+  // re-enters the declaration it is initializing would wait for itself.
+  // To diagnose that, each thread keeps a list of the guards it is
+  // currently initializing.  The list is only touched on the slow path,
+  // once per object.
+  struct init_record
+  {
+    __cxxabiv1::__guard *guard;
+    init_record *next;
+  };
+
+  __gthread_key_t init_key;
+  bool init_key_valid;
+
+  void init_key_dtor (void *p)
+  {
+    init_record *r = static_cast<init_record *> (p);
+    while (r)
+      {
+	init_record *next = r->next;
+	std::free (r);
+	r = next;
+      }
+  }
+
+  void init_key_init ()
+  {
+    init_key_valid = __gthread_key_create (&init_key, init_key_dtor) == 0;
+  }
+
+  bool init_key_ready ()
+  {
+    static __gthread_once_t once = __GTHREAD_ONCE_INIT;
+    __gthread_once (&once, init_key_init);
+    return init_key_valid;
+  }
+
+  // Note that the calling thread has started initializing G.  If memory
+  // is short the record is simply dropped; all that is lost is the
+  // diagnostic.
+  void record_init (__cxxabiv1::__guard *g)
+  {
+    if (!init_key_ready ())
+      return;
+    init_record *r
+      = static_cast<init_record *> (std::malloc (sizeof (init_record)));
+    if (!r)
+      return;
+    r->guard = g;
+    r->next = static_cast<init_record *> (__gthread_getspecific (init_key));
+    __gthread_setspecific (init_key, r);
+  }
+
+  void forget_init (__cxxabiv1::__guard *g)
+  {
+    if (!init_key_ready ())
+      return;
+    init_record *head
+      = static_cast<init_record *> (__gthread_getspecific (init_key));
+    for (init_record **rp = &head; *rp; rp = &(*rp)->next)
+      if ((*rp)->guard == g)
+	{
+	  init_record *r = *rp;
+	  *rp = r->next;
+	  std::free (r);
+	  __gthread_setspecific (init_key, head);
+	  return;
+	}
+  }
+
+  bool initializing_p (__cxxabiv1::__guard *g)
+  {
+    if (!init_key_ready ())
+      return false;
+    for (init_record *r
+	   = static_cast<init_record *> (__gthread_getspecific (init_key));
+	 r; r = r->next)
+      if (r->guard == g)
+	return true;
+    return false;
+  }
+#endif
 }
 #endif
 
@@ -107,19 +226,23 @@ namespace __gnu_cxx
 
 namespace __cxxabiv1 
 {
+  static void
+  recursive_init_error ()
+  {
+#ifdef __EXCEPTIONS
+    throw __gnu_cxx::recursive_init();
+#else
+    abort ();
+#endif
+  }
+
   static int
   acquire_1 (__guard *g)
   {
     if (_GLIBCXX_GUARD_ACQUIRE (g))
       {
 	if (((char *)g)[1]++)
-	  {
-#ifdef __EXCEPTIONS
-	    throw __gnu_cxx::recursive_init();
-#else
-	    abort ();
-#endif
-	  }
+	  recursive_init_error ();
 	return 1;
       }
     return 0;
@@ -128,9 +251,46 @@ namespace __cxxabiv1
   extern "C"
   int __cxa_guard_acquire (__guard *g) 
   {
+#if defined (_GLIBCXX_READ_MEM_BARRIER) && defined (_GLIBCXX_WRITE_MEM_BARRIER)
+    // Once the guard is set nothing ever changes it again, so the common
+    // case needs no lock; the barrier makes the stores done by the
+    // initializing thread visible to this one.
+    if (!_GLIBCXX_GUARD_ACQUIRE (g))
+      {
+	_GLIBCXX_READ_MEM_BARRIER;
+	return 0;
+      }
+#endif
+
 #ifdef __GTHREADS
     if (__gthread_active_p ())
       {
+#ifdef __GTHREAD_HAS_COND
+	static_mutex::lock ();
+	while (_GLIBCXX_GUARD_ACQUIRE (g))
+	  {
+	    if (!((char *)g)[1])
+	      {
+		((char *)g)[1] = 1;
+		record_init (g);
+		static_mutex::unlock ();
+		return 1;
+	      }
+
+	    if (initializing_p (g))
+	      {
+		static_mutex::unlock ();
+		recursive_init_error ();
+	      }
+
+	    // Someone else is initializing this object; wait for them to
+	    // release or abort.
+	    ((char *)g)[2] = 1;
+	    static_mutex::wait ();
+	  }
+	static_mutex::unlock ();
+	return 0;
+#else
 	// Simple wrapper for exception safety.
 	struct mutex_wrapper
 	{
@@ -153,6 +313,7 @@ namespace __cxxabiv1
 	  }
 
 	return 0;
+#endif
       }
 #endif
 
@@ -162,6 +323,23 @@ namespace __cxxabiv1
   extern "C"
   void __cxa_guard_abort (__guard *g)
   {
+#if defined (__GTHREADS) && defined (__GTHREAD_HAS_COND)
+    if (__gthread_active_p ())
+      {
+	static_mutex::lock ();
+	forget_init (g);
+	((char *)g)[1] = 0;
+	// One of the waiters gets to try the initialization again.
+	if (((char *)g)[2])
+	  {
+	    ((char *)g)[2] = 0;
+	    static_mutex::broadcast ();
+	  }
+	static_mutex::unlock ();
+	return;
+      }
+#endif
+
     ((char *)g)[1]--;
 #ifdef __GTHREADS
     if (__gthread_active_p ())
@@ -172,7 +350,32 @@ namespace __cxxabiv1
   extern "C"
   void __cxa_guard_release (__guard *g)
   {
+#if defined (__GTHREADS) && defined (__GTHREAD_HAS_COND)
+    if (__gthread_active_p ())
+      {
+	static_mutex::lock ();
+	forget_init (g);
+	((char *)g)[1] = 0;
+#ifdef _GLIBCXX_WRITE_MEM_BARRIER
+	// Order the initializer's stores before the guard for the benefit
+	// of readers on the lock-free path.
+	_GLIBCXX_WRITE_MEM_BARRIER;
+#endif
+	_GLIBCXX_GUARD_RELEASE (g);
+	if (((char *)g)[2])
+	  {
+	    ((char *)g)[2] = 0;
+	    static_mutex::broadcast ();
+	  }
+	static_mutex::unlock ();
+	return;
+      }
+#endif
+
     ((char *)g)[1]--;
+#ifdef _GLIBCXX_WRITE_MEM_BARRIER
+    _GLIBCXX_WRITE_MEM_BARRIER;
+#endif
     _GLIBCXX_GUARD_RELEASE (g);
 #ifdef __GTHREADS
     if (__gthread_active_p ())
@@ -1,6 +1,6 @@
 // Methods for type_info for -*- C++ -*- Run Time Type Identification.
-// Copyright (C) 1994, 1996, 1998, 1999, 2000, 2001, 2002, 2003, 2004
-// Free Software Foundation
+// Copyright (C) 1994, 1996, 1998, 1999, 2000, 2001, 2002, 2003, 2004,
+// 2005 Free Software Foundation
 //
 // This file is part of GCC.
 //
@@ -29,6 +29,8 @@
 // the GNU General Public License.
 
 #include <bits/c++config.h>
+#include <bits/atomic_word.h>
+#include <bits/gthr.h>
 #include <cstddef>
 #include "tinfo.h"
 #include "new"			// for placement new
@@ -172,6 +174,142 @@ inline bool contained_nonvirtual_p (__class_type_info::__sub_kind access_path)
 static const __class_type_info *const nonvirtual_base_type =
     static_cast <const __class_type_info *> (0) + 1;
 
+#if defined (_GLIBCXX_READ_MEM_BARRIER) && defined (_GLIBCXX_WRITE_MEM_BARRIER)
+// Results of __dynamic_cast are remembered in a small hash table.  The
+// vtable pointer of the source object determines both the most derived
+// type and where the source sits within it, so together with the
+// static types involved it determines the outcome of the cast.
+//
+// Each slot points to an immutable record.  A reader loads the pointer
+// once and checks the key, so it never needs a lock; a writer fills in
+// a fresh record and publishes it behind a write barrier.  Records are
+// never reused, since a reader may still be looking at a replaced one,
+// so they come from a fixed pool, and once it is used up no more
+// results are remembered.
+//
+// Once a shared object is unloaded, another may be loaded at the same
+// address, and its vtables and type_infos may reuse the addresses kept
+// in the records.  So the addresses of the names of the types involved
+// are part of the key too: a hit needs all of the vtable, the three
+// type_infos and their names at the recorded addresses.  Reloading the
+// same object gives the same results; a different object would have to
+// place all six at exactly those addresses.  The addresses kept are
+// only compared, never followed.
+struct dyncast_cache_entry
+{
+  const void *vtable;
+  const __class_type_info *whole_type;
+  const __class_type_info *src_type;
+  const __class_type_info *dst_type;
+  const char *whole_name;
+  const char *src_name;
+  const char *dst_name;
+  ptrdiff_t src2dst;
+  ptrdiff_t whole_object;
+
+  // Whether the cast succeeds, and if so, dst_ptr - src_ptr.
+  bool success;
+  ptrdiff_t src_to_dst;
+};
+
+const std::size_t dyncast_cache_size = 1024;
+const std::size_t dyncast_cache_pool_size = 2 * dyncast_cache_size;
+
+dyncast_cache_entry *volatile dyncast_cache[dyncast_cache_size];
+
+// The records, handed out in order under dyncast_cache_mutex.
+dyncast_cache_entry dyncast_cache_pool[dyncast_cache_pool_size];
+std::size_t dyncast_cache_pool_used;
+
+#ifdef __GTHREADS
+#ifdef __GTHREAD_MUTEX_INIT
+__gthread_mutex_t dyncast_cache_mutex = __GTHREAD_MUTEX_INIT;
+#else
+__gthread_mutex_t dyncast_cache_mutex;
+
+void
+dyncast_cache_init ()
+{
+  __GTHREAD_MUTEX_INIT_FUNCTION (&dyncast_cache_mutex);
+}
+#endif
+#endif
+
+inline std::size_t
+dyncast_cache_hash (const void *vtable, const __class_type_info *dst_type)
+{
+  std::size_t h = reinterpret_cast <std::size_t> (vtable) >> 3;
+  h ^= reinterpret_cast <std::size_t> (dst_type) >> 4;
+  h ^= h >> 10;
+  return h & (dyncast_cache_size - 1);
+}
+
+// Whether the record E holds the cast of an object of vtable VTABLE,
+// with prefix PREFIX, from SRC_TYPE to DST_TYPE.  Only addresses are
+// compared, the ones that differ most often first.
+inline bool
+dyncast_cache_match (const dyncast_cache_entry *e,
+                     const void *vtable, const vtable_prefix *prefix,
+                     const __class_type_info *src_type,
+                     const __class_type_info *dst_type,
+                     ptrdiff_t src2dst)
+{
+  return (e->vtable == vtable && e->dst_type == dst_type
+          && e->src_type == src_type && e->src2dst == src2dst
+          && e->whole_type == prefix->whole_type
+          && e->whole_object == prefix->whole_object
+          && e->whole_name == prefix->whole_type->name ()
+          && e->src_name == src_type->name ()
+          && e->dst_name == dst_type->name ());
+}
+
+void
+dyncast_cache_insert (const void *vtable, const vtable_prefix *prefix,
+                      const __class_type_info *src_type,
+                      const __class_type_info *dst_type,
+                      ptrdiff_t src2dst,
+                      const void *src_ptr, const void *dst_ptr)
+{
+  // Unlocked peek, so that a full pool costs nothing.
+  if (dyncast_cache_pool_used >= dyncast_cache_pool_size)
+    return;
+
+#ifdef __GTHREADS
+#ifndef __GTHREAD_MUTEX_INIT
+  static __gthread_once_t once = __GTHREAD_ONCE_INIT;
+  __gthread_once (&once, dyncast_cache_init);
+#endif
+  __gthread_mutex_lock (&dyncast_cache_mutex);
+#endif
+  dyncast_cache_entry *e = 0;
+  if (dyncast_cache_pool_used < dyncast_cache_pool_size)
+    e = &dyncast_cache_pool[dyncast_cache_pool_used++];
+#ifdef __GTHREADS
+  __gthread_mutex_unlock (&dyncast_cache_mutex);
+#endif
+  if (!e)
+    return;
+
+  e->vtable = vtable;
+  e->whole_type = prefix->whole_type;
+  e->src_type = src_type;
+  e->dst_type = dst_type;
+  e->whole_name = prefix->whole_type->name ();
+  e->src_name = src_type->name ();
+  e->dst_name = dst_type->name ();
+  e->src2dst = src2dst;
+  e->whole_object = prefix->whole_object;
+  e->success = dst_ptr != NULL;
+  e->src_to_dst = (e->success
+                   ? (reinterpret_cast <const char *> (dst_ptr)
+                      - reinterpret_cast <const char *> (src_ptr))
+                   : 0);
+
+  _GLIBCXX_WRITE_MEM_BARRIER;
+  dyncast_cache[dyncast_cache_hash (vtable, dst_type)] = e;
+}
+#endif
+
 } // namespace
 
 namespace __cxxabiv1
@@ -698,14 +836,14 @@ __do_upcast (const __class_type_info *dst, const void *obj_ptr,
   return result.part2dst != __unknown;
 }
 
-// this is the external interface to the dynamic cast machinery
-extern "C" void *
-__dynamic_cast (const void *src_ptr,    // object started from
-                const __class_type_info *src_type, // type of the starting object
-                const __class_type_info *dst_type, // desired target type
-                ptrdiff_t src2dst) // how src and dst are related
+// Perform the cast the long way, by walking the hierarchy of the most
+// derived type.
+static void *
+do_dynamic_cast (const void *src_ptr, const void *vtable,
+                 const __class_type_info *src_type,
+                 const __class_type_info *dst_type,
+                 ptrdiff_t src2dst)
 {
-  const void *vtable = *static_cast <const void *const *> (src_ptr);
   const vtable_prefix *prefix =
       adjust_pointer <vtable_prefix> (vtable, 
 				      -offsetof (vtable_prefix, origin));
@@ -740,4 +878,39 @@ __dynamic_cast (const void *src_ptr,    // object started from
   return NULL;
 }
 
+// this is the external interface to the dynamic cast machinery
+extern "C" void *
+__dynamic_cast (const void *src_ptr,    // object started from
+                const __class_type_info *src_type, // type of the starting object
+                const __class_type_info *dst_type, // desired target type
+                ptrdiff_t src2dst) // how src and dst are related
+{
+  const void *vtable = *static_cast <const void *const *> (src_ptr);
+
+#if defined (_GLIBCXX_READ_MEM_BARRIER) && defined (_GLIBCXX_WRITE_MEM_BARRIER)
+  const vtable_prefix *prefix =
+      adjust_pointer <vtable_prefix> (vtable,
+                                      -offsetof (vtable_prefix, origin));
+  const dyncast_cache_entry *e
+    = dyncast_cache[dyncast_cache_hash (vtable, dst_type)];
+  // Pairs with the write barrier in dyncast_cache_insert, so that the
+  // fields are not read before the record was published.
+  _GLIBCXX_READ_MEM_BARRIER;
+  if (e && dyncast_cache_match (e, vtable, prefix, src_type, dst_type,
+                                src2dst))
+    return (e->success
+            ? const_cast <void *> (adjust_pointer <void> (src_ptr,
+                                                          e->src_to_dst))
+            : NULL);
+#endif
+
+  void *dst_ptr = do_dynamic_cast (src_ptr, vtable, src_type, dst_type,
+                                   src2dst);
+#if defined (_GLIBCXX_READ_MEM_BARRIER) && defined (_GLIBCXX_WRITE_MEM_BARRIER)
+  dyncast_cache_insert (vtable, prefix, src_type, dst_type, src2dst,
+                        src_ptr, dst_ptr);
+#endif
+  return dst_ptr;
+}
+
 } // namespace __cxxabiv1
@@ -1,6 +1,6 @@
 // Debugging mode support code -*- C++ -*-
 
-// Copyright (C) 2003, 2004
+// Copyright (C) 2003, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -37,9 +37,91 @@
 #include <cstring>
 #include <cstdio>
 #include <cctype>
+#include <bits/concurrence.h>
 
 using namespace std;
 
+namespace __gnu_internal
+{
+  // The lists of iterators of the safe sequences are protected by
+  // these mutexes, the one of a sequence being chosen from its
+  // address: threads working on distinct sequences rarely contend,
+  // while those sharing a sequence, e.g. iterating over the same
+  // const container, are serialized.  Static initialization, when
+  // available, makes them usable from the constructors of other
+  // translation units.
+  const size_t debug_mutex_count = 16;
+
+#ifdef __GTHREAD_MUTEX_INIT
+# define _GLIBCXX_DEBUG_MUTEX_INIT4 \
+  __GTHREAD_MUTEX_INIT, __GTHREAD_MUTEX_INIT, \
+  __GTHREAD_MUTEX_INIT, __GTHREAD_MUTEX_INIT
+  __gnu_cxx::mutex_type debug_mutex[debug_mutex_count] =
+  {
+    _GLIBCXX_DEBUG_MUTEX_INIT4, _GLIBCXX_DEBUG_MUTEX_INIT4,
+    _GLIBCXX_DEBUG_MUTEX_INIT4, _GLIBCXX_DEBUG_MUTEX_INIT4
+  };
+# undef _GLIBCXX_DEBUG_MUTEX_INIT4
+#else
+  __gnu_cxx::mutex_type debug_mutex[debug_mutex_count];
+#endif
+
+  inline __gnu_cxx::mutex_type&
+  get_debug_mutex(const __gnu_debug::_Safe_sequence_base* __seq)
+  {
+    // Sequences are at least a few words apart.
+    const size_t __addr = reinterpret_cast<size_t>(__seq);
+    return debug_mutex[((__addr >> 4) ^ (__addr >> 10)) % debug_mutex_count];
+  }
+
+  // Links __it at the head of the list of __seq; the caller holds the
+  // mutex of __seq.
+  inline void
+  attach_single(__gnu_debug::_Safe_iterator_base* __it,
+		__gnu_debug::_Safe_sequence_base* __seq, bool __constant)
+  {
+    __it->_M_sequence = __seq;
+    __it->_M_version = __seq->_M_version;
+    __it->_M_prior = 0;
+    if (__constant)
+      {
+	__it->_M_next = __seq->_M_const_iterators;
+	if (__it->_M_next)
+	  __it->_M_next->_M_prior = __it;
+	__seq->_M_const_iterators = __it;
+      }
+    else
+      {
+	__it->_M_next = __seq->_M_iterators;
+	if (__it->_M_next)
+	  __it->_M_next->_M_prior = __it;
+	__seq->_M_iterators = __it;
+      }
+  }
+
+  // Unlinks __it from the list of its sequence, leaving it singular;
+  // the caller holds the mutex of the sequence.
+  inline void
+  detach_single(__gnu_debug::_Safe_iterator_base* __it)
+  {
+    __gnu_debug::_Safe_sequence_base* __seq = __it->_M_sequence;
+    if (__it->_M_prior)
+      __it->_M_prior->_M_next = __it->_M_next;
+    if (__it->_M_next)
+      __it->_M_next->_M_prior = __it->_M_prior;
+
+    if (__seq->_M_const_iterators == __it)
+      __seq->_M_const_iterators = __it->_M_next;
+    if (__seq->_M_iterators == __it)
+      __seq->_M_iterators = __it->_M_next;
+
+    __it->_M_sequence = 0;
+    __it->_M_version = 0;
+    __it->_M_prior = 0;
+    __it->_M_next = 0;
+  }
+} // namespace __gnu_internal
+
 namespace __gnu_debug
 {
   const char* _S_debug_messages[] = 
@@ -100,25 +182,30 @@ namespace __gnu_debug
     "attempt to output via an ostream_iterator with no associated stream",
     "attempt to dereference an end-of-stream istreambuf_iterator"
     " (this is a GNU extension)",
-    "attempt to increment an end-of-stream istreambuf_iterator"
+    "attempt to increment an end-of-stream istreambuf_iterator",
+    "attempt to insert into container with an iterator outside of"
+    " its current range, possibly invalidated",
+    "attempt to erase from container with iterators outside of"
+    " its current range, possibly invalidated"
   };
 
   void 
   _Safe_sequence_base::
   _M_detach_all()
   {
+    __gnu_cxx::lock sentry(__gnu_internal::get_debug_mutex(this));
     for (_Safe_iterator_base* __iter = _M_iterators; __iter; )
       {
 	_Safe_iterator_base* __old = __iter;
 	__iter = __iter->_M_next;
-	__old->_M_attach(0, false);
+	__gnu_internal::detach_single(__old);
       }
     
     for (_Safe_iterator_base* __iter2 = _M_const_iterators; __iter2; )
       {
 	_Safe_iterator_base* __old = __iter2;
 	__iter2 = __iter2->_M_next;
-	__old->_M_attach(0, true);
+	__gnu_internal::detach_single(__old);
       }
   }
 
@@ -126,12 +213,13 @@ namespace __gnu_debug
   _Safe_sequence_base::
   _M_detach_singular()
   {
+    __gnu_cxx::lock sentry(__gnu_internal::get_debug_mutex(this));
     for (_Safe_iterator_base* __iter = _M_iterators; __iter; )
       {
 	_Safe_iterator_base* __old = __iter;
 	__iter = __iter->_M_next;
 	if (__old->_M_singular())
-	  __old->_M_attach(0, false);
+	  __gnu_internal::detach_single(__old);
       }
 
     for (_Safe_iterator_base* __iter2 = _M_const_iterators; __iter2; )
@@ -139,7 +227,7 @@ namespace __gnu_debug
 	_Safe_iterator_base* __old = __iter2;
 	__iter2 = __iter2->_M_next;
 	if (__old->_M_singular())
-	  __old->_M_attach(0, true);
+	  __gnu_internal::detach_single(__old);
       }
   }
   
@@ -147,6 +235,7 @@ namespace __gnu_debug
   _Safe_sequence_base::
   _M_revalidate_singular()
   {
+    __gnu_cxx::lock sentry(__gnu_internal::get_debug_mutex(this));
     _Safe_iterator_base* __iter;
     for (__iter = _M_iterators; __iter; __iter = __iter->_M_next)
       {
@@ -165,6 +254,15 @@ namespace __gnu_debug
   _Safe_sequence_base::
   _M_swap(_Safe_sequence_base& __x)
   {
+    // Take both mutexes, always in the same order.
+    __gnu_cxx::mutex_type* __m1 = &__gnu_internal::get_debug_mutex(this);
+    __gnu_cxx::mutex_type* __m2 = &__gnu_internal::get_debug_mutex(&__x);
+    if (__m2 < __m1)
+      std::swap(__m1, __m2);
+    __gnu_cxx::lock sentry1(*__m1);
+    if (__m1 != __m2)
+      __glibcxx_mutex_lock(*__m2);
+
     swap(_M_iterators, __x._M_iterators);
     swap(_M_const_iterators, __x._M_const_iterators);
     swap(_M_version, __x._M_version);
@@ -177,34 +275,30 @@ namespace __gnu_debug
       __iter->_M_sequence = this;
     for (__iter = __x._M_const_iterators; __iter; __iter = __iter->_M_next)
       __iter->_M_sequence = &__x;
+
+    if (__m1 != __m2)
+      __glibcxx_mutex_unlock(*__m2);
   }
   
   void 
   _Safe_iterator_base::
   _M_attach(_Safe_sequence_base* __seq, bool __constant)
   {
+    if (__seq && __seq == _M_sequence)
+      {
+	// Already in the right list, the constness of an iterator never
+	// changing: just catch up with the version of the sequence.
+	_M_version = __seq->_M_version;
+	return;
+      }
+
     _M_detach();
     
     // Attach to the new sequence (if there is one)
     if (__seq)
       {
-	_M_sequence = __seq;
-	_M_version = _M_sequence->_M_version;
-	_M_prior = 0;
-	if (__constant)
-	  {
-	    _M_next = _M_sequence->_M_const_iterators;
-	    if (_M_next)
-	      _M_next->_M_prior = this;
-	    _M_sequence->_M_const_iterators = this;
-	  }
-	else
-	  {
-	    _M_next = _M_sequence->_M_iterators;
-	    if (_M_next)
-	      _M_next->_M_prior = this;
-	    _M_sequence->_M_iterators = this;
-	  }
+	__gnu_cxx::lock sentry(__gnu_internal::get_debug_mutex(__seq));
+	__gnu_internal::attach_single(this, __seq, __constant);
       }
   }
 
@@ -214,22 +308,9 @@ namespace __gnu_debug
   {
     if (_M_sequence)
       {
-	// Remove us from this sequence's list
-	if (_M_prior) 
-	  _M_prior->_M_next = _M_next;
-	if (_M_next)  
-	  _M_next->_M_prior = _M_prior;
-	
-	if (_M_sequence->_M_const_iterators == this)
-	  _M_sequence->_M_const_iterators = _M_next;
-	if (_M_sequence->_M_iterators == this)
-	  _M_sequence->_M_iterators = _M_next;
+	__gnu_cxx::lock sentry(__gnu_internal::get_debug_mutex(_M_sequence));
+	__gnu_internal::detach_single(this);
       }
-
-    _M_sequence = 0;
-    _M_version = 0;
-    _M_prior = 0;
-    _M_next = 0;
   }
   
   bool
@@ -1,4 +1,4 @@
-// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004
+// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -57,7 +57,10 @@ namespace std
 
   locale::locale(const locale& __other) throw()
   : _M_impl(__other._M_impl)
-  { _M_impl->_M_add_reference(); }
+  {
+    if (_M_impl != _S_classic)
+      _M_impl->_M_add_reference();
+  }
 
   // This is used to initialize global and classic locales, and
   // assumes that the _Impl objects are constructed correctly.
@@ -66,7 +69,10 @@ namespace std
   { }
 
   locale::~locale() throw()
-  { _M_impl->_M_remove_reference(); }
+  {
+    if (_M_impl != _S_classic)
+      _M_impl->_M_remove_reference();
+  }
 
   bool
   locale::operator==(const locale& __rhs) const throw()
@@ -92,8 +98,10 @@ namespace std
   const locale&
   locale::operator=(const locale& __other) throw()
   {
-    __other._M_impl->_M_add_reference();
-    _M_impl->_M_remove_reference();
+    if (__other._M_impl != _S_classic)
+      __other._M_impl->_M_add_reference();
+    if (_M_impl != _S_classic)
+      _M_impl->_M_remove_reference();
     _M_impl = __other._M_impl;
     return *this;
   }
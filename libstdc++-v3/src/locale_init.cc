@@ -1,4 +1,4 @@
-// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004
+// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -100,9 +100,18 @@ namespace std
   locale::locale() throw() : _M_impl(0)
   { 
     _S_initialize();
-    __gnu_cxx::lock sentry(__gnu_internal::locale_mutex);
-    _S_global->_M_add_reference();
+
+    // The common case, a global locale still "C", needs neither a
+    // reference nor the lock: the classic locale can't go away
+    // while another thread is changing the global one.
     _M_impl = _S_global;
+    if (_M_impl != _S_classic)
+      {
+	__gnu_cxx::lock sentry(__gnu_internal::locale_mutex);
+	_M_impl = _S_global;
+	if (_M_impl != _S_classic)
+	  _M_impl->_M_add_reference();
+      }
   }
 
   locale
@@ -113,7 +122,8 @@ namespace std
     {
       __gnu_cxx::lock sentry(__gnu_internal::locale_mutex);
       __old = _S_global;
-      __other._M_impl->_M_add_reference();
+      if (__other._M_impl != _S_classic)
+	__other._M_impl->_M_add_reference();
       _S_global = __other._M_impl;
       const string __other_name = __other.name();
       if (__other_name != "*")
@@ -139,7 +149,8 @@ namespace std
   locale::_S_initialize_once()
   {
     // 2 references.
-    // One reference for _S_classic, one for _S_global
+    // One reference for _S_classic, one for _S_global.  No more are
+    // counted: they just keep the count from ever reaching zero.
     _S_classic = new (&c_locale_impl) _Impl(2);
     _S_global = _S_classic; 	    
     new (&c_locale) locale(_S_classic);
@@ -1,4 +1,4 @@
-// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004
+// Copyright (C) 1997, 1998, 1999, 2000, 2001, 2002, 2003, 2004, 2005
 // Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Library.  This library is free
@@ -40,7 +40,7 @@ namespace std
       {
 	_S_initialize(); 
 	if (std::strcmp(__s, "C") == 0 || std::strcmp(__s, "POSIX") == 0)
-	  (_M_impl = _S_classic)->_M_add_reference();
+	  _M_impl = _S_classic;
 	else if (std::strcmp(__s, "") != 0)
 	  _M_impl = new _Impl(__s, 1);
 	else
@@ -52,7 +52,7 @@ namespace std
 	      {
 		if (std::strcmp(__env, "C") == 0 
 		    || std::strcmp(__env, "POSIX") == 0)
-		  (_M_impl = _S_classic)->_M_add_reference();
+		  _M_impl = _S_classic;
 		else
 		  _M_impl = new _Impl(__env, 1);
 	      }
@@ -133,7 +133,7 @@ namespace std
 		// ... otherwise either an additional instance of
 		// the "C" locale or LANG.
 		else if (__lang == "C")
-		  (_M_impl = _S_classic)->_M_add_reference();
+		  _M_impl = _S_classic;
 		else
 		  _M_impl = new _Impl(__lang.c_str(), 1);
 	      }
@@ -1,6 +1,6 @@
 // Allocator details.
 
-// Copyright (C) 2004 Free Software Foundation, Inc.
+// Copyright (C) 2004, 2005 Free Software Foundation, Inc.
 //
 // This file is part of the GNU ISO C++ Librarbooly.  This library is free
 // software; you can redistribute it and/or modify it under the
@@ -41,6 +41,41 @@ namespace __gnu_internal
 
 #ifdef __GTHREADS
   __gthread_key_t freelist_key;
+
+  // The thread id records of a __pool<true>, and the number of them
+  // handed out so far.  They are kept here rather than in the pool,
+  // whose size is part of the ABI.  The tables are only added to, under
+  // freelist_mutex, and are read without locking.
+  struct thread_table
+  {
+    const __gnu_cxx::__pool<true>*		pool;
+    __gnu_cxx::__pool<true>::_Thread_record*	records;
+    _Atomic_word				count;
+    thread_table*				next;
+  };
+
+  thread_table* volatile thread_tables;
+
+  thread_table*
+  find_thread_table(const __gnu_cxx::__pool<true>* __pool)
+  {
+    thread_table* __t = thread_tables;
+    while (__t->pool != __pool)
+      __t = __t->next;
+    return __t;
+  }
+
+  // Lock the mutex of a bin, counting in __waits the times it was
+  // held by another thread.
+  inline void
+  lock_bin(__gthread_mutex_t* __mutex, size_t& __waits)
+  {
+    if (__gthread_mutex_trylock(__mutex) != 0)
+      {
+	++__waits;
+	__gthread_mutex_lock(__mutex);
+      }
+  }
 #endif
 }
 
@@ -64,10 +99,15 @@ namespace __gnu_cxx
 	// in order to avoid too much contention we wait until the
 	// number of records is "high enough".
 	const size_t __thread_id = _M_get_thread_id();
-	
+	_Atomic_word* const __reclaimed = _M_get_reclaimed(__bin);
+
+	// Blocks of ours which other threads have freed are no longer
+	// in use by us.
+	const size_t __net_used = (__bin._M_used[__thread_id]
+				   - __reclaimed[__thread_id]);
 	long __remove = ((__bin._M_free[__thread_id] 
 			  * __options._M_freelist_headroom)
-			 - __bin._M_used[__thread_id]);
+			 - __net_used);
 	if (__remove > static_cast<long>(100 * (_M_bin_size - __which)
 					 * __options._M_freelist_headroom)
 	    && __remove > static_cast<long>(__bin._M_free[__thread_id]))
@@ -82,7 +122,8 @@ namespace __gnu_cxx
 	    __bin._M_first[__thread_id] = __tmp->_M_next;
 	    __bin._M_free[__thread_id] -= __removed;
 	    
-	    __gthread_mutex_lock(__bin._M_mutex);
+	    __gnu_internal::lock_bin(__bin._M_mutex,
+				     _M_get_lock_waits(__bin)[__thread_id]);
 	    __tmp->_M_next = __bin._M_first[0];
 	    __bin._M_first[0] = __first;
 	    __bin._M_free[0] += __removed;
@@ -90,8 +131,17 @@ namespace __gnu_cxx
 	  }
 	
 	// Return this block to our list and update counters and
-	// owner id as needed.
-	--__bin._M_used[__block->_M_thread_id];
+	// owner id as needed.  Only the owner of a block writes its
+	// _M_used counter; a block of another thread is accounted for
+	// with an atomic add to the reclaimed counter of its owner.
+	if (__block->_M_thread_id == __thread_id)
+	  --__bin._M_used[__thread_id];
+	else
+	  {
+	    __atomic_add(&__reclaimed[__block->_M_thread_id], 1);
+	    ++_M_get_remote_frees(__bin)[__thread_id];
+	  }
+	++_M_get_frees(__bin)[__thread_id];
 	
 	__block->_M_next = __bin._M_first[__thread_id];
 	__bin._M_first[__thread_id] = __block;
@@ -154,7 +204,18 @@ namespace __gnu_cxx
     //   get the first one.
     if (__gthread_active_p())
       {
-	__gthread_mutex_lock(__bin._M_mutex);
+	// Subtract the blocks of ours which other threads have freed
+	// since we last got here from our _M_used counter.
+	_Atomic_word* const __reclaimed = _M_get_reclaimed(__bin);
+	const _Atomic_word __r = __reclaimed[__thread_id];
+	if (__r != 0)
+	  {
+	    __bin._M_used[__thread_id] -= __r;
+	    __atomic_add(&__reclaimed[__thread_id], -__r);
+	  }
+
+	__gnu_internal::lock_bin(__bin._M_mutex,
+				 _M_get_lock_waits(__bin)[__thread_id]);
 	if (__bin._M_first[0] == NULL)
 	  {
 	    // No need to hold the lock when we are adding a
@@ -319,24 +380,32 @@ namespace __gnu_cxx
       {
 	const size_t __k = sizeof(_Thread_record) * _M_options._M_max_threads;
 	__v = ::operator new(__k);
-	_M_thread_freelist = static_cast<_Thread_record*>(__v);
+	_Thread_record* __records = static_cast<_Thread_record*>(__v);
 	  
 	// NOTE! The first assignable thread id is 1 since the
 	// global pool uses id 0
-	size_t __i;
-	for (__i = 1; __i < _M_options._M_max_threads; ++__i)
+	for (size_t __i = 0; __i < _M_options._M_max_threads; ++__i)
 	  {
-	    _Thread_record& __tr = _M_thread_freelist[__i - 1];
-	    __tr._M_next = &_M_thread_freelist[__i];
-	    __tr._M_id = __i;
+	    _Thread_record& __tr = __records[__i];
+	    __tr._M_next = NULL;
+	    __tr._M_id = __i + 1;
 	  }
-	  
-	// Set last record.
-	_M_thread_freelist[__i - 1]._M_next = NULL;
-	_M_thread_freelist[__i - 1]._M_id = __i;
+
+	__gnu_internal::thread_table* __t = new __gnu_internal::thread_table;
+	__t->pool = this;
+	__t->records = __records;
+	__t->count = 0;
+	{
+	  __gnu_cxx::lock sentry(__gnu_internal::freelist_mutex);
+	  __t->next = __gnu_internal::thread_tables;
+#ifdef _GLIBCXX_WRITE_MEM_BARRIER
+	  _GLIBCXX_WRITE_MEM_BARRIER;
+#endif
+	  __gnu_internal::thread_tables = __t;
+	}
 	  
 	// Initialize per thread key to hold pointer to
-	// _M_thread_freelist.
+	// _M_thread_records.
 	__gthread_key_create(&__gnu_internal::freelist_key, __d);
 	  
 	const size_t __max_threads = _M_options._M_max_threads + 1;
@@ -349,7 +418,9 @@ namespace __gnu_cxx
 	    __v = ::operator new(sizeof(size_t) * __max_threads);
 	    __bin._M_free = static_cast<size_t*>(__v);
 	      
-	    __v = ::operator new(sizeof(size_t) * __max_threads);
+	    // See _Bin_record for what follows _M_used.
+	    __v = ::operator new(4 * sizeof(size_t) * __max_threads
+				 + sizeof(_Atomic_word) * __max_threads);
 	    __bin._M_used = static_cast<size_t*>(__v);
 	      
 	    __v = ::operator new(sizeof(__gthread_mutex_t));
@@ -371,6 +442,10 @@ namespace __gnu_cxx
 		__bin._M_first[__threadn] = NULL;
 		__bin._M_free[__threadn] = 0;
 		__bin._M_used[__threadn] = 0;
+		_M_get_frees(__bin)[__threadn] = 0;
+		_M_get_remote_frees(__bin)[__threadn] = 0;
+		_M_get_lock_waits(__bin)[__threadn] = 0;
+		_M_get_reclaimed(__bin)[__threadn] = 0;
 	      }
 	  }
       }
@@ -455,14 +530,19 @@ namespace __gnu_cxx
 	_Thread_record* __freelist_pos = static_cast<_Thread_record*>(v); 
 	if (__freelist_pos == NULL)
 	  {
+	    // Hand out the ids in order first, which needs no lock.
+	    __freelist_pos = _M_get_unused_thread_record();
+
+	    // Otherwise reuse the id of a thread which has exited.
 	    // Since _M_options._M_max_threads must be larger than
 	    // the theoretical max number of threads of the OS the
 	    // list can never be empty.
-	    {
-	      __gnu_cxx::lock sentry(__gnu_internal::freelist_mutex);
-	      __freelist_pos = _M_thread_freelist;
-	      _M_thread_freelist = _M_thread_freelist->_M_next;
-	    }
+	    if (__freelist_pos == NULL)
+	      {
+		__gnu_cxx::lock sentry(__gnu_internal::freelist_mutex);
+		__freelist_pos = _M_thread_freelist;
+		_M_thread_freelist = _M_thread_freelist->_M_next;
+	      }
 	      
 	    __gthread_setspecific(__gnu_internal::freelist_key, 
 				  static_cast<void*>(__freelist_pos));
@@ -475,15 +555,92 @@ namespace __gnu_cxx
     return 0;
   }
 
+  __pool<true>::_Thread_record*
+  __pool<true>::_M_get_unused_thread_record()
+  {
+    __gnu_internal::thread_table* __t
+      = __gnu_internal::find_thread_table(this);
+
+    // The unlocked test keeps the count from wrapping around once all
+    // ids have been handed out.
+    const size_t __max_threads = _M_options._M_max_threads;
+    if (static_cast<size_t>(__t->count) < __max_threads)
+      {
+	const size_t __n = __exchange_and_add(&__t->count, 1);
+	if (__n < __max_threads)
+	  return &__t->records[__n];
+      }
+    return NULL;
+  }
+
   void
   __pool<true>::_M_destroy_thread_key(void* __freelist_pos)
   {
+    _Thread_record* __tr = static_cast<_Thread_record*>(__freelist_pos);
+    const size_t __thread_id = __tr->_M_id;
+
+    // Move the freelists of this thread, each in one go, to the
+    // global pool, where other threads can pick them up.  Its
+    // _M_used counters stay, as blocks handed out to it may still
+    // be freed, and pass to the next thread given this id.
+    for (size_t __n = 0; __n < _M_bin_size; ++__n)
+      {
+	const _Bin_record& __bin = _M_bin[__n];
+	_Block_record* __first = __bin._M_first[__thread_id];
+	if (__first == NULL)
+	  continue;
+
+	_Block_record* __last = __first;
+	while (__last->_M_next)
+	  __last = __last->_M_next;
+
+	__gnu_internal::lock_bin(__bin._M_mutex,
+				 _M_get_lock_waits(__bin)[__thread_id]);
+	__last->_M_next = __bin._M_first[0];
+	__bin._M_first[0] = __first;
+	__bin._M_free[0] += __bin._M_free[__thread_id];
+	__gthread_mutex_unlock(__bin._M_mutex);
+
+	__bin._M_first[__thread_id] = NULL;
+	__bin._M_free[__thread_id] = 0;
+      }
+
     // Return this thread id record to front of thread_freelist.
     __gnu_cxx::lock sentry(__gnu_internal::freelist_mutex);
-    _Thread_record* __tr = static_cast<_Thread_record*>(__freelist_pos);
     __tr->_M_next = _M_thread_freelist; 
     _M_thread_freelist = __tr;
   }
+
+  __pool_base::_Stats
+  __pool<true>::_M_get_stats() const
+  {
+    _Stats __stats;
+    if (_M_init && !_M_options._M_force_new && __gthread_active_p())
+      {
+	const size_t __max_threads = _M_options._M_max_threads + 1;
+	for (size_t __n = 0; __n < _M_bin_size; ++__n)
+	  {
+	    const _Bin_record& __bin = _M_bin[__n];
+	    const size_t* __frees = _M_get_frees(__bin);
+	    const size_t* __remote_frees = _M_get_remote_frees(__bin);
+	    const size_t* __lock_waits = _M_get_lock_waits(__bin);
+	    const _Atomic_word* __reclaimed = _M_get_reclaimed(__bin);
+	    for (size_t __threadn = 0; __threadn < __max_threads;
+		 ++__threadn)
+	      {
+		// The allocation fast path is inline code, which may
+		// come from older headers, so blocks are counted as they
+		// come back, plus those still in use.
+		__stats._M_allocs += (__frees[__threadn]
+				      + __bin._M_used[__threadn]
+				      - __reclaimed[__threadn]);
+		__stats._M_remote_frees += __remote_frees[__threadn];
+		__stats._M_lock_waits += __lock_waits[__threadn];
+	      }
+	  }
+      }
+    return __stats;
+  }
 #endif
 
   // Definitions for non-exported bits of __common_pool.
@@ -0,0 +1,68 @@
+// { dg-do run { target *-*-linux* } }
+// { dg-options "-ldl" }
+
+// Copyright (C) 2005 Free Software Foundation
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// 5.2.7 Dynamic cast
+
+#include <dlfcn.h>
+#include <testsuite_hooks.h>
+#include <testsuite_shared.h>
+
+// The results of __dynamic_cast are cached by vtable.  Those of the
+// objects of a shared object must still be right once it is unloaded
+// and loaded again, maybe at another address.
+void test01()
+{
+  bool test __attribute__((unused)) = true;
+  using namespace __gnu_test;
+
+  for (int round = 0; round < 4; ++round)
+    {
+      void* h = dlopen("./testsuite_shared.so", RTLD_NOW);
+      VERIFY( h != 0 );
+      make_shared_object_type make
+	= (make_shared_object_type) dlsym(h, "make_shared_object");
+      VERIFY( make != 0 );
+
+      shared_base* d = make(0);
+      shared_base* o = make(1);
+
+      // Twice, to use the cache.
+      for (int i = 0; i < 2; ++i)
+	{
+	  VERIFY( dynamic_cast<shared_derived*>(d)
+		  == static_cast<shared_derived*>(d) );
+	  VERIFY( dynamic_cast<shared_other*>(d) == 0 );
+	  VERIFY( dynamic_cast<shared_other*>(o)
+		  == static_cast<shared_other*>(o) );
+	  VERIFY( dynamic_cast<shared_derived*>(o) == 0 );
+	}
+
+      delete d;
+      delete o;
+      VERIFY( dlclose(h) == 0 );
+    }
+}
+
+int main()
+{
+  test01();
+  return 0;
+}
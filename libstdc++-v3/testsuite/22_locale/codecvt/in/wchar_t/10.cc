@@ -0,0 +1,107 @@
+// Copyright (C) 2005 Free Software Foundation
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// 22.2.1.5 - Template class codecvt [lib.locale.codecvt]
+
+#include <locale>
+#include <testsuite_hooks.h>
+
+// Need to explicitly set the state(mbstate_t) to zero.
+// How to do this is not specified by the ISO C99 standard, so we
+// might need to add some operators to make the intuiative case
+// work:
+//   w_codecvt::state_type state00;
+//   state00 = 0;  
+// or, can use this explicit "C" initialization:
+//   w_codecvt::state_type state01 = {0, 0};
+// .. except Ulrich says: Use memset. Always use memset. Feel the force...
+void
+zero_state(std::mbstate_t& state)
+{ std::memset(&state, 0, sizeof(std::mbstate_t)); }
+
+// Required instantiation
+// codecvt<wchar_t, char, mbstate_t>
+//
+// Ill-formed UTF-8 after a run of well formed characters.
+void test10()
+{
+  using namespace std;
+  typedef codecvt<wchar_t, char, mbstate_t> 	w_codecvt;
+  typedef codecvt_base::result			result;
+  typedef wchar_t				int_type;
+  typedef char					ext_type;
+  typedef char_traits<wchar_t>			int_traits;
+
+  bool test __attribute__((unused)) = true;
+
+  // Overlong forms, a surrogate, a stray continuation byte, bytes
+  // never valid and a sequence cut short.
+  const ext_type* bad[] =
+    {
+      "\xc0\x80", "\xc1\xbf", "\xe0\x80\x80", "\xe0\x9f\xbf",
+      "\xf0\x80\x80\x80", "\xf0\x8f\xbf\xbf", "\xed\xa0\x80", "\x80",
+      "\xbf", "\xfe", "\xff", "\xe4\x80\x41"
+    };
+  const int nbad = sizeof(bad) / sizeof(bad[0]);
+
+  const ext_type* 	e_good =
+    "abcdefghijklmnopqrstuvwxyz\0ABCDEF\xc3\xa9\xe4\xb8\xad\xf0\x9d\x84\x9e";
+  const int_type 	i_good[] = {
+    L'a', L'b', L'c', L'd', L'e', L'f', L'g', L'h', L'i', L'j', L'k',
+    L'l', L'm', L'n', L'o', L'p', L'q', L'r', L's', L't', L'u', L'v',
+    L'w', L'x', L'y', L'z', 0x0, L'A', L'B', L'C', L'D', L'E', L'F',
+    0xe9, 0x4e2d, 0x1d11e
+  };
+  const int 		gsize = 42;
+  const int 		isize = sizeof(i_good) / sizeof(i_good[0]);
+
+  locale loc = __gnu_test::try_named_locale("en_US.UTF-8");
+  locale::global(loc);
+  const w_codecvt* 	cvt = &use_facet<w_codecvt>(loc); 
+
+  for (int i = 0; i < nbad; ++i)
+    {
+      ext_type e_lit[64];
+      memcpy(e_lit, e_good, gsize);
+      const int bsize = strlen(bad[i]);
+      memcpy(e_lit + gsize, bad[i], bsize);
+      const int esize = gsize + bsize;
+
+      int_type i_arr[64];
+      const ext_type* efrom_next;
+      int_type* ito_next;
+      w_codecvt::state_type state01;
+      zero_state(state01);
+      result r1 = cvt->in(state01, e_lit, e_lit + esize, efrom_next,
+			  i_arr, i_arr + 64, ito_next);
+      VERIFY( r1 == codecvt_base::error );
+      VERIFY( efrom_next == e_lit + gsize );
+      VERIFY( ito_next == i_arr + isize );
+      VERIFY( !int_traits::compare(i_arr, i_good, isize) );
+
+      w_codecvt::state_type state02;
+      zero_state(state02);
+      VERIFY( cvt->length(state02, e_lit, e_lit + esize, 64) == gsize );
+    }
+}
+
+int main ()
+{
+  test10();
+  return 0;
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2005 Free Software Foundation
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// 22.1.1.2 locale constructors and destructors [lib.locale.cons]
+
+#include <locale>
+#include <sstream>
+#include <testsuite_hooks.h>
+
+// The locales sharing the classic one, however obtained, copied,
+// assigned and destroyed, never release it.
+void
+test01()
+{
+  using namespace std;
+  bool test __attribute__((unused)) = true;
+
+  for (int i = 0; i < 1000; ++i)
+    {
+      locale l1 = locale::classic();
+      locale l2("C");
+      locale l3("POSIX");
+      locale l4;
+      l4 = l1;
+      l1 = locale(l2);
+      locale l5 = locale::global(l3);
+      VERIFY( l5 == locale::classic() );
+      VERIFY( l1 == l4 && l3 == l2 );
+    }
+
+  const locale named = __gnu_test::try_named_locale("de_DE");
+  for (int i = 0; i < 1000; ++i)
+    {
+      locale l1 = locale::global(named);
+      locale l2;
+      VERIFY( l2 == named );
+      l2 = locale::global(l1);
+      VERIFY( l2 == named );
+      VERIFY( locale() == locale::classic() );
+    }
+
+  ostringstream oss;
+  oss << 1234567;
+  VERIFY( oss.str() == "1234567" );
+  VERIFY( use_facet<numpunct<char> >(locale::classic()).decimal_point()
+	  == '.' );
+  VERIFY( has_facet<ctype<wchar_t> >(locale()) );
+}
+
+int main()
+{
+  test01();
+  return 0;
+}
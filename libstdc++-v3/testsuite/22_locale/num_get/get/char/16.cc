@@ -0,0 +1,87 @@
+// Copyright (C) 2005 Free Software Foundation
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// 22.2.2.1.1  num_get members
+
+#include <locale>
+#include <sstream>
+#include <clocale>
+#include <testsuite_hooks.h>
+
+// Digits are recognized in every base, and only the digits of the base.
+void test01()
+{
+  using namespace std;
+  bool test __attribute__((unused)) = true;
+
+  long l = 0;
+  istringstream iss1("1234567890 777 18 1aF9 0x7fG -42");
+  iss1 >> l;
+  VERIFY( l == 1234567890 );
+  iss1 >> oct >> l;
+  VERIFY( l == 0777 );
+  iss1 >> l;
+  VERIFY( l == 01 );
+  iss1.ignore(1);
+  iss1 >> hex >> l;
+  VERIFY( l == 0x1af9 );
+  iss1 >> l;
+  VERIFY( l == 0x7f );
+  iss1.ignore(1);
+  iss1 >> dec >> l;
+  VERIFY( l == -42 );
+
+  double d = 0.0;
+  istringstream iss2("3.75e2 9x");
+  iss2 >> d;
+  VERIFY( d == 375.0 );
+  iss2 >> d;
+  VERIFY( d == 9.0 );
+  VERIFY( iss2.peek() == 'x' );
+}
+
+// Floating point input does not depend on the LC_NUMERIC locale of
+// the C library.
+void test02()
+{
+  using namespace std;
+  bool test __attribute__((unused)) = true;
+
+  const char* name = setlocale(LC_NUMERIC, "de_DE");
+  if (!name)
+    return;
+  const string saved(name);
+
+  float f = 0.0f;
+  double d = 0.0;
+  long double ld = 0.0L;
+  istringstream iss("1.5 0.25 2.125");
+  iss >> f >> d >> ld;
+  VERIFY( f == 1.5f );
+  VERIFY( d == 0.25 );
+  VERIFY( ld == 2.125L );
+  VERIFY( saved == setlocale(LC_NUMERIC, NULL) );
+  setlocale(LC_NUMERIC, "C");
+}
+
+int main()
+{
+  test01();
+  test02();
+  return 0;
+}
@@ -0,0 +1,103 @@
+// Copyright (C) 2005 Free Software Foundation
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// 22.2.2.2.1  num_put members
+
+#include <locale>
+#include <sstream>
+#include <clocale>
+#include <climits>
+#include <cstdio>
+#include <testsuite_hooks.h>
+
+// Decimal output around the digit pair boundaries.
+void test01()
+{
+  using namespace std;
+  bool test __attribute__((unused)) = true;
+
+  const long values[] = { 0, 7, 9, 10, 42, 99, 100, 101, 999, 1000,
+			  12345, 99999, 100000 };
+  const char* const results[] = { "0", "7", "9", "10", "42", "99", "100",
+				  "101", "999", "1000", "12345", "99999",
+				  "100000" };
+
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+      ostringstream oss;
+      oss << values[i];
+      VERIFY( oss.str() == results[i] );
+
+      ostringstream oss_neg;
+      oss_neg << -values[i];
+      if (values[i])
+	VERIFY( oss_neg.str() == string("-") + results[i] );
+      else
+	VERIFY( oss_neg.str() == "0" );
+    }
+
+  ostringstream oss1;
+  oss1 << ULONG_MAX;
+  char buf[64];
+  sprintf(buf, "%lu", ULONG_MAX);
+  VERIFY( oss1.str() == buf );
+
+  ostringstream oss2;
+  oss2 << LONG_MIN;
+  sprintf(buf, "%ld", LONG_MIN);
+  VERIFY( oss2.str() == buf );
+
+  ostringstream oss4;
+  oss4 << LONG_MAX << ' ' << -LONG_MAX;
+  sprintf(buf, "%ld %ld", LONG_MAX, -LONG_MAX);
+  VERIFY( oss4.str() == buf );
+
+  ostringstream oss3;
+  oss3.setf(ios_base::showpos);
+  oss3.width(8);
+  oss3.fill('*');
+  oss3.setf(ios_base::internal, ios_base::adjustfield);
+  oss3 << 1234;
+  VERIFY( oss3.str() == "+***1234" );
+}
+
+// Floating point output does not depend on the LC_NUMERIC locale of
+// the C library.
+void test02()
+{
+  using namespace std;
+  bool test __attribute__((unused)) = true;
+
+  const char* name = setlocale(LC_NUMERIC, "de_DE");
+  if (!name)
+    return;
+  const string saved(name);
+
+  ostringstream oss;
+  oss << 1.5 << ' ' << 0.25L;
+  VERIFY( oss.str() == "1.5 0.25" );
+  VERIFY( saved == setlocale(LC_NUMERIC, NULL) );
+  setlocale(LC_NUMERIC, "C");
+}
+
+int main()
+{
+  test01();
+  test02();
+  return 0;
+}
@@ -0,0 +1,70 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// 23.2.2.3 list modifiers [lib.list.modifiers]
+
+#include <list>
+#include <testsuite_hooks.h>
+
+typedef __gnu_test::copy_tracker  T;
+
+bool test __attribute__((unused)) = true;
+
+// A range or fill insertion which throws leaves the list unchanged.
+void
+test01()
+{
+  std::list<T> l;
+  l.push_back(T(1));
+  l.push_back(T(2));
+
+  T src[5] = { T(10), T(11), T(12), T(13, true), T(14) };
+  T::reset();
+  try
+    {
+      l.insert(++l.begin(), src, src + 5);
+      VERIFY( false );
+    }
+  catch(...)
+    { }
+  VERIFY( l.size() == 2 );
+  VERIFY( l.front().id() == 1 && l.back().id() == 2 );
+  VERIFY( T::copyCount() == T::dtorCount() );
+
+  T::reset();
+  try
+    {
+      l.insert(l.end(), 3, T(20, true));
+      VERIFY( false );
+    }
+  catch(...)
+    { }
+  VERIFY( l.size() == 2 );
+  VERIFY( l.front().id() == 1 && l.back().id() == 2 );
+
+  l.insert(l.begin(), src, src + 3);
+  VERIFY( l.size() == 5 );
+  VERIFY( l.front().id() == 10 && (++l.begin())->id() == 11 );
+  T::reset();
+}
+
+int main()
+{
+  test01();
+  return 0;
+}
@@ -0,0 +1,131 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// 23.2.2.4 list operations [lib.list.ops]
+
+#include <list>
+#include <vector>
+#include <cstdlib>
+#include <testsuite_hooks.h>
+
+bool test __attribute__((unused)) = true;
+
+struct Elem
+{
+  int key;
+  int seq;
+};
+
+bool
+operator<(const Elem& x, const Elem& y)
+{ return x.key < y.key; }
+
+struct KeyGreater
+{
+  bool
+  operator()(const Elem& x, const Elem& y) const
+  { return x.key > y.key; }
+};
+
+// Throws at the given call.
+struct ThrowingLess
+{
+  static int calls;
+
+  bool
+  operator()(int x, int y) const
+  {
+    if (--calls == 0)
+      throw 1;
+    return x < y;
+  }
+};
+
+int ThrowingLess::calls;
+
+// sort() and sort(pred) are stable, for lists short and long.
+void
+test01()
+{
+  std::srand(11);
+  for (int n = 1; n < 300; n += 1 + n / 8)
+    {
+      std::list<Elem> l1;
+      for (int i = 0; i < n; ++i)
+	{
+	  Elem e = { std::rand() % 10, i };
+	  l1.push_back(e);
+	}
+      std::list<Elem> l2(l1);
+
+      l1.sort();
+      VERIFY( l1.size() == std::size_t(n) );
+      std::list<Elem>::iterator it = l1.begin();
+      for (std::list<Elem>::iterator prev = it++; it != l1.end(); prev = it++)
+	VERIFY( prev->key < it->key
+		|| (prev->key == it->key && prev->seq < it->seq) );
+
+      l2.sort(KeyGreater());
+      VERIFY( l2.size() == std::size_t(n) );
+      it = l2.begin();
+      for (std::list<Elem>::iterator prev = it++; it != l2.end(); prev = it++)
+	VERIFY( prev->key > it->key
+		|| (prev->key == it->key && prev->seq < it->seq) );
+
+      // The links backwards match the links forwards.
+      std::list<Elem>::reverse_iterator rit = l2.rbegin();
+      for (int i = n - 1; i >= 0; --i, ++rit)
+	VERIFY( rit != l2.rend() );
+      VERIFY( rit == l2.rend() );
+    }
+}
+
+// A throwing comparison leaves the list as it was.
+void
+test02()
+{
+  std::list<int> l;
+  for (int i = 0; i < 100; ++i)
+    l.push_back((i * 37) % 100);
+  const std::list<int> orig(l);
+
+  ThrowingLess::calls = 150;
+  try
+    {
+      l.sort(ThrowingLess());
+      VERIFY( false );
+    }
+  catch(int)
+    { }
+  VERIFY( l == orig );
+
+  ThrowingLess::calls = 0;
+  l.sort(ThrowingLess());
+  for (int i = 0; i < 100; ++i)
+    {
+      VERIFY( l.front() == i );
+      l.pop_front();
+    }
+}
+
+int main()
+{
+  test01();
+  test02();
+  return 0;
+}
@@ -0,0 +1,64 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+
+// { dg-options "-D_GLIBCXX_DEBUG_LIGHT" }
+
+#ifndef _GLIBCXX_DEBUG_LIGHT
+#  define _GLIBCXX_DEBUG_LIGHT 1
+#endif
+
+#include <vector>
+#include <string>
+#include <testsuite_hooks.h>
+
+// Correct uses of vector and string are not diagnosed.
+void test01()
+{
+  bool test __attribute__((unused)) = true;
+
+  std::vector<int> v(10, 1);
+  v[9] = 2;
+  VERIFY( v.front() == 1 && v.back() == 2 );
+
+  std::vector<int>::iterator i = v.insert(v.end(), 3);
+  VERIFY( *i == 3 );
+  v.insert(v.begin(), 2, 0);
+  v.insert(v.begin() + 1, v.begin(), v.begin() + 2);
+  VERIFY( v.size() == 15 );
+
+  i = v.erase(v.begin());
+  VERIFY( i == v.begin() );
+  v.erase(v.begin(), v.begin() + 3);
+  v.erase(v.end(), v.end());
+  v.pop_back();
+  VERIFY( v.size() == 10 );
+
+  std::string s("abc");
+  s.insert(s.end(), 'd');
+  s.erase(s.begin());
+  s.erase(s.begin(), s.begin() + 1);
+  VERIFY( s == "cd" );
+  VERIFY( s[1] == 'd' );
+}
+
+int main()
+{
+  test01();
+  return 0;
+}
@@ -0,0 +1,42 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+
+// { dg-options "-D_GLIBCXX_DEBUG_LIGHT" }
+// { dg-do run { xfail *-*-* } }
+
+#ifndef _GLIBCXX_DEBUG_LIGHT
+#  define _GLIBCXX_DEBUG_LIGHT 1
+#endif
+
+#include <vector>
+
+// Inserting through an iterator invalidated by a reallocation.
+void test01()
+{
+  std::vector<int> v(1, 1);
+  std::vector<int>::iterator i = v.begin();
+  v.reserve(v.capacity() + 100);
+  v.insert(i, 2);
+}
+
+int main()
+{
+  test01();
+  return 0;
+}
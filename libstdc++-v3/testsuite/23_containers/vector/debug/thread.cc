@@ -0,0 +1,83 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+
+// { dg-do run { target *-*-freebsd* *-*-netbsd* *-*-linux* *-*-solaris* *-*-cygwin *-*-darwin* alpha*-*-osf* } }
+// { dg-options "-D_GLIBCXX_DEBUG -pthread" { target *-*-freebsd* *-*-netbsd* *-*-linux* alpha*-*-osf* } }
+// { dg-options "-D_GLIBCXX_DEBUG -pthreads" { target *-*-solaris* } }
+
+#ifndef _GLIBCXX_DEBUG
+#  define _GLIBCXX_DEBUG 1
+#endif
+
+#include <vector>
+#include <testsuite_hooks.h>
+
+// Do not include <pthread.h> explicitly; if threads are properly
+// configured for the port, then it is picked up free from STL headers.
+
+#if __GTHREADS
+
+const int thread_count = 4;
+const int size = 1000;
+
+std::vector<int> shared(size, 1);
+std::vector<int> own[thread_count];
+
+// Iterators into the shared vector and into a vector of its own are
+// attached and detached concurrently.
+void*
+sum(void* p)
+{
+  bool test __attribute__((unused)) = true;
+
+  std::vector<int>& v = own[reinterpret_cast<long>(p)];
+  const std::vector<int>& cv = shared;
+  for (int i = 0; i < 100; ++i)
+    {
+      long n = 0;
+      for (std::vector<int>::const_iterator it = cv.begin();
+	   it != cv.end(); ++it)
+	n += *it;
+      VERIFY( n == size );
+
+      v.assign(cv.begin(), cv.end());
+      for (std::vector<int>::iterator it = v.begin(); it != v.end(); ++it)
+	++*it;
+      VERIFY( v.back() == 2 );
+    }
+  return 0;
+}
+
+void test01()
+{
+  pthread_t t[thread_count];
+  for (long i = 0; i < thread_count; ++i)
+    pthread_create(&t[i], 0, sum, reinterpret_cast<void*>(i));
+  for (int i = 0; i < thread_count; ++i)
+    pthread_join(t[i], 0);
+}
+
+int main()
+{
+  test01();
+  return 0;
+}
+#else
+int main (void) { return 0; }
+#endif
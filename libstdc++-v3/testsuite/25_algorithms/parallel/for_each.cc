@@ -0,0 +1,109 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// { dg-do run { target *-*-freebsd* *-*-netbsd* *-*-linux* *-*-solaris* *-*-cygwin *-*-darwin* alpha*-*-osf* } }
+// { dg-options "-D_GLIBCXX_PARALLEL -pthread" { target *-*-freebsd* *-*-netbsd* *-*-linux* alpha*-*-osf* } }
+// { dg-options "-D_GLIBCXX_PARALLEL -pthreads" { target *-*-solaris* } }
+// { dg-options "-D_GLIBCXX_PARALLEL" { target *-*-cygwin *-*-darwin* } }
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <vector>
+#include <testsuite_hooks.h>
+
+const int n = 100003;
+
+struct twice
+{
+  int
+  operator()(int x) const
+  { return 2 * x; }
+};
+
+// Each thread has its own copy, thus count in a shared place.
+struct mark
+{
+  std::vector<int>* seen;
+
+  void
+  operator()(int x)
+  { ++(*seen)[x]; }
+};
+
+void
+set_threads(unsigned int threads)
+{
+  __gnu_parallel::_Settings& s = __gnu_parallel::__get_settings();
+  s._M_num_threads = threads;
+  s._M_loop_minimal_n = 1000;
+}
+
+void
+test01(unsigned int threads)
+{
+  bool test __attribute__((unused)) = true;
+  set_threads(threads);
+
+  std::vector<int> x(n);
+  for (int i = 0; i < n; ++i)
+    x[i] = i;
+
+  std::vector<int> seen(n);
+  mark m = { &seen };
+  std::for_each(x.begin(), x.end(), m);
+  VERIFY( std::count(seen.begin(), seen.end(), 1) == n );
+
+  std::vector<int> y(n);
+  VERIFY( std::transform(x.begin(), x.end(), y.begin(), twice()) == y.end() );
+  for (int i = 0; i < n; ++i)
+    VERIFY( y[i] == 2 * i );
+
+  VERIFY( std::transform(x.begin(), x.end(), y.begin(), y.begin(),
+			 std::plus<int>()) == y.end() );
+  for (int i = 0; i < n; ++i)
+    VERIFY( y[i] == 3 * i );
+}
+
+// Iterators which are not random access take the sequential path.
+void
+test02()
+{
+  bool test __attribute__((unused)) = true;
+  set_threads(4);
+
+  std::vector<int> x(n);
+  for (int i = 0; i < n; ++i)
+    x[i] = i;
+  std::list<int> l(x.begin(), x.end());
+
+  std::vector<int> y;
+  std::transform(l.begin(), l.end(), std::back_inserter(y), twice());
+  VERIFY( y.size() == static_cast<std::size_t>(n) );
+  for (int i = 0; i < n; ++i)
+    VERIFY( y[i] == 2 * i );
+}
+
+int main()
+{
+  for (unsigned int threads = 1; threads <= 8; ++threads)
+    test01(threads);
+  test02();
+  return 0;
+}
@@ -0,0 +1,130 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// { dg-do run { target *-*-freebsd* *-*-netbsd* *-*-linux* *-*-solaris* *-*-cygwin *-*-darwin* alpha*-*-osf* } }
+// { dg-options "-D_GLIBCXX_PARALLEL -pthread" { target *-*-freebsd* *-*-netbsd* *-*-linux* alpha*-*-osf* } }
+// { dg-options "-D_GLIBCXX_PARALLEL -pthreads" { target *-*-solaris* } }
+// { dg-options "-D_GLIBCXX_PARALLEL" { target *-*-cygwin *-*-darwin* } }
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <cstdlib>
+#include <testsuite_hooks.h>
+
+struct entry
+{
+  int key;
+  int seq;
+};
+
+bool
+key_less(const entry& x, const entry& y)
+{ return x.key < y.key; }
+
+const int n = 100003;
+
+void
+set_threads(unsigned int threads)
+{
+  __gnu_parallel::_Settings& s = __gnu_parallel::__get_settings();
+  s._M_num_threads = threads;
+  s._M_sort_minimal_n = 1000;
+}
+
+void
+test01(unsigned int threads)
+{
+  bool test __attribute__((unused)) = true;
+  set_threads(threads);
+
+  std::vector<int> v(n);
+  for (int i = 0; i < n; ++i)
+    v[i] = std::rand() % 1000;
+  std::vector<int> w(v);
+
+  std::sort(v.begin(), v.end());
+  for (int i = 1; i < n; ++i)
+    VERIFY( v[i - 1] <= v[i] );
+
+  std::sort(w.begin(), w.end(), std::greater<int>());
+  for (int i = 1; i < n; ++i)
+    VERIFY( w[i - 1] >= w[i] );
+  VERIFY( std::equal(v.begin(), v.end(), w.rbegin()) );
+
+  // Short ranges take the sequential path.
+  int a[3] = { 3, 1, 2 };
+  std::sort(a, a + 3);
+  VERIFY( a[0] == 1 && a[1] == 2 && a[2] == 3 );
+}
+
+// stable_sort keeps equivalent elements in order.
+void
+test02(unsigned int threads)
+{
+  bool test __attribute__((unused)) = true;
+  set_threads(threads);
+
+  std::vector<entry> v(n);
+  for (int i = 0; i < n; ++i)
+    {
+      v[i].key = std::rand() % 100;
+      v[i].seq = i;
+    }
+  std::stable_sort(v.begin(), v.end(), key_less);
+  for (int i = 1; i < n; ++i)
+    VERIFY( v[i - 1].key < v[i].key
+	    || (v[i - 1].key == v[i].key && v[i - 1].seq < v[i].seq) );
+
+  std::vector<int> w(n);
+  for (int i = 0; i < n; ++i)
+    w[i] = n - i;
+  std::stable_sort(w.begin(), w.end());
+  for (int i = 0; i < n; ++i)
+    VERIFY( w[i] == i + 1 );
+}
+
+void
+test03(unsigned int threads)
+{
+  bool test __attribute__((unused)) = true;
+  set_threads(threads);
+
+  std::vector<int> v(n);
+  for (int i = 0; i < n; ++i)
+    v[i] = std::rand();
+  std::vector<int> s(v);
+  std::sort(s.begin(), s.end());
+
+  std::partial_sort(v.begin(), v.begin() + 5000, v.end());
+  VERIFY( std::equal(v.begin(), v.begin() + 5000, s.begin()) );
+
+  std::partial_sort(v.begin(), v.end(), v.end(), std::less<int>());
+  VERIFY( v == s );
+}
+
+int main()
+{
+  for (unsigned int threads = 1; threads <= 8; ++threads)
+    {
+      test01(threads);
+      test02(threads);
+      test03(threads);
+    }
+  return 0;
+}
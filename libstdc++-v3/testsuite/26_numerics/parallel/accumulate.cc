@@ -0,0 +1,85 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// { dg-do run { target *-*-freebsd* *-*-netbsd* *-*-linux* *-*-solaris* *-*-cygwin *-*-darwin* alpha*-*-osf* } }
+// { dg-options "-D_GLIBCXX_PARALLEL -pthread" { target *-*-freebsd* *-*-netbsd* *-*-linux* alpha*-*-osf* } }
+// { dg-options "-D_GLIBCXX_PARALLEL -pthreads" { target *-*-solaris* } }
+// { dg-options "-D_GLIBCXX_PARALLEL" { target *-*-cygwin *-*-darwin* } }
+
+#include <numeric>
+#include <vector>
+#include <testsuite_hooks.h>
+
+const int n = 100003;
+
+void
+set_threads(unsigned int threads)
+{
+  __gnu_parallel::_Settings& s = __gnu_parallel::__get_settings();
+  s._M_num_threads = threads;
+  s._M_loop_minimal_n = 1000;
+}
+
+void
+test01(unsigned int threads)
+{
+  bool test __attribute__((unused)) = true;
+  set_threads(threads);
+
+  std::vector<long> x(n);
+  long sq = 0;
+  for (int i = 0; i < n; ++i)
+    {
+      x[i] = i;
+      sq += long(i) * i;
+    }
+
+  VERIFY( std::accumulate(x.begin(), x.end(), 5L)
+	  == 5L + long(n) * (n - 1) / 2 );
+  VERIFY( std::inner_product(x.begin(), x.end(), x.begin(), 0L) == sq );
+
+  std::vector<long> p(n);
+  VERIFY( std::partial_sum(x.begin(), x.end(), p.begin()) == p.end() );
+  for (int i = 0; i < n; ++i)
+    VERIFY( p[i] == long(i) * (i + 1) / 2 );
+
+  // In place.
+  std::partial_sum(x.begin(), x.end(), x.begin());
+  VERIFY( x == p );
+}
+
+// Mixed types are summed sequentially, with the conversions at each
+// step.
+void
+test02()
+{
+  bool test __attribute__((unused)) = true;
+  set_threads(4);
+
+  std::vector<double> x(n, 0.5);
+  VERIFY( std::accumulate(x.begin(), x.end(), 0) == 0 );
+  VERIFY( std::accumulate(x.begin(), x.end(), 0.0) == n * 0.5 );
+}
+
+int main()
+{
+  for (unsigned int threads = 1; threads <= 8; ++threads)
+    test01(threads);
+  test02();
+  return 0;
+}
@@ -0,0 +1,114 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+
+// 26.3.3.1 valarray binary operators: v op w, v op t and t op v.
+
+#include <valarray>
+#include <testsuite_hooks.h>
+
+// Construction from and assignment of the closures, at all the
+// sizes around the width of a SIMD register.
+void test01()
+{
+  bool test __attribute__((unused)) = true;
+
+  for (int n = 0; n < 20; ++n)
+    {
+      std::valarray<double> v(n), w(n);
+      for (int i = 0; i < n; ++i)
+	{
+	  v[i] = i * 1.5;
+	  w[i] = i % 3 + 1;
+	}
+
+      std::valarray<double> r1(v + w);
+      std::valarray<double> r2(v * 2.0);
+      std::valarray<double> r3(3.0 - w);
+      std::valarray<double> r4(n);
+      r4 = v / w;
+      for (int i = 0; i < n; ++i)
+	{
+	  VERIFY( r1[i] == v[i] + w[i] );
+	  VERIFY( r2[i] == v[i] * 2.0 );
+	  VERIFY( r3[i] == 3.0 - w[i] );
+	  VERIFY( r4[i] == v[i] / w[i] );
+	}
+    }
+}
+
+// Integer operators, and a result which is also an operand.
+void test02()
+{
+  bool test __attribute__((unused)) = true;
+
+  const int n = 37;
+  std::valarray<int> v(n), w(n), r(n);
+  for (int i = 0; i < n; ++i)
+    {
+      v[i] = i * 7 + 1;
+      w[i] = i % 5 + 1;
+    }
+
+  r = v % w;
+  for (int i = 0; i < n; ++i)
+    VERIFY( r[i] == (i * 7 + 1) % (i % 5 + 1) );
+  r = 1 << w;
+  for (int i = 0; i < n; ++i)
+    VERIFY( r[i] == 1 << (i % 5 + 1) );
+  r = v & 6;
+  for (int i = 0; i < n; ++i)
+    VERIFY( r[i] == ((i * 7 + 1) & 6) );
+
+  v = v - w;
+  for (int i = 0; i < n; ++i)
+    VERIFY( v[i] == i * 7 + 1 - (i % 5 + 1) );
+  w = 2 * w;
+  for (int i = 0; i < n; ++i)
+    VERIFY( w[i] == 2 * (i % 5 + 1) );
+  v = v + v;
+  for (int i = 0; i < n; ++i)
+    VERIFY( v[i] == 2 * (i * 7 + 1 - (i % 5 + 1)) );
+}
+
+// Comparisons keep the generic evaluation.
+void test03()
+{
+  bool test __attribute__((unused)) = true;
+
+  std::valarray<int> v(5), w(5);
+  for (int i = 0; i < 5; ++i)
+    {
+      v[i] = i;
+      w[i] = 4 - i;
+    }
+  std::valarray<bool> b(v < w);
+  for (int i = 0; i < 5; ++i)
+    VERIFY( b[i] == (i < 4 - i) );
+  b = v == 2;
+  for (int i = 0; i < 5; ++i)
+    VERIFY( b[i] == (i == 2) );
+}
+
+int main()
+{
+  test01();
+  test02();
+  test03();
+  return 0;
+}
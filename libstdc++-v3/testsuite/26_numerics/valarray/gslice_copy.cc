@@ -0,0 +1,129 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// 26.3.6 gslice_array, 26.3.5 slice_array: copies to and from
+// valarrays, whose elements may be moved by blocks.
+
+#include <valarray>
+#include <testsuite_hooks.h>
+
+// The positions of the n elements of gs, last dimension fastest.
+std::valarray<size_t>
+positions(const std::gslice& gs, size_t n)
+{
+  std::valarray<size_t> len = gs.size();
+  std::valarray<size_t> str = gs.stride();
+  std::valarray<size_t> idx(size_t(0), len.size());
+  std::valarray<size_t> pos(n);
+  for (size_t k = 0; k < n; ++k)
+    {
+      pos[k] = gs.start();
+      for (size_t d = 0; d < len.size(); ++d)
+	pos[k] += idx[d] * str[d];
+      for (size_t d = len.size(); d-- > 0; )
+	if (++idx[d] < len[d])
+	  break;
+	else
+	  idx[d] = 0;
+    }
+  return pos;
+}
+
+bool
+check(const std::valarray<int>& v, const std::gslice& gs,
+      const std::valarray<int>& a)
+{
+  std::valarray<size_t> pos = positions(gs, v.size());
+  for (size_t k = 0; k < v.size(); ++k)
+    if (v[k] != a[pos[k]])
+      return false;
+  return true;
+}
+
+void
+test(size_t start, size_t l0, size_t l1, size_t l2,
+     size_t s0, size_t s1, size_t s2)
+{
+  bool test __attribute__((unused)) = true;
+
+  std::valarray<int> a(1024);
+  for (size_t i = 0; i < a.size(); ++i)
+    a[i] = i;
+
+  size_t l[] = { l0, l1, l2 };
+  size_t s[] = { s0, s1, s2 };
+  const std::gslice gs(start, std::valarray<size_t>(l, 3),
+		       std::valarray<size_t>(s, 3));
+
+  // valarray(const gslice_array&)
+  std::valarray<int> v = a[gs];
+  VERIFY( v.size() == l0 * l1 * l2 );
+  VERIFY( check(v, gs, a) );
+
+  // valarray::operator=(const gslice_array&)
+  std::valarray<int> w(v.size());
+  w = a[gs];
+  VERIFY( check(w, gs, a) );
+
+  // gslice_array::operator=(const valarray&)
+  std::valarray<int> b(-1, a.size());
+  for (size_t i = 0; i < w.size(); ++i)
+    w[i] = 2000 + i;
+  b[gs] = w;
+  // Where the gslice overlaps itself, the last element stored wins.
+  std::valarray<int> e(-1, a.size());
+  std::valarray<size_t> pos = positions(gs, w.size());
+  for (size_t i = 0; i < w.size(); ++i)
+    e[pos[i]] = w[i];
+  for (size_t i = 0; i < b.size(); ++i)
+    VERIFY( b[i] == e[i] );
+  std::valarray<int> c = b[gs];
+  VERIFY( c.size() == w.size() );
+  VERIFY( check(c, gs, b) );
+}
+
+int main()
+{
+  // Contiguous blocks of several lengths.
+  test(3, 2, 4, 16, 300, 20, 1);
+  test(0, 3, 5, 9, 100, 10, 1);
+  test(1, 2, 2, 24, 200, 24, 1);	// fully contiguous
+  test(5, 4, 3, 8, 100, 8, 1);		// contiguous pairs of dimensions
+  // Overlapping and degenerate blocks.
+  test(0, 4, 10, 10, 0, 5, 1);
+  test(7, 2, 3, 12, 0, 0, 1);
+  // Short or strided blocks.
+  test(0, 4, 8, 3, 100, 10, 1);
+  test(2, 4, 8, 10, 100, 1, 3);
+  test(0, 8, 8, 8, 64, 8, 1);
+
+  // slice_array with stride 1.
+  bool test __attribute__((unused)) = true;
+  std::valarray<int> a(100);
+  for (size_t i = 0; i < a.size(); ++i)
+    a[i] = i;
+  std::valarray<int> v = a[std::slice(10, 50, 1)];
+  for (size_t i = 0; i < v.size(); ++i)
+    VERIFY( v[i] == int(10 + i) );
+  a[std::slice(20, 50, 1)] = v;
+  for (size_t i = 0; i < 50; ++i)
+    VERIFY( a[20 + i] == int(10 + i) );
+  a[std::slice(0, 10, 1)] = 7;
+  VERIFY( a[0] == 7 && a[9] == 7 && a[10] == 10 );
+  return 0;
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// 26.3.2.7 valarray member functions: sum, min, max.
+
+#include <valarray>
+#include <testsuite_hooks.h>
+
+// All the sizes around the unrolled loops, with the extremum at
+// every position.
+void test01()
+{
+  bool test __attribute__((unused)) = true;
+
+  for (int n = 1; n < 20; ++n)
+    for (int pos = 0; pos < n; ++pos)
+      {
+	std::valarray<int> v(n);
+	for (int i = 0; i < n; ++i)
+	  v[i] = (i * 7) % 5 + 10;
+	int sum = 0;
+	for (int i = 0; i < n; ++i)
+	  sum += v[i];
+
+	VERIFY( v.sum() == sum );
+	VERIFY( (v + 1).sum() == sum + n );
+
+	v[pos] = -3;
+	VERIFY( v.min() == -3 );
+	VERIFY( (v * 2).min() == -6 );
+	v[pos] = 42;
+	VERIFY( v.max() == 42 );
+	VERIFY( (v * 2).max() == 84 );
+      }
+}
+
+// Types which are not arithmetic.
+struct num
+{
+  int i;
+  num(int __i = 0) : i(__i) { }
+  num& operator+=(const num& __n) { i += __n.i; return *this; }
+};
+
+bool operator<(const num& __m, const num& __n) { return __m.i < __n.i; }
+bool operator>(const num& __m, const num& __n) { return __m.i > __n.i; }
+
+void test02()
+{
+  bool test __attribute__((unused)) = true;
+
+  std::valarray<num> v(11);
+  for (int i = 0; i < 11; ++i)
+    v[i] = num(i - 5);
+  VERIFY( v.sum().i == 0 );
+  VERIFY( v.min().i == -5 );
+  VERIFY( v.max().i == 5 );
+}
+
+int main()
+{
+  test01();
+  test02();
+  return 0;
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// 27.8.1.4 Overridden virtual functions
+
+#include <locale>
+#include <fstream>
+#include <string>
+#include <testsuite_hooks.h>
+
+// sgetn and sputn of more than a buffer convert to and from the
+// caller's array: the position seen by seekoff must not be affected.
+void test01()
+{
+  using namespace std;
+
+  bool test __attribute__((unused)) = true;
+  const char* name = "tmp_seekoff_4";
+
+  locale loc = __gnu_test::try_named_locale("en_US.UTF-8");
+
+  wstring str;
+  for (int i = 0; i < 30000; ++i)
+    str += i % 3 == 0 ? L'a' + i % 26 : i % 3 == 1 ? 0xe9 : 0x4e2d;
+
+  wfilebuf fbout;
+  fbout.pubimbue(loc);
+  fbout.open(name, ios_base::out | ios_base::trunc);
+  VERIFY( fbout.sputn(str.data(), 5) == 5 );
+  VERIFY( fbout.sputn(str.data() + 5, str.size() - 5)
+	  == streamsize(str.size() - 5) );
+  fbout.close();
+
+  wstring got(str.size(), L'?');
+  wfilebuf fbin;
+  fbin.pubimbue(loc);
+  fbin.open(name, ios_base::in | ios_base::out);
+  VERIFY( fbin.sgetn(&got[0], 1) == 1 );
+  VERIFY( fbin.sgetn(&got[1], 20000) == 20000 );
+  const streampos pos = fbin.pubseekoff(0, ios_base::cur);
+  VERIFY( pos != streampos(streamoff(-1)) );
+  VERIFY( fbin.sgetn(&got[20001], 10) == 10 );
+  VERIFY( fbin.pubseekpos(pos) == pos );
+  VERIFY( fbin.sgetn(&got[20001], str.size())
+	  == streamsize(str.size() - 20001) );
+  VERIFY( got == str );
+
+  // Overwrite from the saved position, then read back.
+  const wstring rep(20000, 0x4e2d);
+  VERIFY( fbin.pubseekpos(pos) == pos );
+  VERIFY( fbin.sputn(rep.data(), rep.size()) == streamsize(rep.size()) );
+  VERIFY( fbin.pubseekpos(pos) == pos );
+  wstring back(rep.size(), L'?');
+  VERIFY( fbin.sgetn(&back[0], back.size()) == streamsize(back.size()) );
+  VERIFY( back == rep );
+}
+
+int main()
+{
+  test01();
+  return 0;
+}
@@ -0,0 +1,121 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// { dg-do run { target *-*-freebsd* *-*-netbsd* *-*-linux* *-*-solaris* *-*-cygwin *-*-darwin* alpha*-*-osf* } }
+// { dg-options "-pthread" { target *-*-freebsd* *-*-netbsd* *-*-linux* alpha*-*-osf* } }
+// { dg-options "-pthreads" { target *-*-solaris* } }
+
+#include <ext/bitmap_allocator.h>
+#include <testsuite_hooks.h>
+
+// Do not include <pthread.h> explicitly; if threads are properly
+// configured for the port, then it is picked up free from STL headers.
+
+#if __GTHREADS
+
+typedef __gnu_cxx::bitmap_allocator<int> allocator_type;
+
+const int count = 5000;
+int* blocks[count];
+
+inline int
+block_size(int i)
+{ return 1 + i % 8; }
+
+void
+fill_blocks(int tag)
+{
+  allocator_type a;
+  for (int i = 0; i < count; ++i)
+    {
+      blocks[i] = a.allocate(block_size(i));
+      for (int j = 0; j < block_size(i); ++j)
+	blocks[i][j] = tag + i;
+    }
+}
+
+void
+check_blocks(int tag)
+{
+  bool test __attribute__((unused)) = true;
+
+  for (int i = 0; i < count; ++i)
+    for (int j = 0; j < block_size(i); ++j)
+      VERIFY( blocks[i][j] == tag + i );
+}
+
+void*
+free_blocks(void*)
+{
+  check_blocks(0);
+  allocator_type a;
+  for (int i = 0; i < count; ++i)
+    a.deallocate(blocks[i], block_size(i));
+  return 0;
+}
+
+void*
+alloc_blocks(void*)
+{
+  fill_blocks(count);
+  return 0;
+}
+
+// Blocks freed by another thread than the one which allocated them.
+void test01()
+{
+  allocator_type a;
+  for (int n = 0; n < 4; ++n)
+    {
+      fill_blocks(0);
+      pthread_t t;
+      pthread_create(&t, 0, free_blocks, 0);
+      pthread_join(t, 0);
+    }
+
+  // The blocks freed by the thread go back to this one.
+  fill_blocks(0);
+  check_blocks(0);
+  for (int i = 0; i < count; ++i)
+    a.deallocate(blocks[i], block_size(i));
+}
+
+// Blocks freed after the thread which allocated them has exited.
+void test02()
+{
+  allocator_type a;
+  for (int n = 0; n < 20; ++n)
+    {
+      pthread_t t;
+      pthread_create(&t, 0, alloc_blocks, 0);
+      pthread_join(t, 0);
+      check_blocks(count);
+      for (int i = 0; i < count; ++i)
+	a.deallocate(blocks[i], block_size(i));
+    }
+}
+
+int main()
+{
+  test01();
+  test02();
+  return 0;
+}
+#else
+int main (void) { return 0; }
+#endif
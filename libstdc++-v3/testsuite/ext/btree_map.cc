@@ -0,0 +1,188 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+
+// btree_map (GNU extension)
+
+#include <ext/btree_map>
+#include <map>
+#include <vector>
+#include <cstdlib>
+#include <testsuite_hooks.h>
+
+// Mixed inserts, lookups and erasures, checked against std::map.
+void
+test01()
+{
+  bool test __attribute__((unused)) = true;
+  __gnu_cxx::btree_map<int, int> m;
+  std::map<int, int> ref;
+
+  std::srand(5);
+  for (int i = 0; i < 100000; ++i)
+    {
+      const int k = std::rand() % 3000;
+      switch (std::rand() % 4)
+	{
+	case 0:
+	case 1:
+	  m[k] += i;
+	  ref[k] += i;
+	  break;
+	case 2:
+	  VERIFY( m.erase(k) == ref.erase(k) );
+	  break;
+	default:
+	  VERIFY( m.count(k) == ref.count(k) );
+	  if (ref.count(k))
+	    VERIFY( m.find(k)->second == ref[k] );
+	}
+      VERIFY( m.size() == ref.size() );
+    }
+
+  std::map<int, int>::iterator r = ref.begin();
+  for (__gnu_cxx::btree_map<int, int>::iterator it = m.begin();
+       it != m.end(); ++it, ++r)
+    VERIFY( it->first == r->first && it->second == r->second );
+  VERIFY( r == ref.end() );
+
+  m.clear();
+  VERIFY( m.empty() && m.begin() == m.end() );
+  m[1] = 2;
+  VERIFY( m.size() == 1 && m[1] == 2 );
+}
+
+// Bulk build from sorted ranges of every size up to a few levels,
+// and fallback on unsorted or duplicate keys.
+void
+test02()
+{
+  bool test __attribute__((unused)) = true;
+  typedef __gnu_cxx::btree_map<int, int> map_type;
+  typedef std::pair<int, int> pair_type;
+
+  for (int n = 0; n < 70; ++n)
+    {
+      std::vector<pair_type> v;
+      for (int i = 0; i < n; ++i)
+	v.push_back(pair_type(2 * i, i));
+      map_type m(v.begin(), v.end());
+      VERIFY( m.size() == v.size() );
+      for (int i = 0; i < n; ++i)
+	{
+	  VERIFY( m.find(2 * i)->second == i );
+	  VERIFY( m.find(2 * i + 1) == m.end() );
+	}
+      // The tree must stay usable for ordinary updates.
+      for (int i = 0; i < n; ++i)
+	m[2 * i + 1] = -i;
+      for (int i = 0; i < n; i += 2)
+	m.erase(2 * i);
+      VERIFY( m.size() == std::size_t(n + n / 2) );
+      int prev = -1;
+      for (map_type::iterator it = m.begin(); it != m.end(); ++it)
+	{
+	  VERIFY( it->first > prev );
+	  prev = it->first;
+	}
+    }
+
+  std::vector<pair_type> v;
+  v.push_back(pair_type(3, 0));
+  v.push_back(pair_type(1, 1));
+  v.push_back(pair_type(3, 2));
+  v.push_back(pair_type(2, 3));
+  map_type m(v.begin(), v.end());
+  VERIFY( m.size() == 3 );
+  VERIFY( m[3] == 0 && m[1] == 1 && m[2] == 3 );
+}
+
+void
+test03()
+{
+  bool test __attribute__((unused)) = true;
+  typedef __gnu_cxx::btree_map<int, int> map_type;
+  map_type m1;
+  for (int i = 0; i < 1000; ++i)
+    m1.insert(map_type::value_type(i, i));
+
+  map_type m2(m1);
+  VERIFY( m2 == m1 );
+  m2.begin()->second++;
+  VERIFY( m2 != m1 );
+  m2 = m1;
+  VERIFY( m2 == m1 );
+
+  map_type m3;
+  m3[-1] = 0;
+  map_type::iterator it = m1.find(10);
+  m3.swap(m1);
+  VERIFY( m1.size() == 1 && m3.size() == 1000 );
+  VERIFY( it->second == 10 && m3.find(10) == it );
+  m1.clear();
+  m3.erase(m3.begin(), m3.find(500));
+  VERIFY( m3.size() == 500 && m3.begin()->first == 500 );
+  for (int i = 0; i < 500; ++i)
+    m3[i] = i;
+  VERIFY( m3 == m2 );
+}
+
+// Erasing invalidates only the iterators to the erased elements,
+// down to empty leaves; reverse iteration crosses the leaves.
+void
+test04()
+{
+  bool test __attribute__((unused)) = true;
+  typedef __gnu_cxx::btree_map<int, int> map_type;
+  map_type m;
+  for (int i = 0; i < 5000; ++i)
+    m[i] = i;
+
+  int n = 0;
+  for (map_type::iterator it = m.begin(); it != m.end(); ++n)
+    if (it->first % 7)
+      m.erase(it++);
+    else
+      ++it;
+  VERIFY( n == 5000 );
+  VERIFY( m.size() == 715 );
+
+  int k = 4998;
+  for (map_type::reverse_iterator it = m.rbegin(); it != m.rend(); ++it)
+    {
+      VERIFY( it->first == k && it->second == k );
+      k -= 7;
+    }
+  VERIFY( k == -7 );
+
+  while (!m.empty())
+    m.erase(m.begin());
+  VERIFY( m.begin() == m.end() );
+  m[3] = 4;
+  VERIFY( m.size() == 1 && m.begin()->second == 4 );
+}
+
+int
+main()
+{
+  test01();
+  test02();
+  test03();
+  test04();
+  return 0;
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+
+// btree_set (GNU extension)
+
+#include <ext/btree_set>
+#include <set>
+#include <string>
+#include <cstdlib>
+#include <testsuite_hooks.h>
+
+// Mixed inserts, lookups and erasures, checked against std::set.
+void
+test01()
+{
+  bool test __attribute__((unused)) = true;
+  __gnu_cxx::btree_set<std::string> s;
+  std::set<std::string> ref;
+
+  std::srand(7);
+  for (int i = 0; i < 50000; ++i)
+    {
+      std::string k(1 + std::rand() % 3, 'a' + std::rand() % 10);
+      k += char('a' + std::rand() % 26);
+      switch (std::rand() % 3)
+	{
+	case 0:
+	  VERIFY( s.insert(k).second == ref.insert(k).second );
+	  break;
+	case 1:
+	  VERIFY( s.erase(k) == ref.erase(k) );
+	  break;
+	default:
+	  VERIFY( s.count(k) == ref.count(k) );
+	  VERIFY( (s.lower_bound(k) == s.end())
+		  == (ref.lower_bound(k) == ref.end()) );
+	}
+      VERIFY( s.size() == ref.size() );
+    }
+
+  __gnu_cxx::btree_set<std::string> s2(ref.begin(), ref.end());
+  VERIFY( s2 == s );
+  s2.clear();
+  VERIFY( s2.empty() && s2 < s );
+}
+
+int
+main()
+{
+  test01();
+  return 0;
+}
@@ -0,0 +1,60 @@
+// Copyright (C) 2005 Free Software Foundation
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+#include <cxxabi.h>
+#include <testsuite_hooks.h>
+
+// __gnu_cxx::__get_eh_alloc_stats
+void test01()
+{
+  bool test __attribute__((unused)) = true;
+  using __gnu_cxx::__eh_alloc_stats;
+  using __gnu_cxx::__get_eh_alloc_stats;
+
+  __eh_alloc_stats before;
+  __get_eh_alloc_stats(&before);
+  VERIFY( before.__emergency_obj_count > 0 );
+  VERIFY( before.__emergency_obj_size > 0 );
+  VERIFY( before.__emergency_in_use == 0 );
+
+  const int count = 10;
+  for (int i = 0; i < count; ++i)
+    {
+      try
+	{
+	  throw i;
+	}
+      catch(int)
+	{ }
+    }
+
+  __eh_alloc_stats after;
+  __get_eh_alloc_stats(&after);
+  VERIFY( after.__allocated - before.__allocated == count );
+
+  // Every exception but the first reuses the object freed by the
+  // previous one.
+  VERIFY( after.__cache_hits - before.__cache_hits >= count - 1 );
+  VERIFY( after.__emergency_in_use == 0 );
+}
+
+int main()
+{
+  test01();
+  return 0;
+}
@@ -24,19 +24,28 @@
 // subdirectory that are meant to be directly included.
 
 #include <ext/algorithm>
+#include <ext/btree_map>
+#include <ext/btree_set>
 #include <ext/functional>
 #include <ext/hash_map>
 #include <ext/hash_set>
 #include <ext/iterator>
 #include <ext/memory>
 #include <ext/numeric>
+#include <ext/open_hash_map>
+#include <ext/open_hash_set>
 #include <ext/rb_tree>
 #include <ext/rope>
+#include <ext/slab_map>
+#include <ext/slab_set>
 #include <ext/slist>
+#include <ext/sso_string.h>
 #include <ext/debug_allocator.h>
 #include <ext/malloc_allocator.h>
+#include <ext/mmap_filebuf.h>
 #include <ext/mt_allocator.h>
 #include <ext/pool_allocator.h>
+#include <ext/profile_allocator.h>
 #include <ext/stdio_filebuf.h>
 #include <ext/stdio_sync_filebuf.h>
 
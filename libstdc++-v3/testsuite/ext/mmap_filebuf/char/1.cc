@@ -0,0 +1,102 @@
+// Copyright (C) 2005 Free Software Foundation
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <ext/mmap_filebuf.h>
+#include <testsuite_hooks.h>
+
+const char name[] = "tmp_mmap_filebuf_1";
+const char str[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+const std::streamsize len = sizeof(str) - 1;
+
+void test01()
+{
+  using namespace std;
+  bool test __attribute__((unused)) = true;
+  typedef __gnu_cxx::mmap_filebuf<char> mmap_filebuf;
+
+  filebuf fbuf;
+  fbuf.open(name, ios_base::out | ios_base::trunc);
+  fbuf.sputn(str, len);
+  fbuf.close();
+
+  mmap_filebuf mbuf;
+  VERIFY( mbuf.open(name, ios_base::in) != 0 );
+  VERIFY( mbuf.in_avail() == len || !mbuf.is_mapped() );
+
+  VERIFY( mbuf.sbumpc() == '0' );
+  VERIFY( mbuf.sgetc() == '1' );
+  VERIFY( mbuf.sungetc() == '0' );
+  VERIFY( mbuf.sputbackc('x') == mmap_filebuf::traits_type::eof()
+	  || !mbuf.is_mapped() );
+
+  char buf[64];
+  VERIFY( mbuf.sgetn(buf, 10) == 10 );
+  VERIFY( !std::memcmp(buf, str, 10) );
+  VERIFY( mbuf.pubseekoff(0, ios_base::cur) == streampos(10) );
+  VERIFY( mbuf.pubseekoff(0, ios_base::cur, ios_base::in)
+	  == streampos(10) );
+  VERIFY( mbuf.pubseekoff(0, ios_base::end) == streampos(len) );
+  VERIFY( mbuf.pubseekoff(-3, ios_base::end) == streampos(len - 3) );
+  VERIFY( mbuf.sgetn(buf, 64) == 3 );
+  VERIFY( !std::memcmp(buf, str + len - 3, 3) );
+  VERIFY( mbuf.sgetc() == mmap_filebuf::traits_type::eof() );
+  VERIFY( mbuf.pubseekpos(5) == streampos(5) );
+  VERIFY( mbuf.sgetc() == '5' );
+
+  istream is(&mbuf);
+  string s;
+  is >> s;
+  VERIFY( s == str + 5 );
+
+  VERIFY( mbuf.close() != 0 );
+  VERIFY( !mbuf.is_mapped() );
+  VERIFY( !mbuf.is_open() );
+}
+
+// Output or empty files are not mapped.
+void test02()
+{
+  using namespace std;
+  bool test __attribute__((unused)) = true;
+  typedef __gnu_cxx::mmap_filebuf<char> mmap_filebuf;
+
+  mmap_filebuf mbuf;
+  mbuf.open(name, ios_base::in | ios_base::out | ios_base::trunc);
+  VERIFY( !mbuf.is_mapped() );
+  VERIFY( mbuf.sputn(str, len) == len );
+  VERIFY( mbuf.pubseekoff(0, ios_base::beg) == streampos(0) );
+  VERIFY( mbuf.sgetc() == '0' );
+  mbuf.close();
+
+  mbuf.open(name, ios_base::out | ios_base::trunc);
+  mbuf.close();
+  mbuf.open(name, ios_base::in);
+  VERIFY( !mbuf.is_mapped() );
+  VERIFY( mbuf.sgetc() == mmap_filebuf::traits_type::eof() );
+}
+
+int main()
+{
+  test01();
+  test02();
+  return 0;
+}
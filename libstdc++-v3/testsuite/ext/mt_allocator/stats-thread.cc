@@ -0,0 +1,121 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// { dg-do run { target *-*-freebsd* *-*-netbsd* *-*-linux* *-*-solaris* *-*-cygwin *-*-darwin* alpha*-*-osf* } }
+// { dg-options "-pthread" { target *-*-freebsd* *-*-netbsd* *-*-linux* alpha*-*-osf* } }
+// { dg-options "-pthreads" { target *-*-solaris* } }
+
+#include <ext/mt_allocator.h>
+#include <testsuite_hooks.h>
+
+// Do not include <pthread.h> explicitly; if threads are properly
+// configured for the port, then it is picked up free from STL headers.
+
+#if __GTHREADS
+
+typedef __gnu_cxx::__per_type_pool_policy<int, true> policy_type;
+typedef __gnu_cxx::__mt_alloc<int, policy_type> allocator_type;
+typedef __gnu_cxx::__pool_base::_Stats stats_type;
+
+const int count = 5000;
+int* blocks[count];
+
+void*
+free_blocks(void*)
+{
+  allocator_type a;
+  for (int i = 0; i < count; ++i)
+    a.deallocate(blocks[i], 1 + i % 8);
+  return 0;
+}
+
+void*
+alloc_free_blocks(void*)
+{
+  allocator_type a;
+  int* local[count];
+  for (int i = 0; i < count; ++i)
+    local[i] = a.allocate(1 + i % 8);
+  for (int i = 0; i < count; ++i)
+    a.deallocate(local[i], 1 + i % 8);
+  return 0;
+}
+
+// Blocks freed by another thread than the one which allocated them.
+void test01()
+{
+  bool test __attribute__((unused)) = true;
+
+  allocator_type a;
+  for (int i = 0; i < count; ++i)
+    blocks[i] = a.allocate(1 + i % 8);
+
+  stats_type s1 = a._M_get_stats();
+  VERIFY( s1._M_allocs >= static_cast<size_t>(count) );
+
+  pthread_t t;
+  pthread_create(&t, 0, free_blocks, 0);
+  pthread_join(t, 0);
+
+  stats_type s2 = a._M_get_stats();
+  VERIFY( s2._M_allocs == s1._M_allocs );
+  VERIFY( s2._M_remote_frees - s1._M_remote_frees
+	  == static_cast<size_t>(count) );
+
+  // The blocks freed by the thread, which has exited, are handed out
+  // again.
+  for (int i = 0; i < count; ++i)
+    blocks[i] = a.allocate(1 + i % 8);
+  for (int i = 0; i < count; ++i)
+    a.deallocate(blocks[i], 1 + i % 8);
+
+  stats_type s3 = a._M_get_stats();
+  VERIFY( s3._M_allocs - s2._M_allocs == static_cast<size_t>(count) );
+  VERIFY( s3._M_remote_frees == s2._M_remote_frees );
+}
+
+// Many short lived threads.
+void test02()
+{
+  bool test __attribute__((unused)) = true;
+
+  allocator_type a;
+  stats_type s1 = a._M_get_stats();
+
+  for (int i = 0; i < 20; ++i)
+    {
+      pthread_t t[4];
+      for (int j = 0; j < 4; ++j)
+	pthread_create(&t[j], 0, alloc_free_blocks, 0);
+      for (int j = 0; j < 4; ++j)
+	pthread_join(t[j], 0);
+    }
+
+  stats_type s2 = a._M_get_stats();
+  VERIFY( s2._M_allocs - s1._M_allocs == static_cast<size_t>(80 * count) );
+}
+
+int main()
+{
+  test01();
+  test02();
+  return 0;
+}
+#else
+int main (void) { return 0; }
+#endif
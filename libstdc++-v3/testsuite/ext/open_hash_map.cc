@@ -0,0 +1,98 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// open_hash_map (GNU extension)
+
+#include <ext/open_hash_map>
+#include <map>
+#include <cstdlib>
+#include <testsuite_hooks.h>
+
+// Mixed inserts, lookups and erasures, checked against std::map.  The
+// keys are multiples of 1024, which all share the low bits.
+void
+test01()
+{
+  bool test __attribute__((unused)) = true;
+  __gnu_cxx::open_hash_map<int, int> m;
+  std::map<int, int> ref;
+
+  std::srand(3);
+  for (int i = 0; i < 200000; ++i)
+    {
+      const int k = (std::rand() % 5000) * 1024;
+      switch (std::rand() % 4)
+	{
+	case 0:
+	case 1:
+	  m[k] += i;
+	  ref[k] += i;
+	  break;
+	case 2:
+	  VERIFY( m.erase(k) == ref.erase(k) );
+	  break;
+	default:
+	  VERIFY( m.count(k) == ref.count(k) );
+	  if (ref.count(k))
+	    VERIFY( m.find(k)->second == ref[k] );
+	}
+      VERIFY( m.size() == ref.size() );
+    }
+
+  std::map<int, int>::size_type n = 0;
+  for (__gnu_cxx::open_hash_map<int, int>::iterator it = m.begin();
+       it != m.end(); ++it, ++n)
+    VERIFY( ref[it->first] == it->second );
+  VERIFY( n == ref.size() );
+}
+
+void
+test02()
+{
+  bool test __attribute__((unused)) = true;
+  typedef __gnu_cxx::open_hash_map<int, int> map_type;
+  map_type m1;
+  for (int i = 0; i < 1000; ++i)
+    m1.insert(map_type::value_type(i, i));
+
+  map_type m2(m1);
+  VERIFY( m2 == m1 );
+  m2.begin()->second++;
+  VERIFY( m2 != m1 );
+  m2 = m1;
+  VERIFY( m2 == m1 );
+  m2.erase(m2.begin(), m2.end());
+  VERIFY( m2.empty() );
+
+  // Erasing leaves the other elements where they were.
+  map_type::iterator it = m1.find(500);
+  m1.erase(499);
+  m1.erase(501);
+  VERIFY( it->first == 500 );
+
+  m1.resize(100000);
+  VERIFY( m1.bucket_count() >= 100000 );
+  VERIFY( m1.size() == 998 );
+}
+
+int main()
+{
+  test01();
+  test02();
+  return 0;
+}
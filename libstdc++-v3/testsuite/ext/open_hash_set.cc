@@ -0,0 +1,79 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// open_hash_set (GNU extension)
+
+#include <ext/open_hash_set>
+#include <string>
+#include <sstream>
+#include <iterator>
+#include <testsuite_hooks.h>
+
+struct string_hash
+{
+  std::size_t
+  operator()(const std::string& s) const
+  { return __gnu_cxx::hash<const char*>()(s.c_str()); }
+};
+
+void
+test01()
+{
+  bool test __attribute__((unused)) = true;
+  typedef __gnu_cxx::open_hash_set<std::string, string_hash> set_type;
+  set_type s;
+
+  for (int i = 0; i < 10000; ++i)
+    {
+      std::ostringstream oss;
+      oss << 'k' << i % 3000;
+      s.insert(oss.str());
+    }
+  VERIFY( s.size() == 3000 );
+
+  std::insert_iterator<set_type> ii(s, s.begin());
+  *ii = "new";
+  VERIFY( s.count("new") == 1 );
+  VERIFY( s.count("k2999") == 1 );
+  VERIFY( s.count("k3000") == 0 );
+
+  set_type s2(s.begin(), s.end());
+  VERIFY( s2 == s );
+  s.swap(s2);
+  s.clear();
+  VERIFY( s.empty() );
+  VERIFY( s2.size() == 3001 );
+
+  // Erasing and reinserting reuses the deleted slots.
+  for (int i = 0; i < 3000; ++i)
+    {
+      std::ostringstream oss;
+      oss << 'k' << i;
+      s2.erase(oss.str());
+      s2.insert(oss.str());
+      s2.erase(oss.str());
+    }
+  VERIFY( s2.size() == 1 );
+  VERIFY( *s2.begin() == "new" );
+}
+
+int main()
+{
+  test01();
+  return 0;
+}
@@ -0,0 +1,113 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+#include <vector>
+#include <list>
+#include <cstdio>
+#include <cstring>
+#include <ext/profile_allocator.h>
+#include <testsuite_hooks.h>
+
+typedef __gnu_cxx::__profile_table<0> table_type;
+typedef __gnu_cxx::__profile_record record_type;
+
+const record_type*
+find_record(const std::type_info& type)
+{
+  for (size_t i = 0; i < table_type::_S_size; ++i)
+    if (table_type::_S_records[i]._M_type
+	&& *table_type::_S_records[i]._M_type == type)
+      return table_type::_S_records + i;
+  return 0;
+}
+
+// The growth of a vector.
+void test01()
+{
+  bool test __attribute__((unused)) = true;
+  typedef __gnu_cxx::profile_allocator<std::allocator<int> > allocator_type;
+
+  {
+    std::vector<int, allocator_type> v;
+    for (int i = 0; i < 1000; ++i)
+      v.push_back(i);
+
+    const record_type* r = find_record(typeid(int));
+    VERIFY( r != 0 );
+    VERIFY( r->_M_allocs > 1 );
+    VERIFY( r->_M_live_bytes == v.capacity() * sizeof(int) );
+    VERIFY( r->_M_max_request == v.capacity() );
+    VERIFY( r->_M_regrowths == r->_M_allocs - 1 );
+  }
+
+  const record_type* r = find_record(typeid(int));
+  VERIFY( r->_M_deallocs == r->_M_allocs );
+  VERIFY( r->_M_live_bytes == 0 );
+  VERIFY( r->_M_peak_bytes >= 1000 * sizeof(int) );
+}
+
+// The nodes of a list, rebound by the container.
+void test02()
+{
+  bool test __attribute__((unused)) = true;
+  typedef __gnu_cxx::profile_allocator<std::allocator<long> > allocator_type;
+  typedef std::list<long, allocator_type> list_type;
+
+  list_type l(100, 1L);
+  const record_type* r = find_record(typeid(std::_List_node<long>));
+  VERIFY( r != 0 );
+  VERIFY( r->_M_allocs == 100 );
+  VERIFY( r->_M_sizes[0] == 100 );
+  VERIFY( r->_M_peak_bytes == 100 * sizeof(std::_List_node<long>) );
+
+  l.clear();
+  VERIFY( r->_M_deallocs == 100 );
+  VERIFY( r->_M_regrowths == 0 );
+}
+
+// The report.
+void test03()
+{
+  bool test __attribute__((unused)) = true;
+
+  std::FILE* f = std::tmpfile();
+  VERIFY( f != 0 );
+  __gnu_cxx::__profile_report(f);
+  std::rewind(f);
+  char buf[1024];
+  int lines = 0;
+  bool found = false;
+  while (std::fgets(buf, sizeof(buf), f))
+    {
+      ++lines;
+      if (std::strstr(buf, "std::_List_node<long>"))
+	found = true;
+    }
+  std::fclose(f);
+  VERIFY( found );
+  // The header, then two lines per record.
+  VERIFY( lines >= 5 );
+}
+
+int main()
+{
+  test01();
+  test02();
+  test03();
+  return 0;
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// sso_string (GNU extension)
+
+#include <ext/sso_string.h>
+#include <sstream>
+#include <testsuite_hooks.h>
+
+void
+test01()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  // Short values live in the object; copies are independent.
+  sso_string s1("short");
+  sso_string s2(s1);
+  VERIFY( s1.data() != s2.data() );
+  s2[0] = 'S';
+  VERIFY( s1 == "short" );
+  VERIFY( s2 == "Short" );
+
+  // Growing past the inline capacity, and back again.
+  sso_string s3(s1);
+  for (int i = 0; i < 10; ++i)
+    s3 += s1;
+  VERIFY( s3.size() == 55 );
+  VERIFY( s3.capacity() >= 55 );
+  VERIFY( s3.find("shortshort", 40) == 40 );
+  s3.erase(5);
+  VERIFY( s3 == s1 );
+  s3.reserve();
+  VERIFY( s3 == s1 );
+
+  // Self-referencing replace.
+  sso_string s4("abcdef");
+  s4.replace(1, 2, s4.c_str(), 4);
+  VERIFY( s4 == "aabcddef" );
+  s4.insert(0, s4);
+  VERIFY( s4 == "aabcddefaabcddef" );
+
+  // Swap between inline and allocated values.
+  sso_string s5("a value that does not fit inline");
+  sso_string s6("tiny");
+  s5.swap(s6);
+  VERIFY( s5 == "tiny" );
+  VERIFY( s6 == "a value that does not fit inline" );
+  s5.swap(s6);
+  VERIFY( s6 == "tiny" );
+
+  // Swap of an empty and a non-empty inline value, both ways.
+  sso_string s7, s8("eaa");
+  s7.swap(s8);
+  VERIFY( s7 == "eaa" );
+  VERIFY( s8.size() == 0 );
+  VERIFY( s8.c_str()[0] == '\0' );
+  s7.swap(s8);
+  VERIFY( s7.size() == 0 );
+  VERIFY( s7.c_str()[0] == '\0' );
+  VERIFY( s8 == "eaa" );
+}
+
+void
+test02()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  std::ostringstream oss;
+  oss.width(6);
+  oss << sso_string("ab") << '|';
+  VERIFY( oss.str() == "    ab|" );
+
+  std::istringstream iss("one two\nthree");
+  sso_string s;
+  iss >> s;
+  VERIFY( s == "one" );
+  getline(iss, s);
+  VERIFY( s == " two" );
+  getline(iss, s);
+  VERIFY( s == "three" );
+}
+
+int main()
+{
+  test01();
+  test02();
+  return 0;
+}
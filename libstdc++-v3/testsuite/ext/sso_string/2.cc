@@ -0,0 +1,109 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// sso_string (GNU extension)
+
+#include <ext/sso_string.h>
+#include <string>
+#include <testsuite_hooks.h>
+
+// Values of every length from empty to well past the inline capacity.
+std::string
+make_value(std::size_t len, char first)
+{
+  std::string s;
+  for (std::size_t i = 0; i < len; ++i)
+    s += char(first + i % 26);
+  return s;
+}
+
+bool
+same(const __gnu_cxx::sso_string& s, const std::string& ref)
+{
+  return (s.size() == ref.size()
+	  && std::string(s.c_str()) == ref
+	  && std::string(s.data(), s.size()) == ref);
+}
+
+// swap, member and non-member, between every combination of inline,
+// allocated and empty values.
+void
+test01()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  for (std::size_t i = 0; i <= 40; ++i)
+    for (std::size_t j = 0; j <= 40; ++j)
+      {
+	const std::string ri = make_value(i, 'a');
+	const std::string rj = make_value(j, 'A');
+	sso_string si(ri.c_str());
+	sso_string sj(rj.c_str());
+
+	si.swap(sj);
+	VERIFY( same(si, rj) );
+	VERIFY( same(sj, ri) );
+
+	swap(si, sj);
+	VERIFY( same(si, ri) );
+	VERIFY( same(sj, rj) );
+
+	// The values keep working after the swap.
+	si += 'x';
+	sj += 'y';
+	VERIFY( same(si, ri + 'x') );
+	VERIFY( same(sj, rj + 'y') );
+      }
+}
+
+// swap of a string with itself, and of strings that were shrunk, so
+// that stale characters lie past the terminator.
+void
+test02()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  sso_string s1("self");
+  s1.swap(s1);
+  VERIFY( s1 == "self" );
+
+  sso_string s2("stale chars");
+  s2.erase(3);
+  sso_string s3;
+  s3.swap(s2);
+  VERIFY( s3 == "sta" );
+  VERIFY( s2.empty() );
+  VERIFY( s2.c_str()[0] == '\0' );
+
+  sso_string s4("0123456789abcdefghij");
+  s4.clear();
+  sso_string s5("xy");
+  s4.swap(s5);
+  VERIFY( s4 == "xy" );
+  VERIFY( s5.empty() );
+  VERIFY( s5.c_str()[0] == '\0' );
+}
+
+int main()
+{
+  test01();
+  test02();
+  return 0;
+}
@@ -0,0 +1,157 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// sso_string (GNU extension)
+
+#include <ext/sso_string.h>
+#include <stdexcept>
+#include <testsuite_hooks.h>
+
+// Constructors and assignment.
+void
+test01()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  sso_string s1;
+  VERIFY( s1.empty() );
+  VERIFY( s1.size() == 0 );
+  VERIFY( s1.c_str()[0] == '\0' );
+
+  sso_string s2("0123456789abcdefghijklmnop");
+  sso_string s3(s2, 10);
+  VERIFY( s3 == "abcdefghijklmnop" );
+  sso_string s4(s2, 10, 3);
+  VERIFY( s4 == "abc" );
+  sso_string s5(s2.c_str(), 5);
+  VERIFY( s5 == "01234" );
+  sso_string s6(20, 'z');
+  VERIFY( s6.size() == 20 );
+  VERIFY( s6.find_first_not_of('z') == sso_string::npos );
+  sso_string s7(s2.begin() + 2, s2.begin() + 6);
+  VERIFY( s7 == "2345" );
+
+  try
+    {
+      sso_string s8(s2, s2.size() + 1);
+      VERIFY( false );
+    }
+  catch (std::out_of_range&)
+    { }
+
+  // Assignment between short and long values, and from parts of self.
+  s1 = s2;
+  VERIFY( s1 == s2 );
+  VERIFY( s1.data() != s2.data() );
+  s1 = "short";
+  VERIFY( s1 == "short" );
+  s1 = 'c';
+  VERIFY( s1 == "c" );
+  s1.assign(s2, 20, sso_string::npos);
+  VERIFY( s1 == "klmnop" );
+  s1.assign(s1.c_str() + 2, 3);
+  VERIFY( s1 == "mno" );
+  s2.assign(s2.c_str() + 1, 20);
+  VERIFY( s2 == "123456789abcdefghijk" );
+  s2.assign(4, 'q');
+  VERIFY( s2 == "qqqq" );
+  s2 = s2;
+  VERIFY( s2 == "qqqq" );
+}
+
+// Capacity.
+void
+test02()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  sso_string s1;
+  const sso_string::size_type local = s1.capacity();
+  VERIFY( local >= 15 );
+
+  s1.reserve(100);
+  VERIFY( s1.capacity() >= 100 );
+  VERIFY( s1.empty() );
+  s1 = "abc";
+  s1.reserve();
+  VERIFY( s1 == "abc" );
+  VERIFY( s1.capacity() == local );
+
+  s1.resize(30, 'x');
+  VERIFY( s1.size() == 30 );
+  VERIFY( s1.substr(0, 4) == "abcx" );
+  VERIFY( s1[29] == 'x' );
+  s1.resize(2);
+  VERIFY( s1 == "ab" );
+  VERIFY( s1.c_str()[2] == '\0' );
+  s1.resize(4);
+  VERIFY( s1.size() == 4 );
+  VERIFY( s1[3] == '\0' );
+
+  s1.clear();
+  VERIFY( s1.empty() );
+  VERIFY( s1.c_str()[0] == '\0' );
+
+  try
+    {
+      s1.reserve(s1.max_size() + 1);
+      VERIFY( false );
+    }
+  catch (std::length_error&)
+    { }
+}
+
+// Element access.
+void
+test03()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  sso_string s1("element access");
+  const sso_string& cs1 = s1;
+  VERIFY( s1[0] == 'e' );
+  VERIFY( cs1[cs1.size()] == '\0' );
+  VERIFY( s1.at(8) == 'a' );
+  s1.at(0) = 'E';
+  VERIFY( s1 == "Element access" );
+  try
+    {
+      cs1.at(cs1.size());
+      VERIFY( false );
+    }
+  catch (std::out_of_range&)
+    { }
+
+  sso_string::size_type n = 0;
+  for (sso_string::const_iterator i = cs1.begin(); i != cs1.end(); ++i)
+    ++n;
+  VERIFY( n == s1.size() );
+  VERIFY( *s1.rbegin() == 's' );
+  VERIFY( *(s1.rend() - 1) == 'E' );
+}
+
+int main()
+{
+  test01();
+  test02();
+  test03();
+  return 0;
+}
@@ -0,0 +1,174 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// sso_string (GNU extension)
+
+#include <ext/sso_string.h>
+#include <string>
+#include <testsuite_hooks.h>
+
+// The modifiers must agree with std::string, for values on both sides
+// of the inline capacity and for arguments that alias the string.
+
+std::string
+make_value(std::size_t len)
+{
+  std::string s;
+  for (std::size_t i = 0; i < len; ++i)
+    s += char('a' + i % 26);
+  return s;
+}
+
+bool
+same(const __gnu_cxx::sso_string& s, const std::string& ref)
+{
+  return (s.size() == ref.size()
+	  && std::string(s.c_str()) == ref
+	  && std::string(s.data(), s.size()) == ref);
+}
+
+const std::size_t lengths[] = { 0, 1, 7, 14, 15, 16, 17, 31, 40 };
+const std::size_t n_lengths = sizeof(lengths) / sizeof(lengths[0]);
+
+// append, push_back, operator+= and operator+.
+void
+test01()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  for (std::size_t i = 0; i < n_lengths; ++i)
+    for (std::size_t j = 0; j < n_lengths; ++j)
+      {
+	std::string r = make_value(lengths[i]);
+	const std::string a = make_value(lengths[j]);
+	sso_string s(r.c_str());
+	const sso_string sa(a.c_str());
+
+	r.append(a);
+	s.append(sa);
+	VERIFY( same(s, r) );
+
+	r.append(r.c_str(), r.size() / 2);
+	s.append(s.c_str(), s.size() / 2);
+	VERIFY( same(s, r) );
+
+	r += 'z';
+	s.push_back('z');
+	VERIFY( same(s, r) );
+
+	r.append(3, '-');
+	s.append(3, '-');
+	VERIFY( same(s, r) );
+
+	VERIFY( same(sa + s, a + r) );
+	VERIFY( same("<" + sa, "<" + a) );
+	VERIFY( same(sa + '>', a + '>') );
+      }
+}
+
+// insert and erase at every position.
+void
+test02()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  for (std::size_t i = 0; i < n_lengths; ++i)
+    for (std::size_t pos = 0; pos <= lengths[i]; ++pos)
+      {
+	std::string r = make_value(lengths[i]);
+	sso_string s(r.c_str());
+
+	r.insert(pos, "INS");
+	s.insert(pos, "INS");
+	VERIFY( same(s, r) );
+
+	r.insert(pos, r);
+	s.insert(pos, s);
+	VERIFY( same(s, r) );
+
+	r.insert(pos, 2, '#');
+	s.insert(pos, 2, '#');
+	VERIFY( same(s, r) );
+
+	r.insert(r.begin() + pos, '@');
+	s.insert(s.begin() + pos, '@');
+	VERIFY( same(s, r) );
+
+	r.erase(pos, 5);
+	s.erase(pos, 5);
+	VERIFY( same(s, r) );
+
+	if (pos < r.size())
+	  {
+	    r.erase(r.begin() + pos);
+	    s.erase(s.begin() + pos);
+	    VERIFY( same(s, r) );
+	  }
+
+	r.erase(pos);
+	s.erase(pos);
+	VERIFY( same(s, r) );
+      }
+}
+
+// replace with shorter, equal and longer values, including parts of
+// the string itself.
+void
+test03()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  for (std::size_t i = 0; i < n_lengths; ++i)
+    for (std::size_t pos = 0; pos <= lengths[i]; pos += 3)
+      for (std::size_t n = 0; n <= 20; n += 5)
+	{
+	  const std::string init = make_value(lengths[i]);
+	  std::string r = init;
+	  sso_string s(init.c_str());
+
+	  r.replace(pos, n, "0123456789abcdefghij", n / 2 + 1);
+	  s.replace(pos, n, "0123456789abcdefghij", n / 2 + 1);
+	  VERIFY( same(s, r) );
+
+	  r.replace(pos, n, 18, '*');
+	  s.replace(pos, n, 18, '*');
+	  VERIFY( same(s, r) );
+
+	  const std::size_t len = r.size();
+	  r.replace(pos, n, r.c_str() + len / 3, len - len / 3);
+	  s.replace(pos, n, s.c_str() + len / 3, len - len / 3);
+	  VERIFY( same(s, r) );
+
+	  r.replace(r.begin(), r.begin() + r.size() / 2, r.c_str() + 1,
+		    r.size() / 4);
+	  s.replace(s.begin(), s.begin() + s.size() / 2, s.c_str() + 1,
+		    s.size() / 4);
+	  VERIFY( same(s, r) );
+	}
+}
+
+int main()
+{
+  test01();
+  test02();
+  test03();
+  return 0;
+}
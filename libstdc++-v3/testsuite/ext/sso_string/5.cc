@@ -0,0 +1,136 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// sso_string (GNU extension)
+
+#include <ext/sso_string.h>
+#include <string>
+#include <testsuite_hooks.h>
+
+// The searches, comparisons and substrings must agree with std::string.
+
+const char* const values[] =
+  {
+    "", "a", "abc", "abcabc", "abcdefghijklmno", "abcdefghijklmnop",
+    "the quick brown fox jumps over the lazy dog",
+    "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+  };
+const std::size_t n_values = sizeof(values) / sizeof(values[0]);
+
+const char* const needles[] =
+  { "", "a", "c", "ab", "bc", "abc", "o", "the", "fox", "xyz", "aaaa" };
+const std::size_t n_needles = sizeof(needles) / sizeof(needles[0]);
+
+void
+test01()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  for (std::size_t i = 0; i < n_values; ++i)
+    {
+      const sso_string s(values[i]);
+      const std::string r(values[i]);
+
+      for (std::size_t j = 0; j < n_needles; ++j)
+	{
+	  const char* n = needles[j];
+	  for (std::size_t pos = 0; pos <= r.size() + 1; ++pos)
+	    {
+	      VERIFY( s.find(n, pos) == r.find(n, pos) );
+	      VERIFY( s.rfind(n, pos) == r.rfind(n, pos) );
+	      VERIFY( s.find_first_of(n, pos) == r.find_first_of(n, pos) );
+	      VERIFY( s.find_last_of(n, pos) == r.find_last_of(n, pos) );
+	      VERIFY( s.find_first_not_of(n, pos)
+		      == r.find_first_not_of(n, pos) );
+	      VERIFY( s.find_last_not_of(n, pos)
+		      == r.find_last_not_of(n, pos) );
+	      if (*n)
+		{
+		  VERIFY( s.find(*n, pos) == r.find(*n, pos) );
+		  VERIFY( s.rfind(*n, pos) == r.rfind(*n, pos) );
+		}
+	    }
+	  VERIFY( s.find(sso_string(n)) == r.find(n) );
+	  VERIFY( s.rfind(sso_string(n)) == r.rfind(n) );
+	}
+    }
+}
+
+int
+sign(int i)
+{ return i < 0 ? -1 : i > 0; }
+
+void
+test02()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  for (std::size_t i = 0; i < n_values; ++i)
+    for (std::size_t j = 0; j < n_values; ++j)
+      {
+	const sso_string a(values[i]), b(values[j]);
+	const std::string ra(values[i]), rb(values[j]);
+
+	VERIFY( sign(a.compare(b)) == sign(ra.compare(rb)) );
+	VERIFY( sign(a.compare(values[j])) == sign(ra.compare(values[j])) );
+	VERIFY( (a == b) == (ra == rb) );
+	VERIFY( (a != b) == (ra != rb) );
+	VERIFY( (a < b) == (ra < rb) );
+	VERIFY( (a <= b) == (ra <= rb) );
+	VERIFY( (a > b) == (ra > rb) );
+	VERIFY( (a >= b) == (ra >= rb) );
+	VERIFY( (values[i] == b) == (ra == rb) );
+	VERIFY( (values[i] < b) == (ra < rb) );
+	if (ra.size() >= 2)
+	  VERIFY( sign(a.compare(1, 3, b)) == sign(ra.compare(1, 3, rb)) );
+      }
+}
+
+void
+test03()
+{
+  using __gnu_cxx::sso_string;
+  bool test __attribute__((unused)) = true;
+
+  for (std::size_t i = 0; i < n_values; ++i)
+    {
+      const sso_string s(values[i]);
+      const std::string r(values[i]);
+
+      for (std::size_t pos = 0; pos <= r.size(); ++pos)
+	for (std::size_t n = 0; n <= r.size() + 1; n += 4)
+	  {
+	    VERIFY( std::string(s.substr(pos, n).c_str()) == r.substr(pos, n) );
+
+	    char buf[64], rbuf[64];
+	    const std::size_t len = s.copy(buf, n, pos);
+	    VERIFY( len == r.copy(rbuf, n, pos) );
+	    VERIFY( std::string(buf, len) == std::string(rbuf, len) );
+	  }
+    }
+}
+
+int main()
+{
+  test01();
+  test02();
+  test03();
+  return 0;
+}
@@ -0,0 +1,84 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// sso_wstring (GNU extension)
+
+#include <ext/sso_string.h>
+#include <sstream>
+#include <testsuite_hooks.h>
+
+// The inline capacity depends on the size of the character type.
+void
+test01()
+{
+  using __gnu_cxx::sso_wstring;
+  bool test __attribute__((unused)) = true;
+
+  sso_wstring s1;
+  VERIFY( s1.capacity() >= 15 / sizeof(wchar_t) );
+  VERIFY( s1.c_str()[0] == L'\0' );
+
+  for (int i = 0; i < 20; ++i)
+    {
+      s1 += wchar_t(L'a' + i);
+      VERIFY( s1.size() == static_cast<sso_wstring::size_type>(i + 1) );
+      VERIFY( s1[i] == wchar_t(L'a' + i) );
+      VERIFY( s1.c_str()[i + 1] == L'\0' );
+    }
+  VERIFY( s1 == L"abcdefghijklmnopqrst" );
+
+  sso_wstring s2(L"ab"), s3;
+  s3.swap(s2);
+  VERIFY( s3 == L"ab" );
+  VERIFY( s2.empty() );
+  VERIFY( s2.c_str()[0] == L'\0' );
+
+  s3.swap(s1);
+  VERIFY( s1 == L"ab" );
+  VERIFY( s3 == L"abcdefghijklmnopqrst" );
+
+  s3.replace(2, 10, L"XY");
+  VERIFY( s3 == L"abXYmnopqrst" );
+  VERIFY( s3.find(L"mno") == 4 );
+  VERIFY( s3.rfind(L't') == s3.size() - 1 );
+}
+
+void
+test02()
+{
+  using __gnu_cxx::sso_wstring;
+  bool test __attribute__((unused)) = true;
+
+  std::wostringstream oss;
+  oss << sso_wstring(L"wide") << L'|';
+  VERIFY( oss.str() == L"wide|" );
+
+  std::wistringstream iss(L"one two");
+  sso_wstring s;
+  iss >> s;
+  VERIFY( s == L"one" );
+  getline(iss, s);
+  VERIFY( s == L" two" );
+}
+
+int main()
+{
+  test01();
+  test02();
+  return 0;
+}
@@ -0,0 +1,111 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+#include <cstdlib>
+#include <sstream>
+#include <testsuite_performance.h>
+
+// Time dynamic_cast in the kinds of hierarchy that make the runtime
+// walk the most: a deep single-inheritance chain, multiple inheritance
+// with a cross cast, and virtual inheritance.
+
+struct base
+{ virtual ~base() { } };
+
+template<int N>
+  struct chain : chain<N - 1>
+  { };
+
+template<>
+  struct chain<0> : base
+  { };
+
+typedef chain<16> deep;
+
+struct left : virtual base
+{ int l; };
+
+struct right : virtual base
+{ int r; };
+
+struct mixin
+{
+  virtual ~mixin() { }
+  int m;
+};
+
+struct diamond : left, right, mixin
+{ int d; };
+
+struct unrelated : base
+{ };
+
+template<typename To, typename From>
+  void
+  test_cast(From* from, bool expect, int iterations, const char* what)
+  {
+    using namespace __gnu_test;
+    time_counter time;
+    resource_counter resource;
+    int found = 0;
+
+    start_counters(time, resource);
+    for (int i = 0; i < iterations; ++i)
+      {
+	// Stop the compiler from hoisting the cast out of the loop.
+	asm volatile ("" : "+r" (from));
+	if (dynamic_cast<To*>(from))
+	  ++found;
+      }
+    stop_counters(time, resource);
+
+    if ((found == iterations) != expect)
+      abort();
+
+    std::ostringstream comment;
+    comment << what << '\t';
+    comment << "casts: " << iterations;
+    report_performance(__FILE__, comment.str(), time, resource);
+  }
+
+int main()
+{
+  const int iterations = 10000000;
+
+  deep d;
+  base* b = &d;
+  test_cast<deep>(b, true, iterations, "deep down cast");
+  test_cast<unrelated>(b, false, iterations, "deep failed cast");
+
+  diamond x;
+  left* l = &x;
+  test_cast<right>(l, true, iterations, "cross cast");
+  test_cast<mixin>(l, true, iterations, "cross cast to non-virtual");
+  base* vb = &x;
+  test_cast<diamond>(vb, true, iterations, "down cast from virtual base");
+  return 0;
+}
@@ -0,0 +1,144 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/*
+ * The goal with this application is to measure the cost of reaching
+ * function-local statics from several threads at once.  While each
+ * run is going, one more thread sits in a slow, unrelated static
+ * initializer; that must not hold up the others.
+ */
+
+#include <sstream>
+#include <pthread.h>
+#include <unistd.h>
+#include <testsuite_performance.h>
+
+// The number of times each thread reaches the statics.
+const int iterations = 10000000;
+
+int __attribute__((noinline))
+make_value(int n)
+{ return n * 2 + 1; }
+
+int __attribute__((noinline))
+shared_value()
+{
+  static int value = make_value(1);
+  return value;
+}
+
+// A different static per thread, so that every thread has its own
+// first-time initialization to get through.
+template<int N>
+  int __attribute__((noinline))
+  own_value()
+  {
+    static int value = make_value(N);
+    return value;
+  }
+
+typedef int (*value_fn)();
+value_fn own_values[16] =
+{
+  own_value<0>, own_value<1>, own_value<2>, own_value<3>,
+  own_value<4>, own_value<5>, own_value<6>, own_value<7>,
+  own_value<8>, own_value<9>, own_value<10>, own_value<11>,
+  own_value<12>, own_value<13>, own_value<14>, own_value<15>
+};
+
+int __attribute__((noinline))
+slow_value()
+{
+  static int value = (sleep(1), make_value(-1));
+  return value;
+}
+
+void*
+do_slow(void*)
+{
+  slow_value();
+  return NULL;
+}
+
+void*
+do_loop(void* p)
+{
+  value_fn own = own_values[reinterpret_cast<long>(p)];
+  int sum = 0;
+  for (int i = 0; i < iterations; ++i)
+    sum += shared_value() + own();
+  return reinterpret_cast<void*>(sum);
+}
+
+void
+test_threads(int n_threads)
+{
+  using namespace __gnu_test;
+  time_counter time;
+  resource_counter resource;
+  pthread_t slow;
+  pthread_t threads[16];
+
+  // Give the slow initializer a head start so that it is in progress
+  // for the whole run.
+  pthread_create(&slow, NULL, do_slow, NULL);
+  usleep(10000);
+
+  clear_counters(time, resource);
+  start_counters(time, resource);
+
+  for (int i = 0; i < n_threads; ++i)
+    pthread_create(&threads[i], NULL, do_loop, reinterpret_cast<void*>(i));
+  for (int i = 0; i < n_threads; ++i)
+    pthread_join(threads[i], NULL);
+
+  stop_counters(time, resource);
+  pthread_join(slow, NULL);
+
+  std::ostringstream comment;
+  comment << "threads: " << n_threads << '\t';
+  comment << "iterations per thread: " << iterations;
+  report_header(__FILE__, comment.str());
+  report_performance(__FILE__, std::string(), time, resource);
+}
+
+int main(void)
+{
+#ifdef TEST_T1
+  test_threads(1);
+#endif
+#ifdef TEST_T2
+  test_threads(2);
+#endif
+#ifdef TEST_T3
+  test_threads(4);
+#endif
+#ifdef TEST_T4
+  test_threads(8);
+#endif
+  return 0;
+}
@@ -0,0 +1,83 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+#include <sstream>
+#include <testsuite_performance.h>
+
+// Throw through DEPTH frames, each of which has a cleanup, so that both
+// phases of the unwinder visit every frame.
+
+struct cleanup
+{
+  int* count;
+  cleanup(int* c) : count(c) { }
+  ~cleanup() { ++*count; }
+};
+
+void __attribute__((noinline))
+thrower(int depth, int* count)
+{
+  cleanup c(count);
+  if (depth == 0)
+    throw depth;
+  thrower(depth - 1, count);
+}
+
+void
+test_depth(int depth, int iterations)
+{
+  using namespace __gnu_test;
+  time_counter time;
+  resource_counter resource;
+  int count = 0;
+
+  start_counters(time, resource);
+  for (int i = 0; i < iterations; ++i)
+    {
+      try
+	{
+	  thrower(depth, &count);
+	}
+      catch(int)
+	{ }
+    }
+  stop_counters(time, resource);
+
+  std::ostringstream comment;
+  comment << "depth: " << depth << '\t';
+  comment << "throws: " << iterations;
+  report_performance(__FILE__, comment.str(), time, resource);
+}
+
+int main()
+{
+  test_depth(1, 200000);
+  test_depth(4, 100000);
+  test_depth(16, 50000);
+  test_depth(64, 10000);
+  return 0;
+}
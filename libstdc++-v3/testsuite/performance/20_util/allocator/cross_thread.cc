@@ -0,0 +1,249 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/*
+ * The goal with this application is to compare the performance of
+ * different allocators when blocks are allocated in one thread and
+ * freed in another.  Each producer thread allocates blocks of a few
+ * small sizes and passes them, in batches, to a consumer thread which
+ * frees them.  For __mt_alloc the statistics of its pool are
+ * reported as well.
+ */
+
+#include <vector>
+#include <typeinfo>
+#include <sstream>
+#include <pthread.h>
+#include <ext/mt_allocator.h>
+#include <ext/new_allocator.h>
+#include <ext/malloc_allocator.h>
+#include <ext/bitmap_allocator.h>
+#include <ext/pool_allocator.h>
+#include <cxxabi.h>
+#include <testsuite_performance.h>
+
+using namespace std;
+using __gnu_cxx::__mt_alloc;
+using __gnu_cxx::new_allocator;
+using __gnu_cxx::malloc_allocator;
+using __gnu_cxx::bitmap_allocator;
+using __gnu_cxx::__pool_alloc;
+
+// The number of batches each producer passes to its consumer.
+const int iterations = 2000;
+
+// The number of blocks in a batch.
+const int batch_size = 256;
+
+// The number of producer/consumer pairs.
+const int n_pairs = 2;
+
+struct value_type
+{
+  int i[4];
+};
+
+template<typename Alloc>
+  struct batch
+  {
+    typename Alloc::pointer	p[batch_size];
+    batch*			next;
+  };
+
+// Batches travel from a producer to its consumer through this queue.
+template<typename Alloc>
+  struct channel
+  {
+    pthread_mutex_t	mutex;
+    pthread_cond_t	cond;
+    batch<Alloc>*	head;
+    batch<Alloc>*	tail;
+    bool		done;
+
+    channel() : head(0), tail(0), done(false)
+    {
+      pthread_mutex_init(&mutex, 0);
+      pthread_cond_init(&cond, 0);
+    }
+
+    ~channel()
+    {
+      pthread_cond_destroy(&cond);
+      pthread_mutex_destroy(&mutex);
+    }
+
+    void
+    push(batch<Alloc>* b)
+    {
+      b->next = 0;
+      pthread_mutex_lock(&mutex);
+      if (tail)
+	tail->next = b;
+      else
+	head = b;
+      tail = b;
+      pthread_cond_signal(&cond);
+      pthread_mutex_unlock(&mutex);
+    }
+
+    void
+    close()
+    {
+      pthread_mutex_lock(&mutex);
+      done = true;
+      pthread_cond_signal(&cond);
+      pthread_mutex_unlock(&mutex);
+    }
+
+    // Returns all the queued batches, or null once the producer is
+    // done and nothing is left.
+    batch<Alloc>*
+    pop_all()
+    {
+      pthread_mutex_lock(&mutex);
+      while (!head && !done)
+	pthread_cond_wait(&cond, &mutex);
+      batch<Alloc>* b = head;
+      head = tail = 0;
+      pthread_mutex_unlock(&mutex);
+      return b;
+    }
+  };
+
+// Sizes, in objects, of the blocks allocated.
+inline int
+block_size(int i)
+{ return 1 + i % 4; }
+
+template<typename Alloc>
+  void*
+  produce(void* p)
+  {
+    channel<Alloc>& ch = *static_cast<channel<Alloc>*>(p);
+    Alloc a;
+    for (int i = 0; i < iterations; ++i)
+      {
+	batch<Alloc>* b = new batch<Alloc>;
+	for (int j = 0; j < batch_size; ++j)
+	  b->p[j] = a.allocate(block_size(j));
+	ch.push(b);
+      }
+    ch.close();
+    return 0;
+  }
+
+template<typename Alloc>
+  void*
+  consume(void* p)
+  {
+    channel<Alloc>& ch = *static_cast<channel<Alloc>*>(p);
+    Alloc a;
+    while (batch<Alloc>* b = ch.pop_all())
+      while (b)
+	{
+	  for (int j = 0; j < batch_size; ++j)
+	    a.deallocate(b->p[j], block_size(j));
+	  batch<Alloc>* next = b->next;
+	  delete b;
+	  b = next;
+	}
+    return 0;
+  }
+
+template<typename Alloc>
+  void
+  report_stats(const Alloc&, std::ostringstream&)
+  { }
+
+template<typename Tp, typename Poolp>
+  void
+  report_stats(const __mt_alloc<Tp, Poolp>& obj, std::ostringstream& comment)
+  {
+    __mt_alloc<Tp, Poolp> a(obj);
+    const __gnu_cxx::__pool_base::_Stats stats = a._M_get_stats();
+    comment << '\t' << "allocs: " << stats._M_allocs;
+    comment << '\t' << "remote frees: " << stats._M_remote_frees;
+    comment << '\t' << "lock waits: " << stats._M_lock_waits;
+  }
+
+template<typename Alloc>
+  void
+  test_allocator(Alloc obj)
+  {
+    using namespace __gnu_test;
+    int status;
+
+    time_counter time;
+    resource_counter resource;
+    channel<Alloc> channels[n_pairs];
+    pthread_t producers[n_pairs];
+    pthread_t consumers[n_pairs];
+
+    clear_counters(time, resource);
+    start_counters(time, resource);
+
+    for (int i = 0; i < n_pairs; ++i)
+      {
+	pthread_create(&consumers[i], 0, consume<Alloc>, &channels[i]);
+	pthread_create(&producers[i], 0, produce<Alloc>, &channels[i]);
+      }
+    for (int i = 0; i < n_pairs; ++i)
+      {
+	pthread_join(producers[i], 0);
+	pthread_join(consumers[i], 0);
+      }
+
+    stop_counters(time, resource);
+
+    std::ostringstream comment;
+    comment << "iterations: " << iterations << '\t';
+    comment << "type: " << abi::__cxa_demangle(typeid(obj).name(),
+					       0, 0, &status);
+    report_stats(obj, comment);
+    report_header(__FILE__, comment.str());
+    report_performance(__FILE__, string(), time, resource);
+  }
+
+int main(void)
+{
+#ifdef TEST_T0
+  test_allocator(new_allocator<value_type>());
+#endif
+#ifdef TEST_T1
+  test_allocator(malloc_allocator<value_type>());
+#endif
+#ifdef TEST_T2
+  test_allocator(__mt_alloc<value_type>());
+#endif
+#ifdef TEST_T3
+  test_allocator(bitmap_allocator<value_type>());
+#endif
+#ifdef TEST_T4
+  test_allocator(__pool_alloc<value_type>());
+#endif
+  return 0;
+}
@@ -0,0 +1,146 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/*
+ * The goal with this application is to compare the performance of
+ * different allocators for blocks of a few objects, as allocated by
+ * small vectors and strings.  Each thread keeps a ring of blocks of
+ * one to eight objects, and replaces them in turn by blocks of
+ * another size.
+ */
+
+#include <typeinfo>
+#include <sstream>
+#include <pthread.h>
+#include <ext/mt_allocator.h>
+#include <ext/new_allocator.h>
+#include <ext/malloc_allocator.h>
+#include <ext/bitmap_allocator.h>
+#include <ext/pool_allocator.h>
+#include <cxxabi.h>
+#include <testsuite_performance.h>
+
+using namespace std;
+using __gnu_cxx::__mt_alloc;
+using __gnu_cxx::new_allocator;
+using __gnu_cxx::malloc_allocator;
+using __gnu_cxx::bitmap_allocator;
+using __gnu_cxx::__pool_alloc;
+
+// The number of blocks each thread allocates.
+const int iterations = 2000000;
+
+// The number of blocks alive in each thread.
+const int ring_size = 1000;
+
+// The number of threads.
+const int n_threads = 4;
+
+struct value_type
+{
+  int i[2];
+};
+
+// Sizes, in objects, of the blocks allocated.
+inline int
+block_size(int i)
+{ return 1 + (i * 5) % 8; }
+
+template<typename Alloc>
+  void*
+  churn(void*)
+  {
+    typedef typename Alloc::pointer pointer;
+    Alloc a;
+    pointer ring[ring_size];
+    int sizes[ring_size];
+    for (int j = 0; j < ring_size; ++j)
+      {
+	sizes[j] = block_size(j);
+	ring[j] = a.allocate(sizes[j]);
+      }
+    for (int i = 0; i < iterations; ++i)
+      {
+	const int j = i % ring_size;
+	a.deallocate(ring[j], sizes[j]);
+	sizes[j] = block_size(i + j);
+	ring[j] = a.allocate(sizes[j]);
+	ring[j]->i[0] = i;
+      }
+    for (int j = 0; j < ring_size; ++j)
+      a.deallocate(ring[j], sizes[j]);
+    return 0;
+  }
+
+template<typename Alloc>
+  void
+  test_allocator(Alloc obj)
+  {
+    using namespace __gnu_test;
+    int status;
+
+    time_counter time;
+    resource_counter resource;
+    pthread_t threads[n_threads];
+
+    clear_counters(time, resource);
+    start_counters(time, resource);
+
+    for (int i = 0; i < n_threads; ++i)
+      pthread_create(&threads[i], 0, churn<Alloc>, 0);
+    for (int i = 0; i < n_threads; ++i)
+      pthread_join(threads[i], 0);
+
+    stop_counters(time, resource);
+
+    std::ostringstream comment;
+    comment << "iterations: " << iterations << '\t';
+    comment << "type: " << abi::__cxa_demangle(typeid(obj).name(),
+					       0, 0, &status);
+    report_header(__FILE__, comment.str());
+    report_performance(__FILE__, string(), time, resource);
+  }
+
+int main(void)
+{
+#ifdef TEST_T0
+  test_allocator(new_allocator<value_type>());
+#endif
+#ifdef TEST_T1
+  test_allocator(malloc_allocator<value_type>());
+#endif
+#ifdef TEST_T2
+  test_allocator(__mt_alloc<value_type>());
+#endif
+#ifdef TEST_T3
+  test_allocator(bitmap_allocator<value_type>());
+#endif
+#ifdef TEST_T4
+  test_allocator(__pool_alloc<value_type>());
+#endif
+  return 0;
+}
@@ -28,59 +28,73 @@
 #include <ctime>
 #include <iostream>
 #include <string>
+#include <ext/sso_string.h>
 #include <testsuite_performance.h>
 
 using namespace std;
 
-void
-test_append_char(int how_much)
-{
-  string buf; // no preallocation
-  for (int i = 0; i < how_much; ++i)
-    buf.append(static_cast<string::size_type>(1) , 'x');
-}
+template<typename String>
+  void
+  test_append_char(int how_much)
+  {
+    String buf; // no preallocation
+    for (int i = 0; i < how_much; ++i)
+      buf.append(static_cast<typename String::size_type>(1) , 'x');
+  }
 
-void
-test_append_string(int how_much)
-{
-  string s(static_cast<string::size_type>(1) , 'x');
-  string buf; // no preallocation
-  for (int i = 0; i < how_much; ++i)
-    buf.append(s);
-}
+template<typename String>
+  void
+  test_append_string(int how_much)
+  {
+    String s(static_cast<typename String::size_type>(1) , 'x');
+    String buf; // no preallocation
+    for (int i = 0; i < how_much; ++i)
+      buf.append(s);
+  }
 
-void 
-run_benchmark1(int how_much)
-{
-  using namespace __gnu_test;
-  time_counter time;
-  resource_counter resource;
-  start_counters(time, resource);
-  test_append_char(how_much);
-  stop_counters(time, resource);
-  report_performance(__FILE__, "char", time, resource);
-}
+template<typename String>
+  void 
+  run_benchmark1(int how_much, const char* name)
+  {
+    using namespace __gnu_test;
+    time_counter time;
+    resource_counter resource;
+    start_counters(time, resource);
+    test_append_char<String>(how_much);
+    stop_counters(time, resource);
+    report_performance(__FILE__, name, time, resource);
+  }
 
-void 
-run_benchmark2(int how_much)
-{
-  using namespace __gnu_test;
-  time_counter time;
-  resource_counter resource;
-  start_counters(time, resource);
-  test_append_string(how_much);
-  stop_counters(time, resource);
-  report_performance(__FILE__, "string", time, resource);
-}
+template<typename String>
+  void 
+  run_benchmark2(int how_much, const char* name)
+  {
+    using namespace __gnu_test;
+    time_counter time;
+    resource_counter resource;
+    start_counters(time, resource);
+    test_append_string<String>(how_much);
+    stop_counters(time, resource);
+    report_performance(__FILE__, name, time, resource);
+  }
+
+template<typename String>
+  void
+  run_benchmarks(int how_much, const char* char_name, const char* str_name)
+  {
+    run_benchmark1<String>(how_much, char_name);
+    run_benchmark2<String>(how_much, str_name);
+  }
 
 // libstdc++/5380
 // libstdc++/4960
 int main()
 {
-  run_benchmark1(100000);
-  run_benchmark2(100000);
-  run_benchmark1(1000000);
-  run_benchmark2(1000000);
-  run_benchmark1(10000000);
-  run_benchmark2(10000000);
+  using __gnu_cxx::sso_string;
+  run_benchmarks<string>(100000, "char", "string");
+  run_benchmarks<sso_string>(100000, "sso char", "sso string");
+  run_benchmarks<string>(1000000, "char", "string");
+  run_benchmarks<sso_string>(1000000, "sso char", "sso string");
+  run_benchmarks<string>(10000000, "char", "string");
+  run_benchmarks<sso_string>(10000000, "sso char", "sso string");
 }
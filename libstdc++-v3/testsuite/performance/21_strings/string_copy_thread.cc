@@ -0,0 +1,145 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/*
+ * The goal with this application is to compare std::string with
+ * __gnu_cxx::sso_string when several threads keep copying strings
+ * from a shared table, and sometimes modify their copies.  With
+ * std::string every copy of a shared value updates the same reference
+ * count; with sso_string short values are copied inline and long
+ * ones get a buffer of their own.
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <ext/sso_string.h>
+#include <testsuite_performance.h>
+
+// The number of times each thread walks the shared table.
+const int iterations = 20000;
+
+const char* values[] =
+{
+  "id", "name", "value", "timestamp", "user_agent",
+  "a somewhat longer value, well past the inline capacity",
+  "x", "content-length", "content-type", "accept-encoding",
+  "another value that needs a buffer of its own to live in",
+  "ok"
+};
+
+const int n_values = sizeof(values) / sizeof(values[0]);
+
+template<typename String>
+  struct thread_data
+  {
+    const std::vector<String>* table;
+    unsigned long result;
+  };
+
+template<typename String>
+  void*
+  do_loop(void* p)
+  {
+    thread_data<String>* data = static_cast<thread_data<String>*>(p);
+    const std::vector<String>& table = *data->table;
+    unsigned long sum = 0;
+
+    for (int i = 0; i < iterations; ++i)
+      for (typename std::vector<String>::size_type j = 0;
+	   j < table.size(); ++j)
+	{
+	  String copy(table[j]);
+	  String other;
+	  other = copy;
+	  if (j % 4 == 0)
+	    copy += 'x';
+	  sum += copy.size() + other.size();
+	}
+
+    data->result = sum;
+    return NULL;
+  }
+
+template<typename String>
+  void
+  test_threads(int n_threads, const char* name)
+  {
+    using namespace __gnu_test;
+    time_counter time;
+    resource_counter resource;
+    pthread_t threads[8];
+    thread_data<String> data[8];
+
+    std::vector<String> table;
+    for (int i = 0; i < 100; ++i)
+      table.push_back(String(values[i % n_values]));
+
+    start_counters(time, resource);
+
+    for (int i = 0; i < n_threads; ++i)
+      {
+	data[i].table = &table;
+	pthread_create(&threads[i], NULL, do_loop<String>, &data[i]);
+      }
+    for (int i = 0; i < n_threads; ++i)
+      pthread_join(threads[i], NULL);
+
+    stop_counters(time, resource);
+
+    std::ostringstream comment;
+    comment << "threads: " << n_threads << '\t';
+    comment << "iterations per thread: " << iterations;
+    report_header(__FILE__, comment.str());
+    report_performance(__FILE__, name, time, resource);
+  }
+
+template<typename String>
+  void
+  test_all(const char* name)
+  {
+#ifdef TEST_T1
+    test_threads<String>(1, name);
+#endif
+#ifdef TEST_T2
+    test_threads<String>(2, name);
+#endif
+#ifdef TEST_T3
+    test_threads<String>(4, name);
+#endif
+#ifdef TEST_T4
+    test_threads<String>(8, name);
+#endif
+  }
+
+int main(void)
+{
+  test_all<std::string>("string");
+  test_all<__gnu_cxx::sso_string>("sso_string");
+  return 0;
+}
@@ -0,0 +1,101 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+/*
+ * The goal with this application is to measure the construction of
+ * streams, and of locales, in several threads at once, when the
+ * global locale is the classic one.  Each stream copies the global
+ * locale a few times, each copy of a counted locale updates the same
+ * reference count, and each default constructed locale takes the
+ * global locale lock.
+ */
+
+#include <locale>
+#include <sstream>
+#include <pthread.h>
+#include <testsuite_performance.h>
+
+// The number of streams each thread creates.
+const int iterations = 200000;
+
+void*
+do_loop(void* p)
+{
+  unsigned long sum = 0;
+  for (int i = 0; i < iterations; ++i)
+    {
+      std::ostringstream oss;
+      std::locale loc;
+      std::locale copy(oss.getloc());
+      copy = loc;
+      sum += (copy == loc);
+    }
+  *static_cast<unsigned long*>(p) = sum;
+  return NULL;
+}
+
+void
+test_threads(int n_threads)
+{
+  using namespace __gnu_test;
+  time_counter time;
+  resource_counter resource;
+  pthread_t threads[8];
+  unsigned long results[8];
+
+  start_counters(time, resource);
+
+  for (int i = 0; i < n_threads; ++i)
+    pthread_create(&threads[i], NULL, do_loop, &results[i]);
+  for (int i = 0; i < n_threads; ++i)
+    pthread_join(threads[i], NULL);
+
+  stop_counters(time, resource);
+
+  std::ostringstream comment;
+  comment << "threads: " << n_threads << '\t';
+  comment << "iterations per thread: " << iterations;
+  report_header(__FILE__, comment.str());
+  report_performance(__FILE__, "", time, resource);
+}
+
+int main(void)
+{
+#ifdef TEST_T1
+  test_threads(1);
+#endif
+#ifdef TEST_T2
+  test_threads(2);
+#endif
+#ifdef TEST_T3
+  test_threads(4);
+#endif
+#ifdef TEST_T4
+  test_threads(8);
+#endif
+  return 0;
+}
@@ -0,0 +1,65 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+// Startup cost of a program using the standard streams: the static
+// initialization of <iostream> builds the classic locale and the eight
+// standard streams.  Each run of this program with an argument exits
+// right away; without, it runs itself that way many times.
+
+#include <iostream>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <testsuite_performance.h>
+
+int main(int argc, char* argv[])
+{
+  using namespace __gnu_test;
+
+  if (argc > 1)
+    return 0;
+
+  time_counter time;
+  resource_counter resource;
+  const int iterations = 500;
+
+  start_counters(time, resource);
+  for (int i = 0; i < iterations; ++i)
+    {
+      const pid_t pid = fork();
+      if (pid == 0)
+	{
+	  execl(argv[0], argv[0], "child", static_cast<char*>(0));
+	  _exit(1);
+	}
+      else if (pid > 0)
+	waitpid(pid, 0, 0);
+    }
+  stop_counters(time, resource);
+  report_performance(__FILE__, "", time, resource);
+  return 0;
+}
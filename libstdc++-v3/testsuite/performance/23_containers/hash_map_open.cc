@@ -0,0 +1,137 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+// Compare insertion, successful and failed lookup, and erasure of
+// integer keys in the open addressing open_hash_map against the
+// chained hash_map and against std::map.
+
+#include <map>
+#include <vector>
+#include <cstdlib>
+#include <ext/hash_map>
+#include <ext/open_hash_map>
+#include <testsuite_hooks.h>
+#include <testsuite_performance.h>
+
+template<typename Container>
+  void
+  do_insert(Container& c, const std::vector<int>& keys)
+  {
+    for (std::vector<int>::size_type i = 0; i < keys.size(); ++i)
+      c.insert(typename Container::value_type(keys[i], i));
+  }
+
+// Keeps the lookups from being optimized away.
+std::vector<int>::size_type found;
+
+template<typename Container>
+  void
+  do_find(const Container& c, const std::vector<int>& keys)
+  {
+    for (std::vector<int>::size_type i = 0; i < keys.size(); ++i)
+      if (c.find(keys[i]) != c.end())
+	++found;
+  }
+
+template<typename Container>
+  void
+  do_erase(Container& c, const std::vector<int>& keys)
+  {
+    bool test __attribute__((unused)) = true;
+    for (std::vector<int>::size_type i = 0; i < keys.size(); ++i)
+      c.erase(keys[i]);
+    VERIFY( c.empty() );
+  }
+
+template<typename Container>
+  void
+  test_container(const char* name, const std::vector<int>& keys,
+		 const std::vector<int>& missing)
+  {
+    using namespace __gnu_test;
+    bool test __attribute__((unused)) = true;
+    time_counter time;
+    resource_counter resource;
+    Container c;
+    std::string label;
+
+    start_counters(time, resource);
+    do_insert(c, keys);
+    stop_counters(time, resource);
+    label = std::string(name) + " insert";
+    report_performance(__FILE__, label, time, resource);
+    clear_counters(time, resource);
+
+    found = 0;
+    start_counters(time, resource);
+    for (int i = 0; i < 4; ++i)
+      do_find(c, keys);
+    stop_counters(time, resource);
+    VERIFY( found == 4 * keys.size() );
+    label = std::string(name) + " find";
+    report_performance(__FILE__, label, time, resource);
+    clear_counters(time, resource);
+
+    found = 0;
+    start_counters(time, resource);
+    for (int i = 0; i < 4; ++i)
+      do_find(c, missing);
+    stop_counters(time, resource);
+    VERIFY( found == 0 );
+    label = std::string(name) + " find missing";
+    report_performance(__FILE__, label, time, resource);
+    clear_counters(time, resource);
+
+    start_counters(time, resource);
+    do_erase(c, keys);
+    stop_counters(time, resource);
+    label = std::string(name) + " erase";
+    report_performance(__FILE__, label, time, resource);
+  }
+
+int main()
+{
+  const int n = 1000000;
+
+  // Distinct keys in random order; the missing keys are odd, the
+  // present ones even.
+  std::vector<int> keys, missing;
+  for (int i = 0; i < n; ++i)
+    {
+      keys.push_back(2 * i);
+      missing.push_back(2 * i + 1);
+    }
+  std::srand(1);
+  std::random_shuffle(keys.begin(), keys.end());
+  std::random_shuffle(missing.begin(), missing.end());
+
+  test_container<std::map<int, int> >("map", keys, missing);
+  test_container<__gnu_cxx::hash_map<int, int> >("hash_map", keys, missing);
+  test_container<__gnu_cxx::open_hash_map<int, int> >("open_hash_map",
+						      keys, missing);
+  return 0;
+}
@@ -0,0 +1,137 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+
+/*
+ * Scaling of the parallel mode, built with -D_GLIBCXX_PARALLEL: each
+ * cycle runs the parallel algorithms on large vectors with another
+ * number of threads, one thread giving the sequential code.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <sstream>
+#include <cstdlib>
+#include <testsuite_performance.h>
+
+const int n = 10000000;
+
+struct square
+{
+  double
+  operator()(double x) const
+  { return x * x; }
+};
+
+void
+test_threads(unsigned int n_threads)
+{
+  using namespace __gnu_test;
+  time_counter time;
+  resource_counter resource;
+
+#ifdef _GLIBCXX_PARALLEL
+  __gnu_parallel::__get_settings()._M_num_threads = n_threads;
+#endif
+
+  std::ostringstream comment;
+  comment << "threads: " << n_threads << '\t' << "elements: " << n;
+  report_header(__FILE__, comment.str());
+
+  std::vector<int> data(n);
+  std::srand(n);
+  for (int i = 0; i < n; ++i)
+    data[i] = std::rand();
+
+  std::vector<int> v(data);
+  start_counters(time, resource);
+  std::sort(v.begin(), v.end());
+  stop_counters(time, resource);
+  report_performance(__FILE__, "sort", time, resource);
+  clear_counters(time, resource);
+
+  v = data;
+  start_counters(time, resource);
+  std::stable_sort(v.begin(), v.end());
+  stop_counters(time, resource);
+  report_performance(__FILE__, "stable_sort", time, resource);
+  clear_counters(time, resource);
+
+  v = data;
+  start_counters(time, resource);
+  std::partial_sort(v.begin(), v.begin() + n / 2, v.end());
+  stop_counters(time, resource);
+  report_performance(__FILE__, "partial_sort", time, resource);
+  clear_counters(time, resource);
+
+  std::vector<double> d(data.begin(), data.end());
+  std::vector<double> r(n);
+  start_counters(time, resource);
+  for (int i = 0; i < 10; ++i)
+    std::transform(d.begin(), d.end(), r.begin(), square());
+  stop_counters(time, resource);
+  report_performance(__FILE__, "transform x10", time, resource);
+  clear_counters(time, resource);
+
+  std::vector<long> l(data.begin(), data.end());
+  long sum = 0;
+  start_counters(time, resource);
+  for (int i = 0; i < 10; ++i)
+    sum += std::accumulate(l.begin(), l.end(), 0L);
+  stop_counters(time, resource);
+  report_performance(__FILE__, "accumulate x10", time, resource);
+  clear_counters(time, resource);
+
+  std::vector<long> p(n);
+  start_counters(time, resource);
+  for (int i = 0; i < 10; ++i)
+    std::partial_sum(l.begin(), l.end(), p.begin());
+  stop_counters(time, resource);
+  report_performance(__FILE__, "partial_sum x10", time, resource);
+  clear_counters(time, resource);
+}
+
+int main(void)
+{
+#ifdef TEST_P1
+  test_threads(1);
+#endif
+#ifdef TEST_P2
+  test_threads(2);
+#endif
+#ifdef TEST_P3
+  test_threads(4);
+#endif
+#ifdef TEST_P4
+  test_threads(8);
+#endif
+#ifdef TEST_P5
+  test_threads(16);
+#endif
+  return 0;
+}
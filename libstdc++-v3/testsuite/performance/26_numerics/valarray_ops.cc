@@ -0,0 +1,105 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+#include <valarray>
+#include <testsuite_performance.h>
+
+// Binary operators, expressions, reductions and gslice copies on large valarrays.
+int main()
+{
+  using namespace std;
+  using namespace __gnu_test;
+
+  time_counter time;
+  resource_counter resource;
+  const int iterations = 2000;
+  const size_t n = 65536;
+
+  valarray<double> a(n), b(n), c(n), r(n);
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] = i % 97 * 0.5;
+      b[i] = i % 89 * 0.25;
+      c[i] = 1.0;
+    }
+  volatile double acc = 0;
+
+  start_counters(time, resource);
+  for (int i = 0; i < iterations; ++i)
+    r = a * b + c;
+  stop_counters(time, resource);
+  report_performance(__FILE__, "expression", time, resource);
+  clear_counters(time, resource);
+
+  start_counters(time, resource);
+  for (int i = 0; i < iterations; ++i)
+    {
+      r = a * b;
+      r = a + 2.0;
+    }
+  stop_counters(time, resource);
+  report_performance(__FILE__, "binary operators", time, resource);
+  clear_counters(time, resource);
+
+  start_counters(time, resource);
+  for (int i = 0; i < iterations; ++i)
+    acc += a.sum();
+  stop_counters(time, resource);
+  report_performance(__FILE__, "sum", time, resource);
+  clear_counters(time, resource);
+
+  start_counters(time, resource);
+  for (int i = 0; i < iterations; ++i)
+    acc += a.min() + a.max();
+  stop_counters(time, resource);
+  report_performance(__FILE__, "min and max", time, resource);
+  clear_counters(time, resource);
+
+  start_counters(time, resource);
+  for (int i = 0; i < iterations; ++i)
+    acc += (a * b).sum();
+  stop_counters(time, resource);
+  report_performance(__FILE__, "expression sum", time, resource);
+  clear_counters(time, resource);
+
+  // A 256x128 block of a 256x256 matrix.
+  size_t l[] = { 256, 128 };
+  size_t s[] = { 256, 1 };
+  const gslice gs(0, valarray<size_t>(l, 2), valarray<size_t>(s, 2));
+  valarray<double> m(n / 2);
+
+  start_counters(time, resource);
+  for (int i = 0; i < iterations; ++i)
+    {
+      m = a[gs];
+      r[gs] = m;
+    }
+  stop_counters(time, resource);
+  report_performance(__FILE__, "gslice copies", time, resource);
+
+  return 0;
+}
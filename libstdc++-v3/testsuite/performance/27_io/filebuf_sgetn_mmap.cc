@@ -0,0 +1,70 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+#include <cstdio>
+#include <fstream>
+#include <ext/mmap_filebuf.h>
+#include <testsuite_performance.h>
+
+// Reading a file in chunks, through the internal buffer and through
+// a mapping.
+template<typename _Filebuf>
+  void
+  test(const char* what, const char* name, int iterations, int chunksize)
+  {
+    using namespace std;
+    using namespace __gnu_test;
+
+    time_counter time;
+    resource_counter resource;
+
+    char* chunk = new char[chunksize];
+    _Filebuf buf;
+    buf.open(name, ios_base::in);
+    start_counters(time, resource);
+    for (int i = 0; i < iterations; ++i)
+      if (buf.sgetn(chunk, chunksize) < chunksize)
+	buf.pubseekoff(0, ios::beg);
+    stop_counters(time, resource);
+    buf.close();
+    report_performance(__FILE__, what, time, resource);
+    delete [] chunk;
+  }
+
+int main()
+{
+  using namespace std;
+
+  const char* name = "/usr/share/dict/linux.words";
+
+  test<filebuf>("filebuf 100", name, 500000, 100);
+  test<__gnu_cxx::mmap_filebuf<char> >("mmap_filebuf 100", name, 500000, 100);
+  test<filebuf>("filebuf 10000", name, 50000, 10000);
+  test<__gnu_cxx::mmap_filebuf<char> >("mmap_filebuf 10000", name,
+				       50000, 10000);
+  return 0;
+}
@@ -0,0 +1,126 @@
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+#include <cstdio>
+#include <fstream>
+#include <testsuite_hooks.h>
+#include <testsuite_performance.h>
+
+// Conversions to and from UTF-8, by the codecvt facet alone and
+// through wfilebuf, with mostly ASCII text and with a mix of one to
+// four byte sequences.
+int main()
+{
+  using namespace std;
+  using namespace __gnu_test;
+
+  typedef codecvt<wchar_t, char, mbstate_t> cvt_type;
+
+  time_counter time;
+  resource_counter resource;
+
+  const int iters = 20000;
+  const int size = 1024;
+  const int fileiters = 50;
+  const int filesize = 1 << 18;
+
+  locale loc = try_named_locale("en_US.UTF-8");
+  const cvt_type& cvt = use_facet<cvt_type>(loc);
+  const char* name = "tmp_wfilebuf_utf8";
+
+  wchar_t* wbuf = new wchar_t[filesize];
+  char* cbuf = new char[size * 4];
+  wchar_t* wbuf2 = new wchar_t[filesize];
+
+  for (int mixed = 0; mixed < 2; ++mixed)
+    {
+      const char* kind = mixed ? "mixed" : "ascii";
+      for (int i = 0; i < filesize; ++i)
+	if (!mixed || i % 4 == 0)
+	  wbuf[i] = L'a' + i % 26;
+	else
+	  wbuf[i] = i % 4 == 1 ? 0xe9 : i % 4 == 2 ? 0x4e2d : 0x1d11e;
+
+      char msg[64];
+      mbstate_t state;
+      const wchar_t* wfrom_next;
+      char* cto_next;
+      memset(&state, 0, sizeof(state));
+      start_counters(time, resource);
+      for (int i = 0; i < iters; ++i)
+	cvt.out(state, wbuf, wbuf + size, wfrom_next,
+		cbuf, cbuf + size * 4, cto_next);
+      stop_counters(time, resource);
+      sprintf(msg, "codecvt out, %s", kind);
+      report_performance(__FILE__, msg, time, resource);
+      clear_counters(time, resource);
+
+      const char* cfrom_next;
+      wchar_t* wto_next;
+      memset(&state, 0, sizeof(state));
+      start_counters(time, resource);
+      for (int i = 0; i < iters; ++i)
+	cvt.in(state, cbuf, cto_next, cfrom_next,
+	       wbuf2, wbuf2 + size, wto_next);
+      stop_counters(time, resource);
+      sprintf(msg, "codecvt in, %s", kind);
+      report_performance(__FILE__, msg, time, resource);
+      clear_counters(time, resource);
+
+      start_counters(time, resource);
+      for (int i = 0; i < fileiters; ++i)
+	{
+	  wfilebuf out;
+	  out.pubimbue(loc);
+	  out.open(name, ios_base::out | ios_base::trunc);
+	  out.sputn(wbuf, filesize);
+	}
+      stop_counters(time, resource);
+      sprintf(msg, "wfilebuf sputn, %s", kind);
+      report_performance(__FILE__, msg, time, resource);
+      clear_counters(time, resource);
+
+      start_counters(time, resource);
+      for (int i = 0; i < fileiters; ++i)
+	{
+	  wfilebuf in;
+	  in.pubimbue(loc);
+	  in.open(name, ios_base::in);
+	  in.sgetn(wbuf2, filesize);
+	}
+      stop_counters(time, resource);
+      sprintf(msg, "wfilebuf sgetn, %s", kind);
+      report_performance(__FILE__, msg, time, resource);
+      clear_counters(time, resource);
+    }
+
+  remove(name);
+  delete [] wbuf;
+  delete [] cbuf;
+  delete [] wbuf2;
+  return 0;
+}
@@ -0,0 +1,58 @@
+// -*- C++ -*-
+// Types shared by testsuite_shared.so and the tests that load it.
+//
+// Copyright (C) 2005 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 2, or (at your option)
+// any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this library; see the file COPYING.  If not, write to the Free
+// Software Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307,
+// USA.
+//
+// As a special exception, you may use this file as part of a free software
+// library without restriction.  Specifically, if other files instantiate
+// templates or use macros or inline functions from this file, or you compile
+// this file and link it with other files to produce an executable, this
+// file does not by itself cause the resulting executable to be covered by
+// the GNU General Public License.  This exception does not however
+// invalidate any other reasons why the executable file might be covered by
+// the GNU General Public License.
+
+#ifndef _GLIBCXX_TESTSUITE_SHARED_H
+#define _GLIBCXX_TESTSUITE_SHARED_H
+
+namespace __gnu_test
+{
+  // All the member functions are inline, so the vtables and type_infos
+  // are emitted both in the tests and in testsuite_shared.so.
+  struct shared_base
+  {
+    virtual ~shared_base() { }
+  };
+
+  struct shared_derived : shared_base
+  {
+    int value;
+  };
+
+  struct shared_other : shared_base
+  {
+    double value;
+  };
+
+  // The type of make_shared_object in testsuite_shared.so, which
+  // returns a new shared_derived if KIND is 0, else a new shared_other.
+  typedef shared_base* (*make_shared_object_type)(int kind);
+} // namespace __gnu_test
+
+#endif